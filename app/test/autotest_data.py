@@ -20,6 +20,18 @@
         "Func":    timer_autotest,
         "Report":   None,
     },
+    {
+        "Name":    "Trace autotest",
+        "Command": "trace_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "Lcore poll autotest",
+        "Command": "lcore_poll_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
         "Name":    "Debug autotest",
         "Command": "debug_autotest",
@@ -110,6 +122,30 @@
         "Func":    default_autotest,
         "Report":  None,
     },
+    {
+        "Name":    "RIB autotest",
+        "Command": "rib_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "FIB autotest",
+        "Command": "fib_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "RIB6 autotest",
+        "Command": "rib6_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "FIB6 autotest",
+        "Command": "fib6_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
         "Name":    "Memcpy autotest",
         "Command": "memcpy_autotest",
@@ -164,12 +200,42 @@
         "Func":    default_autotest,
         "Report":  None,
     },
+    {
+        "Name":    "Stack autotest",
+        "Command": "stack_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "Lock-free stack autotest",
+        "Command": "stack_lf_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "RCU QSBR autotest",
+        "Command": "rcu_qsbr_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
         "Name":    "Spinlock autotest",
         "Command": "spinlock_autotest",
         "Func":    spinlock_autotest,
         "Report":  None,
     },
+    {
+        "Name":    "Ticketlock autotest",
+        "Command": "ticketlock_autotest",
+        "Func":    spinlock_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "MCS lock autotest",
+        "Command": "mcslock_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
         "Name":    "Byte order autotest",
         "Command": "byteorder_autotest",
@@ -676,6 +742,18 @@
         "Func":    default_autotest,
         "Report":  None,
     },
+    {
+        "Name":    "Fib perf autotest",
+        "Command": "fib_perf_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
+    {
+        "Name":    "Fib6 perf autotest",
+        "Command": "fib6_perf_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
          "Name":    "Efd perf autotest",
          "Command": "efd_perf_autotest",
@@ -688,6 +766,12 @@
         "Func":    default_autotest,
         "Report":  None,
     },
+    {
+        "Name":    "Interrupts perf autotest",
+        "Command": "interrupt_perf_autotest",
+        "Func":    default_autotest,
+        "Report":  None,
+    },
     {
         "Name":    "Reciprocal division perf",
         "Command": "reciprocal_division_perf",
@@ -1242,6 +1242,21 @@ test_memory_flags(void)
 	const char *argv10[] = {prgname, "-c", "10", "-n", "2",
 			"--file-prefix=" memtest, valid_socket_mem};
 
+	/* valid --mem-init-threads flag */
+	const char *argv11[] = {prgname, "-c", "10", "-n", "2",
+			"--file-prefix=" memtest, valid_socket_mem,
+			"--mem-init-threads=2"};
+
+	/* invalid (zero) --mem-init-threads flag */
+	const char *argv12[] = {prgname, "-c", "10", "-n", "2",
+			"--file-prefix=" memtest, valid_socket_mem,
+			"--mem-init-threads=0"};
+
+	/* valid --mem-init-lazy flag */
+	const char *argv13[] = {prgname, "-c", "10", "-n", "2",
+			"--file-prefix=" memtest, valid_socket_mem,
+			"--mem-init-lazy"};
+
 	if (launch_proc(argv0) != 0) {
 		printf("Error - secondary process failed with valid -m flag !\n");
 		return -1;
@@ -1306,6 +1321,22 @@ test_memory_flags(void)
 		return -1;
 	}
 
+	if (launch_proc(argv11) != 0) {
+		printf("Error - process failed with valid --mem-init-threads!\n");
+		return -1;
+	}
+
+	if (launch_proc(argv12) == 0) {
+		printf("Error - process run ok with invalid (zero) "
+				"--mem-init-threads!\n");
+		return -1;
+	}
+
+	if (launch_proc(argv13) != 0) {
+		printf("Error - process failed with --mem-init-lazy!\n");
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -0,0 +1,645 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <rte_ip.h>
+#include <rte_random.h>
+#include <rte_rib.h>
+#include <rte_fib.h>
+
+#include "test.h"
+
+static int32_t test_create_invalid(void);
+static int32_t test_multiple_create(void);
+static int32_t test_free_null(void);
+static int32_t test_add_del_invalid(void);
+static int32_t test_get_invalid(void);
+static int32_t test_lookup(void);
+static int32_t test_random_routes(void);
+
+#define MAX_ROUTES	(1 << 16)
+#define MAX_TBL8	(1 << 15)
+#define MAX_DEPTH	32
+
+/*
+ * Check that rte_fib_create fails gracefully for incorrect user input
+ * arguments
+ */
+int32_t
+test_create_invalid(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB_DUMMY;
+
+	/* rte_fib_create: fib name == NULL */
+	fib = rte_fib_create(NULL, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib_create: config == NULL */
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, NULL);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib_create: max_routes = 0 */
+	config.max_routes = 0;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.max_routes = MAX_ROUTES;
+
+	config.type = RTE_FIB_DIR24_8 + 1;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_8B + 1;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* the tbl8 indexes do not fit in a 1 byte next hop */
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_1B;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	config.dir24_8.num_tbl8 = 0;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_2B;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* the default next hop does not fit in a 2 bytes next hop */
+	config.dir24_8.num_tbl8 = 16;
+	config.default_nh = 1 << 15;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Create fib table then delete fib table 10 times
+ * Use a slightly different rules size each time
+ */
+int32_t
+test_multiple_create(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config;
+	int32_t i;
+
+	config.default_nh = 0;
+	config.type = RTE_FIB_DUMMY;
+
+	for (i = 0; i < 10; i++) {
+		config.max_routes = MAX_ROUTES - i;
+		fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+		rte_fib_free(fib);
+	}
+	/* Can not test free so return success */
+	return TEST_SUCCESS;
+}
+
+/*
+ * Call rte_fib_free for NULL pointer user input. Note: free has no return and
+ * therefore it is impossible to check for failure but this test is added to
+ * increase function coverage metrics and to validate that freeing null does
+ * not crash.
+ */
+int32_t
+test_free_null(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB_DUMMY;
+
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	rte_fib_free(fib);
+	rte_fib_free(NULL);
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_fib_add and rte_fib_delete fails gracefully
+ * for incorrect user input arguments
+ */
+int32_t
+test_add_del_invalid(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config;
+	uint64_t nh = 100;
+	uint32_t ip = IPv4(0, 0, 0, 0);
+	int ret;
+	uint8_t depth = 24;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB_DUMMY;
+
+	/* rte_fib_add: fib == NULL */
+	ret = rte_fib_add(NULL, ip, depth, nh);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib_delete: fib == NULL */
+	ret = rte_fib_delete(NULL, ip, depth);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/*Create valid fib to use in rest of test. */
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	/* rte_fib_add: depth > RTE_FIB_MAXDEPTH */
+	ret = rte_fib_add(fib, ip, RTE_FIB_MAXDEPTH + 1, nh);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib_delete: depth > RTE_FIB_MAXDEPTH */
+	ret = rte_fib_delete(fib, ip, RTE_FIB_MAXDEPTH + 1);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib_delete: route not in the FIB */
+	ret = rte_fib_delete(fib, ip, depth);
+	RTE_TEST_ASSERT(ret == -ENOENT,
+		"Call succeeded with invalid parameters\n");
+
+	rte_fib_free(fib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_fib_get_dp and rte_fib_get_rib fails gracefully
+ * for incorrect user input arguments
+ */
+int32_t
+test_get_invalid(void)
+{
+	void *p;
+
+	p = rte_fib_get_dp(NULL);
+	RTE_TEST_ASSERT(p == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	p = rte_fib_get_rib(NULL);
+	RTE_TEST_ASSERT(p == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Add routes for one ip with all depths [1:32], the next hop of each one
+ * being its depth, and delete them starting from the longest or the
+ * shortest, checking the lookups of the addresses after each step.
+ */
+static int
+lookup_and_check_asc(struct rte_fib *fib, uint32_t ip_arr[RTE_FIB_MAXDEPTH],
+	uint32_t ip_missing, uint64_t def_nh, uint32_t n)
+{
+	uint64_t nh_arr[RTE_FIB_MAXDEPTH];
+	int ret;
+	uint32_t i = 0;
+
+	ret = rte_fib_lookup_bulk(fib, ip_arr, nh_arr, RTE_FIB_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+
+	for (; i <= RTE_FIB_MAXDEPTH - n; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == n,
+			"Failed to get proper nexthop\n");
+
+	for (; i < RTE_FIB_MAXDEPTH; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == --n,
+			"Failed to get proper nexthop\n");
+
+	ret = rte_fib_lookup_bulk(fib, &ip_missing, nh_arr, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh_arr[0] == def_nh),
+		"Failed to get proper nexthop\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+lookup_and_check_desc(struct rte_fib *fib, uint32_t ip_arr[RTE_FIB_MAXDEPTH],
+	uint32_t ip_missing, uint64_t def_nh, uint32_t n)
+{
+	uint64_t nh_arr[RTE_FIB_MAXDEPTH];
+	int ret;
+	uint32_t i = 0;
+
+	ret = rte_fib_lookup_bulk(fib, ip_arr, nh_arr, RTE_FIB_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+
+	for (; i < n; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == RTE_FIB_MAXDEPTH - i,
+			"Failed to get proper nexthop\n");
+
+	for (; i < RTE_FIB_MAXDEPTH; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == def_nh,
+			"Failed to get proper nexthop\n");
+
+	ret = rte_fib_lookup_bulk(fib, &ip_missing, nh_arr, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh_arr[0] == def_nh),
+		"Failed to get proper nexthop\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+check_fib(struct rte_fib *fib)
+{
+	uint64_t def_nh = 100;
+	uint32_t ip_arr[RTE_FIB_MAXDEPTH];
+	uint32_t ip_add = IPv4(128, 0, 0, 0);
+	uint32_t i, ip_missing = IPv4(127, 255, 255, 255);
+	int ret;
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH; i++)
+		ip_arr[i] = ip_add + (1ULL << i) - 1;
+
+	ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	for (i = 1; i <= RTE_FIB_MAXDEPTH; i++) {
+		ret = rte_fib_add(fib, ip_add, i, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+		ret = lookup_and_check_asc(fib, ip_arr, ip_missing,
+				def_nh, i);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	for (i = RTE_FIB_MAXDEPTH; i > 1; i--) {
+		ret = rte_fib_delete(fib, ip_add, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		ret = lookup_and_check_asc(fib, ip_arr, ip_missing,
+			def_nh, i - 1);
+
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+	ret = rte_fib_delete(fib, ip_add, i);
+	RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+	ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Lookup and check fails\n");
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH; i++) {
+		ret = rte_fib_add(fib, ip_add, RTE_FIB_MAXDEPTH - i,
+			RTE_FIB_MAXDEPTH - i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+		ret = lookup_and_check_desc(fib, ip_arr, ip_missing,
+			def_nh, i + 1);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	for (i = 1; i <= RTE_FIB_MAXDEPTH; i++) {
+		ret = rte_fib_delete(fib, ip_add, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh,
+			RTE_FIB_MAXDEPTH - i);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* run a check with all the lookup functions supported by a FIB */
+static int
+check_fib_all_lookups(struct rte_fib *fib, int (*check)(struct rte_fib *))
+{
+	static const enum rte_fib_lookup_type types[] = {
+		RTE_FIB_LOOKUP_DIR24_8_SCALAR,
+		RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
+	};
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		if (rte_fib_select_lookup(fib, types[i]) != 0)
+			continue;
+		ret = check(fib);
+		if (ret != TEST_SUCCESS)
+			return ret;
+	}
+	return TEST_SUCCESS;
+}
+
+int32_t
+test_lookup(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config;
+	uint64_t def_nh = 100;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = def_nh;
+	config.type = RTE_FIB_DUMMY;
+
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DUMMY type\n");
+	rte_fib_free(fib);
+
+	config.type = RTE_FIB_DIR24_8;
+
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_1B;
+	config.dir24_8.num_tbl8 = 127;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DIR24_8_1B type\n");
+	rte_fib_free(fib);
+
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_2B;
+	config.dir24_8.num_tbl8 = MAX_TBL8 - 1;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DIR24_8_2B type\n");
+	rte_fib_free(fib);
+
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DIR24_8_4B type\n");
+	rte_fib_free(fib);
+
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_8B;
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DIR24_8_8B type\n");
+	rte_fib_free(fib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Random routes in a small address range, so that they overlap, are added
+ * and deleted while the lookups are checked against a linear search of the
+ * routes.
+ */
+#define RANDOM_ROUTES		512
+#define RANDOM_LOOKUPS		4096
+#define RANDOM_BASE		IPv4(10, 0, 0, 0)
+#define RANDOM_BASE_DEPTH	14
+
+struct random_route {
+	uint32_t ip;
+	uint8_t depth;
+	uint64_t nh;
+	int installed;
+};
+
+static struct random_route random_routes[RANDOM_ROUTES];
+static uint64_t random_max_nh;
+
+static uint64_t
+random_route_lookup(uint32_t ip, uint64_t def_nh)
+{
+	uint64_t nh = def_nh;
+	int depth = -1;
+	unsigned int i;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		if (!random_routes[i].installed ||
+				(random_routes[i].depth <= depth) ||
+				(((ip ^ random_routes[i].ip) &
+				rte_rib_depth_to_mask(random_routes[i].depth))
+				!= 0))
+			continue;
+		depth = random_routes[i].depth;
+		nh = random_routes[i].nh;
+	}
+	return nh;
+}
+
+static int
+check_random_routes(struct rte_fib *fib)
+{
+	static uint32_t ips[RANDOM_LOOKUPS];
+	static uint64_t nhs[RANDOM_LOOKUPS];
+	const uint64_t def_nh = 0;
+	unsigned int i, n;
+	int ret;
+
+	for (i = 0; i < RANDOM_LOOKUPS; i++) {
+		n = rte_rand() % RANDOM_ROUTES;
+		/* the edges of the routes, and random addresses */
+		switch (i % 4) {
+		case 0:
+			ips[i] = random_routes[n].ip;
+			break;
+		case 1:
+			ips[i] = random_routes[n].ip +
+				(uint32_t)((1ULL << (32 -
+				random_routes[n].depth)) - 1);
+			break;
+		case 2:
+			ips[i] = random_routes[n].ip - 1;
+			break;
+		default:
+			ips[i] = RANDOM_BASE + (rte_rand() &
+				~rte_rib_depth_to_mask(RANDOM_BASE_DEPTH - 1));
+			break;
+		}
+	}
+
+	ret = rte_fib_lookup_bulk(fib, ips, nhs, RANDOM_LOOKUPS);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	for (i = 0; i < RANDOM_LOOKUPS; i++)
+		RTE_TEST_ASSERT(nhs[i] == random_route_lookup(ips[i], def_nh),
+			"Wrong nexthop for %u.%u.%u.%u\n",
+			ips[i] >> 24, (ips[i] >> 16) & 0xff,
+			(ips[i] >> 8) & 0xff, ips[i] & 0xff);
+
+	return TEST_SUCCESS;
+}
+
+static int
+check_random_routes_all_lookups(struct rte_fib *fib)
+{
+	return check_fib_all_lookups(fib, check_random_routes);
+}
+
+static int
+random_routes_run(struct rte_fib *fib)
+{
+	struct random_route *r;
+	unsigned int i, j;
+	int ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		r->depth = RANDOM_BASE_DEPTH + rte_rand() %
+			(RTE_FIB_MAXDEPTH - RANDOM_BASE_DEPTH + 1);
+		r->ip = (RANDOM_BASE + (uint32_t)rte_rand() %
+			(1U << (32 - RANDOM_BASE_DEPTH))) &
+			rte_rib_depth_to_mask(r->depth);
+		r->nh = 1 + rte_rand() % random_max_nh;
+		r->installed = 0;
+		/* a duplicate prefix would take the next hop of the last */
+		for (j = 0; j < i; j++) {
+			if ((random_routes[j].ip == r->ip) &&
+					(random_routes[j].depth == r->depth))
+				r->depth = 0;
+		}
+	}
+
+	/*
+	 * Add all the routes, then delete and re-add half of them. The small
+	 * FIBs cannot hold all the /24s with longer routes.
+	 */
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		if (r->depth == 0)
+			continue;
+		ret = rte_fib_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT((ret == 0) || (ret == -ENOSPC),
+			"Failed to add a route\n");
+		r->installed = (ret == 0);
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i += 2) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		ret = rte_fib_delete(fib, r->ip, r->depth);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		r->installed = 0;
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i += 2) {
+		r = &random_routes[i];
+		if (r->depth == 0)
+			continue;
+		r->nh = 1 + rte_rand() % random_max_nh;
+		ret = rte_fib_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT((ret == 0) || (ret == -ENOSPC),
+			"Failed to add a route\n");
+		r->installed = (ret == 0);
+	}
+	/* update the next hop of existing routes */
+	for (i = 1; i < RANDOM_ROUTES; i += 4) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		r->nh = 1 + rte_rand() % random_max_nh;
+		ret = rte_fib_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT(ret == 0, "Failed to update a route\n");
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		ret = rte_fib_delete(fib, r->ip, r->depth);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		r->installed = 0;
+	}
+	return check_random_routes_all_lookups(fib);
+}
+
+int32_t
+test_random_routes(void)
+{
+	static const enum rte_fib_dir24_8_nh_sz nh_szs[] = {
+		RTE_FIB_DIR24_8_1B, RTE_FIB_DIR24_8_2B,
+		RTE_FIB_DIR24_8_4B, RTE_FIB_DIR24_8_8B,
+	};
+	struct rte_fib *fib;
+	struct rte_fib_conf config;
+	unsigned int i;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB_DIR24_8;
+
+	for (i = 0; i < RTE_DIM(nh_szs); i++) {
+		config.dir24_8.nh_sz = nh_szs[i];
+		/* the 1 byte next hops index up to 127 tbl8 groups */
+		config.dir24_8.num_tbl8 = (nh_szs[i] == RTE_FIB_DIR24_8_1B) ?
+			127 : RANDOM_ROUTES;
+		random_max_nh = (nh_szs[i] == RTE_FIB_DIR24_8_1B) ?
+			127 : 1000;
+		fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+		ret = random_routes_run(fib);
+		rte_fib_free(fib);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Random routes fail for next hops of %u bytes\n",
+			1U << nh_szs[i]);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite fib_tests = {
+	.suite_name = "fib autotest",
+	.setup = NULL,
+	.teardown = NULL,
+	.unit_test_cases = {
+		TEST_CASE(test_create_invalid),
+		TEST_CASE(test_multiple_create),
+		TEST_CASE(test_free_null),
+		TEST_CASE(test_add_del_invalid),
+		TEST_CASE(test_get_invalid),
+		TEST_CASE(test_lookup),
+		TEST_CASE(test_random_routes),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_fib(void)
+{
+	return unit_test_suite_runner(&fib_tests);
+}
+
+REGISTER_TEST_COMMAND(fib_autotest, test_fib);
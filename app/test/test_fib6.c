@@ -0,0 +1,682 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_memory.h>
+#include <rte_random.h>
+#include <rte_rib6.h>
+#include <rte_fib6.h>
+
+#include "test.h"
+
+static int32_t test_create_invalid(void);
+static int32_t test_multiple_create(void);
+static int32_t test_free_null(void);
+static int32_t test_add_del_invalid(void);
+static int32_t test_get_invalid(void);
+static int32_t test_lookup(void);
+static int32_t test_random_routes(void);
+
+#define MAX_ROUTES	(1 << 16)
+#define MAX_TBL8	(1 << 15)
+
+/*
+ * Check that rte_fib6_create fails gracefully for incorrect user input
+ * arguments
+ */
+int32_t
+test_create_invalid(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB6_DUMMY;
+
+	/* rte_fib6_create: fib name == NULL */
+	fib = rte_fib6_create(NULL, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_create: config == NULL */
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, NULL);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_create: max_routes = 0 */
+	config.max_routes = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.max_routes = MAX_ROUTES;
+
+	config.type = RTE_FIB6_TRIE + 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	config.type = RTE_FIB6_TRIE;
+	config.trie.num_tbl8 = MAX_TBL8;
+
+	config.trie.nh_sz = RTE_FIB6_TRIE_8B + 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* the tbl8 indexes do not fit in a 2 bytes next hop */
+	config.trie.nh_sz = RTE_FIB6_TRIE_2B;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	config.trie.num_tbl8 = 0;
+	config.trie.nh_sz = RTE_FIB6_TRIE_4B;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* the default next hop does not fit in a 2 bytes next hop */
+	config.trie.num_tbl8 = 16;
+	config.trie.nh_sz = RTE_FIB6_TRIE_2B;
+	config.default_nh = 1 << 15;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Create fib table then delete fib table 10 times
+ * Use a slightly different rules size each time
+ */
+int32_t
+test_multiple_create(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+	int32_t i;
+
+	config.default_nh = 0;
+	config.type = RTE_FIB6_DUMMY;
+
+	for (i = 0; i < 10; i++) {
+		config.max_routes = MAX_ROUTES - i;
+		fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+		rte_fib6_free(fib);
+	}
+	/* Can not test free so return success */
+	return TEST_SUCCESS;
+}
+
+/*
+ * Call rte_fib6_free for NULL pointer user input. Note: free has no return
+ * and therefore it is impossible to check for failure but this test is added
+ * to increase function coverage metrics and to validate that freeing null
+ * does not crash.
+ */
+int32_t
+test_free_null(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB6_DUMMY;
+
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	rte_fib6_free(fib);
+	rte_fib6_free(NULL);
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_fib6_add and rte_fib6_delete fails gracefully
+ * for incorrect user input arguments
+ */
+int32_t
+test_add_del_invalid(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+	uint64_t nh = 100;
+	uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE] = {0};
+	int ret;
+	uint8_t depth = 24;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB6_DUMMY;
+
+	/* rte_fib6_add: fib == NULL */
+	ret = rte_fib6_add(NULL, ip, depth, nh);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_delete: fib == NULL */
+	ret = rte_fib6_delete(NULL, ip, depth);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/*Create valid fib to use in rest of test. */
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	/* rte_fib6_add: ip == NULL */
+	ret = rte_fib6_add(fib, NULL, depth, nh);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_add: depth > RTE_FIB6_MAXDEPTH */
+	ret = rte_fib6_add(fib, ip, RTE_FIB6_MAXDEPTH + 1, nh);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_delete: depth > RTE_FIB6_MAXDEPTH */
+	ret = rte_fib6_delete(fib, ip, RTE_FIB6_MAXDEPTH + 1);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_delete: route not in the FIB */
+	ret = rte_fib6_delete(fib, ip, depth);
+	RTE_TEST_ASSERT(ret == -ENOENT,
+		"Call succeeded with invalid parameters\n");
+
+	rte_fib6_free(fib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_fib6_get_dp and rte_fib6_get_rib fails gracefully
+ * for incorrect user input arguments
+ */
+int32_t
+test_get_invalid(void)
+{
+	void *p;
+
+	p = rte_fib6_get_dp(NULL);
+	RTE_TEST_ASSERT(p == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	p = rte_fib6_get_rib(NULL);
+	RTE_TEST_ASSERT(p == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Add routes for one ip with all depths [1:128], the next hop of each one
+ * being its depth, and delete them starting from the longest or the
+ * shortest, checking the lookups of the addresses after each step.
+ */
+static int
+lookup_and_check_asc(struct rte_fib6 *fib,
+	uint8_t ip_arr[RTE_FIB6_MAXDEPTH][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint8_t ip_missing[][RTE_FIB6_IPV6_ADDR_SIZE], uint64_t def_nh,
+	uint32_t n)
+{
+	uint64_t nh_arr[RTE_FIB6_MAXDEPTH];
+	int ret;
+	uint32_t i = 0;
+
+	ret = rte_fib6_lookup_bulk(fib, ip_arr, nh_arr, RTE_FIB6_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+
+	for (; i <= RTE_FIB6_MAXDEPTH - n; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == n,
+			"Failed to get proper nexthop\n");
+
+	for (; i < RTE_FIB6_MAXDEPTH; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == --n,
+			"Failed to get proper nexthop\n");
+
+	ret = rte_fib6_lookup_bulk(fib, ip_missing, nh_arr, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh_arr[0] == def_nh),
+		"Failed to get proper nexthop\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+lookup_and_check_desc(struct rte_fib6 *fib,
+	uint8_t ip_arr[RTE_FIB6_MAXDEPTH][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint8_t ip_missing[][RTE_FIB6_IPV6_ADDR_SIZE], uint64_t def_nh,
+	uint32_t n)
+{
+	uint64_t nh_arr[RTE_FIB6_MAXDEPTH];
+	int ret;
+	uint32_t i = 0;
+
+	ret = rte_fib6_lookup_bulk(fib, ip_arr, nh_arr, RTE_FIB6_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+
+	for (; i < n; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == RTE_FIB6_MAXDEPTH - i,
+			"Failed to get proper nexthop\n");
+
+	for (; i < RTE_FIB6_MAXDEPTH; i++)
+		RTE_TEST_ASSERT(nh_arr[i] == def_nh,
+			"Failed to get proper nexthop\n");
+
+	ret = rte_fib6_lookup_bulk(fib, ip_missing, nh_arr, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh_arr[0] == def_nh),
+		"Failed to get proper nexthop\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+check_fib(struct rte_fib6 *fib)
+{
+	uint64_t def_nh = 100;
+	uint8_t ip_arr[RTE_FIB6_MAXDEPTH][RTE_FIB6_IPV6_ADDR_SIZE];
+	uint8_t ip_add[RTE_FIB6_IPV6_ADDR_SIZE] = {0x80};
+	uint8_t ip_missing[1][RTE_FIB6_IPV6_ADDR_SIZE];
+	uint32_t i, j;
+	int ret;
+
+	/* ip_arr[i] is 8000:: with its i lowest bits set */
+	for (i = 0; i < RTE_FIB6_MAXDEPTH; i++) {
+		for (j = 0; j < RTE_FIB6_IPV6_ADDR_SIZE; j++)
+			ip_arr[i][j] = ip_add[j] |
+				~rte_rib6_get_msk_part(RTE_FIB6_MAXDEPTH - i,
+				j);
+	}
+	memset(ip_missing[0], UINT8_MAX, RTE_FIB6_IPV6_ADDR_SIZE);
+	ip_missing[0][0] = 0x7f;
+
+	ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	for (i = 1; i <= RTE_FIB6_MAXDEPTH; i++) {
+		ret = rte_fib6_add(fib, ip_add, i, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+		ret = lookup_and_check_asc(fib, ip_arr, ip_missing,
+				def_nh, i);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	for (i = RTE_FIB6_MAXDEPTH; i > 1; i--) {
+		ret = rte_fib6_delete(fib, ip_add, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		ret = lookup_and_check_asc(fib, ip_arr, ip_missing,
+			def_nh, i - 1);
+
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+	ret = rte_fib6_delete(fib, ip_add, i);
+	RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+	ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Lookup and check fails\n");
+
+	for (i = 0; i < RTE_FIB6_MAXDEPTH; i++) {
+		ret = rte_fib6_add(fib, ip_add, RTE_FIB6_MAXDEPTH - i,
+			RTE_FIB6_MAXDEPTH - i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+		ret = lookup_and_check_desc(fib, ip_arr, ip_missing,
+			def_nh, i + 1);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	for (i = 1; i <= RTE_FIB6_MAXDEPTH; i++) {
+		ret = rte_fib6_delete(fib, ip_add, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh,
+			RTE_FIB6_MAXDEPTH - i);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Lookup and check fails\n");
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* run a check with all the lookup functions supported by a FIB */
+static int
+check_fib_all_lookups(struct rte_fib6 *fib, int (*check)(struct rte_fib6 *))
+{
+	static const enum rte_fib6_lookup_type types[] = {
+		RTE_FIB6_LOOKUP_TRIE_SCALAR,
+		RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512,
+	};
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		if (rte_fib6_select_lookup(fib, types[i]) != 0)
+			continue;
+		ret = check(fib);
+		if (ret != TEST_SUCCESS)
+			return ret;
+	}
+	return TEST_SUCCESS;
+}
+
+int32_t
+test_lookup(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+	uint64_t def_nh = 100;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = def_nh;
+	config.type = RTE_FIB6_DUMMY;
+
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for DUMMY type\n");
+	rte_fib6_free(fib);
+
+	config.type = RTE_FIB6_TRIE;
+
+	config.trie.nh_sz = RTE_FIB6_TRIE_2B;
+	config.trie.num_tbl8 = MAX_TBL8 - 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for TRIE_2B type\n");
+	rte_fib6_free(fib);
+
+	config.trie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.trie.num_tbl8 = MAX_TBL8;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for TRIE_4B type\n");
+	rte_fib6_free(fib);
+
+	config.trie.nh_sz = RTE_FIB6_TRIE_8B;
+	config.trie.num_tbl8 = MAX_TBL8;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib_all_lookups(fib, check_fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for TRIE_8B type\n");
+	rte_fib6_free(fib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Random routes are added and deleted while the lookups are checked against
+ * a linear search of the routes. The bytes of the addresses below the base
+ * prefix take a few values only, so that the routes overlap and share their
+ * tbl8 groups at every level.
+ */
+#define RANDOM_ROUTES		512
+#define RANDOM_LOOKUPS		4096
+#define RANDOM_BASE_DEPTH	16
+
+struct random_route {
+	uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE];
+	uint8_t depth;
+	uint64_t nh;
+	int installed;
+};
+
+static struct random_route random_routes[RANDOM_ROUTES];
+static uint64_t random_max_nh;
+
+static void
+random_addr(uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE])
+{
+	static const uint8_t bytes[] = {0x00, 0x01, 0x80, 0xff};
+	unsigned int i;
+
+	ip[0] = 0x20;
+	ip[1] = 0x01;
+	for (i = RANDOM_BASE_DEPTH / 8; i < RTE_FIB6_IPV6_ADDR_SIZE; i++)
+		ip[i] = (rte_rand() % 8 == 0) ? (uint8_t)rte_rand() :
+			bytes[rte_rand() % RTE_DIM(bytes)];
+}
+
+static int
+is_covered(const uint8_t *ip, const uint8_t *pfx, uint8_t depth)
+{
+	unsigned int i;
+
+	for (i = 0; i < RTE_FIB6_IPV6_ADDR_SIZE; i++)
+		if ((ip[i] ^ pfx[i]) & rte_rib6_get_msk_part(depth, i))
+			return 0;
+	return 1;
+}
+
+static uint64_t
+random_route_lookup(const uint8_t *ip, uint64_t def_nh)
+{
+	uint64_t nh = def_nh;
+	int depth = -1;
+	unsigned int i;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		if (!random_routes[i].installed ||
+				(random_routes[i].depth <= depth) ||
+				!is_covered(ip, random_routes[i].ip,
+				random_routes[i].depth))
+			continue;
+		depth = random_routes[i].depth;
+		nh = random_routes[i].nh;
+	}
+	return nh;
+}
+
+static int
+check_random_routes(struct rte_fib6 *fib)
+{
+	static uint8_t ips[RANDOM_LOOKUPS][RTE_FIB6_IPV6_ADDR_SIZE];
+	static uint64_t nhs[RANDOM_LOOKUPS];
+	const uint64_t def_nh = 0;
+	unsigned int i, j, n;
+	int ret;
+
+	for (i = 0; i < RANDOM_LOOKUPS; i++) {
+		n = rte_rand() % RANDOM_ROUTES;
+		/* the edges of the routes, and random addresses */
+		switch (i % 4) {
+		case 0:
+			rte_rib6_copy_addr(ips[i], random_routes[n].ip);
+			break;
+		case 1:
+			for (j = 0; j < RTE_FIB6_IPV6_ADDR_SIZE; j++)
+				ips[i][j] = random_routes[n].ip[j] |
+					~rte_rib6_get_msk_part(
+					random_routes[n].depth, j);
+			break;
+		case 2:
+			rte_rib6_copy_addr(ips[i], random_routes[n].ip);
+			for (j = RTE_FIB6_IPV6_ADDR_SIZE; j-- > 0; )
+				if (ips[i][j]-- != 0)
+					break;
+			break;
+		default:
+			random_addr(ips[i]);
+			break;
+		}
+	}
+
+	ret = rte_fib6_lookup_bulk(fib, ips, nhs, RANDOM_LOOKUPS);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	for (i = 0; i < RANDOM_LOOKUPS; i++)
+		RTE_TEST_ASSERT(nhs[i] == random_route_lookup(ips[i], def_nh),
+			"Wrong nexthop for lookup %u\n", i);
+
+	return TEST_SUCCESS;
+}
+
+static int
+check_random_routes_all_lookups(struct rte_fib6 *fib)
+{
+	return check_fib_all_lookups(fib, check_random_routes);
+}
+
+static int
+random_routes_run(struct rte_fib6 *fib)
+{
+	struct random_route *r;
+	unsigned int i, j;
+	int ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		r->depth = RANDOM_BASE_DEPTH + rte_rand() %
+			(RTE_FIB6_MAXDEPTH - RANDOM_BASE_DEPTH + 1);
+		random_addr(r->ip);
+		for (j = 0; j < RTE_FIB6_IPV6_ADDR_SIZE; j++)
+			r->ip[j] &= rte_rib6_get_msk_part(r->depth, j);
+		r->nh = 1 + rte_rand() % random_max_nh;
+		r->installed = 0;
+		/* a duplicate prefix would take the next hop of the last */
+		for (j = 0; j < i; j++) {
+			if (rte_rib6_is_equal(random_routes[j].ip, r->ip) &&
+					(random_routes[j].depth == r->depth))
+				r->depth = 0;
+		}
+	}
+
+	/*
+	 * Add all the routes, then delete and re-add half of them. The small
+	 * FIBs cannot hold all the tbl8 groups of the longer routes.
+	 */
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		if (r->depth == 0)
+			continue;
+		ret = rte_fib6_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT((ret == 0) || (ret == -ENOSPC),
+			"Failed to add a route\n");
+		r->installed = (ret == 0);
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i += 2) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		ret = rte_fib6_delete(fib, r->ip, r->depth);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		r->installed = 0;
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i += 2) {
+		r = &random_routes[i];
+		if (r->depth == 0)
+			continue;
+		r->nh = 1 + rte_rand() % random_max_nh;
+		ret = rte_fib6_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT((ret == 0) || (ret == -ENOSPC),
+			"Failed to add a route\n");
+		r->installed = (ret == 0);
+	}
+	/* update the next hop of existing routes */
+	for (i = 1; i < RANDOM_ROUTES; i += 4) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		r->nh = 1 + rte_rand() % random_max_nh;
+		ret = rte_fib6_add(fib, r->ip, r->depth, r->nh);
+		RTE_TEST_ASSERT(ret == 0, "Failed to update a route\n");
+	}
+	ret = check_random_routes_all_lookups(fib);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	for (i = 0; i < RANDOM_ROUTES; i++) {
+		r = &random_routes[i];
+		if (!r->installed)
+			continue;
+		ret = rte_fib6_delete(fib, r->ip, r->depth);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		r->installed = 0;
+	}
+	return check_random_routes_all_lookups(fib);
+}
+
+int32_t
+test_random_routes(void)
+{
+	static const struct {
+		enum rte_fib_trie_nh_sz nh_sz;
+		uint32_t num_tbl8;
+	} confs[] = {
+		{ RTE_FIB6_TRIE_2B, 8192 },
+		{ RTE_FIB6_TRIE_4B, 8192 },
+		{ RTE_FIB6_TRIE_8B, 8192 },
+		/* not enough groups for all the routes */
+		{ RTE_FIB6_TRIE_4B, 64 },
+	};
+	struct rte_fib6 *fib;
+	struct rte_fib6_conf config;
+	unsigned int i;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB6_TRIE;
+	random_max_nh = 1000;
+
+	for (i = 0; i < RTE_DIM(confs); i++) {
+		config.trie.nh_sz = confs[i].nh_sz;
+		config.trie.num_tbl8 = confs[i].num_tbl8;
+		fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+		ret = random_routes_run(fib);
+		rte_fib6_free(fib);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Random routes fail for next hops of %u bytes and "
+			"%u tbl8 groups\n",
+			1U << confs[i].nh_sz, confs[i].num_tbl8);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite fib6_tests = {
+	.suite_name = "fib6 autotest",
+	.setup = NULL,
+	.teardown = NULL,
+	.unit_test_cases = {
+		TEST_CASE(test_create_invalid),
+		TEST_CASE(test_multiple_create),
+		TEST_CASE(test_free_null),
+		TEST_CASE(test_add_del_invalid),
+		TEST_CASE(test_get_invalid),
+		TEST_CASE(test_lookup),
+		TEST_CASE(test_random_routes),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_fib6(void)
+{
+	return unit_test_suite_runner(&fib6_tests);
+}
+
+REGISTER_TEST_COMMAND(fib6_autotest, test_fib6);
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_cycles.h>
+#include <rte_random.h>
+#include <rte_branch_prediction.h>
+#include <rte_memory.h>
+#include <rte_fib6.h>
+
+#include "test.h"
+#include "test_lpm6_data.h"
+
+#define TEST_FIB_ASSERT(cond) do {				\
+	if (!(cond)) {						\
+		printf("Error at line %d:\n", __LINE__);	\
+		return -1;					\
+	}							\
+} while (0)
+
+#define ITERATIONS (1 << 6)
+#define BULK_SIZE 32
+#define NUMBER_TBL8S (1 << 17)
+
+/* share of the routes deleted and added back by each churn round */
+#define CHURN_ROUNDS 8
+#define CHURN_SHARE 10 /* % */
+
+static struct rules_tbl_entry full_route_table[NUM_FULL_ROUTE_ENTRIES];
+static uint8_t ip_batch[NUM_IPS_ENTRIES][RTE_FIB6_IPV6_ADDR_SIZE];
+static uint32_t churn_idx[NUM_FULL_ROUTE_ENTRIES];
+
+static void
+print_route_distribution(const struct rules_tbl_entry *table, uint32_t n)
+{
+	unsigned int i, j;
+
+	printf("Route distribution per prefix width:\n");
+	printf("DEPTH    QUANTITY (PERCENT)\n");
+	printf("---------------------------\n");
+
+	/* Count depths. */
+	for (i = 1; i <= RTE_FIB6_MAXDEPTH; i++) {
+		unsigned int depth_counter = 0;
+		double percent_hits;
+
+		for (j = 0; j < n; j++)
+			if (table[j].depth == (uint8_t) i)
+				depth_counter++;
+
+		if (depth_counter == 0)
+			continue;
+		percent_hits = ((double)depth_counter)/((double)n) * 100;
+		printf("%.2u%15u (%.2f)\n", i, depth_counter, percent_hits);
+	}
+	printf("\n");
+}
+
+static void
+test_fib6_lookup_perf(struct rte_fib6 *fib, const char *name, uint32_t n)
+{
+	uint64_t next_hops[BULK_SIZE];
+	uint64_t begin, total_time = 0;
+	int64_t count = 0;
+	unsigned int i, j, k;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		begin = rte_rdtsc();
+		for (j = 0; j + BULK_SIZE <= n; j += BULK_SIZE) {
+			rte_fib6_lookup_bulk(fib, &ip_batch[j], next_hops,
+				BULK_SIZE);
+			for (k = 0; k < BULK_SIZE; k++)
+				if (unlikely(next_hops[k] == 0))
+					count++;
+		}
+		total_time += rte_rdtsc() - begin;
+	}
+	printf("%s BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n", name,
+			(double)total_time / ((double)ITERATIONS * j),
+			(count * 100.0) / ((double)ITERATIONS * j));
+}
+
+/*
+ * Delete and add back random routes of the table, as a router does on BGP
+ * updates.
+ */
+static int
+test_fib6_churn_perf(struct rte_fib6 *fib,
+	const struct rules_tbl_entry *table, uint32_t nb_routes)
+{
+	uint64_t begin, del_time = 0, add_time = 0;
+	uint32_t nb_churn = nb_routes * CHURN_SHARE / 100;
+	uint32_t i, j;
+	int ret;
+
+	for (i = 0; i < CHURN_ROUNDS; i++) {
+		for (j = 0; j < nb_churn; j++)
+			churn_idx[j] = rte_rand() % nb_routes;
+
+		begin = rte_rdtsc();
+		for (j = 0; j < nb_churn; j++)
+			rte_fib6_delete(fib, table[churn_idx[j]].ip,
+				table[churn_idx[j]].depth);
+		del_time += rte_rdtsc() - begin;
+
+		begin = rte_rdtsc();
+		for (j = 0; j < nb_churn; j++) {
+			ret = rte_fib6_add(fib, table[churn_idx[j]].ip,
+				table[churn_idx[j]].depth,
+				table[churn_idx[j]].next_hop + 1);
+			TEST_FIB_ASSERT(ret == 0);
+		}
+		add_time += rte_rdtsc() - begin;
+	}
+
+	printf("Average FIB churn: %g cycles per delete, "
+			"%g cycles per add\n",
+			(double)del_time / (CHURN_ROUNDS * nb_churn),
+			(double)add_time / (CHURN_ROUNDS * nb_churn));
+
+	return 0;
+}
+
+/* Measure add, bulk lookups, churn and delete of the routes of a table */
+static int
+test_fib6_table_perf(const struct rules_tbl_entry *table, uint32_t nb_routes,
+	uint32_t nb_ips)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config;
+	uint64_t begin, total_time;
+	unsigned int i;
+	int status = 0;
+
+	config.max_routes = 1000000;
+	config.type = RTE_FIB6_TRIE;
+	config.default_nh = 0;
+	config.trie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.trie.num_tbl8 = NUMBER_TBL8S;
+
+	printf("No. routes = %u\n", nb_routes);
+	print_route_distribution(table, nb_routes);
+
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	TEST_FIB_ASSERT(fib != NULL);
+
+	/* Measure add. */
+	begin = rte_rdtsc();
+
+	for (i = 0; i < nb_routes; i++) {
+		/* the next hops are not null to count the failed lookups */
+		if (rte_fib6_add(fib, table[i].ip, table[i].depth,
+				table[i].next_hop + 1) == 0)
+			status++;
+	}
+	/* End Timer. */
+	total_time = rte_rdtsc() - begin;
+
+	printf("Unique added entries = %d\n", status);
+	printf("Average FIB Add: %g cycles\n",
+			(double)total_time / nb_routes);
+
+	/* Measure bulk Lookup with each implementation */
+	if (rte_fib6_select_lookup(fib, RTE_FIB6_LOOKUP_TRIE_SCALAR) == 0)
+		test_fib6_lookup_perf(fib, "Scalar", nb_ips);
+	if (rte_fib6_select_lookup(fib,
+			RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512) == 0)
+		test_fib6_lookup_perf(fib, "AVX512", nb_ips);
+
+	/* Measure route updates of the table */
+	status = test_fib6_churn_perf(fib, table, nb_routes);
+	TEST_FIB_ASSERT(status == 0);
+
+	/* Delete */
+	begin = rte_rdtsc();
+
+	for (i = 0; i < nb_routes; i++)
+		rte_fib6_delete(fib, table[i].ip, table[i].depth);
+
+	total_time = rte_rdtsc() - begin;
+
+	printf("Average FIB Delete: %g cycles\n",
+			(double)total_time / nb_routes);
+
+	rte_fib6_free(fib);
+
+	return 0;
+}
+
+static int
+test_fib6_perf(void)
+{
+	unsigned int i;
+	int status;
+
+	rte_srand(rte_rdtsc());
+
+	/* the table of the LPM6 perf test, for comparison */
+	generate_large_ips_table(0);
+	for (i = 0; i < NUM_IPS_ENTRIES; i++)
+		memcpy(ip_batch[i], large_ips_table[i].ip,
+			RTE_FIB6_IPV6_ADDR_SIZE);
+
+	status = test_fib6_table_perf(large_route_table, NUM_ROUTE_ENTRIES,
+		NUM_IPS_ENTRIES);
+	TEST_FIB_ASSERT(status == 0);
+
+	/* a table of the size of a full IPv6 Internet routing table */
+	generate_full_route_table(full_route_table, NUM_FULL_ROUTE_ENTRIES);
+	generate_full_ips_table(ip_batch, NUM_IPS_ENTRIES, full_route_table,
+		NUM_FULL_ROUTE_ENTRIES);
+
+	return test_fib6_table_perf(full_route_table, NUM_FULL_ROUTE_ENTRIES,
+		NUM_IPS_ENTRIES);
+}
+
+REGISTER_TEST_COMMAND(fib6_perf_autotest, test_fib6_perf);
@@ -18,6 +18,7 @@
 #include <rte_eal.h>
 #include <rte_ip.h>
 #include <rte_string_fns.h>
+#include <rte_errno.h>
 
 #include "test.h"
 
@@ -1713,6 +1714,409 @@ test_hash_add_delete_jhash_3word(void)
 	return ret;
 }
 
+/* a single bucket of the table */
+#define RCU_HASH_ENTRIES 8
+
+static void *rcu_freed_data;
+
+static void
+test_hash_rcu_free_key_data(void *p, void *key_data)
+{
+	RTE_SET_USED(p);
+	rcu_freed_data = key_data;
+}
+
+/*
+ * Lock-free hash with an attached RCU QSBR variable:
+ *  - fill the table and delete a key while a reader is still active
+ *  - the key slot must not be reused until the reader reports a quiescent
+ *    state (defer queue mode), or it is reused right away if the reader is
+ *    offline (blocking mode)
+ *  - the data of the deleted key is passed to the free callback
+ */
+static int
+test_hash_rcu_qsbr(enum rte_hash_qsbr_mode mode)
+{
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	struct rte_hash_parameters params = {
+		.name = "test_hash_rcu",
+		.entries = RCU_HASH_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = NULL,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+	struct rte_hash *handle = NULL;
+	struct rte_rcu_qsbr *v;
+	uint32_t k;
+	int32_t ret;
+
+	v = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	RETURN_IF_ERROR(v == NULL, "RCU variable allocation failed");
+	rte_rcu_qsbr_init(v, RTE_MAX_LCORE);
+
+	handle = rte_hash_create(&params);
+	if (handle == NULL)
+		rte_free(v);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	rcu_cfg.v = v;
+	rcu_cfg.mode = mode;
+	rcu_cfg.free_key_data_func = test_hash_rcu_free_key_data;
+	ret = rte_hash_rcu_qsbr_add(handle, &rcu_cfg);
+	if (ret != 0)
+		goto err;
+	ret = rte_hash_rcu_qsbr_add(handle, &rcu_cfg);
+	if (ret != 1 || rte_errno != EEXIST) {
+		printf("RCU QSBR variable added twice\n");
+		goto err;
+	}
+
+	rte_rcu_qsbr_thread_register(v, 0);
+	if (mode == RTE_HASH_QSBR_MODE_DQ)
+		rte_rcu_qsbr_thread_online(v, 0);
+
+	for (k = 0; k < RCU_HASH_ENTRIES; k++) {
+		ret = rte_hash_add_key_data(handle, &k,
+					    (void *)((uintptr_t)k + 1));
+		if (ret != 0) {
+			printf("failed to add key %u\n", k);
+			goto err;
+		}
+	}
+
+	rcu_freed_data = NULL;
+	k = 0;
+	if (rte_hash_del_key(handle, &k) < 0) {
+		printf("failed to delete key %u\n", k);
+		goto err;
+	}
+
+	k = RCU_HASH_ENTRIES;
+	if (mode == RTE_HASH_QSBR_MODE_DQ) {
+		/* The reader may still reference the deleted key */
+		if (rte_hash_add_key(handle, &k) != -ENOSPC ||
+				rcu_freed_data != NULL) {
+			printf("key slot reused before the grace period\n");
+			goto err;
+		}
+		rte_rcu_qsbr_quiescent(v, 0);
+	}
+
+	if (rte_hash_add_key(handle, &k) < 0) {
+		printf("key slot not reused after the grace period\n");
+		goto err;
+	}
+	if (rcu_freed_data != (void *)(uintptr_t)1) {
+		printf("key data not freed\n");
+		goto err;
+	}
+
+	rte_rcu_qsbr_thread_offline(v, 0);
+	rte_rcu_qsbr_thread_unregister(v, 0);
+	rte_hash_free(handle);
+	rte_free(v);
+	return 0;
+
+err:
+	rte_rcu_qsbr_thread_offline(v, 0);
+	rte_rcu_qsbr_thread_unregister(v, 0);
+	rte_hash_free(handle);
+	rte_free(v);
+	return -1;
+}
+
+#define BULK_HASH_ENTRIES 64
+#define BULK_HASH_KEYS (2 * RTE_HASH_LOOKUP_BULK_MAX)
+
+/*
+ * Add keys by bursts until the table is full, check them with single key
+ * lookups, then delete them by bursts. Return the number of keys added.
+ */
+static int
+test_hash_bulk_fill_delete(struct rte_hash *handle, uint8_t extra_flag)
+{
+	uint32_t key_vals[BULK_HASH_KEYS];
+	const void *key_ptrs[BULK_HASH_KEYS];
+	void *data[BULK_HASH_KEYS];
+	int32_t pos[BULK_HASH_KEYS], del_pos[BULK_HASH_KEYS];
+	void *lookup_data;
+	uint32_t i;
+	int added = 0, deleted = 0;
+	int ret;
+
+	for (i = 0; i < BULK_HASH_KEYS; i++) {
+		key_vals[i] = i;
+		key_ptrs[i] = &key_vals[i];
+		data[i] = (void *)((uintptr_t)i + 1);
+	}
+
+	for (i = 0; i < BULK_HASH_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		ret = rte_hash_add_key_bulk_data(handle, &key_ptrs[i],
+				RTE_HASH_LOOKUP_BULK_MAX, &data[i], &pos[i]);
+		if (ret < 0)
+			return -1;
+		added += ret;
+	}
+
+	if (added == 0 || rte_hash_count(handle) != added) {
+		printf("bulk add count %d, table count %d\n", added,
+			rte_hash_count(handle));
+		return -1;
+	}
+
+	for (i = 0; i < BULK_HASH_KEYS; i++) {
+		ret = rte_hash_lookup_data(handle, key_ptrs[i], &lookup_data);
+		if (pos[i] < 0 && (pos[i] != -ENOSPC || ret != -ENOENT)) {
+			printf("key %u failed with %d, lookup %d\n",
+				i, pos[i], ret);
+			return -1;
+		}
+		if (pos[i] >= 0 && (ret != pos[i] || lookup_data != data[i])) {
+			printf("key %u added at %d, lookup %d\n",
+				i, pos[i], ret);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < BULK_HASH_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		ret = rte_hash_del_key_bulk(handle, &key_ptrs[i],
+				RTE_HASH_LOOKUP_BULK_MAX, &del_pos[i]);
+		if (ret < 0)
+			return -1;
+		deleted += ret;
+	}
+
+	for (i = 0; i < BULK_HASH_KEYS; i++) {
+		if (del_pos[i] != (pos[i] >= 0 ? pos[i] : -ENOENT)) {
+			printf("key %u added at %d, deleted at %d\n",
+				i, pos[i], del_pos[i]);
+			return -1;
+		}
+		if ((extra_flag & RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF) &&
+				del_pos[i] >= 0)
+			rte_hash_free_key_with_position(handle, del_pos[i]);
+	}
+
+	if (deleted != added || rte_hash_count(handle) != 0) {
+		printf("bulk delete count %d, table count %d\n", deleted,
+			rte_hash_count(handle));
+		return -1;
+	}
+
+	return added;
+}
+
+/*
+ * Bulk add, delete and lookup or add:
+ *  - fill the table by bursts, check the keys and delete them by bursts
+ *  - fill it again, which must add as many keys if no key slot leaked
+ *  - lookup or add a burst of existing, new and repeated keys
+ */
+static int
+test_hash_bulk(uint8_t extra_flag)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_hash_bulk",
+		.entries = BULK_HASH_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = extra_flag,
+	};
+	/* key 1 is in the table, 2 is new and repeated, 3 is new */
+	uint32_t burst_keys[] = {1, 2, 2, 3, 1, 2};
+	const uint64_t burst_hits = 0x35;
+	const void *key_ptrs[RTE_DIM(burst_keys)];
+	void *data[RTE_DIM(burst_keys)];
+	int32_t pos[RTE_DIM(burst_keys)];
+	struct rte_hash *handle;
+	uint64_t hit_mask;
+	void *lookup_data;
+	uint32_t i;
+	int added;
+	int ret;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < RTE_DIM(burst_keys); i++) {
+		key_ptrs[i] = &burst_keys[i];
+		data[i] = (void *)((uintptr_t)i + 200);
+	}
+
+	added = test_hash_bulk_fill_delete(handle, extra_flag);
+	RETURN_IF_ERROR(added < 0, "bulk fill and delete failed");
+	ret = test_hash_bulk_fill_delete(handle, extra_flag);
+	RETURN_IF_ERROR(ret != added,
+			"bulk refill added %d keys instead of %d", ret, added);
+
+	ret = rte_hash_add_key_data(handle, &burst_keys[0], (void *)100);
+	RETURN_IF_ERROR(ret != 0, "failed to add key");
+
+	ret = rte_hash_lookup_or_add_bulk_data(handle, key_ptrs,
+			RTE_DIM(burst_keys), data, pos, &hit_mask);
+	RETURN_IF_ERROR(ret != (int)RTE_DIM(burst_keys),
+			"lookup or add returned %d", ret);
+	RETURN_IF_ERROR(hit_mask != burst_hits,
+			"lookup or add hit mask 0x%" PRIx64, hit_mask);
+	RETURN_IF_ERROR(data[0] != (void *)100 || data[4] != (void *)100,
+			"wrong data for existing key");
+	RETURN_IF_ERROR(data[1] != (void *)201 || data[2] != (void *)201 ||
+			data[5] != (void *)201 || pos[2] != pos[1] ||
+			pos[5] != pos[1], "wrong entry for repeated key");
+	RETURN_IF_ERROR(rte_hash_count(handle) != 3,
+			"%d keys in the table", rte_hash_count(handle));
+
+	for (i = 1; i < 4; i++) {
+		ret = rte_hash_lookup_data(handle, key_ptrs[i], &lookup_data);
+		RETURN_IF_ERROR(ret != pos[i] || lookup_data != data[i],
+				"key %u not added", burst_keys[i]);
+	}
+
+	rte_hash_free(handle);
+	return 0;
+}
+
+#define RESIZE_HASH_ENTRIES (4 * BULK_HASH_ENTRIES)
+
+/*
+ * Online resize:
+ *  - fill the table by bursts and start growing it
+ *  - while its buckets are migrated, look up all the keys by bursts, delete
+ *    some, update others and add new ones beyond the initial capacity
+ *  - finish the migration and check the content of the table
+ */
+static int
+test_hash_resize(uint8_t extra_flag)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_hash_resize",
+		.entries = BULK_HASH_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = extra_flag,
+	};
+	uint32_t key_vals[BULK_HASH_KEYS + RTE_HASH_LOOKUP_BULK_MAX];
+	const void *key_ptrs[RTE_DIM(key_vals)];
+	void *data[RTE_DIM(key_vals)];
+	int32_t pos[RTE_DIM(key_vals)], ret_pos[RTE_DIM(key_vals)];
+	void *lookup_data[RTE_DIM(key_vals)];
+	struct rte_hash *handle;
+	uint32_t migrated, total, iter, i;
+	uint64_t hit_mask;
+	const void *next_key;
+	void *next_data;
+	int count = 0;
+	int ret;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < RTE_DIM(key_vals); i++) {
+		key_vals[i] = i;
+		key_ptrs[i] = &key_vals[i];
+		data[i] = (void *)((uintptr_t)i + 1);
+	}
+	for (i = 0; i < BULK_HASH_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		ret = rte_hash_add_key_bulk_data(handle, &key_ptrs[i],
+				RTE_HASH_LOOKUP_BULK_MAX, &data[i], &pos[i]);
+		RETURN_IF_ERROR(ret < 0, "bulk add failed");
+		count += ret;
+	}
+
+	RETURN_IF_ERROR(rte_hash_resize(handle, BULK_HASH_ENTRIES) !=
+			-EINVAL, "resize to the same size should fail");
+	ret = rte_hash_resize(handle, RESIZE_HASH_ENTRIES);
+	RETURN_IF_ERROR(ret != 0, "resize failed with %d", ret);
+	/* Buckets of 8 entries are migrated */
+	ret = rte_hash_resize_progress(handle, &migrated, &total);
+	RETURN_IF_ERROR(ret != 1 || migrated != 0 ||
+			total != BULK_HASH_ENTRIES / 8,
+			"unexpected resize progress %u/%u", migrated, total);
+	ret = rte_hash_resize(handle, 2 * RESIZE_HASH_ENTRIES);
+	RETURN_IF_ERROR(ret != -EBUSY, "resize in progress not detected");
+
+	/* All the keys are still in the old buckets */
+	for (i = 0; i < BULK_HASH_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		ret = rte_hash_lookup_bulk_data(handle, &key_ptrs[i],
+				RTE_HASH_LOOKUP_BULK_MAX, &hit_mask,
+				&lookup_data[i]);
+		RETURN_IF_ERROR(ret != __builtin_popcountll(hit_mask),
+				"bulk lookup returned %d", ret);
+	}
+	for (i = 0; i < BULK_HASH_KEYS; i++)
+		RETURN_IF_ERROR(pos[i] >= 0 && lookup_data[i] != data[i],
+				"key %u not found during resize", i);
+
+	/* Each burst migrates a few more buckets: delete one key out of
+	 * four, update the data of another one and add new keys.
+	 */
+	for (i = 0; i < BULK_HASH_KEYS; i += 4)
+		rte_hash_del_key_bulk(handle, &key_ptrs[i], 1, &ret_pos[i]);
+	for (i = 0; i < BULK_HASH_KEYS; i += 4) {
+		RETURN_IF_ERROR(ret_pos[i] != (pos[i] >= 0 ? pos[i] : -ENOENT),
+				"key %u added at %d, deleted at %d",
+				i, pos[i], ret_pos[i]);
+		if (pos[i] >= 0) {
+			if (extra_flag & RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)
+				rte_hash_free_key_with_position(handle,
+						pos[i]);
+			count--;
+		}
+		pos[i] = -ENOENT;
+	}
+	for (i = 1; i < BULK_HASH_KEYS; i += 4) {
+		data[i] = (void *)((uintptr_t)i + 1000);
+		ret = rte_hash_add_key_bulk_data(handle, &key_ptrs[i], 1,
+				&data[i], &ret_pos[i]);
+		RETURN_IF_ERROR(ret_pos[i] != pos[i] && pos[i] >= 0,
+				"key %u updated at %d instead of %d",
+				i, ret_pos[i], pos[i]);
+		if (pos[i] < 0) {
+			pos[i] = ret_pos[i];
+			count++;
+		}
+	}
+	ret = rte_hash_lookup_or_add_bulk_data(handle,
+			&key_ptrs[BULK_HASH_KEYS], RTE_HASH_LOOKUP_BULK_MAX,
+			&data[BULK_HASH_KEYS], &pos[BULK_HASH_KEYS],
+			&hit_mask);
+	RETURN_IF_ERROR(ret != RTE_HASH_LOOKUP_BULK_MAX || hit_mask != 0,
+			"lookup or add of new keys returned %d", ret);
+	count += ret;
+
+	do {
+		ret = rte_hash_resize_step(handle, 1);
+		RETURN_IF_ERROR(ret < 0, "resize step failed with %d", ret);
+	} while (ret != 0);
+	ret = rte_hash_resize_progress(handle, &migrated, &total);
+	RETURN_IF_ERROR(ret != 0 || total != 0, "resize not over");
+
+	RETURN_IF_ERROR(rte_hash_count(handle) != count,
+			"%d keys in the table instead of %d",
+			rte_hash_count(handle), count);
+	for (i = 0; i < RTE_DIM(key_vals); i++) {
+		ret = rte_hash_lookup_data(handle, key_ptrs[i],
+				&lookup_data[i]);
+		RETURN_IF_ERROR(ret != (pos[i] >= 0 ? pos[i] : -ENOENT) ||
+				(ret >= 0 && lookup_data[i] != data[i]),
+				"key %u at %d, lookup %d", i, pos[i], ret);
+	}
+	iter = 0;
+	while (rte_hash_iterate(handle, &next_key, &next_data, &iter) >= 0)
+		count--;
+	RETURN_IF_ERROR(count != 0, "iteration missed %d keys", count);
+
+	rte_hash_free(handle);
+	return 0;
+}
+
 /*
  * Do all unit and performance tests.
  */
@@ -1767,6 +2171,27 @@ test_hash(void)
 	if (test_hash_iteration(1) < 0)
 		return -1;
 
+	if (test_hash_rcu_qsbr(RTE_HASH_QSBR_MODE_DQ) < 0)
+		return -1;
+	if (test_hash_rcu_qsbr(RTE_HASH_QSBR_MODE_SYNC) < 0)
+		return -1;
+
+	if (test_hash_bulk(0) < 0)
+		return -1;
+	if (test_hash_bulk(RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD) < 0)
+		return -1;
+	if (test_hash_bulk(RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF) < 0)
+		return -1;
+	if (test_hash_bulk(RTE_HASH_EXTRA_FLAGS_EXT_TABLE) < 0)
+		return -1;
+
+	if (test_hash_resize(0) < 0)
+		return -1;
+	if (test_hash_resize(RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY) < 0)
+		return -1;
+	if (test_hash_resize(RTE_HASH_EXTRA_FLAGS_EXT_TABLE) < 0)
+		return -1;
+
 	run_hash_func_tests();
 
 	if (test_crc32_hash_alg_equiv() < 0)
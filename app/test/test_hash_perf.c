@@ -34,6 +34,8 @@ enum operations {
 	LOOKUP,
 	LOOKUP_MULTI,
 	DELETE,
+	ADD_MULTI,
+	DELETE_MULTI,
 	NUM_OPERATIONS
 };
 
@@ -503,6 +505,99 @@ timed_deletes(unsigned int with_hash, unsigned int with_data,
 	return 0;
 }
 
+static int
+timed_adds_multi(unsigned int with_data, unsigned int table_index,
+							unsigned int ext)
+{
+	unsigned int i, k;
+	int32_t positions_burst[BURST_SIZE];
+	const void *keys_burst[BURST_SIZE];
+	void *data_burst[BURST_SIZE];
+	int ret;
+	unsigned int keys_to_add;
+
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add / BURST_SIZE; i++) {
+		for (k = 0; k < BURST_SIZE; k++) {
+			keys_burst[k] = keys[i * BURST_SIZE + k];
+			data_burst[k] = (void *) ((uintptr_t)
+					signatures[i * BURST_SIZE + k]);
+		}
+		ret = rte_hash_add_key_bulk_data(h[table_index],
+				(const void **) keys_burst, BURST_SIZE,
+				with_data ? data_burst : NULL,
+				positions_burst);
+		if (ret != BURST_SIZE) {
+			printf("Expect to add %u keys, but added %d\n",
+					BURST_SIZE, ret);
+			return -1;
+		}
+		for (k = 0; k < BURST_SIZE; k++)
+			positions[i * BURST_SIZE + k] = positions_burst[k];
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	cycles[table_index][ADD_MULTI][0][with_data] = time_taken/keys_to_add;
+
+	return 0;
+}
+
+static int
+timed_deletes_multi(unsigned int with_data, unsigned int table_index,
+							unsigned int ext)
+{
+	unsigned int i, k;
+	int32_t positions_burst[BURST_SIZE];
+	const void *keys_burst[BURST_SIZE];
+	int ret;
+	unsigned int keys_to_add;
+
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add / BURST_SIZE; i++) {
+		for (k = 0; k < BURST_SIZE; k++)
+			keys_burst[k] = keys[i * BURST_SIZE + k];
+		ret = rte_hash_del_key_bulk(h[table_index],
+				(const void **) keys_burst, BURST_SIZE,
+				positions_burst);
+		if (ret != BURST_SIZE) {
+			printf("Expect to delete %u keys, but deleted %d\n",
+					BURST_SIZE, ret);
+			return -1;
+		}
+		for (k = 0; k < BURST_SIZE; k++) {
+			if (positions_burst[k] !=
+					positions[i * BURST_SIZE + k]) {
+				printf("Key deleted from %d, should be in %d\n",
+					positions_burst[k],
+					positions[i * BURST_SIZE + k]);
+				return -1;
+			}
+		}
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	cycles[table_index][DELETE_MULTI][0][with_data] =
+						time_taken/keys_to_add;
+
+	return 0;
+}
+
 static void
 free_table(unsigned table_index)
 {
@@ -547,6 +642,12 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 				if (timed_deletes(with_hash, with_data, i, ext) < 0)
 					return -1;
 
+				if (timed_adds_multi(with_data, i, ext) < 0)
+					return -1;
+
+				if (timed_deletes_multi(with_data, i, ext) < 0)
+					return -1;
+
 				/* Print a dot to show progress on operations */
 				printf(".");
 				fflush(stdout);
@@ -570,8 +671,9 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 			else
 				printf("\nWithout pre-computed hash values\n");
 
-			printf("\n%-18s%-18s%-18s%-18s%-18s\n",
-			"Keysize", "Add", "Lookup", "Lookup_bulk", "Delete");
+			printf("\n%-18s%-18s%-18s%-18s%-18s%-18s%-18s\n",
+			"Keysize", "Add", "Lookup", "Lookup_bulk", "Delete",
+			"Add_bulk", "Delete_bulk");
 			for (i = 0; i < NUM_KEYSIZES; i++) {
 				printf("%-18d", hashtest_key_lens[i]);
 				for (j = 0; j < NUM_OPERATIONS; j++)
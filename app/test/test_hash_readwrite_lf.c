@@ -12,6 +12,7 @@
 #include <rte_launch.h>
 #include <rte_malloc.h>
 #include <rte_random.h>
+#include <rte_rcu_qsbr.h>
 #include <rte_spinlock.h>
 
 #include "test.h"
@@ -42,6 +43,13 @@
 #define READ_PASS_NON_SHIFT_PATH 8
 #define BULK_LOOKUP 16
 #define NUM_TEST 3
+
+#define RESIZE_INIT_ENTRIES (32*1024)
+#define RESIZE_INIT_KEYS (28*1024)
+#define RESIZE_ENTRIES (128*1024)
+#define RESIZE_KEYS (96*1024)
+#define RESIZE_STEP_KEYS 64
+#define RESIZE_STEP_BUCKETS 256
 unsigned int rwc_core_cnt[NUM_TEST] = {1, 2, 4};
 
 struct rwc_perf {
@@ -81,6 +89,9 @@ uint16_t enabled_core_ids[RTE_MAX_LCORE];
 
 uint8_t *scanned_bkts;
 
+static struct rte_rcu_qsbr *resize_rcu;
+static int32_t *resize_pos;
+
 static inline int
 get_enabled_cores_list(void)
 {
@@ -1045,6 +1056,220 @@ test_hash_multi_add_lookup(struct rwc_perf *rwc_perf_results, int rwc_lf,
 	return -1;
 }
 
+static int
+test_rwc_resize_reader(__attribute__((unused)) void *arg)
+{
+	uint32_t keys[BULK_LOOKUP_SIZE];
+	const void *key_ptrs[BULK_LOOKUP_SIZE];
+	int32_t pos[BULK_LOOKUP_SIZE];
+	unsigned int lcore_id = rte_lcore_id();
+	uint32_t i, j;
+	int32_t ret;
+	int err = 0;
+
+	rte_rcu_qsbr_thread_register(resize_rcu, lcore_id);
+	rte_rcu_qsbr_thread_online(resize_rcu, lcore_id);
+	do {
+		for (i = 0; i < RESIZE_INIT_KEYS && err == 0; i++) {
+			ret = rte_hash_lookup(tbl_rwc_test_param.h, &i);
+			if (ret != resize_pos[i]) {
+				printf("lookup failed! %"PRIu32"\n", i);
+				err = -1;
+			}
+		}
+		for (i = 0; i < RESIZE_INIT_KEYS && err == 0;
+		     i += BULK_LOOKUP_SIZE) {
+			for (j = 0; j < BULK_LOOKUP_SIZE; j++) {
+				keys[j] = i + j;
+				key_ptrs[j] = &keys[j];
+			}
+			rte_hash_lookup_bulk(tbl_rwc_test_param.h, key_ptrs,
+					     BULK_LOOKUP_SIZE, pos);
+			for (j = 0; j < BULK_LOOKUP_SIZE; j++)
+				if (pos[j] != resize_pos[i + j]) {
+					printf("bulk lookup failed! %"PRIu32
+					       "\n", i + j);
+					err = -1;
+				}
+		}
+		/* The old buckets are freed once all the readers are
+		 * past a quiescent state.
+		 */
+		rte_rcu_qsbr_quiescent(resize_rcu, lcore_id);
+	} while (!writer_done && err == 0);
+	rte_rcu_qsbr_thread_offline(resize_rcu, lcore_id);
+	rte_rcu_qsbr_thread_unregister(resize_rcu, lcore_id);
+
+	return err;
+}
+
+/*
+ * Test online resize:
+ * Reader looks up the keys present in the table with single and bulk
+ * lookups, while the writer grows the table twice, migrating its buckets
+ * and adding keys beyond the initial capacity.
+ */
+static int
+test_hash_resize_lookup_hit(void)
+{
+	struct rte_hash_parameters hash_params = {
+		.name = "tests_resize",
+		.entries = RESIZE_INIT_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+			      RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
+	};
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	const void *next_key;
+	void *next_data;
+	uint32_t migrated, total, iter, count;
+	uint32_t i, key;
+	int left;
+
+	printf("\nTest: Hash resize - lookup hit\n");
+	writer_done = 0;
+	tbl_rwc_test_param.h = NULL;
+	resize_pos = rte_zmalloc(NULL, sizeof(int32_t) * RESIZE_KEYS, 0);
+	resize_rcu = rte_zmalloc(NULL,
+				 rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+				 RTE_CACHE_LINE_SIZE);
+	if (resize_pos == NULL || resize_rcu == NULL) {
+		printf("RTE_MALLOC failed\n");
+		goto err;
+	}
+	rte_rcu_qsbr_init(resize_rcu, RTE_MAX_LCORE);
+
+	tbl_rwc_test_param.h = rte_hash_create(&hash_params);
+	if (tbl_rwc_test_param.h == NULL) {
+		printf("hash creation failed\n");
+		goto err;
+	}
+
+	for (key = 0; key < RESIZE_INIT_KEYS; key++) {
+		resize_pos[key] = rte_hash_add_key(tbl_rwc_test_param.h, &key);
+		if (resize_pos[key] < 0) {
+			printf("writer failed %"PRIu32"\n", key);
+			goto err;
+		}
+	}
+
+	/* The old buckets cannot be freed safely without RCU */
+	if (rte_hash_resize(tbl_rwc_test_param.h, RESIZE_ENTRIES) !=
+			-ENOTSUP) {
+		printf("resize without RCU should have failed\n");
+		goto err;
+	}
+	rcu_cfg.v = resize_rcu;
+	if (rte_hash_rcu_qsbr_add(tbl_rwc_test_param.h, &rcu_cfg) != 0) {
+		printf("RCU QSBR variable add failed\n");
+		goto err;
+	}
+
+	rte_eal_remote_launch(test_rwc_resize_reader, NULL,
+			      enabled_core_ids[1]);
+
+	if (rte_hash_resize(tbl_rwc_test_param.h, RESIZE_ENTRIES) != 0) {
+		printf("resize failed\n");
+		goto err;
+	}
+	if (rte_hash_resize_progress(tbl_rwc_test_param.h, &migrated,
+			&total) != 1 || migrated != 0 ||
+			total != RESIZE_INIT_ENTRIES / 8) {
+		printf("unexpected resize progress %"PRIu32"/%"PRIu32"\n",
+		       migrated, total);
+		goto err;
+	}
+
+	/* Add keys while the buckets are migrated */
+	do {
+		for (i = 0; i < RESIZE_STEP_KEYS && key < RESIZE_KEYS;
+		     i++, key++) {
+			resize_pos[key] = rte_hash_add_key(
+					tbl_rwc_test_param.h, &key);
+			if (resize_pos[key] < 0) {
+				printf("writer failed %"PRIu32"\n", key);
+				goto err;
+			}
+		}
+		left = rte_hash_resize_step(tbl_rwc_test_param.h,
+					    RESIZE_STEP_BUCKETS);
+		if (left < 0) {
+			printf("resize step failed\n");
+			goto err;
+		}
+	} while (left != 0);
+	if (rte_hash_resize_progress(tbl_rwc_test_param.h, &migrated,
+			&total) != 0) {
+		printf("resize should be over\n");
+		goto err;
+	}
+	for (; key < RESIZE_KEYS; key++) {
+		resize_pos[key] = rte_hash_add_key(tbl_rwc_test_param.h, &key);
+		if (resize_pos[key] < 0) {
+			printf("writer failed %"PRIu32"\n", key);
+			goto err;
+		}
+	}
+
+	/* Grow again, waiting for the reader to release the first old
+	 * buckets.
+	 */
+	if (rte_hash_resize(tbl_rwc_test_param.h, RESIZE_ENTRIES * 2) != 0) {
+		printf("second resize failed\n");
+		goto err;
+	}
+	do {
+		left = rte_hash_resize_step(tbl_rwc_test_param.h,
+					    RESIZE_STEP_BUCKETS);
+		if (left < 0) {
+			printf("resize step failed\n");
+			goto err;
+		}
+	} while (left != 0);
+
+	writer_done = 1;
+	if (rte_eal_wait_lcore(enabled_core_ids[1]) < 0)
+		goto err;
+
+	if (rte_hash_count(tbl_rwc_test_param.h) != RESIZE_KEYS) {
+		printf("unexpected entry count after resize\n");
+		goto err;
+	}
+	for (key = 0; key < RESIZE_KEYS; key++) {
+		if (rte_hash_lookup(tbl_rwc_test_param.h, &key) !=
+				resize_pos[key]) {
+			printf("lookup failed after resize! %"PRIu32"\n",
+			       key);
+			goto err;
+		}
+	}
+	iter = 0;
+	count = 0;
+	while (rte_hash_iterate(tbl_rwc_test_param.h, &next_key, &next_data,
+				&iter) >= 0)
+		count++;
+	if (count != RESIZE_KEYS) {
+		printf("iterated %"PRIu32" keys after resize\n", count);
+		goto err;
+	}
+
+	rte_hash_free(tbl_rwc_test_param.h);
+	rte_free(resize_rcu);
+	rte_free(resize_pos);
+	return 0;
+
+err:
+	writer_done = 1;
+	rte_eal_mp_wait_lcore();
+	rte_hash_free(tbl_rwc_test_param.h);
+	rte_free(resize_rcu);
+	rte_free(resize_pos);
+	return -1;
+}
+
 static int
 test_hash_readwrite_lf_main(void)
 {
@@ -1099,6 +1324,8 @@ test_hash_readwrite_lf_main(void)
 		if (test_hash_multi_add_lookup(&rwc_lf_results, rwc_lf, htm)
 							< 0)
 			return -1;
+		if (test_hash_resize_lookup_hit() < 0)
+			return -1;
 	}
 	printf("\nTest lookup with read-write concurrency lock free support"
 	       " disabled\n");
@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_interrupts.h>
+#include <rte_pause.h>
+
+#include "test.h"
+
+#ifdef RTE_EXEC_ENV_LINUXAPP
+
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+
+#define TEST_INTR_SOURCES 1000
+#define TEST_INTR_TIMEOUT 5 /* s */
+
+struct test_intr_source {
+	struct rte_intr_handle handle;
+	volatile uint64_t trigger_tsc; /* when the eventfd was written */
+	volatile uint64_t latency;     /* cycles until the callback ran */
+	volatile uint32_t count;       /* number of calls of the callback */
+};
+
+static struct test_intr_source sources[TEST_INTR_SOURCES];
+
+static void
+test_intr_perf_callback(void *arg)
+{
+	struct test_intr_source *src = arg;
+	uint64_t value;
+
+	src->latency = rte_rdtsc() - src->trigger_tsc;
+	/* the EAL does not read external sources, clear the event */
+	if (read(src->handle.fd, &value, sizeof(value)) < 0)
+		printf("Cannot read eventfd %d\n", src->handle.fd);
+	src->count++;
+}
+
+static int
+test_intr_perf_trigger(struct test_intr_source *src)
+{
+	uint64_t value = 1;
+
+	src->trigger_tsc = rte_rdtsc();
+	if (write(src->handle.fd, &value, sizeof(value)) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/* wait for the callbacks of sources [first, last[ to be called count times */
+static int
+test_intr_perf_wait(unsigned int first, unsigned int last, uint32_t count)
+{
+	uint64_t timeout = rte_get_timer_cycles() +
+		TEST_INTR_TIMEOUT * rte_get_timer_hz();
+	unsigned int i;
+
+	for (i = first; i < last; i++) {
+		while (sources[i].count < count) {
+			if (rte_get_timer_cycles() > timeout)
+				return -1;
+			rte_pause();
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_intr_perf_fd_limit(void)
+{
+	struct rlimit limit;
+
+	if (getrlimit(RLIMIT_NOFILE, &limit) < 0)
+		return -1;
+
+	/* keep room for the fds of the EAL and the drivers */
+	if (limit.rlim_cur >= TEST_INTR_SOURCES * 2)
+		return 0;
+	if (limit.rlim_max < TEST_INTR_SOURCES * 2)
+		limit.rlim_cur = limit.rlim_max;
+	else
+		limit.rlim_cur = TEST_INTR_SOURCES * 2;
+
+	return setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+static int
+test_interrupts_perf(void)
+{
+	uint64_t hz = rte_get_tsc_hz();
+	uint64_t start, cycles, total, max;
+	unsigned int i, nb_sources = 0, nb_registered = 0;
+	int ret = -1;
+
+	if (test_intr_perf_fd_limit() < 0)
+		printf("Cannot raise the limit of open files\n");
+
+	printf("%u interrupt sources, %u interrupt thread(s)\n",
+		TEST_INTR_SOURCES, rte_intr_thread_count());
+
+	for (i = 0; i < TEST_INTR_SOURCES; i++) {
+		sources[i].handle.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (sources[i].handle.fd < 0) {
+			printf("Cannot create eventfd %u: %s\n",
+				i, strerror(errno));
+			goto out;
+		}
+		sources[i].handle.type = RTE_INTR_HANDLE_EXT;
+		sources[i].count = 0;
+		nb_sources++;
+	}
+
+	/* registration, each one updating the wait list of a thread */
+	start = rte_rdtsc();
+	for (i = 0; i < TEST_INTR_SOURCES; i++) {
+		if (rte_intr_callback_register(&sources[i].handle,
+				test_intr_perf_callback, &sources[i]) < 0) {
+			printf("Cannot register source %u\n", i);
+			goto unregister;
+		}
+		nb_registered++;
+	}
+	cycles = rte_rdtsc() - start;
+	printf("Registration: %"PRIu64" cycles per source\n",
+		cycles / TEST_INTR_SOURCES);
+
+	/* latency of a single interrupt among all the registered sources */
+	total = 0;
+	max = 0;
+	for (i = 0; i < TEST_INTR_SOURCES; i++) {
+		if (test_intr_perf_trigger(&sources[i]) < 0 ||
+				test_intr_perf_wait(i, i + 1, 1) < 0) {
+			printf("Interrupt of source %u not handled\n", i);
+			goto unregister;
+		}
+		total += sources[i].latency;
+		max = RTE_MAX(max, sources[i].latency);
+	}
+	printf("Single interrupt latency: average %"PRIu64" us, "
+		"max %"PRIu64" us\n",
+		total * 1000000 / hz / TEST_INTR_SOURCES, max * 1000000 / hz);
+
+	/* all the sources interrupting at once */
+	start = rte_rdtsc();
+	for (i = 0; i < TEST_INTR_SOURCES; i++) {
+		if (test_intr_perf_trigger(&sources[i]) < 0) {
+			printf("Cannot trigger source %u\n", i);
+			goto unregister;
+		}
+	}
+	if (test_intr_perf_wait(0, TEST_INTR_SOURCES, 2) < 0) {
+		printf("Interrupt burst not handled\n");
+		goto unregister;
+	}
+	cycles = rte_rdtsc() - start;
+	max = 0;
+	for (i = 0; i < TEST_INTR_SOURCES; i++)
+		max = RTE_MAX(max, sources[i].latency);
+	printf("Burst of %u interrupts: handled in %"PRIu64" us, "
+		"max latency %"PRIu64" us\n", TEST_INTR_SOURCES,
+		cycles * 1000000 / hz, max * 1000000 / hz);
+
+	ret = 0;
+
+unregister:
+	start = rte_rdtsc();
+	for (i = 0; i < nb_registered; i++) {
+		int unreg;
+
+		/* the callback may still be running */
+		do {
+			unreg = rte_intr_callback_unregister(&sources[i].handle,
+				test_intr_perf_callback, &sources[i]);
+		} while (unreg == -EAGAIN);
+		if (unreg < 0) {
+			printf("Cannot unregister source %u\n", i);
+			ret = -1;
+		}
+	}
+	cycles = rte_rdtsc() - start;
+	if (nb_registered != 0)
+		printf("Unregistration: %"PRIu64" cycles per source\n",
+			cycles / nb_registered);
+
+out:
+	for (i = 0; i < nb_sources; i++)
+		close(sources[i].handle.fd);
+
+	return ret;
+}
+
+#else
+
+static int
+test_interrupts_perf(void)
+{
+	printf("Interrupt performance test is supported on Linux only\n");
+	return TEST_SKIPPED;
+}
+
+#endif /* RTE_EXEC_ENV_LINUXAPP */
+
+REGISTER_TEST_COMMAND(interrupt_perf_autotest, test_interrupts_perf);
@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_lcore_poll.h>
+
+#include "test.h"
+
+#define TEST_POLL_ITERATIONS 1000
+
+static int
+test_lcore_poll_mark(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_lcore_poll_stats stats;
+	uint64_t iterations;
+	unsigned int i;
+	int ret;
+
+	TEST_ASSERT_SUCCESS(rte_lcore_poll_stats_reset(lcore_id),
+		"Cannot reset stats");
+	rte_lcore_poll_resume();
+
+	/* one busy iteration out of four, each bucket of work in turn */
+	for (i = 0; i < TEST_POLL_ITERATIONS; i++) {
+		rte_delay_us_block(1);
+		if (i % 4 == 0)
+			rte_lcore_poll_mark(1U << ((i / 4) %
+				RTE_LCORE_POLL_HIST_SIZE));
+		else
+			rte_lcore_poll_mark(0);
+	}
+
+	TEST_ASSERT_SUCCESS(rte_lcore_poll_stats_get(lcore_id, &stats),
+		"Cannot get stats");
+	TEST_ASSERT(stats.busy_cycles != 0, "No busy cycles accounted");
+	TEST_ASSERT(stats.idle_cycles != 0, "No idle cycles accounted");
+
+	iterations = 0;
+	for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+		iterations += stats.hist[i];
+	TEST_ASSERT_EQUAL(iterations, TEST_POLL_ITERATIONS,
+		"Wrong number of iterations: %"PRIu64, iterations);
+	TEST_ASSERT_EQUAL(stats.hist[0], TEST_POLL_ITERATIONS * 3 / 4,
+		"Wrong number of idle iterations: %"PRIu64, stats.hist[0]);
+	/* 1 << 11 and larger are counted in the last bucket */
+	for (i = 1; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+		TEST_ASSERT(stats.hist[i] != 0,
+			"No iteration in bucket %u", i);
+
+	ret = rte_lcore_poll_busy_percent(lcore_id);
+	TEST_ASSERT(ret >= 0 && ret <= 100, "Wrong busy ratio: %d", ret);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_lcore_poll_reset(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_lcore_poll_stats stats;
+	unsigned int i;
+
+	TEST_ASSERT_SUCCESS(rte_lcore_poll_stats_reset(lcore_id),
+		"Cannot reset stats");
+	TEST_ASSERT_SUCCESS(rte_lcore_poll_stats_get(lcore_id, &stats),
+		"Cannot get stats");
+	TEST_ASSERT(stats.busy_cycles == 0 && stats.idle_cycles == 0,
+		"Cycles not reset");
+	for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+		TEST_ASSERT(stats.hist[i] == 0, "Histogram not reset");
+	TEST_ASSERT_EQUAL(rte_lcore_poll_busy_percent(lcore_id), -ENODATA,
+		"Busy ratio without data");
+
+	rte_lcore_poll_mark(32);
+	TEST_ASSERT_SUCCESS(rte_lcore_poll_stats_get(lcore_id, &stats),
+		"Cannot get stats");
+	TEST_ASSERT(stats.hist[6] == 1, "Iteration not counted after reset");
+
+	TEST_ASSERT_EQUAL(rte_lcore_poll_stats_get(RTE_MAX_LCORE, &stats),
+		-EINVAL, "Stats of an invalid lcore");
+	TEST_ASSERT_EQUAL(rte_lcore_poll_stats_get(lcore_id, NULL),
+		-EINVAL, "Stats in an invalid buffer");
+	TEST_ASSERT_EQUAL(rte_lcore_poll_stats_reset(RTE_MAX_LCORE),
+		-EINVAL, "Reset of an invalid lcore");
+
+	rte_lcore_poll_dump(stdout);
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite lcore_poll_tests = {
+	.suite_name = "lcore poll autotest",
+	.setup = NULL,
+	.teardown = NULL,
+	.unit_test_cases = {
+		TEST_CASE(test_lcore_poll_mark),
+		TEST_CASE(test_lcore_poll_reset),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_lcore_poll(void)
+{
+	return unit_test_suite_runner(&lcore_poll_tests);
+}
+
+REGISTER_TEST_COMMAND(lcore_poll_autotest, test_lcore_poll);
@@ -5,9 +5,12 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <rte_ip.h>
 #include <rte_lpm.h>
+#include <rte_malloc.h>
+#include <rte_random.h>
 
 #include "test.h"
 #include "test_xmmt_ops.h"
@@ -40,6 +43,8 @@ static int32_t test15(void);
 static int32_t test16(void);
 static int32_t test17(void);
 static int32_t test18(void);
+static int32_t test19(void);
+static int32_t test20(void);
 
 rte_lpm_test tests[] = {
 /* Test Cases */
@@ -61,7 +66,9 @@ rte_lpm_test tests[] = {
 	test15,
 	test16,
 	test17,
-	test18
+	test18,
+	test19,
+	test20
 };
 
 #define NUM_LPM_TESTS (sizeof(tests)/sizeof(tests[0]))
@@ -1266,6 +1273,149 @@ test18(void)
 	return PASS;
 }
 
+/*
+ * Tbl8 group reclamation with an attached RCU QSBR variable:
+ *  - add a rule using the only tbl8 group, and delete it while a reader
+ *    is still active
+ *  - check the tbl8 group cannot be allocated for another rule
+ *  - report the quiescent state of the reader
+ *  - check the tbl8 group is reused
+ */
+int32_t
+test19(void)
+{
+	struct rte_lpm_rcu_config rcu_cfg = {0};
+	struct rte_lpm *lpm = NULL;
+	struct rte_lpm_config config;
+	struct rte_rcu_qsbr *v;
+	uint32_t ip1, ip2;
+	uint8_t depth = 28;
+	int32_t status;
+
+	config.max_rules = MAX_RULES;
+	config.number_tbl8s = 1;
+	config.flags = 0;
+
+	lpm = rte_lpm_create(__func__, SOCKET_ID_ANY, &config);
+	TEST_LPM_ASSERT(lpm != NULL);
+
+	v = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	TEST_LPM_ASSERT(v != NULL);
+	rte_rcu_qsbr_init(v, RTE_MAX_LCORE);
+
+	rcu_cfg.v = v;
+	rcu_cfg.mode = RTE_LPM_QSBR_MODE_DQ;
+	status = rte_lpm_rcu_qsbr_add(lpm, &rcu_cfg);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_rcu_qsbr_add(lpm, &rcu_cfg);
+	TEST_LPM_ASSERT(status != 0);
+
+	rte_rcu_qsbr_thread_register(v, 0);
+	rte_rcu_qsbr_thread_online(v, 0);
+
+	ip1 = IPv4(192, 168, 100, 100);
+	ip2 = IPv4(10, 0, 0, 1);
+
+	status = rte_lpm_add(lpm, ip1, depth, 1);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_delete(lpm, ip1, depth);
+	TEST_LPM_ASSERT(status == 0);
+
+	/* The reader may still walk the tbl8 group */
+	status = rte_lpm_add(lpm, ip2, depth, 2);
+	TEST_LPM_ASSERT(status == -ENOSPC);
+
+	rte_rcu_qsbr_quiescent(v, 0);
+	status = rte_lpm_add(lpm, ip2, depth, 2);
+	TEST_LPM_ASSERT(status == 0);
+
+	rte_rcu_qsbr_thread_offline(v, 0);
+	rte_rcu_qsbr_thread_unregister(v, 0);
+	rte_lpm_free(lpm);
+	rte_free(v);
+
+	return PASS;
+}
+
+/*
+ * Check that the bulk lookup functions give the results of
+ * rte_lpm_lookup_bulk(), for routes shorter and longer than 24 bits, and
+ * numbers of addresses which are not multiple of the vector widths.
+ */
+#define TEST20_ROUTES 64
+#define TEST20_LOOKUPS 256
+
+int32_t
+test20(void)
+{
+	static const enum rte_lpm_lookup_type types[] = {
+		RTE_LPM_LOOKUP_DEFAULT,
+		RTE_LPM_LOOKUP_SCALAR,
+		RTE_LPM_LOOKUP_VECTOR_AVX2,
+		RTE_LPM_LOOKUP_VECTOR_AVX512,
+	};
+	static const unsigned int nums[] = {TEST20_LOOKUPS, 1, 7, 8, 15, 17,
+		31};
+	struct rte_lpm *lpm = NULL;
+	struct rte_lpm_config config;
+	rte_lpm_lookup_bulk_fn_t fn;
+	uint32_t ips[TEST20_LOOKUPS];
+	uint32_t next_hops[TEST20_LOOKUPS];
+	uint32_t expected[TEST20_LOOKUPS];
+	uint32_t ip;
+	unsigned int i, j, k;
+	uint8_t depth;
+
+	config.max_rules = MAX_RULES;
+	config.number_tbl8s = NUMBER_TBL8S;
+	config.flags = 0;
+
+	TEST_LPM_ASSERT(rte_lpm_get_lookup_bulk_fn(NULL,
+		RTE_LPM_LOOKUP_DEFAULT) == NULL);
+
+	lpm = rte_lpm_create(__func__, SOCKET_ID_ANY, &config);
+	TEST_LPM_ASSERT(lpm != NULL);
+
+	/* the routes and the addresses share a few /24 */
+	for (i = 0; i < TEST20_ROUTES; i++) {
+		ip = IPv4(10, rte_rand() % 4, rte_rand() % 4, rte_rand());
+		depth = 16 + rte_rand() % (MAX_DEPTH - 16 + 1);
+		TEST_LPM_ASSERT(rte_lpm_add(lpm, ip, depth, i) == 0);
+	}
+	for (i = 0; i < TEST20_LOOKUPS; i++) {
+		if (i % 4 == 0)
+			ips[i] = rte_rand();
+		else
+			ips[i] = IPv4(10, rte_rand() % 4, rte_rand() % 4,
+				rte_rand());
+	}
+	rte_lpm_lookup_bulk(lpm, ips, expected, TEST20_LOOKUPS);
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		fn = rte_lpm_get_lookup_bulk_fn(lpm, types[i]);
+		if (fn == NULL) {
+			/* the vector lookups may not be supported */
+			TEST_LPM_ASSERT(types[i] != RTE_LPM_LOOKUP_DEFAULT &&
+				types[i] != RTE_LPM_LOOKUP_SCALAR);
+			continue;
+		}
+		for (j = 0; j < RTE_DIM(nums); j++) {
+			memset(next_hops, 0, sizeof(next_hops));
+			fn(lpm, ips, next_hops, nums[j]);
+			for (k = 0; k < nums[j]; k++)
+				TEST_LPM_ASSERT(next_hops[k] == expected[k]);
+			/* the next hops after the last address are untouched */
+			for (; k < TEST20_LOOKUPS; k++)
+				TEST_LPM_ASSERT(next_hops[k] == 0);
+		}
+	}
+
+	rte_lpm_free(lpm);
+
+	return PASS;
+}
+
 /*
  * Do all unit tests.
  */
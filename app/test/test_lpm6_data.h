@@ -6,6 +6,9 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <rte_common.h>
 
 struct rules_tbl_entry {
 	uint8_t ip[16];
@@ -1156,4 +1159,91 @@ static void generate_large_ips_table(int gen_expected_next_hop)
 
 }
 
+/* number of routes of a table close to a full IPv6 Internet routing table */
+#define  NUM_FULL_ROUTE_ENTRIES 150000
+
+/* share per ten thousand of each depth in the full routing table */
+static const struct {
+	uint8_t depth;
+	uint16_t share;
+} full_route_depths[] = {
+	{16, 2}, {19, 4}, {20, 10}, {22, 6}, {24, 8}, {28, 40}, {29, 500},
+	{30, 40}, {31, 30}, {32, 1200}, {33, 120}, {34, 110}, {35, 80},
+	{36, 280}, {37, 60}, {38, 70}, {39, 50}, {40, 600}, {41, 40},
+	{42, 120}, {43, 40}, {44, 800}, {45, 120}, {46, 200}, {47, 170},
+	{48, 5100}, {56, 60}, {64, 80}, {128, 60}
+};
+
+/* number of the /32 blocks in which the more specific routes are allocated */
+#define  NUM_FULL_ROUTE_BLOCKS 12000
+
+/* the /32 blocks are taken in the /12 allocated to the registries */
+static inline void generate_full_route_block(uint8_t *ip)
+{
+	static const uint16_t rir_pfx[] = {
+		0x2001, 0x2400, 0x2600, 0x2800, 0x2a00, 0x2c00
+	};
+	uint16_t pfx = rir_pfx[lrand48() % RTE_DIM(rir_pfx)];
+
+	if (pfx != 0x2001)
+		pfx |= lrand48() & 0x0f;
+	memset(ip, 0, 16);
+	ip[0] = pfx >> 8;
+	ip[1] = pfx & 0xff;
+	ip[2] = lrand48();
+	ip[3] = lrand48();
+}
+
+/* generate a table of n routes with the depths of a full routing table,
+ * the routes longer than /32 being more specifics of a pool of /32 blocks
+ * in which they are clustered in a few /40, as they are on the Internet.
+ */
+static inline void generate_full_route_table(struct rules_tbl_entry *table,
+	uint32_t n)
+{
+	static uint8_t blocks[NUM_FULL_ROUTE_BLOCKS][16];
+	uint32_t i, j, k, total = 0, pick;
+	uint8_t ip[16];
+
+	for (i = 0; i < NUM_FULL_ROUTE_BLOCKS; i++)
+		generate_full_route_block(blocks[i]);
+	for (j = 0; j < RTE_DIM(full_route_depths); j++)
+		total += full_route_depths[j].share;
+
+	for (i = 0; i < n; i++) {
+		pick = lrand48() % total;
+		for (j = 0; pick >= full_route_depths[j].share; j++)
+			pick -= full_route_depths[j].share;
+		table[i].depth = full_route_depths[j].depth;
+
+		if (table[i].depth <= 32) {
+			generate_full_route_block(ip);
+		} else {
+			memcpy(ip, blocks[lrand48() % NUM_FULL_ROUTE_BLOCKS],
+				16);
+			ip[4] = lrand48() % 4;
+			for (k = 5; k < 16; k++)
+				ip[k] = lrand48();
+		}
+		memset(table[i].ip, 0, 16);
+		mask_ip6_prefix(table[i].ip, ip, table[i].depth);
+		table[i].next_hop = i & 0xff;
+	}
+}
+
+/* generate n addresses, each one covered by a random route of the table */
+static inline void generate_full_ips_table(uint8_t ips[][16], uint32_t n,
+	const struct rules_tbl_entry *table, uint32_t nb_routes)
+{
+	uint32_t i, j;
+	const struct rules_tbl_entry *rule;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < 16; j++)
+			ips[i][j] = lrand48();
+		rule = &table[lrand48() % nb_routes];
+		mask_ip6_prefix(ips[i], rule->ip, rule->depth);
+	}
+}
+
 #endif /* _TEST_LPM_ROUTES_H_ */
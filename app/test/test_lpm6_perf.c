@@ -50,6 +50,118 @@ print_route_distribution(const struct rules_tbl_entry *table, uint32_t n)
 	printf("\n");
 }
 
+/* share of the routes deleted and added back by each churn round */
+#define CHURN_ROUNDS 8
+#define CHURN_SHARE 10 /* % */
+#define FULL_TABLE_NUMBER_TBL8S (1 << 17)
+#define FULL_TABLE_BULK_SIZE 32
+
+static struct rules_tbl_entry full_route_table[NUM_FULL_ROUTE_ENTRIES];
+static uint8_t full_ips_table[BATCH_SIZE][16];
+
+/*
+ * Add, lookup, update and delete the routes of a table of the size of a full
+ * IPv6 Internet routing table.
+ */
+static int
+test_lpm6_full_table_perf(void)
+{
+	static uint32_t churn_idx[NUM_FULL_ROUTE_ENTRIES];
+	struct rte_lpm6 *lpm = NULL;
+	struct rte_lpm6_config config;
+	uint64_t begin, total_time, del_time = 0, add_time = 0;
+	int32_t next_hops[FULL_TABLE_BULK_SIZE];
+	uint32_t nb_churn = NUM_FULL_ROUTE_ENTRIES * CHURN_SHARE / 100;
+	unsigned int i, j, k;
+	int status = 0;
+	int64_t count = 0;
+
+	config.max_rules = 1000000;
+	config.number_tbl8s = FULL_TABLE_NUMBER_TBL8S;
+	config.flags = 0;
+
+	generate_full_route_table(full_route_table, NUM_FULL_ROUTE_ENTRIES);
+	generate_full_ips_table(full_ips_table, BATCH_SIZE, full_route_table,
+		NUM_FULL_ROUTE_ENTRIES);
+
+	printf("No. routes of the full table = %u\n",
+		(unsigned int)NUM_FULL_ROUTE_ENTRIES);
+	print_route_distribution(full_route_table, NUM_FULL_ROUTE_ENTRIES);
+
+	lpm = rte_lpm6_create("lpm6_full_table", SOCKET_ID_ANY, &config);
+	TEST_LPM_ASSERT(lpm != NULL);
+
+	/* Measure add. */
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_FULL_ROUTE_ENTRIES; i++) {
+		if (rte_lpm6_add(lpm, full_route_table[i].ip,
+				full_route_table[i].depth,
+				full_route_table[i].next_hop) == 0)
+			status++;
+	}
+	total_time = rte_rdtsc() - begin;
+
+	printf("Unique added entries = %d\n", status);
+	printf("Average LPM Add: %g cycles\n",
+			(double)total_time / NUM_FULL_ROUTE_ENTRIES);
+
+	/* Measure bulk Lookup */
+	total_time = 0;
+	for (i = 0; i < ITERATIONS / 16; i++) {
+		begin = rte_rdtsc();
+		for (j = 0; j + FULL_TABLE_BULK_SIZE <= BATCH_SIZE;
+				j += FULL_TABLE_BULK_SIZE) {
+			rte_lpm6_lookup_bulk_func(lpm, &full_ips_table[j],
+				next_hops, FULL_TABLE_BULK_SIZE);
+			for (k = 0; k < FULL_TABLE_BULK_SIZE; k++)
+				if (next_hops[k] < 0)
+					count++;
+		}
+		total_time += rte_rdtsc() - begin;
+	}
+	printf("BULK LPM Lookup: %.1f cycles (fails = %.1f%%)\n",
+			(double)total_time / ((double)(ITERATIONS / 16) * j),
+			(count * 100.0) / ((double)(ITERATIONS / 16) * j));
+
+	/* Measure churn: delete and add back random routes of the table */
+	for (i = 0; i < CHURN_ROUNDS; i++) {
+		for (j = 0; j < nb_churn; j++)
+			churn_idx[j] = rte_rand() % NUM_FULL_ROUTE_ENTRIES;
+
+		begin = rte_rdtsc();
+		for (j = 0; j < nb_churn; j++)
+			rte_lpm6_delete(lpm, full_route_table[churn_idx[j]].ip,
+				full_route_table[churn_idx[j]].depth);
+		del_time += rte_rdtsc() - begin;
+
+		begin = rte_rdtsc();
+		for (j = 0; j < nb_churn; j++)
+			TEST_LPM_ASSERT(rte_lpm6_add(lpm,
+				full_route_table[churn_idx[j]].ip,
+				full_route_table[churn_idx[j]].depth,
+				full_route_table[churn_idx[j]].next_hop) == 0);
+		add_time += rte_rdtsc() - begin;
+	}
+	printf("Average LPM churn: %g cycles per delete, "
+			"%g cycles per add\n",
+			(double)del_time / (CHURN_ROUNDS * nb_churn),
+			(double)add_time / (CHURN_ROUNDS * nb_churn));
+
+	/* Delete */
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_FULL_ROUTE_ENTRIES; i++)
+		rte_lpm6_delete(lpm, full_route_table[i].ip,
+			full_route_table[i].depth);
+	total_time = rte_rdtsc() - begin;
+
+	printf("Average LPM Delete: %g cycles\n",
+			(double)total_time / NUM_FULL_ROUTE_ENTRIES);
+
+	rte_lpm6_free(lpm);
+
+	return 0;
+}
+
 static int
 test_lpm6_perf(void)
 {
@@ -157,7 +269,7 @@ test_lpm6_perf(void)
 	rte_lpm6_delete_all(lpm);
 	rte_lpm6_free(lpm);
 
-	return 0;
+	return test_lpm6_full_table_perf();
 }
 
 REGISTER_TEST_COMMAND(lpm6_perf_autotest, test_lpm6_perf);
@@ -292,6 +292,39 @@ static void generate_large_route_rule_table(void)
 	insert_rule_in_random_pos(IPv4(192, 168, 129, 124), 32);
 }
 
+/* Measure the bulk lookups of a bulk lookup function */
+static void
+test_lpm_lookup_bulk_fn_perf(struct rte_lpm *lpm, rte_lpm_lookup_bulk_fn_t fn,
+	const char *name)
+{
+	static uint32_t ip_batch[BATCH_SIZE];
+	uint32_t next_hops[BULK_SIZE];
+	uint64_t begin, total_time = 0;
+	int64_t count = 0;
+	unsigned int i, j, k;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		/* Create array of random IP addresses */
+		for (j = 0; j < BATCH_SIZE; j++)
+			ip_batch[j] = rte_rand();
+
+		/* Lookup per batch */
+		begin = rte_rdtsc();
+		for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
+			fn(lpm, &ip_batch[j], next_hops, BULK_SIZE);
+			for (k = 0; k < BULK_SIZE; k++)
+				if (unlikely(!(next_hops[k] &
+						RTE_LPM_LOOKUP_SUCCESS)))
+					count++;
+		}
+
+		total_time += rte_rdtsc() - begin;
+	}
+	printf("%s BULK LPM Lookup: %.1f cycles (fails = %.1f%%)\n", name,
+			(double)total_time / ((double)ITERATIONS * BATCH_SIZE),
+			(count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+}
+
 static void
 print_route_distribution(const struct route_rule *table, uint32_t n)
 {
@@ -321,6 +354,7 @@ test_lpm_perf(void)
 {
 	struct rte_lpm *lpm = NULL;
 	struct rte_lpm_config config;
+	rte_lpm_lookup_bulk_fn_t fn;
 
 	config.max_rules = 2000000;
 	config.number_tbl8s = 2048;
@@ -429,6 +463,14 @@ test_lpm_perf(void)
 			(double)total_time / ((double)ITERATIONS * BATCH_SIZE),
 			(count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
 
+	/* Measure bulk Lookup with the vector implementations */
+	fn = rte_lpm_get_lookup_bulk_fn(lpm, RTE_LPM_LOOKUP_VECTOR_AVX2);
+	if (fn != NULL)
+		test_lpm_lookup_bulk_fn_perf(lpm, fn, "AVX2");
+	fn = rte_lpm_get_lookup_bulk_fn(lpm, RTE_LPM_LOOKUP_VECTOR_AVX512);
+	if (fn != NULL)
+		test_lpm_lookup_bulk_fn_perf(lpm, fn, "AVX512");
+
 	/* Measure LookupX4 */
 	total_time = 0;
 	count = 0;
@@ -365,6 +365,102 @@ test_multi_alloc_statistics(void)
 	return 0;
 }
 
+#if RTE_MALLOC_SLAB_MAX_SIZE > 0
+/*
+ * Small allocations are served from per-lcore size class magazines. An
+ * element freed on a slave lcore must be handed back, zeroed, by the next
+ * allocation of the same class on that lcore, the cached element
+ * must not be reported as allocated, and freeing it again is rejected.
+ */
+static int
+test_malloc_slab_per_lcore(__attribute__((unused)) void *arg)
+{
+	struct rte_malloc_socket_stats pre_stats, alloc_stats, post_stats;
+	int socket = rte_socket_id();
+	size_t size = RTE_CACHE_LINE_SIZE;
+	char *p1, *p2;
+	size_t i;
+
+	/* prime the magazine so that the element below is a cached one */
+	p1 = rte_malloc_socket("slab", size, 0, socket);
+	if (p1 == NULL)
+		return -1;
+	rte_free(p1);
+
+	rte_malloc_get_socket_stats(socket, &pre_stats);
+
+	p1 = rte_malloc_socket("slab", size, 0, socket);
+	if (p1 == NULL)
+		return -1;
+	memset(p1, 0xa5, size);
+
+	rte_malloc_get_socket_stats(socket, &alloc_stats);
+	if (alloc_stats.heap_allocsz_bytes <= pre_stats.heap_allocsz_bytes ||
+			alloc_stats.alloc_count != pre_stats.alloc_count + 1) {
+		printf("Cached element not accounted as allocated\n");
+		rte_free(p1);
+		return -1;
+	}
+
+	rte_free(p1);
+
+	p2 = rte_malloc_socket("slab", size, 0, socket);
+	if (p2 != p1) {
+		printf("Freed element not reused: %p (expected %p)\n", p2, p1);
+		rte_free(p2);
+		return -1;
+	}
+	for (i = 0; i < size; i++) {
+		if (p2[i] != 0) {
+			printf("Cached element not zeroed at offset %zu\n", i);
+			rte_free(p2);
+			return -1;
+		}
+	}
+	rte_free(p2);
+
+	rte_malloc_get_socket_stats(socket, &post_stats);
+	if (post_stats.heap_allocsz_bytes != pre_stats.heap_allocsz_bytes ||
+			post_stats.heap_freesz_bytes !=
+				pre_stats.heap_freesz_bytes ||
+			post_stats.alloc_count != pre_stats.alloc_count) {
+		printf("Malloc statistics are incorrect - cached free\n");
+		return -1;
+	}
+
+	/* a double free must not cache the element twice */
+	rte_free(p2);
+	p1 = rte_malloc_socket("slab", size, 0, socket);
+	p2 = rte_malloc_socket("slab", size, 0, socket);
+	rte_free(p1);
+	if (p1 == NULL || p2 == p1) {
+		printf("Double free element handed out twice\n");
+		if (p2 != p1)
+			rte_free(p2);
+		return -1;
+	}
+	rte_free(p2);
+
+	return 0;
+}
+
+static int
+test_malloc_slab(void)
+{
+	unsigned int lcore_id;
+
+	/* the master lcore does not cache blocks */
+	lcore_id = rte_get_next_lcore(-1, 1, 0);
+	if (lcore_id >= RTE_MAX_LCORE) {
+		printf("No slave lcore to test the malloc cache, skipping\n");
+		return 0;
+	}
+
+	rte_eal_remote_launch(test_malloc_slab_per_lcore, NULL, lcore_id);
+	return rte_eal_wait_lcore(lcore_id);
+}
+#endif
+
 static int
 test_rte_malloc_type_limits(void)
 {
@@ -935,6 +1031,16 @@ test_malloc(void)
 	else
 		printf("test_multi_alloc_statistics() passed\n");
 
+#if RTE_MALLOC_SLAB_MAX_SIZE > 0
+	ret = test_malloc_slab();
+	if (ret < 0) {
+		printf("test_malloc_slab() failed\n");
+		return ret;
+	}
+	else
+		printf("test_malloc_slab() passed\n");
+#endif
+
 	return 0;
 }
 
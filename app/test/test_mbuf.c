@@ -13,6 +13,7 @@
 
 #include <rte_common.h>
 #include <rte_debug.h>
+#include <rte_errno.h>
 #include <rte_log.h>
 #include <rte_memory.h>
 #include <rte_memcpy.h>
@@ -25,6 +26,9 @@
 #include <rte_ring.h>
 #include <rte_mempool.h>
 #include <rte_mbuf.h>
+#include <rte_mbuf_pool_ops.h>
+#include <rte_pause.h>
+#include <rte_malloc.h>
 #include <rte_random.h>
 #include <rte_cycles.h>
 
@@ -501,6 +505,386 @@ test_attach_from_different_pool(struct rte_mempool *pktmbuf_pool,
 		rte_pktmbuf_free(clone2);
 	return -1;
 }
+
+/*
+ * test bulk free of mbufs chained across pools, shared and NULL entries
+ */
+static int
+test_pktmbuf_free_bulk(struct rte_mempool *pktmbuf_pool,
+		struct rte_mempool *pktmbuf_pool2)
+{
+	struct rte_mbuf *m[NB_MBUF / 2];
+	struct rte_mbuf *single, *clone;
+	unsigned int avail, avail2, i;
+
+	avail = rte_mempool_avail_count(pktmbuf_pool);
+	avail2 = rte_mempool_avail_count(pktmbuf_pool2);
+
+	if (rte_pktmbuf_alloc_bulk(pktmbuf_pool, m, RTE_DIM(m)) != 0)
+		GOTO_FAIL("rte_pktmbuf_alloc_bulk() failed");
+
+	/* chain a segment from the other pool on every other mbuf */
+	for (i = 0; i < RTE_DIM(m); i += 2) {
+		struct rte_mbuf *seg = rte_pktmbuf_alloc(pktmbuf_pool2);
+
+		if (seg == NULL)
+			GOTO_FAIL("rte_pktmbuf_alloc() failed");
+		if (rte_pktmbuf_chain(m[i], seg) != 0) {
+			rte_pktmbuf_free(seg);
+			GOTO_FAIL("rte_pktmbuf_chain() failed");
+		}
+	}
+
+	/* a clone keeps a reference on the first mbuf */
+	clone = rte_pktmbuf_clone(m[0], pktmbuf_pool);
+	if (clone == NULL)
+		GOTO_FAIL("rte_pktmbuf_clone() failed");
+
+	/* NULL entries are skipped */
+	single = m[1];
+	m[1] = NULL;
+
+	rte_pktmbuf_free_bulk(m, RTE_DIM(m));
+	rte_pktmbuf_free(single);
+	if (rte_mempool_avail_count(pktmbuf_pool2) != avail2 - 1)
+		GOTO_FAIL("shared segment freed");
+	rte_pktmbuf_free_bulk(&clone, 1);
+
+	if (rte_mempool_avail_count(pktmbuf_pool) != avail)
+		GOTO_FAIL("%u mbufs not freed",
+			avail - rte_mempool_avail_count(pktmbuf_pool));
+	if (rte_mempool_avail_count(pktmbuf_pool2) != avail2)
+		GOTO_FAIL("%u segments not freed",
+			avail2 - rte_mempool_avail_count(pktmbuf_pool2));
+
+	return 0;
+
+fail:
+	return -1;
+}
+
+/*
+ * check that mbufs of a fast-free pool are reset by the bulk and single
+ * frees, so that the bulk allocation can skip the reset
+ */
+static int
+test_pktmbuf_fast_free(void)
+{
+	struct rte_mbuf *m[NB_MBUF];
+	struct rte_mempool *mp;
+	unsigned int i;
+
+	mp = rte_pktmbuf_pool_create_with_flags("test_pktmbuf_fast_free",
+		NB_MBUF, 0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY, NULL,
+		RTE_PKTMBUF_POOL_F_FAST_FREE);
+#ifndef RTE_MBUF_FAST_FREE_POOL
+	if (mp != NULL || rte_errno != ENOTSUP)
+		GOTO_FAIL("fast-free pool created while not built in");
+	return 0;
+#endif
+	if (mp == NULL)
+		GOTO_FAIL("cannot allocate fast-free mbuf pool");
+
+	if (rte_pktmbuf_alloc_bulk(mp, m, RTE_DIM(m) / 2) != 0)
+		GOTO_FAIL("rte_pktmbuf_alloc_bulk() failed");
+
+	/* dirty the mbufs and chain them by pairs */
+	for (i = 0; i < RTE_DIM(m) / 2; i++) {
+		if (rte_pktmbuf_append(m[i], MBUF_TEST_DATA_LEN2) == NULL)
+			GOTO_FAIL("rte_pktmbuf_append() failed");
+		if (rte_pktmbuf_adj(m[i], MBUF_TEST_HDR1_LEN) == NULL)
+			GOTO_FAIL("rte_pktmbuf_adj() failed");
+		m[i]->ol_flags = PKT_RX_VLAN;
+		m[i]->vlan_tci = 1;
+		m[i]->packet_type = RTE_PTYPE_L2_ETHER;
+		m[i]->port = 0;
+		if (i % 2 == 1 && rte_pktmbuf_chain(m[i - 1], m[i]) != 0)
+			GOTO_FAIL("rte_pktmbuf_chain() failed");
+		if (i % 2 == 1)
+			m[i] = NULL;
+	}
+	rte_pktmbuf_free_bulk(m, RTE_DIM(m) / 4);
+	for (i = RTE_DIM(m) / 4; i < RTE_DIM(m) / 2; i++)
+		rte_pktmbuf_free(m[i]);
+
+	/* every mbuf of the pool must come back in reset state */
+	if (rte_pktmbuf_alloc_bulk(mp, m, RTE_DIM(m)) != 0)
+		GOTO_FAIL("rte_pktmbuf_alloc_bulk() failed (2)");
+	for (i = 0; i < RTE_DIM(m); i++) {
+		if (m[i]->next != NULL || m[i]->nb_segs != 1 ||
+				m[i]->pkt_len != 0 || m[i]->data_len != 0 ||
+				m[i]->ol_flags != 0 || m[i]->vlan_tci != 0 ||
+				m[i]->packet_type != 0 ||
+				m[i]->port != MBUF_INVALID_PORT ||
+				m[i]->data_off != RTE_MIN(RTE_PKTMBUF_HEADROOM,
+					m[i]->buf_len))
+			GOTO_FAIL("mbuf %u not in reset state", i);
+	}
+	rte_pktmbuf_free_bulk(m, RTE_DIM(m));
+
+	if (rte_mempool_avail_count(mp) != NB_MBUF)
+		GOTO_FAIL("mbufs not freed");
+
+	rte_mempool_free(mp);
+
+	/* only the fast-free flag can be given at creation */
+	mp = rte_pktmbuf_pool_create_with_flags("test_pktmbuf_fast_free",
+		NB_MBUF, 0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY, NULL,
+		RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF);
+	if (mp != NULL || rte_errno != EINVAL)
+		GOTO_FAIL("pool created with unsupported flags");
+
+	return 0;
+
+fail:
+	rte_mempool_free(mp);
+	return -1;
+}
+
+#define MBUF_PERF_BURST 32
+#define MBUF_PERF_ITER 10000
+
+/*
+ * print the cycles per mbuf of the allocation and free paths, with and
+ * without the bulk free and the fast-free pool flag
+ */
+static int
+test_pktmbuf_bulk_perf(struct rte_mempool *pktmbuf_pool)
+{
+	struct rte_mbuf *m[MBUF_PERF_BURST];
+	struct rte_mempool *pools[2] = { pktmbuf_pool, NULL };
+	uint64_t alloc_cycles, free_cycles, start;
+	unsigned int i, j, p, nb_pools = 1;
+	int free_bulk;
+
+#ifdef RTE_MBUF_FAST_FREE_POOL
+	pools[1] = rte_pktmbuf_pool_create_with_flags("test_pktmbuf_perf",
+		NB_MBUF, 32, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY, NULL,
+		RTE_PKTMBUF_POOL_F_FAST_FREE);
+	if (pools[1] == NULL) {
+		printf("cannot allocate fast-free mbuf pool\n");
+		return -1;
+	}
+	nb_pools = 2;
+#endif
+
+	for (p = 0; p < nb_pools; p++) {
+		for (free_bulk = 0; free_bulk <= 1; free_bulk++) {
+			alloc_cycles = 0;
+			free_cycles = 0;
+			for (i = 0; i < MBUF_PERF_ITER; i++) {
+				start = rte_rdtsc();
+				if (rte_pktmbuf_alloc_bulk(pools[p], m,
+						MBUF_PERF_BURST) != 0) {
+					rte_mempool_free(pools[1]);
+					return -1;
+				}
+				alloc_cycles += rte_rdtsc() - start;
+
+				start = rte_rdtsc();
+				if (free_bulk) {
+					rte_pktmbuf_free_bulk(m,
+						MBUF_PERF_BURST);
+				} else {
+					for (j = 0; j < MBUF_PERF_BURST; j++)
+						rte_pktmbuf_free(m[j]);
+				}
+				free_cycles += rte_rdtsc() - start;
+			}
+
+			printf("%s pool, %s: alloc %.2f, free %.2f cycles/mbuf\n",
+				p == 0 ? "default" : "fast-free",
+				free_bulk ? "rte_pktmbuf_free_bulk" :
+					"rte_pktmbuf_free",
+				(double)alloc_cycles /
+					(MBUF_PERF_ITER * MBUF_PERF_BURST),
+				(double)free_cycles /
+					(MBUF_PERF_ITER * MBUF_PERF_BURST));
+		}
+	}
+
+	rte_mempool_free(pools[1]);
+	return 0;
+}
+
+#ifdef RTE_MBUF_REFCNT_ATOMIC
+
+#define PINNED_RACE_ITER 1000
+
+static struct rte_mbuf * volatile pinned_race_mbuf;
+static volatile unsigned int pinned_race_done;
+
+/* free the mbufs given by the master lcore, racing with its own free */
+static int
+test_pinned_race_slave(__attribute__((unused)) void *arg)
+{
+	struct rte_mbuf *m;
+	unsigned int i;
+
+	for (i = 0; i < PINNED_RACE_ITER; i++) {
+		while ((m = pinned_race_mbuf) == NULL)
+			rte_pause();
+		pinned_race_mbuf = NULL;
+		rte_pktmbuf_free(m);
+		rte_smp_wmb();
+		pinned_race_done = i + 1;
+	}
+	return 0;
+}
+
+#endif
+
+/* count the mbufs of a pool not having a reference counter of 1 */
+static void
+test_pktmbuf_count_bad_refcnt(__attribute__((unused)) struct rte_mempool *mp,
+		void *opaque, void *obj, __attribute__((unused)) unsigned int i)
+{
+	unsigned int *nb_bad = opaque;
+
+	if (rte_mbuf_refcnt_read(obj) != 1)
+		(*nb_bad)++;
+}
+
+/*
+ * check that mbufs of a pool with pinned external buffers stay attached
+ * to their buffer, and are only given back once their clones are freed
+ */
+static int
+test_pktmbuf_pinned_extbuf(struct rte_mempool *pktmbuf_pool)
+{
+	struct rte_pktmbuf_extmem ext_mem;
+	struct rte_mempool *mp = NULL;
+	struct rte_mbuf *m[NB_MBUF / 2];
+	struct rte_mbuf *clone = NULL;
+	unsigned int i, slave, nb_bad;
+	char *data;
+
+	ext_mem.elt_size = MBUF_DATA_SIZE;
+	ext_mem.buf_len = (size_t)NB_MBUF * MBUF_DATA_SIZE;
+	ext_mem.buf_ptr = rte_malloc("test_extmem", ext_mem.buf_len, 0);
+	if (ext_mem.buf_ptr == NULL)
+		GOTO_FAIL("cannot allocate external memory");
+	ext_mem.buf_iova = rte_malloc_virt2iova(ext_mem.buf_ptr);
+
+	mp = rte_pktmbuf_pool_create_extbuf("test_pktmbuf_pinned", NB_MBUF,
+		0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY, &ext_mem, 1);
+	if (mp == NULL)
+		GOTO_FAIL("cannot allocate pinned mbuf pool");
+
+	if (rte_pktmbuf_alloc_bulk(mp, m, RTE_DIM(m)) != 0)
+		GOTO_FAIL("rte_pktmbuf_alloc_bulk() failed");
+
+	for (i = 0; i < RTE_DIM(m); i++) {
+		if (!RTE_MBUF_HAS_EXTBUF(m[i]) ||
+				!RTE_MBUF_HAS_PINNED_EXTBUF(m[i]))
+			GOTO_FAIL("mbuf %u has no pinned buffer", i);
+		if ((char *)m[i]->buf_addr < (char *)ext_mem.buf_ptr ||
+				(char *)m[i]->buf_addr + m[i]->buf_len >
+				(char *)ext_mem.buf_ptr + ext_mem.buf_len)
+			GOTO_FAIL("mbuf %u buffer out of external memory", i);
+		data = rte_pktmbuf_append(m[i], MBUF_TEST_DATA_LEN2);
+		if (data == NULL)
+			GOTO_FAIL("rte_pktmbuf_append() failed");
+		memset(data, 0xcc, MBUF_TEST_DATA_LEN2);
+	}
+
+	/* the clone shares the pinned buffer */
+	clone = rte_pktmbuf_clone(m[0], pktmbuf_pool);
+	if (clone == NULL)
+		GOTO_FAIL("rte_pktmbuf_clone() failed");
+	if (clone->buf_addr != m[0]->buf_addr ||
+			rte_mbuf_ext_refcnt_read(m[0]->shinfo) != 2)
+		GOTO_FAIL("clone does not share the pinned buffer");
+
+	rte_pktmbuf_free_bulk(m, RTE_DIM(m));
+	if (rte_mempool_avail_count(mp) != NB_MBUF - 1)
+		GOTO_FAIL("cloned mbuf given back to the pool");
+
+	rte_pktmbuf_free(clone);
+	clone = NULL;
+	if (rte_mempool_avail_count(mp) != NB_MBUF)
+		GOTO_FAIL("cloned mbuf not given back to the pool");
+
+	/* freed mbufs keep their buffer */
+	if (rte_pktmbuf_alloc_bulk(mp, m, RTE_DIM(m)) != 0)
+		GOTO_FAIL("rte_pktmbuf_alloc_bulk() failed (2)");
+	for (i = 0; i < RTE_DIM(m); i++) {
+		if (!RTE_MBUF_HAS_EXTBUF(m[i]) || m[i]->pkt_len != 0 ||
+				rte_mbuf_ext_refcnt_read(m[i]->shinfo) != 1)
+			GOTO_FAIL("mbuf %u not reset", i);
+		rte_pktmbuf_free(m[i]);
+	}
+
+	/* the original has several references when its clone is made */
+	m[0] = rte_pktmbuf_alloc(mp);
+	if (m[0] == NULL)
+		GOTO_FAIL("rte_pktmbuf_alloc() failed");
+	rte_mbuf_refcnt_update(m[0], 1);
+	clone = rte_pktmbuf_clone(m[0], pktmbuf_pool);
+	if (clone == NULL)
+		GOTO_FAIL("rte_pktmbuf_clone() failed (2)");
+	rte_pktmbuf_free(m[0]);
+	if (rte_mbuf_refcnt_read(m[0]) != 1)
+		GOTO_FAIL("bad refcnt after first free");
+	rte_pktmbuf_free(m[0]);
+	if (rte_mempool_avail_count(mp) != NB_MBUF - 1)
+		GOTO_FAIL("cloned mbuf given back to the pool (2)");
+	rte_pktmbuf_free(clone);
+	clone = NULL;
+	if (rte_mempool_avail_count(mp) != NB_MBUF)
+		GOTO_FAIL("cloned mbuf not given back to the pool (2)");
+
+#ifdef RTE_MBUF_REFCNT_ATOMIC
+	/* the last two references of the original are released concurrently,
+	 * so that one of the frees may drop it from 2 to 0
+	 */
+	slave = rte_get_next_lcore(-1, 1, 0);
+	if (slave < RTE_MAX_LCORE) {
+		pinned_race_mbuf = NULL;
+		pinned_race_done = 0;
+		rte_eal_remote_launch(test_pinned_race_slave, NULL, slave);
+		for (i = 0; i < PINNED_RACE_ITER; i++) {
+			m[0] = rte_pktmbuf_alloc(mp);
+			if (m[0] == NULL)
+				rte_panic("rte_pktmbuf_alloc() failed\n");
+			rte_mbuf_refcnt_update(m[0], 1);
+			clone = rte_pktmbuf_clone(m[0], pktmbuf_pool);
+			if (clone == NULL)
+				rte_panic("rte_pktmbuf_clone() failed\n");
+			rte_smp_wmb();
+			pinned_race_mbuf = m[0];
+			rte_pktmbuf_free(m[0]);
+			while (pinned_race_done != i + 1)
+				rte_pause();
+			rte_smp_rmb();
+			rte_pktmbuf_free(clone);
+			clone = NULL;
+		}
+		rte_eal_wait_lcore(slave);
+		if (rte_mempool_avail_count(mp) != NB_MBUF)
+			GOTO_FAIL("raced mbufs not given back to the pool");
+	}
+#else
+	RTE_SET_USED(slave);
+#endif
+
+	/* mbufs are always put back with one reference */
+	nb_bad = 0;
+	rte_mempool_obj_iter(mp, test_pktmbuf_count_bad_refcnt, &nb_bad);
+	if (nb_bad != 0)
+		GOTO_FAIL("%u mbufs put back with a bad refcnt", nb_bad);
+
+	rte_mempool_free(mp);
+	rte_free(ext_mem.buf_ptr);
+	return 0;
+
+fail:
+	rte_pktmbuf_free(clone);
+	rte_mempool_free(mp);
+	rte_free(ext_mem.buf_ptr);
+	return -1;
+}
+
 #undef GOTO_FAIL
 
 /*
@@ -1126,6 +1510,26 @@ test_mbuf(void)
 		printf("test_mbuf_linearize_check() failed\n");
 		goto err;
 	}
+
+	if (test_pktmbuf_free_bulk(pktmbuf_pool, pktmbuf_pool2) < 0) {
+		printf("test_pktmbuf_free_bulk() failed\n");
+		goto err;
+	}
+
+	if (test_pktmbuf_fast_free() < 0) {
+		printf("test_pktmbuf_fast_free() failed\n");
+		goto err;
+	}
+
+	if (test_pktmbuf_bulk_perf(pktmbuf_pool) < 0) {
+		printf("test_pktmbuf_bulk_perf() failed\n");
+		goto err;
+	}
+
+	if (test_pktmbuf_pinned_extbuf(pktmbuf_pool) < 0) {
+		printf("test_pktmbuf_pinned_extbuf() failed\n");
+		goto err;
+	}
 	ret = 0;
 
 err:
@@ -44,7 +44,8 @@ static size_t buf_sizes[TEST_VALUE_RANGE];
  * changed.
  */
 static int
-test_single_memcpy(unsigned int off_src, unsigned int off_dst, size_t size)
+test_single_memcpy(unsigned int off_src, unsigned int off_dst, size_t size,
+		   int nt)
 {
 	unsigned int i;
 	uint8_t dest[SMALL_BUFFER_SIZE + ALIGNMENT_UNIT];
@@ -58,17 +59,22 @@ test_single_memcpy(unsigned int off_src, unsigned int off_dst, size_t size)
 	}
 
 	/* Do the copy */
-	ret = rte_memcpy(dest + off_dst, src + off_src, size);
+	if (nt)
+		ret = rte_memcpy_nt(dest + off_dst, src + off_src, size);
+	else
+		ret = rte_memcpy(dest + off_dst, src + off_src, size);
 	if (ret != (dest + off_dst)) {
-		printf("rte_memcpy() returned %p, not %p\n",
+		printf("%s() returned %p, not %p\n",
+		       nt ? "rte_memcpy_nt" : "rte_memcpy",
 		       ret, dest + off_dst);
 	}
 
 	/* Check nothing before offset is affected */
 	for (i = 0; i < off_dst; i++) {
 		if (dest[i] != 0) {
-			printf("rte_memcpy() failed for %u bytes (offsets=%u,%u): "
+			printf("%s() failed for %u bytes (offsets=%u,%u): "
 			       "[modified before start of dst].\n",
+			       nt ? "rte_memcpy_nt" : "rte_memcpy",
 			       (unsigned)size, off_src, off_dst);
 			return -1;
 		}
@@ -77,8 +83,9 @@ test_single_memcpy(unsigned int off_src, unsigned int off_dst, size_t size)
 	/* Check everything was copied */
 	for (i = 0; i < size; i++) {
 		if (dest[i + off_dst] != src[i + off_src]) {
-			printf("rte_memcpy() failed for %u bytes (offsets=%u,%u): "
+			printf("%s() failed for %u bytes (offsets=%u,%u): "
 			       "[didn't copy byte %u].\n",
+			       nt ? "rte_memcpy_nt" : "rte_memcpy",
 			       (unsigned)size, off_src, off_dst, i);
 			return -1;
 		}
@@ -87,8 +94,9 @@ test_single_memcpy(unsigned int off_src, unsigned int off_dst, size_t size)
 	/* Check nothing after copy was affected */
 	for (i = size; i < SMALL_BUFFER_SIZE; i++) {
 		if (dest[i + off_dst] != 0) {
-			printf("rte_memcpy() failed for %u bytes (offsets=%u,%u): "
+			printf("%s() failed for %u bytes (offsets=%u,%u): "
 			       "[copied too many].\n",
+			       nt ? "rte_memcpy_nt" : "rte_memcpy",
 			       (unsigned)size, off_src, off_dst);
 			return -1;
 		}
@@ -110,7 +118,11 @@ func_test(void)
 		for (off_dst = 0; off_dst < ALIGNMENT_UNIT; off_dst++) {
 			for (i = 0; i < num_buf_sizes; i++) {
 				ret = test_single_memcpy(off_src, off_dst,
-				                         buf_sizes[i]);
+				                         buf_sizes[i], 0);
+				if (ret != 0)
+					return -1;
+				ret = test_single_memcpy(off_src, off_dst,
+				                         buf_sizes[i], 1);
 				if (ret != 0)
 					return -1;
 			}
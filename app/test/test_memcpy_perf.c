@@ -50,6 +50,9 @@ static size_t buf_sizes[TEST_VALUE_RANGE];
 #define TEST_ITERATIONS         1000000
 #define TEST_BATCH_SIZE         100
 
+/* Smallest size for the non-temporal memcpy tests */
+#define NT_MIN_SIZE             256
+
 /* Data is aligned on this many bytes (power of 2) */
 #ifdef RTE_MACHINE_CPUFLAG_AVX512F
 #define ALIGNMENT_UNIT          64
@@ -220,6 +223,52 @@ do {                                                                     \
     SINGLE_PERF_TEST(large_buf_write, 0, 1, large_buf_read, 0, 5, n);    \
 } while (0)
 
+/*
+ * Run a single non-temporal memcpy performance test, compared to
+ * rte_memcpy().
+ */
+#define SINGLE_NT_PERF_TEST(dst, is_dst_cached, dst_uoffset,                \
+                            src, is_src_cached, src_uoffset, size)          \
+do {                                                                        \
+    unsigned int iter, t;                                                   \
+    size_t dst_addrs[TEST_BATCH_SIZE], src_addrs[TEST_BATCH_SIZE];          \
+    uint64_t start_time, total_time = 0;                                    \
+    uint64_t total_time2 = 0;                                               \
+    for (iter = 0; iter < (TEST_ITERATIONS / TEST_BATCH_SIZE); iter++) {    \
+        fill_addr_arrays(dst_addrs, is_dst_cached, dst_uoffset,             \
+                         src_addrs, is_src_cached, src_uoffset);            \
+        start_time = rte_rdtsc();                                           \
+        for (t = 0; t < TEST_BATCH_SIZE; t++)                               \
+            rte_memcpy_nt(dst+dst_addrs[t], src+src_addrs[t], size);        \
+        total_time += rte_rdtsc() - start_time;                             \
+    }                                                                       \
+    for (iter = 0; iter < (TEST_ITERATIONS / TEST_BATCH_SIZE); iter++) {    \
+        fill_addr_arrays(dst_addrs, is_dst_cached, dst_uoffset,             \
+                         src_addrs, is_src_cached, src_uoffset);            \
+        start_time = rte_rdtsc();                                           \
+        for (t = 0; t < TEST_BATCH_SIZE; t++)                               \
+            rte_memcpy(dst+dst_addrs[t], src+src_addrs[t], size);           \
+        total_time2 += rte_rdtsc() - start_time;                            \
+    }                                                                       \
+    printf("%3.0f -", (double)total_time  / TEST_ITERATIONS);                 \
+    printf("%3.0f",   (double)total_time2 / TEST_ITERATIONS);                 \
+    printf("(%6.2f%%) ", ((double)total_time - total_time2)*100/total_time2); \
+} while (0)
+
+/* Run non-temporal memcpy tests for each cached/uncached permutation */
+#define ALL_NT_PERF_TESTS_FOR_SIZE(n, dst_uoffset, src_uoffset)                \
+do {                                                                           \
+    printf("\n%7u", (unsigned)n);                                              \
+    SINGLE_NT_PERF_TEST(small_buf_write, 1, dst_uoffset,                       \
+                        small_buf_read, 1, src_uoffset, n);                    \
+    SINGLE_NT_PERF_TEST(large_buf_write, 0, dst_uoffset,                       \
+                        small_buf_read, 1, src_uoffset, n);                    \
+    SINGLE_NT_PERF_TEST(small_buf_write, 1, dst_uoffset,                       \
+                        large_buf_read, 0, src_uoffset, n);                    \
+    SINGLE_NT_PERF_TEST(large_buf_write, 0, dst_uoffset,                       \
+                        large_buf_read, 0, src_uoffset, n);                    \
+} while (0)
+
 /* Run memcpy tests for constant length */
 #define ALL_PERF_TEST_FOR_CONSTANT                                      \
 do {                                                                    \
@@ -268,6 +317,23 @@ perf_test_variable_unaligned(void)
 	}
 }
 
+/*
+ * Run all non-temporal memcpy tests for the variable sizes which are large
+ * enough to bypass the caches.
+ */
+static inline void
+perf_test_nt(size_t dst_uoffset, size_t src_uoffset)
+{
+	unsigned n = sizeof(buf_sizes) / sizeof(buf_sizes[0]);
+	unsigned i;
+	for (i = 0; i < n; i++) {
+		if (buf_sizes[i] < NT_MIN_SIZE)
+			continue;
+		ALL_NT_PERF_TESTS_FOR_SIZE((size_t)buf_sizes[i],
+				dst_uoffset, src_uoffset);
+	}
+}
+
 /* Run all memcpy tests */
 static int
 perf_test(void)
@@ -276,6 +342,7 @@ perf_test(void)
 	struct timeval tv_begin, tv_end;
 	double time_aligned, time_unaligned;
 	double time_aligned_const, time_unaligned_const;
+	double time_nt_aligned, time_nt_unaligned;
 
 	ret = init_buffers();
 	if (ret != 0)
@@ -328,11 +395,33 @@ perf_test(void)
 		+ ((double)tv_end.tv_usec - tv_begin.tv_usec)/1000000;
 	printf("\n======= ================= ================= ================= =================\n\n");
 
+	printf("** rte_memcpy_nt() - rte_memcpy() perf. tests **\n"
+		   "======= ================= ================= ================= =================\n"
+		   "   Size   Cache to cache     Cache to mem      Mem to cache        Mem to mem\n"
+		   "(bytes)          (ticks)          (ticks)           (ticks)           (ticks)\n"
+		   "------- ----------------- ----------------- ----------------- -----------------");
+	printf("\n================================= %2dB aligned =================================",
+		ALIGNMENT_UNIT);
+	gettimeofday(&tv_begin, NULL);
+	perf_test_nt(0, 0);
+	gettimeofday(&tv_end, NULL);
+	time_nt_aligned = (double)(tv_end.tv_sec - tv_begin.tv_sec)
+		+ ((double)tv_end.tv_usec - tv_begin.tv_usec)/1000000;
+	printf("\n================================== Unaligned ==================================");
+	gettimeofday(&tv_begin, NULL);
+	perf_test_nt(1, 5);
+	gettimeofday(&tv_end, NULL);
+	time_nt_unaligned = (double)(tv_end.tv_sec - tv_begin.tv_sec)
+		+ ((double)tv_end.tv_usec - tv_begin.tv_usec)/1000000;
+	printf("\n======= ================= ================= ================= =================\n\n");
+
 	printf("Test Execution Time (seconds):\n");
 	printf("Aligned variable copy size   = %8.3f\n", time_aligned);
 	printf("Aligned constant copy size   = %8.3f\n", time_aligned_const);
 	printf("Unaligned variable copy size = %8.3f\n", time_unaligned);
 	printf("Unaligned constant copy size = %8.3f\n", time_unaligned_const);
+	printf("Aligned non-temporal copy    = %8.3f\n", time_nt_aligned);
+	printf("Unaligned non-temporal copy  = %8.3f\n", time_nt_unaligned);
 	free_buffers();
 
 	return 0;
@@ -447,6 +447,168 @@ test_mempool_same_name_twice_creation(void)
 	return 0;
 }
 
+/*
+ * check that an adaptive cache grows under bulks larger than its size,
+ * then shrinks and gives its objects back when most of it is unused
+ */
+static int
+test_mempool_cache_adaptive(void)
+{
+	struct rte_mempool_cache_stats stats;
+	struct rte_mempool_cache *cache;
+	struct rte_mempool *mp;
+	void *objs[RTE_MEMPOOL_CACHE_MAX_SIZE];
+	unsigned int bulk = RTE_MEMPOOL_CACHE_MAX_SIZE / 8;
+	uint32_t size;
+	unsigned int i;
+	int ret = -1;
+
+	mp = rte_mempool_create("test_cache_adaptive", MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE, RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+		NULL, NULL, my_obj_init, NULL,
+		SOCKET_ID_ANY, MEMPOOL_F_CACHE_ADAPTIVE);
+	if (mp == NULL)
+		RET_ERR();
+
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	if (cache == NULL)
+		GOTO_ERR(ret, exit);
+
+	/* bulks as large as the cache always reach the common pool */
+	if (cache->size != bulk)
+		GOTO_ERR(ret, exit);
+	for (i = 0; i < 4 * RTE_MEMPOOL_CACHE_ADAPT_WINDOW; i++) {
+		if (rte_mempool_get_bulk(mp, objs, bulk) < 0)
+			GOTO_ERR(ret, exit);
+		rte_mempool_put_bulk(mp, objs, bulk);
+	}
+
+	if (rte_mempool_cache_stats_get(mp, rte_lcore_id(), &stats) < 0)
+		GOTO_ERR(ret, exit);
+	if (stats.grow == 0 || cache->size <= bulk)
+		GOTO_ERR(ret, exit);
+	if (cache->len > cache->flushthresh)
+		GOTO_ERR(ret, exit);
+
+	/* fill the cache, then only touch its top with single objects */
+	size = cache->size;
+	if (rte_mempool_get_bulk(mp, objs, size - 1) < 0)
+		GOTO_ERR(ret, exit);
+	rte_mempool_put_bulk(mp, objs, size - 1);
+	for (i = 0; i < 4 * RTE_MEMPOOL_CACHE_ADAPT_WINDOW; i++) {
+		if (rte_mempool_get(mp, &objs[0]) < 0)
+			GOTO_ERR(ret, exit);
+		rte_mempool_put(mp, objs[0]);
+	}
+
+	if (rte_mempool_cache_stats_get(mp, LCORE_ID_ANY, &stats) < 0)
+		GOTO_ERR(ret, exit);
+	if (stats.shrink == 0 || cache->size >= size)
+		GOTO_ERR(ret, exit);
+	if (cache->len > cache->size || stats.get_hit == 0)
+		GOTO_ERR(ret, exit);
+
+	rte_mempool_cache_stats_reset(mp);
+	if (test_mempool_basic(mp, 0) < 0)
+		GOTO_ERR(ret, exit);
+
+	ret = 0;
+
+exit:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+/*
+ * check that contiguous objects come from a single block on the bucket
+ * handler, virtually contiguous, and that handlers without blocks fall
+ * back to the bulk path
+ */
+static int
+test_mempool_contig_objs(void)
+{
+	void *objs[MAX_KEEP];
+	struct rte_mempool_info info;
+	struct rte_mempool *mp_ring = NULL, *mp_bucket = NULL;
+	size_t total_elt_sz;
+	unsigned int i, n;
+	void *first_obj;
+	int ret = -1;
+
+	mp_ring = rte_mempool_create("test_contig_ring", MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE, 0, 0, NULL, NULL, my_obj_init, NULL,
+		SOCKET_ID_ANY, 0);
+	if (mp_ring == NULL)
+		GOTO_ERR(ret, exit);
+
+	/* no block support: blocks are refused, objects are still given */
+	if (rte_mempool_get_contig_blocks(mp_ring, &first_obj, 1) !=
+			-EOPNOTSUPP)
+		GOTO_ERR(ret, exit);
+	if (rte_mempool_get_contig_objs(mp_ring, objs, MAX_KEEP) != 0)
+		GOTO_ERR(ret, exit);
+	rte_mempool_put_bulk(mp_ring, objs, MAX_KEEP);
+	if (rte_mempool_get_contig_objs(mp_ring, objs, 1) != 1)
+		GOTO_ERR(ret, exit);
+	rte_mempool_put(mp_ring, objs[0]);
+	if (rte_mempool_avail_count(mp_ring) != mp_ring->size)
+		GOTO_ERR(ret, exit);
+
+	mp_bucket = rte_mempool_create_empty("test_contig_bucket",
+		MEMPOOL_SIZE, MEMPOOL_ELT_SIZE, 0, 0, SOCKET_ID_ANY, 0);
+	if (mp_bucket == NULL)
+		GOTO_ERR(ret, exit);
+	if (rte_mempool_set_ops_byname(mp_bucket, "bucket", NULL) < 0) {
+		printf("bucket handler not available, skipping\n");
+		ret = 0;
+		goto exit;
+	}
+	if (rte_mempool_populate_default(mp_bucket) < 0) {
+		/* buckets do not fit in the small pages used without hugepages */
+		if (!rte_eal_has_hugepages()) {
+			printf("bucket pool cannot be populated, skipping\n");
+			ret = 0;
+			goto exit;
+		}
+		GOTO_ERR(ret, exit);
+	}
+	rte_mempool_obj_iter(mp_bucket, my_obj_init, NULL);
+
+	if (rte_mempool_ops_get_info(mp_bucket, &info) < 0 ||
+			info.contig_block_size < 2)
+		GOTO_ERR(ret, exit);
+
+	total_elt_sz = mp_bucket->header_size + mp_bucket->elt_size +
+		mp_bucket->trailer_size;
+	n = RTE_MIN(info.contig_block_size - 1, (unsigned int)MAX_KEEP);
+	if (rte_mempool_get_contig_objs(mp_bucket, objs, n) != 1)
+		GOTO_ERR(ret, exit);
+	/* only virtual contiguity is guaranteed, not IOVA contiguity */
+	for (i = 1; i < n; i++) {
+		if (objs[i] != RTE_PTR_ADD(objs[0], i * total_elt_sz))
+			GOTO_ERR(ret, exit);
+	}
+	rte_mempool_put_bulk(mp_bucket, objs, n);
+
+	/* larger than a block: served by the bulk path */
+	if (info.contig_block_size < MAX_KEEP) {
+		n = info.contig_block_size + 1;
+		if (rte_mempool_get_contig_objs(mp_bucket, objs, n) != 0)
+			GOTO_ERR(ret, exit);
+		rte_mempool_put_bulk(mp_bucket, objs, n);
+	}
+
+	if (rte_mempool_avail_count(mp_bucket) != mp_bucket->size)
+		GOTO_ERR(ret, exit);
+
+	ret = 0;
+
+exit:
+	rte_mempool_free(mp_bucket);
+	rte_mempool_free(mp_ring);
+	return ret;
+}
+
 static void
 walk_cb(struct rte_mempool *mp, void *userdata __rte_unused)
 {
@@ -571,6 +733,12 @@ test_mempool(void)
 	if (test_mempool_same_name_twice_creation() < 0)
 		goto err;
 
+	if (test_mempool_cache_adaptive() < 0)
+		goto err;
+
+	if (test_mempool_contig_objs() < 0)
+		goto err;
+
 	/* test the stack handler */
 	if (test_mempool_basic(mp_stack, 1) < 0)
 		goto err;
@@ -279,12 +279,44 @@ do_one_mempool_test(struct rte_mempool *mp, unsigned int cores)
 	return 0;
 }
 
+/* create an uncached mempool using the given handler */
+static struct rte_mempool *
+create_mempool_with_ops(const char *name, const char *ops)
+{
+	struct rte_mempool *mp;
+
+	mp = rte_mempool_create_empty(name, MEMPOOL_SIZE, MEMPOOL_ELT_SIZE,
+				      0, 0, SOCKET_ID_ANY, 0);
+	if (mp == NULL) {
+		printf("cannot allocate %s mempool\n", ops);
+		return NULL;
+	}
+
+	if (rte_mempool_set_ops_byname(mp, ops, NULL) < 0) {
+		printf("cannot set %s handler\n", ops);
+		rte_mempool_free(mp);
+		return NULL;
+	}
+
+	if (rte_mempool_populate_default(mp) < 0) {
+		printf("cannot populate %s mempool\n", ops);
+		rte_mempool_free(mp);
+		return NULL;
+	}
+
+	rte_mempool_obj_iter(mp, my_obj_init, NULL);
+
+	return mp;
+}
+
 static int
 test_mempool_perf(void)
 {
 	struct rte_mempool *mp_cache = NULL;
 	struct rte_mempool *mp_nocache = NULL;
 	struct rte_mempool *default_pool = NULL;
+	struct rte_mempool *stack_pool = NULL;
+	struct rte_mempool *lf_stack_pool = NULL;
 	const char *default_pool_ops;
 	int ret = -1;
 
@@ -335,6 +367,18 @@ test_mempool_perf(void)
 
 	rte_mempool_obj_iter(default_pool, my_obj_init, NULL);
 
+	/* stack handlers, to compare against the default (ring) one */
+	stack_pool = create_mempool_with_ops("perf_test_stack", "stack");
+	if (stack_pool == NULL)
+		goto err;
+
+#if defined(RTE_ARCH_X86_64) || defined(RTE_ARCH_ARM64)
+	lf_stack_pool = create_mempool_with_ops("perf_test_lf_stack",
+						"lf_stack");
+	if (lf_stack_pool == NULL)
+		goto err;
+#endif
+
 	/* performance test with 1, 2 and max cores */
 	printf("start performance test (without cache)\n");
 
@@ -360,6 +404,33 @@ test_mempool_perf(void)
 	if (do_one_mempool_test(default_pool, rte_lcore_count()) < 0)
 		goto err;
 
+	/* performance test with 1, 2 and max cores */
+	printf("start performance test for stack (without cache)\n");
+
+	if (do_one_mempool_test(stack_pool, 1) < 0)
+		goto err;
+
+	if (do_one_mempool_test(stack_pool, 2) < 0)
+		goto err;
+
+	if (do_one_mempool_test(stack_pool, rte_lcore_count()) < 0)
+		goto err;
+
+	if (lf_stack_pool != NULL) {
+		/* performance test with 1, 2 and max cores */
+		printf("start performance test for lf_stack (without cache)\n");
+
+		if (do_one_mempool_test(lf_stack_pool, 1) < 0)
+			goto err;
+
+		if (do_one_mempool_test(lf_stack_pool, 2) < 0)
+			goto err;
+
+		if (do_one_mempool_test(lf_stack_pool,
+					rte_lcore_count()) < 0)
+			goto err;
+	}
+
 	/* performance test with 1, 2 and max cores */
 	printf("start performance test (with cache)\n");
 
@@ -393,6 +464,8 @@ test_mempool_perf(void)
 	rte_mempool_free(mp_cache);
 	rte_mempool_free(mp_nocache);
 	rte_mempool_free(default_pool);
+	rte_mempool_free(stack_pool);
+	rte_mempool_free(lf_stack_pool);
 	return ret;
 }
 
@@ -0,0 +1,362 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include <rte_rcu_qsbr.h>
+#include <rte_atomic.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+
+#include "test.h"
+
+/*
+ * RCU QSBR autotest
+ * =================
+ *
+ * - invalid parameters of the quiescent state variable APIs
+ * - registration of the reader threads
+ * - token acknowledgement: online threads must report a quiescent state,
+ *   offline ones are not waited for
+ * - defer queue: resources are only freed after the grace period, in
+ *   their order of deletion
+ * - readers on all the worker lcores dereference a shared element while the
+ *   master lcore replaces it and waits for a grace period before freeing the
+ *   old one; a reader must never see a freed element
+ */
+
+#define TEST_RCU_MAX_LCORE RTE_MAX_LCORE
+#define TEST_RCU_DQ_SIZE 8
+#define TEST_RCU_NUM_UPDATES 64
+
+#define TEST_RCU_ELEM_VALID 0x600DF00D
+#define TEST_RCU_ELEM_FREED 0xDEADBEEF
+
+static struct rte_rcu_qsbr *t;
+
+/* Resources freed by the defer queue callback */
+static uint32_t freed_elems[TEST_RCU_DQ_SIZE * 2];
+static unsigned int num_freed;
+
+struct test_rcu_elem {
+	uint32_t magic;
+};
+
+static struct test_rcu_elem *shared_elem;
+static volatile int writer_done;
+static rte_atomic32_t reader_errors;
+
+static int
+testsuite_setup(void)
+{
+	t = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(TEST_RCU_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	if (t == NULL)
+		return -1;
+
+	return 0;
+}
+
+static void
+testsuite_teardown(void)
+{
+	rte_free(t);
+}
+
+static int
+ut_setup(void)
+{
+	return rte_rcu_qsbr_init(t, TEST_RCU_MAX_LCORE) == 0 ? 0 : -1;
+}
+
+static void
+test_rcu_free_resource(void *p, void *e, unsigned int n)
+{
+	unsigned int i;
+
+	RTE_SET_USED(p);
+
+	for (i = 0; i < n; i++)
+		freed_elems[num_freed++] = ((uint32_t *)e)[i];
+}
+
+static int
+test_rcu_qsbr_params(void)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_get_memsize(0), 1,
+			"get_memsize accepted 0 threads");
+	TEST_ASSERT(rte_rcu_qsbr_get_memsize(1) > sizeof(struct rte_rcu_qsbr),
+			"get_memsize too small");
+
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_init(NULL, TEST_RCU_MAX_LCORE), 1,
+			"init accepted a NULL variable");
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_init(t, 0), 1,
+			"init accepted 0 threads");
+
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_thread_register(NULL, 0), 1,
+			"register accepted a NULL variable");
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_thread_register(t, TEST_RCU_MAX_LCORE),
+			1, "register accepted an invalid thread ID");
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_thread_unregister(t, TEST_RCU_MAX_LCORE),
+			1, "unregister accepted an invalid thread ID");
+
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_dump(NULL, t), 1,
+			"dump accepted a NULL file");
+
+	TEST_ASSERT_NULL(rte_rcu_qsbr_dq_create(NULL),
+			"defer queue created without parameters");
+	params.name = "TEST_RCU";
+	params.size = TEST_RCU_DQ_SIZE;
+	params.esize = sizeof(uint32_t);
+	params.free_fn = test_rcu_free_resource;
+	TEST_ASSERT_NULL(rte_rcu_qsbr_dq_create(&params),
+			"defer queue created without variable");
+	params.v = t;
+	params.esize = 3;
+	TEST_ASSERT_NULL(rte_rcu_qsbr_dq_create(&params),
+			"defer queue created with an unaligned element");
+	params.esize = sizeof(uint32_t);
+	TEST_ASSERT_NULL(rte_rcu_qsbr_dq_create(&params),
+			"defer queue created with auto reclaim of 0 resources");
+
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_dq_enqueue(NULL, &params), 1,
+			"enqueue accepted a NULL queue");
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_dq_reclaim(NULL, 1, NULL, NULL, NULL),
+			1, "reclaim accepted a NULL queue");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rcu_qsbr_register(void)
+{
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_register(t, 0),
+			"register failed");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_register(t, 0),
+			"register twice failed");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_register(t, 65),
+			"register in second bitmap element failed");
+	TEST_ASSERT_EQUAL(t->num_threads, 2, "wrong number of threads");
+
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dump(stdout, t), "dump failed");
+
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_unregister(t, 0),
+			"unregister failed");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_unregister(t, 0),
+			"unregister twice failed");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_thread_unregister(t, 65),
+			"unregister in second bitmap element failed");
+	TEST_ASSERT_EQUAL(t->num_threads, 0, "wrong number of threads");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rcu_qsbr_check(void)
+{
+	uint64_t token;
+
+	/* No registered reader, the grace period is over right away */
+	token = rte_rcu_qsbr_start(t);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, false), 1,
+			"check failed without readers");
+
+	rte_rcu_qsbr_thread_register(t, 0);
+	rte_rcu_qsbr_thread_register(t, 100);
+	rte_rcu_qsbr_thread_online(t, 0);
+	rte_rcu_qsbr_thread_online(t, 100);
+
+	token = rte_rcu_qsbr_start(t);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, false), 0,
+			"check succeeded before any quiescent state");
+	rte_rcu_qsbr_quiescent(t, 0);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, false), 0,
+			"check succeeded with a reader still active");
+	rte_rcu_qsbr_quiescent(t, 100);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, false), 1,
+			"check failed after all the quiescent states");
+
+	/* An offline reader is not waited for */
+	token = rte_rcu_qsbr_start(t);
+	rte_rcu_qsbr_thread_offline(t, 100);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, false), 0,
+			"check succeeded with a reader still active");
+	rte_rcu_qsbr_quiescent(t, 0);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_check(t, token, true), 1,
+			"check failed with an offline reader");
+
+	/* The writer may be a reader itself */
+	rte_rcu_qsbr_synchronize(t, 0);
+
+	rte_rcu_qsbr_thread_offline(t, 0);
+	rte_rcu_qsbr_thread_unregister(t, 0);
+	rte_rcu_qsbr_thread_unregister(t, 100);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rcu_qsbr_dq(void)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	unsigned int freed, pending, available;
+	struct rte_rcu_qsbr_dq *dq;
+	uint32_t i;
+
+	params.name = "TEST_RCU";
+	params.size = TEST_RCU_DQ_SIZE;
+	params.esize = sizeof(uint32_t);
+	/* no automatic reclamation */
+	params.trigger_reclaim_limit = TEST_RCU_DQ_SIZE + 1;
+	params.free_fn = test_rcu_free_resource;
+	params.v = t;
+	dq = rte_rcu_qsbr_dq_create(&params);
+	TEST_ASSERT_NOT_NULL(dq, "defer queue create failed");
+
+	num_freed = 0;
+	rte_rcu_qsbr_thread_register(t, 0);
+	rte_rcu_qsbr_thread_online(t, 0);
+
+	/* The oldest resource is held out of the ring when it is full */
+	for (i = 0; i < TEST_RCU_DQ_SIZE + 1; i++)
+		TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_enqueue(dq, &i),
+				"enqueue %u failed", i);
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_dq_enqueue(dq, &i), 1,
+			"enqueue succeeded in a full queue");
+	TEST_ASSERT_EQUAL(rte_errno, ENOSPC, "wrong error");
+
+	/* The reader did not report its quiescent state */
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_reclaim(dq, TEST_RCU_DQ_SIZE,
+			&freed, &pending, &available), "reclaim failed");
+	TEST_ASSERT_EQUAL(freed, 0, "resource freed before the grace period");
+	TEST_ASSERT_EQUAL(pending, TEST_RCU_DQ_SIZE + 1, "wrong pending count");
+	TEST_ASSERT_EQUAL(available, 0, "wrong available count");
+	TEST_ASSERT_EQUAL(rte_rcu_qsbr_dq_delete(dq), 1,
+			"queue deleted with pending resources");
+	TEST_ASSERT_EQUAL(rte_errno, EAGAIN, "wrong error");
+
+	rte_rcu_qsbr_quiescent(t, 0);
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_reclaim(dq, TEST_RCU_DQ_SIZE / 2,
+			&freed, &pending, &available), "reclaim failed");
+	TEST_ASSERT_EQUAL(freed, TEST_RCU_DQ_SIZE / 2, "wrong freed count");
+	TEST_ASSERT_EQUAL(pending, TEST_RCU_DQ_SIZE / 2 + 1,
+			"wrong pending count");
+	TEST_ASSERT_EQUAL(available, TEST_RCU_DQ_SIZE / 2 - 1,
+			"wrong available count");
+
+	/* A resource deleted after the quiescent state is kept */
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_enqueue(dq, &i), "enqueue failed");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_reclaim(dq, TEST_RCU_DQ_SIZE,
+			&freed, &pending, NULL), "reclaim failed");
+	TEST_ASSERT_EQUAL(freed, TEST_RCU_DQ_SIZE / 2 + 1, "wrong freed count");
+	TEST_ASSERT_EQUAL(pending, 1, "wrong pending count");
+
+	rte_rcu_qsbr_quiescent(t, 0);
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_dq_delete(dq), "delete failed");
+
+	TEST_ASSERT_EQUAL(num_freed, TEST_RCU_DQ_SIZE + 2, "wrong freed count");
+	for (i = 0; i < num_freed; i++)
+		TEST_ASSERT_EQUAL(freed_elems[i], i, "resource freed out of order");
+
+	rte_rcu_qsbr_thread_offline(t, 0);
+	rte_rcu_qsbr_thread_unregister(t, 0);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rcu_qsbr_reader(__attribute__((unused)) void *arg)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct test_rcu_elem *e;
+
+	rte_rcu_qsbr_thread_register(t, lcore_id);
+	rte_rcu_qsbr_thread_online(t, lcore_id);
+
+	while (!writer_done) {
+		e = __atomic_load_n(&shared_elem, __ATOMIC_ACQUIRE);
+		if (e->magic != TEST_RCU_ELEM_VALID)
+			rte_atomic32_inc(&reader_errors);
+
+		rte_rcu_qsbr_quiescent(t, lcore_id);
+	}
+
+	rte_rcu_qsbr_thread_offline(t, lcore_id);
+	rte_rcu_qsbr_thread_unregister(t, lcore_id);
+
+	return 0;
+}
+
+static int
+test_rcu_qsbr_readers_writer(void)
+{
+	struct test_rcu_elem *e, *old;
+	unsigned int i;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough cores for %s, expecting at least 2\n",
+		       __func__);
+		return TEST_SKIPPED;
+	}
+
+	shared_elem = rte_zmalloc(NULL, sizeof(*shared_elem), 0);
+	TEST_ASSERT_NOT_NULL(shared_elem, "element allocation failed");
+	shared_elem->magic = TEST_RCU_ELEM_VALID;
+	writer_done = 0;
+	rte_atomic32_clear(&reader_errors);
+
+	rte_eal_mp_remote_launch(test_rcu_qsbr_reader, NULL, SKIP_MASTER);
+
+	for (i = 0; i < TEST_RCU_NUM_UPDATES; i++) {
+		e = rte_zmalloc(NULL, sizeof(*e), 0);
+		if (e == NULL)
+			break;
+		e->magic = TEST_RCU_ELEM_VALID;
+
+		old = __atomic_exchange_n(&shared_elem, e, __ATOMIC_ACQ_REL);
+
+		/* Wait for the readers of the old element */
+		rte_rcu_qsbr_synchronize(t, RTE_QSBR_THRID_INVALID);
+		old->magic = TEST_RCU_ELEM_FREED;
+		rte_free(old);
+	}
+
+	writer_done = 1;
+	rte_eal_mp_wait_lcore();
+	rte_free(shared_elem);
+
+	TEST_ASSERT_EQUAL(i, TEST_RCU_NUM_UPDATES, "element allocation failed");
+	TEST_ASSERT_EQUAL(rte_atomic32_read(&reader_errors), 0,
+			"readers accessed freed elements");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite rcu_qsbr_testsuite = {
+	.suite_name = "RCU QSBR autotest",
+	.setup = testsuite_setup,
+	.teardown = testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_rcu_qsbr_params),
+		TEST_CASE_ST(ut_setup, NULL, test_rcu_qsbr_register),
+		TEST_CASE_ST(ut_setup, NULL, test_rcu_qsbr_check),
+		TEST_CASE_ST(ut_setup, NULL, test_rcu_qsbr_dq),
+		TEST_CASE_ST(ut_setup, NULL, test_rcu_qsbr_readers_writer),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_rcu_qsbr(void)
+{
+	return unit_test_suite_runner(&rcu_qsbr_testsuite);
+}
+
+REGISTER_TEST_COMMAND(rcu_qsbr_autotest, test_rcu_qsbr);
@@ -0,0 +1,444 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <rte_memory.h>
+#include <rte_rib6.h>
+
+#include "test.h"
+
+static int32_t test_create_invalid(void);
+static int32_t test_multiple_create(void);
+static int32_t test_free_null(void);
+static int32_t test_insert_invalid(void);
+static int32_t test_get_fn(void);
+static int32_t test_basic(void);
+static int32_t test_tree_traversal(void);
+
+#define MAX_DEPTH 128
+#define MAX_RULES (1 << 16)
+
+/* 2001:db8:<a>:<b>::<c> */
+#define IPV6_DOC(a, b, c) { 0x20, 0x01, 0x0d, 0xb8,		\
+	((a) >> 8) & 0xff, (a) & 0xff, ((b) >> 8) & 0xff, (b) & 0xff,	\
+	0, 0, 0, 0, 0, 0, ((c) >> 8) & 0xff, (c) & 0xff }
+
+/*
+ * Check that rte_rib6_create fails gracefully for incorrect user input
+ * arguments
+ */
+int32_t
+test_create_invalid(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_conf config;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	/* rte_rib6_create: rib name == NULL */
+	rib = rte_rib6_create(NULL, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_rib6_create: config == NULL */
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, NULL);
+	RTE_TEST_ASSERT(rib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_rib6_create: max_nodes = 0 */
+	config.max_nodes = 0;
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.max_nodes = MAX_RULES;
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Create rib table then delete rib table 10 times
+ * Use a slightly different rules size each time
+ */
+int32_t
+test_multiple_create(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_conf config;
+	int32_t i;
+
+	config.ext_sz = 0;
+
+	for (i = 0; i < 10; i++) {
+		config.max_nodes = MAX_RULES - i;
+		rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+		rte_rib6_free(rib);
+	}
+	/* Can not test free so return success */
+	return TEST_SUCCESS;
+}
+
+/*
+ * Call rte_rib6_free for NULL pointer user input. Note: free has no return
+ * and therefore it is impossible to check for failure but this test is added
+ * to increase function coverage metrics and to validate that freeing null
+ * does not crash.
+ */
+int32_t
+test_free_null(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_conf config;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+
+	rte_rib6_free(rib);
+	rte_rib6_free(NULL);
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_rib6_insert fails gracefully for incorrect user input
+ * arguments
+ */
+int32_t
+test_insert_invalid(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_node *node, *node1;
+	struct rte_rib6_conf config;
+	uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE] = {0};
+	uint8_t depth = 24;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	/* rte_rib6_insert: rib == NULL */
+	node = rte_rib6_insert(NULL, ip, depth);
+	RTE_TEST_ASSERT(node == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/*Create valid rib to use in rest of test. */
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+
+	/* rte_rib6_insert: ip == NULL */
+	node = rte_rib6_insert(rib, NULL, depth);
+	RTE_TEST_ASSERT(node == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_rib6_insert: depth > MAX_DEPTH */
+	node = rte_rib6_insert(rib, ip, MAX_DEPTH + 1);
+	RTE_TEST_ASSERT(node == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* insert the same ip/depth twice*/
+	node = rte_rib6_insert(rib, ip, depth);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+	node1 = rte_rib6_insert(rib, ip, depth);
+	RTE_TEST_ASSERT(node1 == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	rte_rib6_free(rib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Call rte_rib6_node access functions with incorrect input.
+ * After call rte_rib6_node access functions with correct args
+ * and check the return values for correctness
+ */
+int32_t
+test_get_fn(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_node *node;
+	struct rte_rib6_conf config;
+	void *ext;
+	uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE] = IPV6_DOC(0, 0, 0);
+	uint8_t ip_ret[RTE_RIB6_IPV6_ADDR_SIZE];
+	uint64_t nh_set = 10;
+	uint64_t nh_ret;
+	uint8_t depth = 48;
+	uint8_t depth_ret;
+	int ret;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 1;
+
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+
+	node = rte_rib6_insert(rib, ip, depth);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+
+	/* test rte_rib6_get_ip() with incorrect args */
+	ret = rte_rib6_get_ip(NULL, ip_ret);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+	ret = rte_rib6_get_ip(node, NULL);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* test rte_rib6_get_depth() with incorrect args */
+	ret = rte_rib6_get_depth(NULL, &depth_ret);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+	ret = rte_rib6_get_depth(node, NULL);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* test rte_rib6_set_nh() with incorrect args */
+	ret = rte_rib6_set_nh(NULL, nh_set);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* test rte_rib6_get_nh() with incorrect args */
+	ret = rte_rib6_get_nh(NULL, &nh_ret);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+	ret = rte_rib6_get_nh(node, NULL);
+	RTE_TEST_ASSERT(ret < 0,
+		"Call succeeded with invalid parameters\n");
+
+	/* test rte_rib6_get_ext() with incorrect args */
+	ext = rte_rib6_get_ext(NULL);
+	RTE_TEST_ASSERT(ext == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* check the return values */
+	ret = rte_rib6_get_ip(node, ip_ret);
+	RTE_TEST_ASSERT((ret == 0) && rte_rib6_is_equal(ip_ret, ip),
+		"Failed to get proper node ip\n");
+	ret = rte_rib6_get_depth(node, &depth_ret);
+	RTE_TEST_ASSERT((ret == 0) && (depth_ret == depth),
+		"Failed to get proper node depth\n");
+	ret = rte_rib6_set_nh(node, nh_set);
+	RTE_TEST_ASSERT(ret == 0,
+		"Failed to set rte_rib6_node nexthop\n");
+	ret = rte_rib6_get_nh(node, &nh_ret);
+	RTE_TEST_ASSERT((ret == 0) && (nh_ret == nh_set),
+		"Failed to get proper nexthop\n");
+
+	rte_rib6_free(rib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Call insert, lookup/lookup_exact and delete for a single rule
+ */
+int32_t
+test_basic(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_node *node;
+	struct rte_rib6_conf config;
+
+	uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE] = IPV6_DOC(1, 2, 3);
+	uint64_t next_hop_add = 10;
+	uint64_t next_hop_return;
+	uint8_t depth = 128;
+	int ret;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+
+	node = rte_rib6_insert(rib, ip, depth);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+
+	ret = rte_rib6_set_nh(node, next_hop_add);
+	RTE_TEST_ASSERT(ret == 0,
+		"Failed to set rte_rib6_node field\n");
+
+	node = rte_rib6_lookup(rib, ip);
+	RTE_TEST_ASSERT(node != NULL, "Failed to lookup\n");
+
+	ret = rte_rib6_get_nh(node, &next_hop_return);
+	RTE_TEST_ASSERT((ret == 0) && (next_hop_add == next_hop_return),
+		"Failed to get proper nexthop\n");
+
+	node = rte_rib6_lookup_exact(rib, ip, depth);
+	RTE_TEST_ASSERT(node != NULL,
+		"Failed to lookup\n");
+
+	ret = rte_rib6_get_nh(node, &next_hop_return);
+	RTE_TEST_ASSERT((ret == 0) && (next_hop_add == next_hop_return),
+		"Failed to get proper nexthop\n");
+
+	rte_rib6_remove(rib, ip, depth);
+
+	node = rte_rib6_lookup(rib, ip);
+	RTE_TEST_ASSERT(node == NULL,
+		"Lookup returns non existent rule\n");
+	node = rte_rib6_lookup_exact(rib, ip, depth);
+	RTE_TEST_ASSERT(node == NULL,
+		"Lookup returns non existent rule\n");
+
+	rte_rib6_free(rib);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check the longest prefix match, the parent of the routes and the removal
+ * of a route keeping its intermediate node
+ */
+int32_t
+test_tree_traversal(void)
+{
+	struct rte_rib6 *rib = NULL;
+	struct rte_rib6_node *node, *parent;
+	struct rte_rib6_conf config;
+	const uint8_t ips[][RTE_RIB6_IPV6_ADDR_SIZE] = {
+		IPV6_DOC(0, 0, 0),		/* /32 */
+		IPV6_DOC(1, 0, 0),		/* /48 */
+		IPV6_DOC(1, 2, 0),		/* /64 */
+		IPV6_DOC(1, 2, 0x80),		/* /121 */
+		IPV6_DOC(0x8000, 0, 0),		/* /33 */
+		IPV6_DOC(2, 0, 0),		/* /48 */
+	};
+	const uint8_t depths[] = {32, 48, 64, 121, 33, 48};
+	/* more specific routes of 2001:db8::/32 in increasing order */
+	const uint8_t all_ips[][RTE_RIB6_IPV6_ADDR_SIZE] = {
+		IPV6_DOC(1, 0, 0), IPV6_DOC(1, 2, 0), IPV6_DOC(1, 2, 0x80),
+		IPV6_DOC(2, 0, 0), IPV6_DOC(0x8000, 0, 0)
+	};
+	/* routes of 2001:db8::/32 not covered by another one */
+	const uint8_t cover_ips[][RTE_RIB6_IPV6_ADDR_SIZE] = {
+		IPV6_DOC(1, 0, 0), IPV6_DOC(2, 0, 0), IPV6_DOC(0x8000, 0, 0)
+	};
+	const uint8_t ip_121[RTE_RIB6_IPV6_ADDR_SIZE] = IPV6_DOC(1, 2, 0xc8);
+	const uint8_t ip_64[RTE_RIB6_IPV6_ADDR_SIZE] = IPV6_DOC(1, 2, 0x64);
+	const uint8_t ip_32[RTE_RIB6_IPV6_ADDR_SIZE] = IPV6_DOC(3, 0, 1);
+	const uint8_t ip_none[RTE_RIB6_IPV6_ADDR_SIZE] = {0x20, 0x02};
+	uint8_t ip_ret[RTE_RIB6_IPV6_ADDR_SIZE];
+	uint8_t zero_ip[RTE_RIB6_IPV6_ADDR_SIZE] = {0};
+	uint64_t nh;
+	unsigned int i;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	rib = rte_rib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB6\n");
+
+	for (i = 0; i < RTE_DIM(ips); i++) {
+		node = rte_rib6_insert(rib, ips[i], depths[i]);
+		RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+		rte_rib6_set_nh(node, i);
+	}
+
+	/* longest prefix match */
+	node = rte_rib6_lookup(rib, ip_121);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 3), "Failed to lookup\n");
+	node = rte_rib6_lookup(rib, ip_64);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 2), "Failed to lookup\n");
+	node = rte_rib6_lookup(rib, ip_32);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 0), "Failed to lookup\n");
+	node = rte_rib6_lookup(rib, ip_none);
+	RTE_TEST_ASSERT(node == NULL, "Lookup returns non existent rule\n");
+
+	/* parent of the routes */
+	node = rte_rib6_lookup_exact(rib, ips[3], 121);
+	parent = rte_rib6_lookup_parent(node);
+	RTE_TEST_ASSERT((parent != NULL) &&
+		(rte_rib6_get_nh(parent, &nh) == 0) && (nh == 2),
+		"Failed to get the parent\n");
+	node = rte_rib6_lookup_exact(rib, ips[0], 32);
+	RTE_TEST_ASSERT(rte_rib6_lookup_parent(node) == NULL,
+		"Parent returned for a top level route\n");
+
+	/* iterate on all the more specific routes */
+	node = NULL;
+	for (i = 0; i < RTE_DIM(all_ips); i++) {
+		node = rte_rib6_get_nxt(rib, ips[0], 32, node,
+			RTE_RIB6_GET_NXT_ALL);
+		RTE_TEST_ASSERT(node != NULL, "Failed to get next route\n");
+		rte_rib6_get_ip(node, ip_ret);
+		RTE_TEST_ASSERT(rte_rib6_is_equal(ip_ret, all_ips[i]),
+			"Routes not returned in increasing order\n");
+	}
+	node = rte_rib6_get_nxt(rib, ips[0], 32, node, RTE_RIB6_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node == NULL, "Iteration did not end\n");
+
+	/* iterate on the covering routes only */
+	node = NULL;
+	for (i = 0; i < RTE_DIM(cover_ips); i++) {
+		node = rte_rib6_get_nxt(rib, ips[0], 32, node,
+			RTE_RIB6_GET_NXT_COVER);
+		RTE_TEST_ASSERT(node != NULL, "Failed to get next route\n");
+		rte_rib6_get_ip(node, ip_ret);
+		RTE_TEST_ASSERT(rte_rib6_is_equal(ip_ret, cover_ips[i]),
+			"Routes not returned in increasing order\n");
+	}
+	node = rte_rib6_get_nxt(rib, ips[0], 32, node,
+		RTE_RIB6_GET_NXT_COVER);
+	RTE_TEST_ASSERT(node == NULL, "Iteration did not end\n");
+
+	/* remove a route in the middle of the tree */
+	rte_rib6_remove(rib, ips[2], 64);
+	node = rte_rib6_lookup(rib, ip_64);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 1), "Failed to lookup after removal\n");
+	node = rte_rib6_lookup(rib, ip_121);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 3), "Failed to lookup after removal\n");
+
+	/* re-insert it on its intermediate node */
+	node = rte_rib6_insert(rib, ips[2], 64);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+	rte_rib6_set_nh(node, 2);
+	node = rte_rib6_lookup(rib, ip_64);
+	RTE_TEST_ASSERT((node != NULL) && (rte_rib6_get_nh(node, &nh) == 0) &&
+		(nh == 2), "Failed to lookup after insertion\n");
+
+	for (i = 0; i < RTE_DIM(ips); i++)
+		rte_rib6_remove(rib, ips[i], depths[i]);
+	node = rte_rib6_get_nxt(rib, zero_ip, 0, NULL, RTE_RIB6_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node == NULL, "Routes left after removal\n");
+
+	rte_rib6_free(rib);
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite rib6_tests = {
+	.suite_name = "rib6 autotest",
+	.setup = NULL,
+	.teardown = NULL,
+	.unit_test_cases = {
+		TEST_CASE(test_create_invalid),
+		TEST_CASE(test_multiple_create),
+		TEST_CASE(test_free_null),
+		TEST_CASE(test_insert_invalid),
+		TEST_CASE(test_get_fn),
+		TEST_CASE(test_basic),
+		TEST_CASE(test_tree_traversal),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_rib6(void)
+{
+	return unit_test_suite_runner(&rib6_tests);
+}
+
+REGISTER_TEST_COMMAND(rib6_autotest, test_rib6);
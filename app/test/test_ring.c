@@ -23,6 +23,9 @@
 #include <rte_branch_prediction.h>
 #include <rte_malloc.h>
 #include <rte_ring.h>
+#include <rte_ring_elem.h>
+#include <rte_ring_peek.h>
+#include <rte_ring_peek_zc.h>
 #include <rte_random.h>
 #include <rte_errno.h>
 #include <rte_hexdump.h>
@@ -47,6 +50,16 @@
  *      - Dequeue one object, two objects, MAX_BULK objects
  *      - Check that dequeued pointers are correct
  *
+ *    - Using the RTS and HTS multi-producer/multi-consumer sync modes:
+ *
+ *      - Fill and empty the ring through the generic API
+ *      - Check that conflicting sync mode flags are rejected
+ *
+ *    - Using the peek and zero-copy APIs on SP/SC and HTS rings:
+ *
+ *      - Reserve ring slots and write objects in place
+ *      - Peek at objects, keep some of them in the ring
+ *
  * #. Performance tests.
  *
  * Tests done in test_ring_perf.c
@@ -597,6 +610,289 @@ test_ring_burst_basic(struct rte_ring *r)
 	return -1;
 }
 
+/*
+ * check the ring in each of the MT sync modes with the generic
+ * enqueue/dequeue API, and that conflicting sync flags are rejected
+ */
+static int
+test_ring_sync_modes(void)
+{
+	static const struct {
+		const char *desc;
+		unsigned int flags;
+	} modes[] = {
+		{ "MP_RTS/MC_RTS", RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ },
+		{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+		{ "MP_RTS/MC_HTS", RING_F_MP_RTS_ENQ | RING_F_MC_HTS_DEQ },
+		{ "MP/MC_RTS", RING_F_MC_RTS_DEQ },
+		{ "SP/MC_HTS", RING_F_SP_ENQ | RING_F_MC_HTS_DEQ },
+	};
+	void **src = NULL, **dst = NULL;
+	struct rte_ring *r = NULL;
+	unsigned int i;
+	int ret = -1;
+
+	src = rte_calloc("test_ring_sync_src", RING_SIZE, sizeof(void *), 0);
+	dst = rte_calloc("test_ring_sync_dst", RING_SIZE, sizeof(void *), 0);
+	if (src == NULL || dst == NULL) {
+		printf("%s: failed to allocate object tables\n", __func__);
+		goto end;
+	}
+	for (i = 0; i < RING_SIZE; i++)
+		src[i] = (void *)(unsigned long)i;
+
+	for (i = 0; i < RTE_DIM(modes); i++) {
+		printf("%s: testing %s ring\n", __func__, modes[i].desc);
+
+		r = rte_ring_create("test_sync_mode", RING_SIZE, SOCKET_ID_ANY,
+				modes[i].flags);
+		if (r == NULL) {
+			printf("%s: cannot create %s ring\n", __func__,
+					modes[i].desc);
+			goto end;
+		}
+
+		if (test_ring_basic_full_empty(r, src, dst) != 0)
+			goto end;
+
+		if (rte_ring_enqueue_burst(r, src, MAX_BULK, NULL) !=
+				MAX_BULK ||
+				rte_ring_dequeue_burst(r, dst, RING_SIZE,
+					NULL) != MAX_BULK ||
+				memcmp(src, dst, MAX_BULK * sizeof(void *))) {
+			printf("%s: burst enqueue/dequeue failed on %s ring\n",
+					__func__, modes[i].desc);
+			goto end;
+		}
+
+		/* head/tail distance is only tunable in RTS mode */
+		if ((rte_ring_set_prod_htd_max(r, 0) == 0) !=
+				!!(modes[i].flags & RING_F_MP_RTS_ENQ) ||
+				(rte_ring_set_cons_htd_max(r, 0) == 0) !=
+				!!(modes[i].flags & RING_F_MC_RTS_DEQ)) {
+			printf("%s: unexpected htd_max result on %s ring\n",
+					__func__, modes[i].desc);
+			goto end;
+		}
+
+		/* a zero head/tail distance fully serializes an RTS ring */
+		if (test_ring_basic_full_empty(r, src, dst) != 0)
+			goto end;
+
+		rte_ring_free(r);
+		r = NULL;
+	}
+
+	r = rte_ring_create("test_sync_bad", RING_SIZE, SOCKET_ID_ANY,
+			RING_F_MP_RTS_ENQ | RING_F_MP_HTS_ENQ);
+	if (r != NULL) {
+		printf("%s: ring created with conflicting sync flags\n",
+				__func__);
+		goto end;
+	}
+
+	ret = 0;
+end:
+	rte_ring_free(r);
+	rte_free(src);
+	rte_free(dst);
+	return ret;
+}
+
+/*
+ * check the peek and zero-copy APIs on the sync modes that support them:
+ * objects are written in place, inspected and either kept or released
+ */
+static int
+test_ring_peek(void)
+{
+	static const struct {
+		const char *desc;
+		unsigned int flags;
+	} modes[] = {
+		{ "SP/SC", RING_F_SP_ENQ | RING_F_SC_DEQ },
+		{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+	};
+	struct rte_ring_zc_data zcd;
+	struct rte_ring *r = NULL;
+	void *src[MAX_BULK], *dst[MAX_BULK];
+	unsigned int i, j, k, n;
+	int ret = -1;
+
+	for (i = 0; i < MAX_BULK; i++)
+		src[i] = (void *)(unsigned long)(i + 1);
+
+	for (i = 0; i < RTE_DIM(modes); i++) {
+		printf("%s: testing %s ring\n", __func__, modes[i].desc);
+
+		r = rte_ring_create("test_peek", RING_SIZE, SOCKET_ID_ANY,
+				modes[i].flags);
+		if (r == NULL)
+			goto end;
+
+		/* go around the ring several times to cover wrap-around */
+		for (k = 0; k < 2 * RING_SIZE / (MAX_BULK - 1); k++) {
+			/* write the objects in place */
+			n = rte_ring_enqueue_zc_bulk_start(r, MAX_BULK - 1,
+					&zcd, NULL);
+			TEST_RING_VERIFY(n == MAX_BULK - 1);
+			for (j = 0; j != n; j++) {
+				if (j < zcd.n1)
+					zcd.ptr1[j] = src[j];
+				else
+					zcd.ptr2[j - zcd.n1] = src[j];
+			}
+			rte_ring_enqueue_zc_finish(r, n);
+			TEST_RING_VERIFY(rte_ring_count(r) == n);
+
+			/* peek at the head object and keep it */
+			n = rte_ring_dequeue_zc_bulk_start(r, 1, &zcd, NULL);
+			TEST_RING_VERIFY(n == 1 && zcd.ptr1[0] == src[0]);
+			rte_ring_dequeue_zc_finish(r, 0);
+			TEST_RING_VERIFY(rte_ring_count(r) == MAX_BULK - 1);
+
+			/* peek with a copy, release only the first half */
+			n = rte_ring_dequeue_burst_start(r, dst, MAX_BULK,
+					NULL);
+			TEST_RING_VERIFY(n == MAX_BULK - 1);
+			TEST_RING_VERIFY(memcmp(src, dst,
+					n * sizeof(void *)) == 0);
+			rte_ring_dequeue_finish(r, n / 2);
+			TEST_RING_VERIFY(rte_ring_count(r) == n - n / 2);
+
+			/* the remaining objects are still in order */
+			n = rte_ring_dequeue_burst(r, dst, MAX_BULK, NULL);
+			TEST_RING_VERIFY(n == MAX_BULK - 1 - (MAX_BULK - 1) / 2);
+			TEST_RING_VERIFY(memcmp(&src[(MAX_BULK - 1) / 2], dst,
+					n * sizeof(void *)) == 0);
+		}
+
+		/* a reservation larger than the free space must fail */
+		n = rte_ring_enqueue_bulk_start(r, RING_SIZE, NULL);
+		TEST_RING_VERIFY(n == 0);
+		n = rte_ring_enqueue_burst_start(r, MAX_BULK, NULL);
+		TEST_RING_VERIFY(n == MAX_BULK);
+		rte_ring_enqueue_finish(r, src, n);
+		TEST_RING_VERIFY(rte_ring_count(r) == MAX_BULK);
+
+		/* nothing to peek at after a full dequeue */
+		n = rte_ring_dequeue_bulk(r, dst, MAX_BULK, NULL);
+		TEST_RING_VERIFY(n == MAX_BULK);
+		n = rte_ring_dequeue_zc_burst_start(r, 1, &zcd, NULL);
+		TEST_RING_VERIFY(n == 0);
+
+		rte_ring_free(r);
+		r = NULL;
+	}
+
+	ret = 0;
+end:
+	rte_ring_free(r);
+	return ret;
+}
+
+#define ELEM_RING_SIZE 64
+#define ELEM_MAX_SIZE 32
+
+/*
+ * check rings with non pointer sized elements: objects are copied by value,
+ * including across the wrap-around point, in every sync mode
+ */
+static int
+test_ring_elem(void)
+{
+	static const unsigned int esizes[] = { 4, 8, 16, 20, 32 };
+	static const struct {
+		const char *desc;
+		unsigned int flags;
+	} modes[] = {
+		{ "MP/MC", 0 },
+		{ "SP/SC", RING_F_SP_ENQ | RING_F_SC_DEQ },
+		{ "MP_RTS/MC_RTS", RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ },
+		{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+	};
+	uint32_t src[MAX_BULK * ELEM_MAX_SIZE / sizeof(uint32_t)];
+	uint32_t dst[2 * MAX_BULK * ELEM_MAX_SIZE / sizeof(uint32_t)];
+	struct rte_ring *r = NULL;
+	unsigned int i, j, k, n, esize, avail;
+
+	for (i = 0; i < RTE_DIM(src); i++)
+		src[i] = rte_rand();
+
+	for (i = 0; i < RTE_DIM(esizes); i++) {
+		esize = esizes[i];
+
+		for (j = 0; j < RTE_DIM(modes); j++) {
+			printf("%s: testing %uB elements on %s ring\n",
+					__func__, esize, modes[j].desc);
+
+			r = rte_ring_create_elem("test_elem", esize,
+					ELEM_RING_SIZE, SOCKET_ID_ANY,
+					modes[j].flags);
+			TEST_RING_VERIFY(r != NULL);
+
+			/* odd sized bulks to hit every wrap-around offset */
+			for (k = 0; k < 4 * ELEM_RING_SIZE; k++) {
+				memset(dst, 0, sizeof(dst));
+				n = rte_ring_enqueue_bulk_elem(r, src, esize,
+						MAX_BULK - 1, NULL);
+				TEST_RING_VERIFY(n == MAX_BULK - 1);
+				n = rte_ring_dequeue_bulk_elem(r, dst, esize,
+						MAX_BULK - 1, &avail);
+				TEST_RING_VERIFY(n == MAX_BULK - 1);
+				TEST_RING_VERIFY(avail == 0);
+				TEST_RING_VERIFY(memcmp(src, dst,
+						n * esize) == 0);
+			}
+
+			/* bulk fails, burst is truncated on a full ring */
+			n = rte_ring_enqueue_burst_elem(r, src, esize,
+					MAX_BULK, NULL);
+			TEST_RING_VERIFY(n == MAX_BULK);
+			n = rte_ring_enqueue_bulk_elem(r, src, esize,
+					MAX_BULK, NULL);
+			TEST_RING_VERIFY(n == 0);
+			n = rte_ring_enqueue_burst_elem(r, src, esize,
+					MAX_BULK, &avail);
+			TEST_RING_VERIFY(n == ELEM_RING_SIZE - 1 - MAX_BULK);
+			TEST_RING_VERIFY(avail == 0);
+			TEST_RING_VERIFY(rte_ring_enqueue_elem(r, src,
+					esize) == -ENOBUFS);
+
+			n = rte_ring_dequeue_burst_elem(r, dst, esize,
+					2 * MAX_BULK, NULL);
+			TEST_RING_VERIFY(n == ELEM_RING_SIZE - 1);
+			TEST_RING_VERIFY(memcmp(src, dst,
+					MAX_BULK * esize) == 0);
+			TEST_RING_VERIFY(memcmp(src,
+					(uint8_t *)dst + MAX_BULK * esize,
+					(n - MAX_BULK) * esize) == 0);
+
+			/* single object enqueue/dequeue */
+			memset(dst, 0, sizeof(dst));
+			TEST_RING_VERIFY(rte_ring_enqueue_elem(r, src,
+					esize) == 0);
+			TEST_RING_VERIFY(rte_ring_dequeue_elem(r, dst,
+					esize) == 0);
+			TEST_RING_VERIFY(memcmp(src, dst, esize) == 0);
+			TEST_RING_VERIFY(rte_ring_dequeue_elem(r, dst,
+					esize) == -ENOENT);
+
+			rte_ring_free(r);
+			r = NULL;
+		}
+	}
+
+	/* element size must be a non zero multiple of 4 */
+	r = rte_ring_create_elem("test_elem_bad", 6, ELEM_RING_SIZE,
+			SOCKET_ID_ANY, 0);
+	TEST_RING_VERIFY(r == NULL && rte_errno == EINVAL);
+	TEST_RING_VERIFY(rte_ring_get_memsize_elem(0, ELEM_RING_SIZE) ==
+			-EINVAL);
+
+	return 0;
+}
+
 /*
  * it will always fail to create ring with a wrong ring size number in this function
  */
@@ -860,6 +1156,15 @@ test_ring(void)
 	if (test_ring_with_exact_size() < 0)
 		goto test_fail;
 
+	if (test_ring_sync_modes() < 0)
+		goto test_fail;
+
+	if (test_ring_peek() < 0)
+		goto test_fail;
+
+	if (test_ring_elem() < 0)
+		goto test_fail;
+
 	/* dump the ring status */
 	rte_ring_list_dump(stdout);
 
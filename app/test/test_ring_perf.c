@@ -20,6 +20,9 @@
  *  * Empty ring dequeue
  *  * Enqueue/dequeue of bursts in 1 threads
  *  * Enqueue/dequeue of bursts in 2 threads
+ *  * Enqueue/dequeue of bursts on all lcores for each MP/MC sync mode
+ *    (meant to be run with more lcores than physical cores, e.g.
+ *    --lcores='(0-7)@(0-1)', to show the effect of preempted threads)
  */
 
 #define RING_NAME "RING_PERF"
@@ -362,6 +365,112 @@ test_bulk_enqueue_dequeue(struct rte_ring *r)
 	}
 }
 
+/*
+ * per-lcore parameters for the multi-thread test: input is the ring and
+ * the burst size, output is the cycles spent and objects passed through
+ */
+struct mt_thread_params {
+	struct rte_ring *r;
+	unsigned int size;
+	uint64_t cycles;
+	uint64_t objs;
+} __rte_cache_aligned;
+
+static struct mt_thread_params mt_params[RTE_MAX_LCORE];
+
+/*
+ * Every lcore enqueues a burst and dequeues a burst in a loop on the same
+ * ring, using the default sync mode of the ring. Each lcore always has at
+ * most one burst of its own in the ring, so this cannot deadlock as long as
+ * the ring can hold one burst per lcore.
+ */
+static int
+mt_enqueue_dequeue(void *p)
+{
+	const unsigned int iter_shift = 16;
+	const unsigned int iterations = 1 << iter_shift;
+	struct mt_thread_params *params =
+		&((struct mt_thread_params *)p)[rte_lcore_id()];
+	struct rte_ring *r = params->r;
+	const unsigned int size = params->size;
+	void *burst[MAX_BURST] = {0};
+	unsigned int i;
+
+	if (__sync_add_and_fetch(&lcore_count, 1) != rte_lcore_count())
+		while (lcore_count != rte_lcore_count())
+			rte_pause();
+
+	const uint64_t start = rte_rdtsc();
+	for (i = 0; i < iterations; i++) {
+		while (rte_ring_enqueue_bulk(r, burst, size, NULL) == 0)
+			rte_pause();
+		while (rte_ring_dequeue_bulk(r, burst, size, NULL) == 0)
+			rte_pause();
+	}
+	const uint64_t end = rte_rdtsc();
+
+	params->cycles = end - start;
+	params->objs = (uint64_t)iterations * size;
+	return 0;
+}
+
+/*
+ * Compare the MP/MC sync modes with all lcores hammering the same ring.
+ * When lcores share physical cores, a preempted thread stalls the default
+ * MP/MC mode while RTS and HTS keep making progress.
+ */
+static int
+test_mt_sync_modes(void)
+{
+	static const struct {
+		const char *desc;
+		unsigned int flags;
+	} modes[] = {
+		{ "MP/MC", 0 },
+		{ "MP_RTS/MC_RTS", RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ },
+		{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+	};
+	const unsigned int nb_lcores = rte_lcore_count();
+	struct rte_ring *r;
+	unsigned int i, sz, lcore_id;
+	uint64_t cycles, objs;
+
+	if (nb_lcores * MAX_BURST > RING_SIZE - 1) {
+		printf("Too many lcores for ring size, skipping\n");
+		return 0;
+	}
+
+	for (i = 0; i < RTE_DIM(modes); i++) {
+		r = rte_ring_create("RING_PERF_MT", RING_SIZE, rte_socket_id(),
+				modes[i].flags);
+		if (r == NULL)
+			return -1;
+
+		for (sz = 0; sz < RTE_DIM(bulk_sizes); sz++) {
+			RTE_LCORE_FOREACH(lcore_id) {
+				mt_params[lcore_id].r = r;
+				mt_params[lcore_id].size = bulk_sizes[sz];
+			}
+			lcore_count = 0;
+			rte_eal_mp_remote_launch(mt_enqueue_dequeue, mt_params,
+					CALL_MASTER);
+			rte_eal_mp_wait_lcore();
+
+			cycles = 0;
+			objs = 0;
+			RTE_LCORE_FOREACH(lcore_id) {
+				cycles += mt_params[lcore_id].cycles;
+				objs += mt_params[lcore_id].objs;
+			}
+			printf("%s bulk enq/dequeue (size: %u, lcores: %u): "
+					"%.2F\n", modes[i].desc, bulk_sizes[sz],
+					nb_lcores, (double)cycles / objs);
+		}
+		rte_ring_free(r);
+	}
+	return 0;
+}
+
 static int
 test_ring_perf(void)
 {
@@ -395,6 +504,12 @@ test_ring_perf(void)
 		run_on_core_pair(&cores, r, enqueue_bulk, dequeue_bulk);
 	}
 	rte_ring_free(r);
+
+	if (rte_lcore_count() > 1) {
+		printf("\n### Testing MP/MC sync modes using all lcores ###\n");
+		if (test_mt_sync_modes() != 0)
+			return -1;
+	}
 	return 0;
 }
 
@@ -885,6 +885,212 @@ service_may_be_active(void)
 	return unregister_all();
 }
 
+/* used to count the calls of the busy and idle services */
+static uint32_t busy_calls;
+static uint32_t idle_calls;
+
+static int32_t busy_cb(void *args)
+{
+	RTE_SET_USED(args);
+	busy_calls++;
+	return 0;
+}
+
+static int32_t idle_cb(void *args)
+{
+	RTE_SET_USED(args);
+	idle_calls++;
+	return -EAGAIN;
+}
+
+/* verify the adaptive scheduling favours a busy service over an idle one */
+static int
+service_lcore_sched_adaptive(void)
+{
+	struct rte_service_spec service;
+	uint32_t busy_id, idle_id;
+	uint32_t attr_value;
+
+	unregister_all();
+
+	memset(&service, 0, sizeof(struct rte_service_spec));
+	service.callback = busy_cb;
+	snprintf(service.name, sizeof(service.name), "busy_service");
+	TEST_ASSERT_EQUAL(0, rte_service_component_register(&service,
+			&busy_id), "Register of busy service failed");
+	service.callback = idle_cb;
+	snprintf(service.name, sizeof(service.name), "idle_service");
+	TEST_ASSERT_EQUAL(0, rte_service_component_register(&service,
+			&idle_id), "Register of idle service failed");
+
+	/* check error return values */
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_weight_set(UINT32_MAX, 1),
+			"Invalid service id didn't return -EINVAL");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_weight_set(busy_id, 0),
+			"Zero weight didn't return -EINVAL");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_weight_set(busy_id,
+			RTE_SERVICE_WEIGHT_MAX + 1),
+			"Too large weight didn't return -EINVAL");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_lcore_sched_mode_set(UINT32_MAX,
+			RTE_SERVICE_LCORE_SCHED_ADAPTIVE),
+			"Invalid lcore_id didn't return -EINVAL");
+	TEST_ASSERT_EQUAL(-ENOTSUP, rte_service_lcore_sched_mode_set(
+			rte_lcore_id(), RTE_SERVICE_LCORE_SCHED_ADAPTIVE),
+			"Non-service core didn't return -ENOTSUP");
+
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_add(slcore_id),
+			"Service core add did not return zero");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_lcore_sched_mode_set(slcore_id,
+			UINT32_MAX), "Invalid mode didn't return -EINVAL");
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_sched_mode_set(slcore_id,
+			RTE_SERVICE_LCORE_SCHED_ADAPTIVE),
+			"Setting adaptive mode failed");
+	TEST_ASSERT_EQUAL(0, rte_service_weight_set(busy_id, 4),
+			"Setting weight failed");
+
+	rte_service_component_runstate_set(busy_id, 1);
+	rte_service_component_runstate_set(idle_id, 1);
+	rte_service_set_stats_enable(busy_id, 1);
+	rte_service_set_stats_enable(idle_id, 1);
+	TEST_ASSERT_EQUAL(0, rte_service_runstate_set(busy_id, 1),
+			"Error: Service start returned non-zero");
+	TEST_ASSERT_EQUAL(0, rte_service_runstate_set(idle_id, 1),
+			"Error: Service start returned non-zero");
+	TEST_ASSERT_EQUAL(0, rte_service_map_lcore_set(busy_id, slcore_id, 1),
+			"Enabling valid service and core failed");
+	TEST_ASSERT_EQUAL(0, rte_service_map_lcore_set(idle_id, slcore_id, 1),
+			"Enabling valid service and core failed");
+
+	busy_calls = 0;
+	idle_calls = 0;
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_start(slcore_id),
+			"Starting service core failed");
+
+	/* wait for the service lcore to run */
+	rte_delay_ms(200);
+
+	rte_service_runstate_set(busy_id, 0);
+	rte_service_runstate_set(idle_id, 0);
+	rte_service_lcore_stop(slcore_id);
+	rte_eal_wait_lcore(slcore_id);
+
+	TEST_ASSERT(busy_calls > 0 && idle_calls > 0,
+			"Services were not called");
+	/* the idle service is called at most once every 32 loops, while the
+	 * busy one is called 4 times per loop
+	 */
+	TEST_ASSERT(idle_calls < busy_calls / 32,
+			"Idle service not skipped (busy %u idle %u)",
+			busy_calls, idle_calls);
+
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(idle_id,
+			RTE_SERVICE_ATTR_IDLE_CALL_COUNT, &attr_value),
+			"Valid attr_get() call didn't return success");
+	TEST_ASSERT_EQUAL(idle_calls, attr_value,
+			"attr_get() didn't get idle call count");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(idle_id,
+			RTE_SERVICE_ATTR_CYCLES_PER_BUSY_CALL, &attr_value),
+			"Valid attr_get() call didn't return success");
+	TEST_ASSERT_EQUAL(0, attr_value,
+			"Idle service has cycles per busy call");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(busy_id,
+			RTE_SERVICE_ATTR_IDLE_CALL_COUNT, &attr_value),
+			"Valid attr_get() call didn't return success");
+	TEST_ASSERT_EQUAL(0, attr_value,
+			"Busy service has idle calls");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(busy_id,
+			RTE_SERVICE_ATTR_CYCLES_PER_BUSY_CALL, &attr_value),
+			"Valid attr_get() call didn't return success");
+	TEST_ASSERT(attr_value > 0,
+			"attr_get() failed to get cycles per busy call");
+
+	return unregister_all();
+}
+
+static int32_t loaded_cb(void *args)
+{
+	RTE_SET_USED(args);
+	rte_delay_us(20);
+	return 0;
+}
+
+/* verify the balancing spreads the services over the service cores */
+static int
+service_lcore_balance(void)
+{
+	struct rte_service_spec service;
+	uint32_t lcores[2];
+	uint32_t ids[2];
+	uint32_t i;
+
+	/* the master lcore and two service cores */
+	if (rte_lcore_count() < 3) {
+		printf("Not enough lcores for the balancing test, skipping\n");
+		return -ENOTSUP;
+	}
+
+	unregister_all();
+
+	lcores[0] = slcore_id;
+	lcores[1] = rte_get_next_lcore(slcore_id, 1, 0);
+
+	memset(&service, 0, sizeof(struct rte_service_spec));
+	service.callback = loaded_cb;
+	for (i = 0; i < RTE_DIM(ids); i++) {
+		snprintf(service.name, sizeof(service.name),
+				"loaded_service_%u", i);
+		TEST_ASSERT_EQUAL(0, rte_service_component_register(&service,
+				&ids[i]), "Register of service failed");
+		rte_service_component_runstate_set(ids[i], 1);
+		TEST_ASSERT_EQUAL(0, rte_service_runstate_set(ids[i], 1),
+				"Error: Service start returned non-zero");
+	}
+
+	for (i = 0; i < RTE_DIM(lcores); i++)
+		TEST_ASSERT_EQUAL(0, rte_service_lcore_add(lcores[i]),
+				"Service core add did not return zero");
+
+	/* map both services to the first core only */
+	for (i = 0; i < RTE_DIM(ids); i++)
+		TEST_ASSERT_EQUAL(0, rte_service_map_lcore_set(ids[i],
+				lcores[0], 1),
+				"Enabling valid service and core failed");
+
+	TEST_ASSERT_EQUAL(0, rte_service_balance_set(10),
+			"Enabling balancing failed");
+	for (i = 0; i < RTE_DIM(lcores); i++)
+		TEST_ASSERT_EQUAL(0, rte_service_lcore_start(lcores[i]),
+				"Starting service core failed");
+
+	/* wait for the balancing to move one of the services */
+	for (i = 0; i < 100; i++) {
+		if (rte_service_lcore_count_services(lcores[1]) == 1)
+			break;
+		/* leave the CPU to the service cores if they share it */
+		rte_delay_us_sleep(10 * 1000);
+	}
+
+	TEST_ASSERT_EQUAL(0, rte_service_balance_set(0),
+			"Disabling balancing failed");
+	for (i = 0; i < RTE_DIM(ids); i++)
+		rte_service_runstate_set(ids[i], 0);
+	for (i = 0; i < RTE_DIM(lcores); i++) {
+		rte_service_lcore_stop(lcores[i]);
+		rte_eal_wait_lcore(lcores[i]);
+	}
+
+	TEST_ASSERT_EQUAL(1, rte_service_lcore_count_services(lcores[0]),
+			"First service core not left with one service");
+	TEST_ASSERT_EQUAL(1, rte_service_lcore_count_services(lcores[1]),
+			"Second service core not given one service");
+	for (i = 0; i < RTE_DIM(ids); i++)
+		TEST_ASSERT_EQUAL(1, rte_service_map_lcore_get(ids[i],
+				lcores[0]) + rte_service_map_lcore_get(ids[i],
+				lcores[1]), "Service not mapped to a single core");
+
+	return unregister_all();
+}
+
 static struct unit_test_suite service_tests  = {
 	.suite_name = "service core test suite",
 	.setup = testsuite_setup,
@@ -906,6 +1112,9 @@ static struct unit_test_suite service_tests  = {
 		TEST_CASE_ST(dummy_register, NULL, service_app_lcore_mt_safe),
 		TEST_CASE_ST(dummy_register, NULL, service_app_lcore_mt_unsafe),
 		TEST_CASE_ST(dummy_register, NULL, service_may_be_active),
+		TEST_CASE_ST(dummy_register, NULL,
+				service_lcore_sched_adaptive),
+		TEST_CASE_ST(dummy_register, NULL, service_lcore_balance),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
@@ -43,6 +43,31 @@
  *      all cores randomly reschedule them.
  *    - Again we check that the expected number of callbacks has occurred when
  *      we call timer-manage.
+ *    - The test is run a second time with the timing wheel lists.
+ *
+ * #. Timing wheel test.
+ *
+ *    This test checks the expiry of timers kept in a timing wheel.
+ *
+ *    - The master lcore list is switched to a timing wheel.
+ *    - Timers are loaded with random delays up to 100 ms, so that they are
+ *      cascaded from the upper levels of the wheel, and a few of them are
+ *      stopped or reset.
+ *    - rte_timer_manage() is called until all the timers have expired. Each
+ *      callback must be called once, and not before its expiry time.
+ *
+ * #. Timer data instance test.
+ *
+ *    This test checks that the timers of a timer data instance are kept
+ *    apart from the default ones.
+ *
+ *    - Timers are loaded in a newly allocated instance, they must not be
+ *      run by rte_timer_manage(), and the instance cannot be freed.
+ *    - Some of them are returned by rte_timer_alt_manage_burst(), then the
+ *      others are run by rte_timer_alt_manage(). Each timer must expire
+ *      once.
+ *    - Timers are loaded again and removed by rte_timer_stop_all(), then
+ *      the instance is freed.
  *
  * #. Basic test.
  *
@@ -86,6 +111,7 @@
  */
 
 #include <stdio.h>
+#include <errno.h>
 #include <stdarg.h>
 #include <string.h>
 #include <stdlib.h>
@@ -494,6 +520,264 @@ timer_basic_main_loop(__attribute__((unused)) void *arg)
 	return 0;
 }
 
+static int
+timer_set_list_type(enum rte_timer_list_type type)
+{
+	unsigned int lcore_id;
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		if (rte_timer_list_set_type(lcore_id, type) != 0) {
+			printf("Cannot set the timer list type of core %u\n",
+				lcore_id);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+#define NB_WHEEL_TIMERS 4096
+
+static volatile int wheel_cb_count;
+
+/* callback for timing wheel test, check that it is not called too early */
+static void
+timer_wheel_cb(struct rte_timer *tim, void *arg)
+{
+	unsigned int *count = arg;
+
+	if (rte_get_timer_cycles() < tim->expire) {
+		printf("- Timer expired %"PRIu64" cycles early\n",
+			tim->expire - rte_get_timer_cycles());
+		test_failed = 1;
+	}
+	(*count)++;
+	wheel_cb_count++;
+}
+
+static int
+timer_wheel_test(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t max_delay = rte_get_timer_hz() / 10;
+	uint64_t end;
+	struct rte_timer *timers;
+	unsigned int *counts;
+	int i, nb_expected = NB_WHEEL_TIMERS;
+
+	timers = rte_malloc(NULL, sizeof(*timers) * NB_WHEEL_TIMERS, 0);
+	counts = rte_zmalloc(NULL, sizeof(*counts) * NB_WHEEL_TIMERS, 0);
+	if (timers == NULL || counts == NULL) {
+		printf("- Cannot allocate memory for timers\n");
+		goto fail;
+	}
+
+	if (rte_timer_list_set_type(lcore_id, RTE_TIMER_LIST_WHEEL) != 0) {
+		printf("- Cannot switch to a timing wheel\n");
+		goto fail;
+	}
+
+	test_failed = 0;
+	wheel_cb_count = 0;
+	for (i = 0; i < NB_WHEEL_TIMERS; i++) {
+		rte_timer_init(&timers[i]);
+		rte_timer_reset(&timers[i], rte_rand() % max_delay, SINGLE,
+				lcore_id, timer_wheel_cb, &counts[i]);
+	}
+
+	/* a list holding timers cannot be changed */
+	if (rte_timer_list_set_type(lcore_id, RTE_TIMER_LIST_SKIPLIST) !=
+			-EBUSY) {
+		printf("- Timer list type changed with pending timers\n");
+		goto fail;
+	}
+
+	/* stop some timers and move others */
+	for (i = 0; i < NB_WHEEL_TIMERS; i += 16) {
+		rte_timer_stop(&timers[i]);
+		nb_expected--;
+		rte_timer_reset(&timers[i + 1], rte_rand() % max_delay,
+				SINGLE, lcore_id, timer_wheel_cb,
+				&counts[i + 1]);
+	}
+
+	end = rte_get_timer_cycles() + 2 * max_delay;
+	while (wheel_cb_count < nb_expected &&
+			rte_get_timer_cycles() < end) {
+		rte_timer_manage();
+		rte_delay_us(3);
+	}
+
+	for (i = 0; i < NB_WHEEL_TIMERS; i++) {
+		if (counts[i] != (i % 16 == 0 ? 0u : 1u)) {
+			printf("- Timer %d expired %u times\n", i, counts[i]);
+			test_failed = 1;
+		}
+	}
+	if (test_failed)
+		goto fail;
+
+	if (rte_timer_list_set_type(lcore_id, RTE_TIMER_LIST_SKIPLIST) != 0) {
+		printf("- Cannot switch back to a skiplist\n");
+		goto fail;
+	}
+
+	rte_free(timers);
+	rte_free(counts);
+	return 0;
+
+fail:
+	printf("Test Failed\n");
+	if (timers != NULL)
+		for (i = 0; i < NB_WHEEL_TIMERS; i++)
+			rte_timer_stop_sync(&timers[i]);
+	rte_timer_list_set_type(lcore_id, RTE_TIMER_LIST_SKIPLIST);
+	rte_free(timers);
+	rte_free(counts);
+	return -1;
+}
+
+#define NB_DATA_TIMERS 64
+#define DATA_BURST_SIZE 16
+
+/* count the expiry of a timer data instance timer */
+static void
+timer_data_cb(struct rte_timer *tim, void *arg __rte_unused)
+{
+	unsigned int *count = tim->arg;
+
+	(*count)++;
+}
+
+static void
+timer_data_manage_cb(struct rte_timer *tim)
+{
+	timer_data_cb(tim, NULL);
+}
+
+static void
+timer_data_stop_cb(struct rte_timer *tim __rte_unused, void *arg)
+{
+	unsigned int *nb_stopped = arg;
+
+	(*nb_stopped)++;
+}
+
+static int
+timer_data_test(void)
+{
+	struct rte_timer *expired[DATA_BURST_SIZE];
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t ticks = rte_get_timer_hz() / 1000;
+	struct rte_timer *timers;
+	unsigned int *counts;
+	unsigned int nb_stopped = 0;
+	uint32_t id;
+	int i, ret;
+
+	timers = rte_malloc(NULL, sizeof(*timers) * NB_DATA_TIMERS, 0);
+	counts = rte_zmalloc(NULL, sizeof(*counts) * NB_DATA_TIMERS, 0);
+	if (timers == NULL || counts == NULL) {
+		printf("- Cannot allocate memory for timers\n");
+		goto fail_free;
+	}
+
+	if (rte_timer_data_alloc(&id) != 0) {
+		printf("- Cannot allocate a timer data instance\n");
+		goto fail_free;
+	}
+
+	for (i = 0; i < NB_DATA_TIMERS; i++) {
+		rte_timer_init(&timers[i]);
+		rte_timer_alt_reset(id, &timers[i], ticks, SINGLE, lcore_id,
+				    timer_data_cb, &counts[i]);
+	}
+	rte_delay_us(2000);
+
+	/* the default instance does not hold these timers */
+	rte_timer_manage();
+	for (i = 0; i < NB_DATA_TIMERS; i++) {
+		if (counts[i] != 0) {
+			printf("- Timer %d run by rte_timer_manage()\n", i);
+			goto fail;
+		}
+	}
+
+	if (rte_timer_data_dealloc(id) != -EBUSY) {
+		printf("- Timer data instance freed with pending timers\n");
+		goto fail;
+	}
+
+	ret = rte_timer_alt_manage_burst(id, NULL, 0, expired,
+					 DATA_BURST_SIZE);
+	if (ret != DATA_BURST_SIZE) {
+		printf("- %d timers returned by burst manage (expected %d)\n",
+			ret, DATA_BURST_SIZE);
+		goto fail;
+	}
+	for (i = 0; i < ret; i++) {
+		if (rte_timer_pending(expired[i])) {
+			printf("- Returned timer still pending\n");
+			goto fail;
+		}
+		timer_data_cb(expired[i], NULL);
+	}
+
+	if (rte_timer_alt_manage(id, NULL, 0, timer_data_manage_cb) != 0) {
+		printf("- Cannot manage the timer data instance\n");
+		goto fail;
+	}
+
+	for (i = 0; i < NB_DATA_TIMERS; i++) {
+		if (counts[i] != 1) {
+			printf("- Timer %d expired %u times\n", i, counts[i]);
+			goto fail;
+		}
+	}
+
+	/* drain the instance without running the timers */
+	for (i = 0; i < NB_DATA_TIMERS; i++)
+		rte_timer_alt_reset(id, &timers[i], ticks, SINGLE, lcore_id,
+				    timer_data_cb, &counts[i]);
+	if (rte_timer_stop_all(id, &lcore_id, 1, timer_data_stop_cb,
+			       &nb_stopped) != 0 ||
+			nb_stopped != NB_DATA_TIMERS) {
+		printf("- %u timers stopped (expected %d)\n", nb_stopped,
+			NB_DATA_TIMERS);
+		goto fail;
+	}
+	for (i = 0; i < NB_DATA_TIMERS; i++) {
+		if (rte_timer_pending(&timers[i])) {
+			printf("- Timer %d still pending\n", i);
+			goto fail;
+		}
+	}
+
+	if (rte_timer_data_dealloc(id) != 0) {
+		printf("- Cannot free the timer data instance\n");
+		goto fail;
+	}
+
+	if (rte_timer_alt_reset(id, &timers[0], ticks, SINGLE, lcore_id,
+				timer_data_cb, &counts[0]) != -EINVAL) {
+		printf("- Timer loaded in a freed instance\n");
+		goto fail_free;
+	}
+
+	rte_free(timers);
+	rte_free(counts);
+	return 0;
+
+fail:
+	rte_timer_stop_all(id, &lcore_id, 1, NULL, NULL);
+	rte_timer_data_dealloc(id);
+fail_free:
+	printf("Test Failed\n");
+	rte_free(timers);
+	rte_free(counts);
+	return -1;
+}
+
 static int
 timer_sanity_check(void)
 {
@@ -577,6 +861,23 @@ test_timer(void)
 	if (test_failed)
 		return TEST_FAILED;
 
+	/* run them again, with timing wheels */
+	printf("\nStart timer stress tests 2 with timing wheels\n");
+	if (timer_set_list_type(RTE_TIMER_LIST_WHEEL) < 0)
+		return TEST_FAILED;
+	rte_eal_mp_remote_launch(timer_stress2_main_loop, NULL, CALL_MASTER);
+	rte_eal_mp_wait_lcore();
+	if (timer_set_list_type(RTE_TIMER_LIST_SKIPLIST) < 0 || test_failed)
+		return TEST_FAILED;
+
+	printf("\nStart timing wheel tests\n");
+	if (timer_wheel_test() < 0)
+		return TEST_FAILED;
+
+	printf("\nStart timer data instance tests\n");
+	if (timer_data_test() < 0)
+		return TEST_FAILED;
+
 	/* calculate the "end of test" time */
 	cur_time = rte_get_timer_cycles();
 	hz = rte_get_timer_hz();
@@ -16,6 +16,7 @@
 #include <rte_pause.h>
 
 #define MAX_ITERATIONS 1000000
+#define NB_LARGE_TIMERS 10000000
 
 int outstanding_count = 0;
 
@@ -33,6 +34,76 @@ timer_cb(struct rte_timer *t __rte_unused, void *param __rte_unused)
 #define do_delay() rte_pause()
 #endif
 
+static void
+print_cycles_per_timer(const char *what, unsigned int n, uint64_t cycles)
+{
+	printf("%s %u timers: %"PRIu64" cycles per timer\n", what, n,
+		(cycles + n / 2) / n);
+}
+
+/* arm, cancel and expire a lot of timers, with random delays up to 1s */
+static int
+test_timer_perf_large(enum rte_timer_list_type type, const char *name)
+{
+	const uint64_t max_delay = rte_get_timer_hz();
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int n = NB_LARGE_TIMERS;
+	uint64_t *delays = NULL;
+	struct rte_timer *tms;
+	uint64_t start_tsc;
+	unsigned int i;
+	int ret = -1;
+
+	/* use less timers if there is not enough memory */
+	while ((tms = rte_malloc(NULL, sizeof(*tms) * n, 0)) == NULL ||
+			(delays = rte_malloc(NULL, sizeof(*delays) * n, 0)) ==
+			NULL) {
+		rte_free(tms);
+		n /= 2;
+		if (n == 0)
+			return -1;
+	}
+
+	if (rte_timer_list_set_type(lcore_id, type) != 0) {
+		printf("Cannot use a %s timer list\n", name);
+		goto out;
+	}
+	printf("\nTimer list: %s\n", name);
+
+	for (i = 0; i < n; i++) {
+		rte_timer_init(&tms[i]);
+		delays[i] = rte_rand() % max_delay;
+	}
+
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < n; i++)
+		rte_timer_reset(&tms[i], delays[i], SINGLE, lcore_id,
+				timer_cb, NULL);
+	print_cycles_per_timer("Arming", n, rte_rdtsc() - start_tsc);
+
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < n; i++)
+		rte_timer_stop(&tms[i]);
+	print_cycles_per_timer("Cancelling", n, rte_rdtsc() - start_tsc);
+
+	/* rearm them, and expire them as they come */
+	outstanding_count = n;
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < n; i++)
+		rte_timer_reset(&tms[i], delays[i], SINGLE, lcore_id,
+				timer_cb, NULL);
+	while (outstanding_count)
+		rte_timer_manage();
+	printf("Arming and expiring %u timers in %"PRIu64"ms\n", n,
+		(rte_rdtsc() - start_tsc) * MS_PER_S / rte_get_tsc_hz());
+
+	ret = rte_timer_list_set_type(lcore_id, RTE_TIMER_LIST_SKIPLIST);
+out:
+	rte_free(delays);
+	rte_free(tms);
+	return ret;
+}
+
 static int
 test_timer_perf(void)
 {
@@ -127,7 +198,14 @@ test_timer_perf(void)
 	printf("Time per rte_timer_manage with zero callbacks: %"PRIu64" cycles\n",
 			(end_tsc - start_tsc + iterations/2) / iterations);
 
+	rte_timer_stop_sync(&tms[0]);
 	rte_free(tms);
+
+	if (test_timer_perf_large(RTE_TIMER_LIST_SKIPLIST, "skiplist") < 0 ||
+			test_timer_perf_large(RTE_TIMER_LIST_WHEEL,
+				"timing wheel") < 0)
+		return -1;
+
 	return 0;
 }
 
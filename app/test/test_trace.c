@@ -0,0 +1,226 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_trace.h>
+
+#include "test.h"
+
+RTE_TRACE_POINT_DEFINE(test_trace_point, "app.test.trace", "a", "b");
+RTE_TRACE_POINT_DEFINE(test_trace_point_noarg, "app.test.trace_noarg", NULL);
+
+#define TEST_TRACE_RECORDS 100
+
+static const char *
+test_trace_path(char *buf, size_t len, const char *dir, const char *file)
+{
+	snprintf(buf, len, "%s/%s", dir, file);
+	return buf;
+}
+
+/* add the size of the integer declared on a metadata line */
+static void
+test_trace_field_size(const char *line, size_t *size)
+{
+	if (strstr(line, "uint32_t ") != NULL)
+		*size += sizeof(uint32_t);
+	else if (strstr(line, "uint64_t ") != NULL ||
+			strstr(line, "uint64_clock_t ") != NULL)
+		*size += sizeof(uint64_t);
+}
+
+/* get the sizes of the packet and event headers declared in metadata */
+static int
+test_trace_metadata_sizes(FILE *f, size_t *pkt_size, size_t *hdr_size)
+{
+	char line[256];
+	size_t *size = NULL;
+	int found = 0;
+
+	*pkt_size = 0;
+	*hdr_size = 0;
+	while (fgets(line, sizeof(line), f) != NULL) {
+		if (strstr(line, "name = \"app.test.trace\";") != NULL)
+			found = 1;
+		if (strstr(line, "packet.header := struct") != NULL ||
+				strstr(line, "packet.context := struct") != NULL)
+			size = pkt_size;
+		else if (strstr(line, "event.header := struct") != NULL)
+			size = hdr_size;
+		else if (strstr(line, "};") != NULL)
+			size = NULL;
+		else if (size != NULL)
+			test_trace_field_size(line, size);
+	}
+
+	return found;
+}
+
+static int
+test_trace_register(void)
+{
+	static const char * const fields[RTE_TRACE_ARGS_MAX] = { "a" };
+	rte_trace_point_t tp;
+
+	TEST_ASSERT_EQUAL(rte_trace_point_lookup("app.test.trace"),
+		&test_trace_point, "Tracepoint not found");
+	TEST_ASSERT_NULL(rte_trace_point_lookup("app.test.none"),
+		"Unknown tracepoint found");
+	TEST_ASSERT(__rte_trace_point_register(&tp, "app.test.trace",
+		fields) == -EEXIST, "Duplicate tracepoint registered");
+	TEST_ASSERT(!rte_trace_point_is_enabled(&test_trace_point),
+		"Tracepoint enabled by default");
+	TEST_ASSERT(rte_trace_point_enable(&tp) == -EINVAL,
+		"Unregistered tracepoint enabled");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_trace_emit(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	const struct rte_trace_record *rec;
+	struct rte_trace_buffer *buf;
+	uint64_t head;
+	unsigned int i;
+	uint32_t id;
+
+	/* disabled tracepoints do not write anything */
+	buf = rte_trace_buffers[lcore_id];
+	head = buf != NULL ? buf->head : 0;
+	rte_trace_point_emit(&test_trace_point, 1, 2, 0, 0);
+	TEST_ASSERT(buf == NULL || buf->head == head,
+		"Disabled tracepoint recorded");
+
+	TEST_ASSERT_EQUAL(rte_trace_pattern("app.test.*", 1), 2,
+		"Wrong number of tracepoints enabled");
+	TEST_ASSERT(rte_trace_point_is_enabled(&test_trace_point),
+		"Tracepoint not enabled");
+	buf = rte_trace_buffers[lcore_id];
+	TEST_ASSERT_NOT_NULL(buf, "Trace buffer not allocated");
+	TEST_ASSERT(rte_is_power_of_2(buf->size), "Wrong buffer size");
+	head = buf->head;
+	id = test_trace_point & RTE_TRACE_POINT_ID_MASK;
+
+	for (i = 0; i < TEST_TRACE_RECORDS; i++)
+		rte_trace_point_emit(&test_trace_point, i, i * 2, 0, 0);
+	rte_trace_point_emit(&test_trace_point_noarg, 0, 0, 0, 0);
+	TEST_ASSERT_EQUAL(buf->head, head + TEST_TRACE_RECORDS + 1,
+		"Wrong number of records");
+
+	for (i = 0; i < TEST_TRACE_RECORDS; i++) {
+		rec = &buf->rec[(head + i) & (buf->size - 1)];
+		TEST_ASSERT_EQUAL(rec->id, id, "Wrong record id");
+		TEST_ASSERT(rec->args[0] == i && rec->args[1] == i * 2,
+			"Wrong record arguments");
+		if (i != 0)
+			TEST_ASSERT(rec->timestamp >= (rec - 1)->timestamp,
+				"Timestamps not monotonic");
+	}
+
+	/* the oldest records are overwritten */
+	head = buf->head;
+	for (i = 0; i < buf->size + 1; i++)
+		rte_trace_point_emit(&test_trace_point, i, 0, 0, 0);
+	rec = &buf->rec[head & (buf->size - 1)];
+	TEST_ASSERT(rec->args[0] == buf->size, "Oldest record not overwritten");
+
+	TEST_ASSERT_EQUAL(rte_trace_pattern("app.test.*", 0), 2,
+		"Wrong number of tracepoints disabled");
+	head = buf->head;
+	rte_trace_point_emit(&test_trace_point, 1, 2, 0, 0);
+	TEST_ASSERT_EQUAL(buf->head, head, "Disabled tracepoint recorded");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_trace_save(void)
+{
+	char dir[] = "/tmp/dpdk_test_trace_XXXXXX";
+	char path[PATH_MAX];
+	char file[32];
+	const struct rte_trace_buffer *buf;
+	size_t pkt_size, hdr_size, rec_size, i;
+	uint64_t args[2];
+	uint32_t id, tp_id;
+	struct stat st;
+	int found;
+	FILE *f;
+	int ret;
+
+	TEST_ASSERT_NOT_NULL(mkdtemp(dir), "Cannot create directory");
+
+	ret = rte_trace_save(dir);
+	TEST_ASSERT_SUCCESS(ret, "Cannot save trace");
+
+	f = fopen(test_trace_path(path, sizeof(path), dir, "metadata"), "r");
+	TEST_ASSERT_NOT_NULL(f, "No metadata file");
+	found = test_trace_metadata_sizes(f, &pkt_size, &hdr_size);
+	fclose(f);
+	unlink(path);
+	TEST_ASSERT(found, "Tracepoint not described in metadata");
+
+	snprintf(file, sizeof(file), "channel0_%u", rte_lcore_id());
+	test_trace_path(path, sizeof(path), dir, file);
+	ret = stat(path, &st);
+	f = ret == 0 ? fopen(path, "r") : NULL;
+	unlink(path);
+	rmdir(dir);
+	TEST_ASSERT_SUCCESS(ret, "No stream file");
+	TEST_ASSERT_NOT_NULL(f, "Cannot open stream file");
+
+	/* the buffer is full of records with 2 args, the oldest ones having
+	 * 1 and 0 as arguments; decode them as described by the metadata
+	 */
+	buf = rte_trace_buffers[rte_lcore_id()];
+	tp_id = test_trace_point & RTE_TRACE_POINT_ID_MASK;
+	rec_size = hdr_size + 2 * sizeof(uint64_t);
+	ret = st.st_size == (off_t)(pkt_size + buf->size * rec_size) ? 0 : -1;
+	for (i = 0; i < 2 && ret == 0; i++) {
+		if (fseek(f, pkt_size + i * rec_size + sizeof(uint64_t),
+				SEEK_SET) != 0 ||
+				fread(&id, sizeof(id), 1, f) != 1 ||
+				fseek(f, pkt_size + i * rec_size + hdr_size,
+					SEEK_SET) != 0 ||
+				fread(args, sizeof(args), 1, f) != 1 ||
+				id != tp_id ||
+				args[0] != i + 1 || args[1] != 0)
+			ret = -1;
+	}
+	fclose(f);
+	TEST_ASSERT_SUCCESS(ret, "Stream file does not match the metadata");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite trace_tests = {
+	.suite_name = "trace autotest",
+	.setup = NULL,
+	.teardown = NULL,
+	.unit_test_cases = {
+		TEST_CASE(test_trace_register),
+		TEST_CASE(test_trace_emit),
+		TEST_CASE(test_trace_save),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_trace(void)
+{
+	return unit_test_suite_runner(&trace_tests);
+}
+
+REGISTER_TEST_COMMAND(trace_autotest, test_trace);
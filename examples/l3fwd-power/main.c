@@ -27,6 +27,7 @@
 #include <rte_cycles.h>
 #include <rte_prefetch.h>
 #include <rte_lcore.h>
+#include <rte_lcore_poll.h>
 #include <rte_per_lcore.h>
 #include <rte_branch_prediction.h>
 #include <rte_interrupts.h>
@@ -987,6 +988,7 @@ main_loop(__attribute__((unused)) void *dummy)
 	enum freq_scale_hint_t lcore_scaleup_hint;
 	uint32_t lcore_rx_idle_count = 0;
 	uint32_t lcore_idle_hint = 0;
+	uint32_t lcore_rx_count;
 	int intr_en = 0;
 
 	const uint64_t drain_tsc = (rte_get_tsc_hz() + US_PER_S - 1) / US_PER_S * BURST_TX_DRAIN_US;
@@ -1050,6 +1052,7 @@ main_loop(__attribute__((unused)) void *dummy)
 		 */
 		lcore_scaleup_hint = FREQ_CURRENT;
 		lcore_rx_idle_count = 0;
+		lcore_rx_count = 0;
 		for (i = 0; i < qconf->n_rx_queue; ++i) {
 			rx_queue = &(qconf->rx_queue_list[i]);
 			rx_queue->idle_hint = 0;
@@ -1060,6 +1063,7 @@ main_loop(__attribute__((unused)) void *dummy)
 								MAX_PKT_BURST);
 
 			stats[lcore_id].nb_rx_processed += nb_rx;
+			lcore_rx_count += nb_rx;
 			if (unlikely(nb_rx == 0)) {
 				/**
 				 * no packet received from rx queue, try to
@@ -1152,9 +1156,12 @@ main_loop(__attribute__((unused)) void *dummy)
 			else {
 				/* suspend until rx interrupt trigges */
 				if (intr_en) {
+					rte_lcore_poll_mark(0);
 					turn_on_intr(qconf);
 					sleep_until_rx_interrupt(
 						qconf->n_rx_queue);
+					/* the lcore was not polling while sleeping */
+					rte_lcore_poll_resume();
 					/**
 					 * start receiving packets immediately
 					 */
@@ -1163,6 +1170,8 @@ main_loop(__attribute__((unused)) void *dummy)
 			}
 			stats[lcore_id].sleep_time += lcore_idle_hint;
 		}
+
+		rte_lcore_poll_mark(lcore_rx_count);
 	}
 }
 
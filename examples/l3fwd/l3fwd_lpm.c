@@ -74,6 +74,9 @@ static struct ipv6_l3fwd_lpm_route ipv6_l3fwd_lpm_route_array[] = {
 struct rte_lpm *ipv4_l3fwd_lpm_lookup_struct[NB_SOCKETS];
 struct rte_lpm6 *ipv6_l3fwd_lpm_lookup_struct[NB_SOCKETS];
 
+/* Vector bulk lookup of the IPv4 tables, NULL if the CPU has none */
+static rte_lpm_lookup_bulk_fn_t ipv4_l3fwd_lpm_lookup_bulk;
+
 static inline uint16_t
 lpm_get_ipv4_dst_port(void *ipv4_hdr, uint16_t portid, void *lookup_struct)
 {
@@ -296,6 +299,18 @@ setup_lpm(const int socketid)
 			ipv4_l3fwd_lpm_route_array[i].if_out);
 	}
 
+	/* the tables of all the sockets have the same configuration */
+	ipv4_l3fwd_lpm_lookup_bulk = NULL;
+#ifdef RTE_ENABLE_AVX512
+	ipv4_l3fwd_lpm_lookup_bulk = rte_lpm_get_lookup_bulk_fn(
+			ipv4_l3fwd_lpm_lookup_struct[socketid],
+			RTE_LPM_LOOKUP_VECTOR_AVX512);
+#endif
+	if (ipv4_l3fwd_lpm_lookup_bulk == NULL)
+		ipv4_l3fwd_lpm_lookup_bulk = rte_lpm_get_lookup_bulk_fn(
+			ipv4_l3fwd_lpm_lookup_struct[socketid],
+			RTE_LPM_LOOKUP_VECTOR_AVX2);
+
 	/* create the LPM6 table */
 	snprintf(s, sizeof(s), "IPV6_L3FWD_LPM_%d", socketid);
 
@@ -77,6 +77,39 @@ processx4_step2(const struct lcore_conf *qconf,
 	}
 }
 
+/*
+ * Lookup of the destination ports of a burst with the vector bulk lookup:
+ * the destination addresses of all the packets are looked up at once, and
+ * the results kept for the IPv4 packets only.
+ */
+static inline void
+lpm_get_dst_ports_bulk(const struct lcore_conf *qconf,
+		struct rte_mbuf **pkts, int32_t nb_rx, uint16_t portid,
+		uint16_t dprt[MAX_PKT_BURST])
+{
+	uint32_t dip[MAX_PKT_BURST];
+	uint32_t next_hops[MAX_PKT_BURST];
+	struct ipv4_hdr *ipv4_hdr;
+	int32_t j;
+
+	for (j = 0; j != nb_rx; j++) {
+		ipv4_hdr = rte_pktmbuf_mtod_offset(pkts[j], struct ipv4_hdr *,
+				sizeof(struct ether_hdr));
+		dip[j] = rte_be_to_cpu_32(ipv4_hdr->dst_addr);
+	}
+
+	ipv4_l3fwd_lpm_lookup_bulk(qconf->ipv4_lookup_struct, dip, next_hops,
+			nb_rx);
+
+	for (j = 0; j != nb_rx; j++) {
+		if (likely(RTE_ETH_IS_IPV4_HDR(pkts[j]->packet_type)))
+			dprt[j] = (next_hops[j] & RTE_LPM_LOOKUP_SUCCESS) ?
+				(uint16_t)next_hops[j] : portid;
+		else
+			dprt[j] = lpm_get_dst_port(qconf, pkts[j], portid);
+	}
+}
+
 /*
  * Buffer optimized handling of packets, invoked
  * from main_loop.
@@ -91,6 +124,13 @@ l3fwd_lpm_send_packets(int nb_rx, struct rte_mbuf **pkts_burst,
 	uint32_t ipv4_flag[MAX_PKT_BURST / FWDSTEP];
 	const int32_t k = RTE_ALIGN_FLOOR(nb_rx, FWDSTEP);
 
+	if (ipv4_l3fwd_lpm_lookup_bulk != NULL) {
+		lpm_get_dst_ports_bulk(qconf, pkts_burst, nb_rx, portid,
+				dst_port);
+		send_packets_multi(qconf, pkts_burst, dst_port, nb_rx);
+		return;
+	}
+
 	for (j = 0; j != k; j += FWDSTEP)
 		processx4_step1(&pkts_burst[j], &dip[j / FWDSTEP],
 				&ipv4_flag[j / FWDSTEP]);
@@ -47,6 +47,13 @@ static struct rte_cryptodev rte_crypto_devices[RTE_CRYPTO_MAX_DEVS];
 
 struct rte_cryptodev *rte_cryptodevs = rte_crypto_devices;
 
+RTE_TRACE_POINT_DEFINE(rte_cryptodev_trace_enqueue_burst,
+		"lib.cryptodev.enqueue_burst",
+		"dev_id", "qp_id", "nb_ops", "nb_enq");
+RTE_TRACE_POINT_DEFINE(rte_cryptodev_trace_dequeue_burst,
+		"lib.cryptodev.dequeue_burst",
+		"dev_id", "qp_id", "nb_ops", "nb_deq");
+
 static struct rte_cryptodev_global cryptodev_globals = {
 		.devs			= rte_crypto_devices,
 		.data			= { NULL },
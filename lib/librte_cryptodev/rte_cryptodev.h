@@ -23,6 +23,7 @@ extern "C" {
 #include "rte_dev.h"
 #include <rte_common.h>
 #include <rte_config.h>
+#include <rte_trace.h>
 
 extern const char **rte_cyptodev_names;
 
@@ -858,6 +859,12 @@ struct rte_cryptodev_data {
 } __rte_cache_aligned;
 
 extern struct rte_cryptodev *rte_cryptodevs;
+
+/** @internal Tracepoint of rte_cryptodev_enqueue_burst(). */
+extern rte_trace_point_t rte_cryptodev_trace_enqueue_burst;
+/** @internal Tracepoint of rte_cryptodev_dequeue_burst(). */
+extern rte_trace_point_t rte_cryptodev_trace_dequeue_burst;
+
 /**
  *
  * Dequeue a burst of processed crypto operations from a queue on the crypto
@@ -899,11 +906,15 @@ rte_cryptodev_dequeue_burst(uint8_t dev_id, uint16_t qp_id,
 		struct rte_crypto_op **ops, uint16_t nb_ops)
 {
 	struct rte_cryptodev *dev = &rte_cryptodevs[dev_id];
+	uint16_t nb_deq;
 
-	nb_ops = (*dev->dequeue_burst)
+	nb_deq = (*dev->dequeue_burst)
 			(dev->data->queue_pairs[qp_id], ops, nb_ops);
 
-	return nb_ops;
+	rte_trace_point_emit_fp(&rte_cryptodev_trace_dequeue_burst, dev_id,
+			qp_id, nb_ops, nb_deq);
+
+	return nb_deq;
 }
 
 /**
@@ -942,9 +953,15 @@ rte_cryptodev_enqueue_burst(uint8_t dev_id, uint16_t qp_id,
 		struct rte_crypto_op **ops, uint16_t nb_ops)
 {
 	struct rte_cryptodev *dev = &rte_cryptodevs[dev_id];
+	uint16_t nb_enq;
 
-	return (*dev->enqueue_burst)(
+	nb_enq = (*dev->enqueue_burst)(
 			dev->data->queue_pairs[qp_id], ops, nb_ops);
+
+	rte_trace_point_emit_fp(&rte_cryptodev_trace_enqueue_burst, dev_id,
+			qp_id, nb_ops, nb_enq);
+
+	return nb_enq;
 }
 
 
@@ -813,6 +813,12 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	if (eal_trace_init() < 0) {
+		rte_eal_init_alert("Cannot init trace");
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
 	/* Probe all the buses and devices/drivers on them */
 	if (rte_bus_probe()) {
 		rte_eal_init_alert("Cannot probe devices");
@@ -855,6 +861,7 @@ rte_eal_init(int argc, char **argv)
 int __rte_experimental
 rte_eal_cleanup(void)
 {
+	eal_trace_fini();
 	rte_service_finalize();
 	rte_mp_channel_cleanup();
 	eal_cleanup_config(&internal_config);
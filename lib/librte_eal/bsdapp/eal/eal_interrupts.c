@@ -7,6 +7,7 @@
 #include <sys/event.h>
 #include <sys/queue.h>
 #include <unistd.h>
+#include <pthread_np.h>
 
 #include <rte_errno.h>
 #include <rte_lcore.h>
@@ -476,6 +477,28 @@ rte_eal_intr_init(void)
 	return ret;
 }
 
+unsigned int __rte_experimental
+rte_intr_thread_count(void)
+{
+	return kq < 0 ? 0 : 1;
+}
+
+int __rte_experimental
+rte_intr_thread_affinity_set(unsigned int thread_id,
+		const rte_cpuset_t *cpuset)
+{
+	int ret;
+
+	if (thread_id >= rte_intr_thread_count() || cpuset == NULL)
+		return -EINVAL;
+
+	ret = pthread_setaffinity_np(intr_thread, sizeof(*cpuset), cpuset);
+	if (ret != 0)
+		return -ret;
+
+	return 0;
+}
+
 int
 rte_intr_rx_ctl(struct rte_intr_handle *intr_handle,
 		int epfd, int op, unsigned int vec, void *data)
@@ -23,6 +23,7 @@
 
 #include "eal_private.h"
 #include "eal_thread.h"
+#include "malloc_slab.h"
 
 RTE_DEFINE_PER_LCORE(unsigned, _lcore_id) = LCORE_ID_ANY;
 RTE_DEFINE_PER_LCORE(unsigned, _socket_id) = (unsigned)SOCKET_ID_ANY;
@@ -152,6 +153,9 @@ eal_thread_loop(__attribute__((unused)) void *arg)
 		fct_arg = lcore_config[lcore_id].arg;
 		ret = lcore_config[lcore_id].f(fct_arg);
 		lcore_config[lcore_id].ret = ret;
+
+		/* do not keep memory cached by an lcore going idle */
+		malloc_slab_flush_lcore();
 		rte_wmb();
 		lcore_config[lcore_id].state = FINISHED;
 	}
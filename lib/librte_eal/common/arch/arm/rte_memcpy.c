@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_memcpy.h>
+
+void * __rte_experimental
+rte_memcpy_nt(void *dst, const void *src, size_t n)
+{
+	return memcpy(dst, src, n);
+}
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_cpuflags.h>
+#include <rte_memcpy.h>
+
+#include "rte_memcpy_internal.h"
+
+/* copies smaller than this are not worth bypassing the caches */
+#define MEMCPY_NT_THRESHOLD 256
+
+typedef void *(*memcpy_func_t)(void *dst, const void *src, size_t n);
+
+/* the build instruction set is used until the CPU flags are checked */
+static memcpy_func_t memcpy_large = rte_memcpy_large_sse;
+static memcpy_func_t memcpy_nt = rte_memcpy_nt_sse;
+
+/* implementations for the build instruction set, at least SSE */
+void *
+rte_memcpy_large_sse(void *dst, const void *src, size_t n)
+{
+	if (!(((uintptr_t)dst | (uintptr_t)src) & ALIGNMENT_MASK))
+		return rte_memcpy_aligned(dst, src, n);
+	return rte_memcpy_generic(dst, src, n);
+}
+
+void *
+rte_memcpy_nt_sse(void *dst, const void *src, size_t n)
+{
+	uint8_t *d = dst;
+	const uint8_t *s = src;
+	size_t head;
+
+	/* non-temporal stores require an aligned destination */
+	head = -(uintptr_t)d & 0xF;
+	if (head != 0) {
+		rte_mov16(d, s);
+		d += head;
+		s += head;
+		n -= head;
+	}
+
+	for (; n >= 64; n -= 64) {
+		__m128i x0 = _mm_loadu_si128((const __m128i *)(s + 0 * 16));
+		__m128i x1 = _mm_loadu_si128((const __m128i *)(s + 1 * 16));
+		__m128i x2 = _mm_loadu_si128((const __m128i *)(s + 2 * 16));
+		__m128i x3 = _mm_loadu_si128((const __m128i *)(s + 3 * 16));
+
+		_mm_stream_si128((__m128i *)(d + 0 * 16), x0);
+		_mm_stream_si128((__m128i *)(d + 1 * 16), x1);
+		_mm_stream_si128((__m128i *)(d + 2 * 16), x2);
+		_mm_stream_si128((__m128i *)(d + 3 * 16), x3);
+		d += 64;
+		s += 64;
+	}
+
+	/* order the non-temporal stores before the following ones */
+	_mm_sfence();
+
+	if (n != 0)
+		rte_memcpy_generic(d, s, n);
+
+	return dst;
+}
+
+void *
+__rte_memcpy_large(void *dst, const void *src, size_t n)
+{
+	return memcpy_large(dst, src, n);
+}
+
+void * __rte_experimental
+rte_memcpy_nt(void *dst, const void *src, size_t n)
+{
+	if (n < MEMCPY_NT_THRESHOLD)
+		return rte_memcpy(dst, src, n);
+	return memcpy_nt(dst, src, n);
+}
+
+RTE_INIT(rte_memcpy_init)
+{
+	/* AVX512 may lower the core frequency, it is opt-in like in the
+	 * build target selection
+	 */
+#if defined(CC_AVX512F_SUPPORT) && defined(RTE_ENABLE_AVX512)
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F)) {
+		memcpy_large = rte_memcpy_large_avx512f;
+		memcpy_nt = rte_memcpy_nt_avx512f;
+		return;
+	}
+#endif
+#ifdef CC_AVX2_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2)) {
+		memcpy_large = rte_memcpy_large_avx2;
+		memcpy_nt = rte_memcpy_nt_avx2;
+	}
+#endif
+}
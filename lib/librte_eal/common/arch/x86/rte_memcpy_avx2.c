@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_config.h>
+
+/* select the AVX2 implementation of rte_memcpy.h, this file being built
+ * with the AVX2 instruction set whatever the build target
+ */
+#undef RTE_MACHINE_CPUFLAG_AVX512F
+#ifndef RTE_MACHINE_CPUFLAG_AVX2
+#define RTE_MACHINE_CPUFLAG_AVX2 1
+#endif
+
+#include <rte_memcpy.h>
+
+#include "rte_memcpy_internal.h"
+
+void *
+rte_memcpy_large_avx2(void *dst, const void *src, size_t n)
+{
+	if (!(((uintptr_t)dst | (uintptr_t)src) & ALIGNMENT_MASK))
+		return rte_memcpy_aligned(dst, src, n);
+	return rte_memcpy_generic(dst, src, n);
+}
+
+void *
+rte_memcpy_nt_avx2(void *dst, const void *src, size_t n)
+{
+	uint8_t *d = dst;
+	const uint8_t *s = src;
+	size_t head;
+
+	/* non-temporal stores require an aligned destination */
+	head = -(uintptr_t)d & 0x1F;
+	if (head != 0) {
+		rte_mov32(d, s);
+		d += head;
+		s += head;
+		n -= head;
+	}
+
+	for (; n >= 128; n -= 128) {
+		__m256i y0 = _mm256_loadu_si256((const __m256i *)(s + 0 * 32));
+		__m256i y1 = _mm256_loadu_si256((const __m256i *)(s + 1 * 32));
+		__m256i y2 = _mm256_loadu_si256((const __m256i *)(s + 2 * 32));
+		__m256i y3 = _mm256_loadu_si256((const __m256i *)(s + 3 * 32));
+
+		_mm256_stream_si256((__m256i *)(d + 0 * 32), y0);
+		_mm256_stream_si256((__m256i *)(d + 1 * 32), y1);
+		_mm256_stream_si256((__m256i *)(d + 2 * 32), y2);
+		_mm256_stream_si256((__m256i *)(d + 3 * 32), y3);
+		d += 128;
+		s += 128;
+	}
+
+	/* order the non-temporal stores before the following ones */
+	_mm_sfence();
+
+	if (n != 0)
+		rte_memcpy_generic(d, s, n);
+
+	return dst;
+}
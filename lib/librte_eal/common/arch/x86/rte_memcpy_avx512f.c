@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_config.h>
+
+/* select the AVX512 implementation of rte_memcpy.h, this file being built
+ * with the AVX512F instruction set whatever the build target
+ */
+#ifndef RTE_MACHINE_CPUFLAG_AVX512F
+#define RTE_MACHINE_CPUFLAG_AVX512F 1
+#endif
+
+#include <rte_memcpy.h>
+
+#include "rte_memcpy_internal.h"
+
+void *
+rte_memcpy_large_avx512f(void *dst, const void *src, size_t n)
+{
+	if (!(((uintptr_t)dst | (uintptr_t)src) & ALIGNMENT_MASK))
+		return rte_memcpy_aligned(dst, src, n);
+	return rte_memcpy_generic(dst, src, n);
+}
+
+void *
+rte_memcpy_nt_avx512f(void *dst, const void *src, size_t n)
+{
+	uint8_t *d = dst;
+	const uint8_t *s = src;
+	size_t head;
+
+	/* non-temporal stores require an aligned destination */
+	head = -(uintptr_t)d & 0x3F;
+	if (head != 0) {
+		rte_mov64(d, s);
+		d += head;
+		s += head;
+		n -= head;
+	}
+
+	for (; n >= 256; n -= 256) {
+		__m512i z0 = _mm512_loadu_si512((const void *)(s + 0 * 64));
+		__m512i z1 = _mm512_loadu_si512((const void *)(s + 1 * 64));
+		__m512i z2 = _mm512_loadu_si512((const void *)(s + 2 * 64));
+		__m512i z3 = _mm512_loadu_si512((const void *)(s + 3 * 64));
+
+		_mm512_stream_si512((void *)(d + 0 * 64), z0);
+		_mm512_stream_si512((void *)(d + 1 * 64), z1);
+		_mm512_stream_si512((void *)(d + 2 * 64), z2);
+		_mm512_stream_si512((void *)(d + 3 * 64), z3);
+		d += 256;
+		s += 256;
+	}
+
+	/* order the non-temporal stores before the following ones */
+	_mm_sfence();
+
+	if (n != 0)
+		rte_memcpy_generic(d, s, n);
+
+	return dst;
+}
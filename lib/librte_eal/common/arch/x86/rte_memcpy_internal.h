@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_MEMCPY_INTERNAL_H_
+#define _RTE_MEMCPY_INTERNAL_H_
+
+/*
+ * Implementations of the large and non-temporal copies for each instruction
+ * set, selected at runtime by rte_memcpy.c.
+ */
+
+#include <stddef.h>
+
+void *rte_memcpy_large_sse(void *dst, const void *src, size_t n);
+void *rte_memcpy_nt_sse(void *dst, const void *src, size_t n);
+
+void *rte_memcpy_large_avx2(void *dst, const void *src, size_t n);
+void *rte_memcpy_nt_avx2(void *dst, const void *src, size_t n);
+
+void *rte_memcpy_large_avx512f(void *dst, const void *src, size_t n);
+void *rte_memcpy_nt_avx512f(void *dst, const void *src, size_t n);
+
+#endif /* _RTE_MEMCPY_INTERNAL_H_ */
@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_lcore_poll.h>
+
+struct rte_lcore_poll rte_lcore_poll_data[RTE_MAX_LCORE];
+
+/*
+ * Statistics of the lcores at their last reset. The accounting state is
+ * written by its lcore only, so a reset from another thread records the
+ * current statistics, subtracted when they are read, rather than clearing
+ * them.
+ */
+static struct rte_lcore_poll_stats poll_base[RTE_MAX_LCORE];
+
+int __rte_experimental
+rte_lcore_poll_stats_get(unsigned int lcore_id,
+		struct rte_lcore_poll_stats *stats)
+{
+	const volatile struct rte_lcore_poll_stats *cur;
+	const struct rte_lcore_poll_stats *base;
+	unsigned int i;
+
+	if (lcore_id >= RTE_MAX_LCORE || stats == NULL)
+		return -EINVAL;
+
+	cur = &rte_lcore_poll_data[lcore_id].stats;
+	base = &poll_base[lcore_id];
+
+	stats->busy_cycles = cur->busy_cycles - base->busy_cycles;
+	stats->idle_cycles = cur->idle_cycles - base->idle_cycles;
+	for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+		stats->hist[i] = cur->hist[i] - base->hist[i];
+
+	return 0;
+}
+
+int __rte_experimental
+rte_lcore_poll_stats_reset(unsigned int lcore_id)
+{
+	const volatile struct rte_lcore_poll_stats *cur;
+	struct rte_lcore_poll_stats *base;
+	unsigned int i;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	cur = &rte_lcore_poll_data[lcore_id].stats;
+	base = &poll_base[lcore_id];
+
+	base->busy_cycles = cur->busy_cycles;
+	base->idle_cycles = cur->idle_cycles;
+	for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+		base->hist[i] = cur->hist[i];
+
+	return 0;
+}
+
+int __rte_experimental
+rte_lcore_poll_busy_percent(unsigned int lcore_id)
+{
+	struct rte_lcore_poll_stats stats;
+	uint64_t total;
+	int ret;
+
+	ret = rte_lcore_poll_stats_get(lcore_id, &stats);
+	if (ret < 0)
+		return ret;
+
+	total = stats.busy_cycles + stats.idle_cycles;
+	if (total == 0)
+		return -ENODATA;
+
+	return (int)(stats.busy_cycles * 100 / total);
+}
+
+void __rte_experimental
+rte_lcore_poll_dump(FILE *f)
+{
+	struct rte_lcore_poll_stats stats;
+	unsigned int lcore_id, i;
+	uint64_t iterations;
+
+	fprintf(f, "lcore poll stats:\n");
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (rte_lcore_poll_data[lcore_id].last_tsc == 0)
+			continue;
+
+		rte_lcore_poll_stats_get(lcore_id, &stats);
+		iterations = 0;
+		for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+			iterations += stats.hist[i];
+
+		fprintf(f, "  lcore %u: busy %"PRIu64" idle %"PRIu64
+			" cycles, %"PRIu64" iterations (%"PRIu64" idle)\n",
+			lcore_id, stats.busy_cycles, stats.idle_cycles,
+			iterations, stats.hist[0]);
+		fprintf(f, "    work histogram:");
+		for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++)
+			fprintf(f, " %"PRIu64, stats.hist[i]);
+		fprintf(f, "\n");
+	}
+}
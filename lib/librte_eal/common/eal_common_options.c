@@ -80,6 +80,11 @@ eal_long_options[] = {
 	{OPT_LEGACY_MEM,        0, NULL, OPT_LEGACY_MEM_NUM       },
 	{OPT_SINGLE_FILE_SEGMENTS, 0, NULL, OPT_SINGLE_FILE_SEGMENTS_NUM},
 	{OPT_MATCH_ALLOCATIONS, 0, NULL, OPT_MATCH_ALLOCATIONS_NUM},
+	{OPT_MEM_INIT_THREADS,  1, NULL, OPT_MEM_INIT_THREADS_NUM },
+	{OPT_MEM_INIT_LAZY,     0, NULL, OPT_MEM_INIT_LAZY_NUM    },
+	{OPT_TRACE,             1, NULL, OPT_TRACE_NUM            },
+	{OPT_TRACE_DIR,         1, NULL, OPT_TRACE_DIR_NUM        },
+	{OPT_INTR_THREADS,      1, NULL, OPT_INTR_THREADS_NUM     },
 	{0,                     0, NULL, 0                        }
 };
 
@@ -202,6 +207,9 @@ eal_reset_internal_config(struct internal_config *internal_cfg)
 		internal_cfg->hugepage_info[i].lock_descriptor = -1;
 	}
 	internal_cfg->base_virtaddr = 0;
+	internal_cfg->mem_init_threads = 1;
+	internal_cfg->mem_init_lazy = 0;
+	internal_cfg->intr_threads = 1;
 
 	internal_cfg->syslog_facility = LOG_DAEMON;
 
@@ -217,6 +225,7 @@ eal_reset_internal_config(struct internal_config *internal_cfg)
 	internal_cfg->create_uio_dev = 0;
 	internal_cfg->iova_mode = RTE_IOVA_DC;
 	internal_cfg->user_mbuf_pool_ops_name = NULL;
+	internal_cfg->trace_dir = NULL;
 	internal_cfg->init_complete = 0;
 }
 
@@ -1323,6 +1332,21 @@ eal_parse_common_option(int opt, const char *optarg,
 			return -1;
 		}
 		break;
+	case OPT_TRACE_NUM:
+		if (eal_trace_pattern_save(optarg) < 0) {
+			RTE_LOG(ERR, EAL, "invalid parameters for --"
+				OPT_TRACE "\n");
+			return -1;
+		}
+		break;
+	case OPT_TRACE_DIR_NUM:
+		free(conf->trace_dir);
+		conf->trace_dir = strdup(optarg);
+		if (conf->trace_dir == NULL) {
+			RTE_LOG(ERR, EAL, "Could not store trace directory\n");
+			return -1;
+		}
+		break;
 
 	/* don't know what to do, leave this to caller */
 	default:
@@ -1369,6 +1393,8 @@ eal_cleanup_config(struct internal_config *internal_cfg)
 		free(internal_cfg->hugepage_dir);
 	if (internal_cfg->user_mbuf_pool_ops_name != NULL)
 		free(internal_cfg->user_mbuf_pool_ops_name);
+	if (internal_cfg->trace_dir != NULL)
+		free(internal_cfg->trace_dir);
 
 	return 0;
 }
@@ -1478,6 +1504,16 @@ eal_check_common_options(struct internal_config *internal_cfg)
 				"with --"OPT_MATCH_ALLOCATIONS"\n");
 		return -1;
 	}
+	if (internal_cfg->no_hugetlbfs && internal_cfg->mem_init_lazy) {
+		RTE_LOG(ERR, EAL, "Option --"OPT_NO_HUGE" is not compatible "
+				"with --"OPT_MEM_INIT_LAZY"\n");
+		return -1;
+	}
+	if (internal_cfg->legacy_mem && internal_cfg->mem_init_lazy) {
+		RTE_LOG(ERR, EAL, "Option --"OPT_LEGACY_MEM" is not compatible "
+				"with --"OPT_MEM_INIT_LAZY"\n");
+		return -1;
+	}
 
 	return 0;
 }
@@ -1526,6 +1562,10 @@ eal_common_usage(void)
 	       "  --"OPT_LOG_LEVEL"=<int>   Set global log level\n"
 	       "  --"OPT_LOG_LEVEL"=<type-match>:<int>\n"
 	       "                      Set specific log level\n"
+	       "  --"OPT_TRACE"=<glob>      Enable the matching tracepoints\n"
+	       "                      (can be used multiple times)\n"
+	       "  --"OPT_TRACE_DIR"=<dir>   Save the trace in CTF in this directory\n"
+	       "                      on rte_eal_cleanup()\n"
 	       "  -v                  Display version information on startup\n"
 	       "  -h, --help          This help\n"
 	       "  --"OPT_IN_MEMORY"   Operate entirely in memory. This will\n"
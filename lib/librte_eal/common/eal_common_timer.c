@@ -55,6 +55,16 @@ rte_delay_us_sleep(unsigned int us)
 	}
 }
 
+uint64_t
+eal_get_time_us(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+		return 0;
+	return (uint64_t)ts.tv_sec * US_PER_S + ts.tv_nsec / 1000;
+}
+
 uint64_t
 rte_get_tsc_hz(void)
 {
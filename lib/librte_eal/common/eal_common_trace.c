@@ -0,0 +1,572 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <errno.h>
+#include <fnmatch.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/queue.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_eal.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+#include <rte_string_fns.h>
+#include <rte_trace.h>
+#include <rte_version.h>
+
+#include "eal_internal_cfg.h"
+#include "eal_private.h"
+
+/* number of records of the trace buffer of an lcore, a power of 2 */
+#define TRACE_BUF_SIZE 16384
+#define TRACE_POINT_MAX 512
+
+/* CTF magic number of the stream packets */
+#define CTF_MAGIC 0xc1fc1fc1
+
+struct trace_point {
+	rte_trace_point_t *handle;
+	char name[RTE_TRACE_NAME_SIZE];
+	const char *fields[RTE_TRACE_ARGS_MAX];
+	unsigned int nb_fields;
+};
+
+struct trace_pattern {
+	TAILQ_ENTRY(trace_pattern) next;
+	char *pattern;
+};
+
+TAILQ_HEAD(trace_pattern_list, trace_pattern);
+
+/* tracepoint of ID n is points[n - 1], ID 0 is never valid */
+static struct {
+	struct trace_point points[TRACE_POINT_MAX];
+	unsigned int nb_points;
+	/* patterns given with --trace, for the late registrations */
+	struct trace_pattern_list patterns;
+	/* true once the buffers can be allocated */
+	bool ready;
+	rte_spinlock_t lock;
+} trace = {
+	.patterns = TAILQ_HEAD_INITIALIZER(trace.patterns),
+	.lock = RTE_SPINLOCK_INITIALIZER,
+};
+
+struct rte_trace_buffer *rte_trace_buffers[RTE_MAX_LCORE];
+
+/* CTF stream packet, with its header and context */
+struct ctf_packet {
+	uint32_t magic;
+	uint32_t stream_id;
+	uint64_t timestamp_begin;
+	uint64_t timestamp_end;
+	uint64_t content_size; /* in bits */
+	uint64_t packet_size; /* in bits */
+	uint32_t cpu_id;
+	uint32_t padding;
+};
+
+static struct trace_point *
+trace_point_find(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0; i < trace.nb_points; i++)
+		if (strcmp(trace.points[i].name, name) == 0)
+			return &trace.points[i];
+
+	return NULL;
+}
+
+static int
+trace_point_valid(const rte_trace_point_t *tp)
+{
+	uint32_t id;
+
+	if (tp == NULL)
+		return 0;
+	id = __atomic_load_n(tp, __ATOMIC_RELAXED) & RTE_TRACE_POINT_ID_MASK;
+	return id != 0 && id <= trace.nb_points &&
+		trace.points[id - 1].handle == tp;
+}
+
+/* allocate the buffers of the lcores which do not have one yet */
+static int
+trace_buffers_alloc(void)
+{
+	struct rte_trace_buffer *buf;
+	unsigned int lcore_id;
+	size_t size;
+
+	size = sizeof(*buf) + TRACE_BUF_SIZE * sizeof(buf->rec[0]);
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (rte_eal_lcore_role(lcore_id) == ROLE_OFF ||
+				rte_trace_buffers[lcore_id] != NULL)
+			continue;
+
+		buf = rte_zmalloc_socket("trace_buffer", size,
+				RTE_CACHE_LINE_SIZE,
+				rte_lcore_to_socket_id(lcore_id));
+		if (buf == NULL) {
+			RTE_LOG(ERR, EAL,
+				"Cannot allocate trace buffer of lcore %u\n",
+				lcore_id);
+			return -ENOMEM;
+		}
+		buf->size = TRACE_BUF_SIZE;
+		buf->lcore_id = lcore_id;
+		__atomic_store_n(&rte_trace_buffers[lcore_id], buf,
+				__ATOMIC_RELEASE);
+	}
+
+	return 0;
+}
+
+static int
+trace_point_set(rte_trace_point_t *tp, bool enable)
+{
+	int ret;
+
+	if (!enable) {
+		__atomic_and_fetch(tp, ~RTE_TRACE_POINT_ENABLED,
+				__ATOMIC_RELEASE);
+		return 0;
+	}
+
+	/* before the EAL initialization, the buffers are allocated by
+	 * eal_trace_init()
+	 */
+	if (trace.ready) {
+		ret = trace_buffers_alloc();
+		if (ret < 0)
+			return ret;
+	}
+	__atomic_or_fetch(tp, RTE_TRACE_POINT_ENABLED, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+int __rte_experimental
+__rte_trace_point_register(rte_trace_point_t *tp, const char *name,
+		const char * const fields[RTE_TRACE_ARGS_MAX])
+{
+	struct trace_pattern *pat;
+	struct trace_point *p;
+	unsigned int i;
+	int ret = 0;
+
+	if (tp == NULL || name == NULL || fields == NULL)
+		return -EINVAL;
+	if (strlen(name) >= RTE_TRACE_NAME_SIZE)
+		return -ENAMETOOLONG;
+
+	rte_spinlock_lock(&trace.lock);
+
+	if (trace_point_find(name) != NULL) {
+		ret = -EEXIST;
+		goto out;
+	}
+	if (trace.nb_points == TRACE_POINT_MAX) {
+		ret = -ENOSPC;
+		goto out;
+	}
+
+	p = &trace.points[trace.nb_points];
+	strlcpy(p->name, name, sizeof(p->name));
+	for (i = 0; i < RTE_TRACE_ARGS_MAX && fields[i] != NULL; i++)
+		p->fields[i] = fields[i];
+	p->nb_fields = i;
+	p->handle = tp;
+	trace.nb_points++;
+	__atomic_store_n(tp, trace.nb_points, __ATOMIC_RELAXED);
+
+	TAILQ_FOREACH(pat, &trace.patterns, next) {
+		if (fnmatch(pat->pattern, name, 0) == 0) {
+			ret = trace_point_set(tp, true);
+			break;
+		}
+	}
+
+out:
+	rte_spinlock_unlock(&trace.lock);
+	return ret;
+}
+
+rte_trace_point_t * __rte_experimental
+rte_trace_point_lookup(const char *name)
+{
+	struct trace_point *p;
+
+	if (name == NULL)
+		return NULL;
+
+	rte_spinlock_lock(&trace.lock);
+	p = trace_point_find(name);
+	rte_spinlock_unlock(&trace.lock);
+
+	return p != NULL ? p->handle : NULL;
+}
+
+int __rte_experimental
+rte_trace_point_enable(rte_trace_point_t *tp)
+{
+	int ret;
+
+	if (!trace_point_valid(tp))
+		return -EINVAL;
+
+	rte_spinlock_lock(&trace.lock);
+	ret = trace_point_set(tp, true);
+	rte_spinlock_unlock(&trace.lock);
+
+	return ret;
+}
+
+int __rte_experimental
+rte_trace_point_disable(rte_trace_point_t *tp)
+{
+	if (!trace_point_valid(tp))
+		return -EINVAL;
+
+	return trace_point_set(tp, false);
+}
+
+int __rte_experimental
+rte_trace_point_is_enabled(rte_trace_point_t *tp)
+{
+	if (!trace_point_valid(tp))
+		return 0;
+
+	return !!(__atomic_load_n(tp, __ATOMIC_RELAXED) &
+		RTE_TRACE_POINT_ENABLED);
+}
+
+int __rte_experimental
+rte_trace_pattern(const char *pattern, int enable)
+{
+	unsigned int i;
+	int count = 0;
+	int ret = 0;
+
+	if (pattern == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&trace.lock);
+	for (i = 0; i < trace.nb_points; i++) {
+		if (fnmatch(pattern, trace.points[i].name, 0) != 0)
+			continue;
+		ret = trace_point_set(trace.points[i].handle, enable != 0);
+		if (ret < 0)
+			break;
+		count++;
+	}
+	rte_spinlock_unlock(&trace.lock);
+
+	return ret < 0 ? ret : count;
+}
+
+int
+eal_trace_pattern_save(const char *pattern)
+{
+	struct trace_pattern *pat;
+	int ret;
+
+	pat = malloc(sizeof(*pat));
+	if (pat == NULL)
+		return -ENOMEM;
+	pat->pattern = strdup(pattern);
+	if (pat->pattern == NULL) {
+		free(pat);
+		return -ENOMEM;
+	}
+
+	ret = rte_trace_pattern(pattern, 1);
+	if (ret < 0) {
+		free(pat->pattern);
+		free(pat);
+		return ret;
+	}
+
+	rte_spinlock_lock(&trace.lock);
+	TAILQ_INSERT_TAIL(&trace.patterns, pat, next);
+	rte_spinlock_unlock(&trace.lock);
+
+	return 0;
+}
+
+int
+eal_trace_init(void)
+{
+	unsigned int i;
+	int ret = 0;
+
+	rte_spinlock_lock(&trace.lock);
+	trace.ready = true;
+	for (i = 0; i < trace.nb_points; i++) {
+		if (rte_trace_point_is_enabled(trace.points[i].handle)) {
+			ret = trace_buffers_alloc();
+			break;
+		}
+	}
+	rte_spinlock_unlock(&trace.lock);
+
+	return ret;
+}
+
+void
+eal_trace_fini(void)
+{
+	struct trace_pattern *pat;
+	unsigned int lcore_id;
+	unsigned int i;
+
+	for (i = 0; i < trace.nb_points; i++)
+		trace_point_set(trace.points[i].handle, false);
+
+	if (internal_config.trace_dir != NULL &&
+			rte_trace_save(internal_config.trace_dir) < 0)
+		RTE_LOG(ERR, EAL, "Cannot save trace in %s\n",
+			internal_config.trace_dir);
+
+	rte_spinlock_lock(&trace.lock);
+	trace.ready = false;
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		rte_free(rte_trace_buffers[lcore_id]);
+		rte_trace_buffers[lcore_id] = NULL;
+	}
+	while ((pat = TAILQ_FIRST(&trace.patterns)) != NULL) {
+		TAILQ_REMOVE(&trace.patterns, pat, next);
+		free(pat->pattern);
+		free(pat);
+	}
+	rte_spinlock_unlock(&trace.lock);
+}
+
+static void
+ctf_metadata_write(FILE *f)
+{
+	struct timespec ts;
+	uint64_t hz = rte_get_tsc_hz();
+	uint64_t cycles, offset_ns;
+	unsigned int i, j;
+
+	/* map the TSC to the wall clock */
+	clock_gettime(CLOCK_REALTIME, &ts);
+	cycles = rte_get_tsc_cycles();
+	offset_ns = (uint64_t)ts.tv_sec * NS_PER_S + ts.tv_nsec -
+		((cycles / hz) * NS_PER_S + (cycles % hz) * NS_PER_S / hz);
+
+	fprintf(f, "/* CTF 1.8 */\n\n"
+		"typealias integer { size = 8; align = 8; signed = false; } := uint8_t;\n"
+		"typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n"
+		"typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+		"typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n"
+		"\n"
+		"trace {\n"
+		"	major = 1;\n"
+		"	minor = 8;\n"
+		"	byte_order = %s;\n"
+		"	packet.header := struct {\n"
+		"		uint32_t magic;\n"
+		"		uint32_t stream_id;\n"
+		"	};\n"
+		"};\n"
+		"\n"
+		"env {\n"
+		"	dpdk_version = \"%s\";\n"
+		"	tracer_name = \"dpdk\";\n"
+		"};\n"
+		"\n"
+		"clock {\n"
+		"	name = \"dpdk\";\n"
+		"	freq = %" PRIu64 ";\n"
+		"	offset_s = %" PRIu64 ";\n"
+		"	offset = %" PRIu64 ";\n"
+		"};\n"
+		"\n"
+		"typealias integer {\n"
+		"	size = 64; align = 8; signed = false;\n"
+		"	map = clock.dpdk.value;\n"
+		"} := uint64_clock_t;\n"
+		"\n"
+		"stream {\n"
+		"	id = 0;\n"
+		"	packet.context := struct {\n"
+		"		uint64_clock_t timestamp_begin;\n"
+		"		uint64_clock_t timestamp_end;\n"
+		"		uint64_t content_size;\n"
+		"		uint64_t packet_size;\n"
+		"		uint32_t cpu_id;\n"
+		"		uint32_t padding;\n"
+		"	};\n"
+		"	event.header := struct {\n"
+		"		uint64_clock_t timestamp;\n"
+		"		uint32_t id;\n"
+		"		uint32_t reserved;\n"
+		"	};\n"
+		"};\n",
+		RTE_BYTE_ORDER == RTE_LITTLE_ENDIAN ? "le" : "be",
+		rte_version(), hz, offset_ns / NS_PER_S,
+		(offset_ns % NS_PER_S) * hz / NS_PER_S);
+
+	for (i = 0; i < trace.nb_points; i++) {
+		fprintf(f, "\nevent {\n"
+			"	id = %u;\n"
+			"	name = \"%s\";\n"
+			"	stream_id = 0;\n",
+			i + 1, trace.points[i].name);
+		if (trace.points[i].nb_fields != 0) {
+			fprintf(f, "	fields := struct {\n");
+			for (j = 0; j < trace.points[i].nb_fields; j++)
+				fprintf(f, "		uint64_t %s;\n",
+					trace.points[i].fields[j]);
+			fprintf(f, "	};\n");
+		}
+		fprintf(f, "};\n");
+	}
+}
+
+/* size of a record in the stream, without its unused arguments */
+static size_t
+ctf_record_size(const struct rte_trace_record *rec)
+{
+	unsigned int nb_fields = 0;
+
+	if (rec->id != 0 && rec->id <= trace.nb_points)
+		nb_fields = trace.points[rec->id - 1].nb_fields;
+
+	return offsetof(struct rte_trace_record, args) +
+		nb_fields * sizeof(rec->args[0]);
+}
+
+static int
+ctf_stream_write(FILE *f, const struct rte_trace_buffer *buf)
+{
+	const struct rte_trace_record *rec;
+	struct ctf_packet pkt;
+	uint64_t head, first, n;
+	uint64_t content_size;
+
+	head = __atomic_load_n(&buf->head, __ATOMIC_ACQUIRE);
+	first = head > buf->size ? head - buf->size : 0;
+
+	content_size = sizeof(pkt);
+	for (n = first; n < head; n++)
+		content_size += ctf_record_size(
+			&buf->rec[n & (buf->size - 1)]);
+
+	memset(&pkt, 0, sizeof(pkt));
+	pkt.magic = CTF_MAGIC;
+	pkt.timestamp_begin = buf->rec[first & (buf->size - 1)].timestamp;
+	pkt.timestamp_end = buf->rec[(head - 1) & (buf->size - 1)].timestamp;
+	pkt.content_size = content_size * CHAR_BIT;
+	pkt.packet_size = content_size * CHAR_BIT;
+	pkt.cpu_id = buf->lcore_id;
+	if (fwrite(&pkt, sizeof(pkt), 1, f) != 1)
+		return -EIO;
+
+	for (n = first; n < head; n++) {
+		rec = &buf->rec[n & (buf->size - 1)];
+		if (fwrite(rec, ctf_record_size(rec), 1, f) != 1)
+			return -EIO;
+	}
+
+	return 0;
+}
+
+int __rte_experimental
+rte_trace_save(const char *dir)
+{
+	const struct rte_trace_buffer *buf;
+	char path[PATH_MAX];
+	unsigned int lcore_id;
+	FILE *f;
+	int ret = 0;
+
+	if (dir == NULL)
+		return -EINVAL;
+	if (mkdir(dir, 0700) < 0 && errno != EEXIST) {
+		RTE_LOG(ERR, EAL, "Cannot create trace directory %s: %s\n",
+			dir, strerror(errno));
+		return -errno;
+	}
+
+	rte_spinlock_lock(&trace.lock);
+
+	snprintf(path, sizeof(path), "%s/metadata", dir);
+	f = fopen(path, "w");
+	if (f == NULL) {
+		ret = -errno;
+		goto out;
+	}
+	ctf_metadata_write(f);
+	if (fclose(f) != 0) {
+		ret = -EIO;
+		goto out;
+	}
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		buf = rte_trace_buffers[lcore_id];
+		if (buf == NULL || buf->head == 0)
+			continue;
+
+		snprintf(path, sizeof(path), "%s/channel0_%u", dir, lcore_id);
+		f = fopen(path, "w");
+		if (f == NULL) {
+			ret = -errno;
+			goto out;
+		}
+		ret = ctf_stream_write(f, buf);
+		if (fclose(f) != 0 && ret == 0)
+			ret = -EIO;
+		if (ret < 0)
+			goto out;
+	}
+
+out:
+	rte_spinlock_unlock(&trace.lock);
+	if (ret < 0)
+		RTE_LOG(ERR, EAL, "Cannot save trace in %s: %s\n",
+			dir, strerror(-ret));
+	return ret;
+}
+
+void __rte_experimental
+rte_trace_dump(FILE *f)
+{
+	const struct rte_trace_buffer *buf;
+	unsigned int lcore_id;
+	unsigned int i;
+
+	rte_spinlock_lock(&trace.lock);
+
+	fprintf(f, "tracepoints:\n");
+	for (i = 0; i < trace.nb_points; i++)
+		fprintf(f, "  id %u: %s, %s\n", i + 1, trace.points[i].name,
+			rte_trace_point_is_enabled(trace.points[i].handle) ?
+			"enabled" : "disabled");
+
+	fprintf(f, "buffers:\n");
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		buf = rte_trace_buffers[lcore_id];
+		if (buf == NULL)
+			continue;
+		fprintf(f, "  lcore %u: %" PRIu64 " records written, size %u\n",
+			lcore_id, buf->head, buf->size);
+	}
+
+	rte_spinlock_unlock(&trace.lock);
+}
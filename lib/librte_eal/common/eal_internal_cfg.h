@@ -15,6 +15,8 @@
 
 #define MAX_HUGEPAGE_SIZES 3  /**< support up to 3 page sizes */
 
+#define EAL_INTR_THREADS_MAX 16 /**< max number of interrupt threads */
+
 /*
  * internal configuration structure for the number, size and
  * mount points of hugepages
@@ -59,6 +61,12 @@ struct internal_config {
 	 */
 	volatile unsigned match_allocations;
 	/**< true to free hugepages exactly as allocated */
+	unsigned int mem_init_threads;
+	/**< number of threads per socket faulting in the memory at init */
+	volatile unsigned mem_init_lazy;
+	/**< true to fault in the memory at init on first use only */
+	unsigned int intr_threads;
+	/**< number of threads handling the interrupts */
 	volatile unsigned single_file_segments;
 	/**< true if storing all pages within single files (per-page-size,
 	 * per-node) non-legacy mode only.
@@ -70,6 +78,7 @@ struct internal_config {
 	char *hugepage_dir;         /**< specific hugetlbfs directory to use */
 	char *user_mbuf_pool_ops_name;
 			/**< user defined mbuf pool ops name */
+	char *trace_dir;            /**< directory the trace is saved in */
 	unsigned num_hugepage_sizes;      /**< how many sizes on this system */
 	struct hugepage_info hugepage_info[MAX_HUGEPAGE_SIZES];
 	enum rte_iova_mode iova_mode ;    /**< Set IOVA mode on this system  */
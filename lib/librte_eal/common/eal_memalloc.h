@@ -29,6 +29,25 @@ int
 eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
 		int socket, bool exact);
 
+/*
+ * Allocate exactly `n_segs` segments, like eal_memalloc_alloc_seg_bulk(), but
+ * only map them: the pages are faulted in on first access, on the requested
+ * socket when NUMA is supported. Their IOVA is only set in IOVA as VA mode.
+ */
+int
+eal_memalloc_map_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
+		int socket);
+
+/*
+ * Fault in `n_segs` segments allocated with eal_memalloc_map_seg_bulk() and
+ * set their IOVA, using `n_threads` threads running on the cores of each
+ * socket. Returns 0 if all segments are accessible on their socket, -1
+ * otherwise.
+ */
+int
+eal_memalloc_populate_seg_bulk(struct rte_memseg **ms, int n_segs,
+		unsigned int n_threads);
+
 /*
  * Deallocate segment
  */
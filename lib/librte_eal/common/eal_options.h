@@ -67,6 +67,16 @@ enum {
 	OPT_IOVA_MODE_NUM,
 #define OPT_MATCH_ALLOCATIONS  "match-allocations"
 	OPT_MATCH_ALLOCATIONS_NUM,
+#define OPT_MEM_INIT_THREADS   "mem-init-threads"
+	OPT_MEM_INIT_THREADS_NUM,
+#define OPT_MEM_INIT_LAZY      "mem-init-lazy"
+	OPT_MEM_INIT_LAZY_NUM,
+#define OPT_TRACE              "trace"
+	OPT_TRACE_NUM,
+#define OPT_TRACE_DIR          "trace-dir"
+	OPT_TRACE_DIR_NUM,
+#define OPT_INTR_THREADS       "intr-threads"
+	OPT_INTR_THREADS_NUM,
 	OPT_LONG_MAX_NUM
 };
 
@@ -218,6 +218,14 @@ uint64_t get_tsc_freq(void);
  */
 uint64_t get_tsc_freq_arch(void);
 
+/**
+ * Get a monotonic time in microseconds, usable before the timers are
+ * initialized, to report the duration of the EAL init steps.
+ *
+ * This function is private to the EAL.
+ */
+uint64_t eal_get_time_us(void);
+
 /**
  * Prepare physical memory mapping
  * i.e. hugepages on Linux and
@@ -381,4 +389,33 @@ rte_option_init(void);
 void
 rte_option_usage(void);
 
+/**
+ * Enable the tracepoints matching a pattern, including the ones registered
+ * later.
+ *
+ * @param pattern
+ *   The globbing pattern given with the --trace option.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int
+eal_trace_pattern_save(const char *pattern);
+
+/**
+ * Allocate the trace buffers if some tracepoints are enabled, and allow
+ * their allocation when the tracepoints are enabled later.
+ *
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int
+eal_trace_init(void);
+
+/**
+ * Disable the tracepoints, save the trace if requested with the
+ * --trace-dir option, and free the trace buffers.
+ */
+void
+eal_trace_fini(void);
+
 #endif /* _EAL_PRIVATE_H_ */
@@ -40,6 +40,56 @@ extern "C" {
 
 #define rte_cio_rmb() dmb(oshld)
 
+/*------------------------ 128 bit atomic operations -------------------------*/
+
+static inline int __rte_experimental
+rte_atomic128_cmp_exchange(rte_int128_t *dst,
+			   rte_int128_t *exp,
+			   const rte_int128_t *src,
+			   unsigned int weak,
+			   int success,
+			   int failure)
+{
+	uint64_t old0, old1;
+	uint32_t fail;
+
+	RTE_SET_USED(failure);
+
+	/* Exclusive load/store pair loop, always uses acquire/release
+	 * semantics which are at least as strong as any requested model.
+	 */
+	do {
+		asm volatile("ldaxp %0, %1, %2"
+			     : "=&r" (old0), "=&r" (old1)
+			     : "Q" (dst->val[0])
+			     : "memory");
+
+		if (old0 != exp->val[0] || old1 != exp->val[1]) {
+			/* Clear the exclusive monitor by writing back
+			 * the value that was read.
+			 */
+			asm volatile("stlxp %w0, %1, %2, %3"
+				     : "=&r" (fail)
+				     : "r" (old0), "r" (old1),
+				       "Q" (dst->val[0])
+				     : "memory");
+			exp->val[0] = old0;
+			exp->val[1] = old1;
+			return 0;
+		}
+
+		asm volatile("stlxp %w0, %1, %2, %3"
+			     : "=&r" (fail)
+			     : "r" (src->val[0]), "r" (src->val[1]),
+			       "Q" (dst->val[0])
+			     : "memory");
+	} while (fail && !weak);
+
+	RTE_SET_USED(success);
+
+	return !fail;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,7 @@
 #include <string.h>
 #include <rte_vect.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_config.h>
 
 #ifdef __cplusplus
@@ -40,6 +41,54 @@ extern "C" {
 static __rte_always_inline void *
 rte_memcpy(void *dst, const void *src, size_t n);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Copy bytes from one location to another with non-temporal stores, which
+ * bypass the caches. The locations must not overlap.
+ *
+ * This is meant for large copies whose destination is not read again soon,
+ * like packet payloads, so that they do not evict useful data from the
+ * caches. The implementation is selected at runtime, based on the
+ * instruction sets supported by the CPU.
+ *
+ * @param dst
+ *   Pointer to the destination of the data.
+ * @param src
+ *   Pointer to the source data.
+ * @param n
+ *   Number of bytes to copy.
+ * @return
+ *   Pointer to the destination data.
+ */
+void * __rte_experimental
+rte_memcpy_nt(void *dst, const void *src, size_t n);
+
+/**
+ * @internal
+ * Copy size from which rte_memcpy() uses the implementation selected at
+ * runtime, when the build does not target the best instruction set.
+ */
+#define RTE_MEMCPY_DISPATCH_THRESHOLD 2048
+
+/*
+ * The runtime selection can only find a wider instruction set than the
+ * build target if it is below AVX2, or below AVX512F when it is enabled.
+ */
+#if !defined(RTE_MACHINE_CPUFLAG_AVX512F) && \
+	(!defined(RTE_MACHINE_CPUFLAG_AVX2) || defined(RTE_ENABLE_AVX512))
+#define RTE_MEMCPY_DISPATCH
+#endif
+
+/**
+ * @internal
+ * Copy bytes with the implementation selected at runtime, based on the
+ * instruction sets supported by the CPU.
+ */
+void *
+__rte_memcpy_large(void *dst, const void *src, size_t n);
+
 #ifdef RTE_MACHINE_CPUFLAG_AVX512F
 
 #define ALIGNMENT_MASK 0x3F
@@ -863,6 +912,11 @@ rte_memcpy_aligned(void *dst, const void *src, size_t n)
 static inline void *
 rte_memcpy(void *dst, const void *src, size_t n)
 {
+#ifdef RTE_MEMCPY_DISPATCH
+	/* the CPU may support a wider instruction set than the build */
+	if (n >= RTE_MEMCPY_DISPATCH_THRESHOLD)
+		return __rte_memcpy_large(dst, src, n);
+#endif
 	if (!(((uintptr_t)dst | (uintptr_t)src) & ALIGNMENT_MASK))
 		return rte_memcpy_aligned(dst, src, n);
 	else
@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __DOXYGEN__
 
@@ -1082,4 +1083,65 @@ static inline void rte_atomic64_clear(rte_atomic64_t *v)
 }
 #endif
 
+/*------------------------ 128 bit atomic operations -------------------------*/
+
+#ifdef __SIZEOF_INT128__
+
+/**
+ * 128-bit integer structure.
+ */
+RTE_STD_C11
+typedef struct {
+	RTE_STD_C11
+	union {
+		uint64_t val[2];
+		__extension__ __int128 int128;
+	};
+} __rte_aligned(16) rte_int128_t;
+
+#endif /* __SIZEOF_INT128__ */
+
+#ifdef __DOXYGEN__
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * An atomic compare and exchange function used on 128-bit values, only
+ * available on 64-bit architectures providing a double word CAS
+ * (cmpxchg16b on x86_64, ldaxp/stlxp on arm64).
+ *
+ * If *exp == *dst, write *src to *dst and return true. Otherwise,
+ * write *dst to *exp and return false.
+ *
+ * @param dst
+ *   The destination object, 16B aligned.
+ * @param exp
+ *   Pointer to the expected value. On failure, it is updated with the
+ *   current value of *dst.
+ * @param src
+ *   The new value.
+ * @param weak
+ *   A value of true allows the comparison to spuriously fail. Hints
+ *   that the caller will retry in a loop.
+ * @param success
+ *   If successful, the operation's memory behavior conforms to this (or a
+ *   stronger) model.
+ * @param failure
+ *   If unsuccessful, the operation's memory behavior conforms to this (or a
+ *   stronger) model. This argument cannot be __ATOMIC_RELEASE,
+ *   __ATOMIC_ACQ_REL, or a stronger model than success.
+ * @return
+ *   Non-zero on success; 0 on failure.
+ */
+static inline int __rte_experimental
+rte_atomic128_cmp_exchange(rte_int128_t *dst,
+			   rte_int128_t *exp,
+			   const rte_int128_t *src,
+			   unsigned int weak,
+			   int success,
+			   int failure);
+
+#endif /* __DOXYGEN__ */
+
 #endif /* _RTE_ATOMIC_H_ */
@@ -11,6 +11,10 @@
  * Functions for vectorised implementation of memcpy().
  */
 
+#include <stddef.h>
+
+#include <rte_compat.h>
+
 /**
  * Copy 16 bytes from one location to another using optimised
  * instructions. The locations should not overlap.
@@ -87,6 +91,30 @@ rte_mov128(uint8_t *dst, const uint8_t *src);
 static inline void
 rte_mov256(uint8_t *dst, const uint8_t *src);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Copy bytes from one location to another with non-temporal stores, which
+ * bypass the caches. The locations must not overlap.
+ *
+ * This is meant for large copies whose destination is not read again soon,
+ * like packet payloads, so that they do not evict useful data from the
+ * caches. On architectures without such an implementation, this is a
+ * regular copy.
+ *
+ * @param dst
+ *   Pointer to the destination of the data.
+ * @param src
+ *   Pointer to the source data.
+ * @param n
+ *   Number of bytes to copy.
+ * @return
+ *   Pointer to the destination data.
+ */
+void * __rte_experimental
+rte_memcpy_nt(void *dst, const void *src, size_t n);
+
 #ifdef __DOXYGEN__
 
 /**
@@ -6,6 +6,8 @@
 #define _RTE_INTERRUPTS_H_
 
 #include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_lcore.h>
 
 /**
  * @file
@@ -29,6 +31,13 @@ typedef void (*rte_intr_callback_fn)(void *cb_arg);
 /**
  * It registers the callback for the specific interrupt. Multiple
  * callbacks cal be registered at the same time.
+ *
+ * The callbacks of one interrupt handle are always called from the same
+ * interrupt thread, one at a time. When several interrupt threads are
+ * started (--intr-threads option on Linux), the callbacks of different
+ * handles may run concurrently, even if they are the same function or
+ * share their argument: such callbacks must protect their shared state.
+ *
  * @param intr_handle
  *  Pointer to the interrupt handle.
  * @param cb
@@ -85,6 +94,38 @@ int rte_intr_enable(const struct rte_intr_handle *intr_handle);
  */
 int rte_intr_disable(const struct rte_intr_handle *intr_handle);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * It returns the number of threads handling the interrupts, the interrupt
+ * sources being spread on them as they are registered.
+ *
+ * @return
+ *  The number of interrupt threads, 0 if they are not running.
+ */
+unsigned int __rte_experimental
+rte_intr_thread_count(void);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * It sets the CPU affinity of an interrupt thread.
+ *
+ * @param thread_id
+ *  the interrupt thread, from 0 to rte_intr_thread_count() - 1.
+ * @param cpuset
+ *  the CPUs the thread is allowed to run on.
+ *
+ * @return
+ *  - On success, zero.
+ *  - On failure, a negative value.
+ */
+int __rte_experimental
+rte_intr_thread_affinity_set(unsigned int thread_id,
+		const rte_cpuset_t *cpuset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,204 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_LCORE_POLL_H_
+#define _RTE_LCORE_POLL_H_
+
+/**
+ * @file
+ *
+ * RTE lcore poll loop accounting
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * A polling lcore always runs at 100% of its CPU, whatever the traffic.
+ * To know how much of this time is actually spent on work, the poll loop
+ * marks the end of each of its iterations with rte_lcore_poll_mark(),
+ * giving the amount of work the iteration did, for example the number of
+ * packets received. The cycles since the previous mark are accounted as
+ * busy cycles if the iteration did some work, as idle cycles otherwise.
+ *
+ * The iterations are also counted in a histogram of the amount of work
+ * they did, in power of 2 buckets: the bucket 0 counts the idle
+ * iterations, the bucket i counts the iterations which did between
+ * 2^(i-1) and 2^i - 1 work items, and the last bucket counts all the
+ * larger ones.
+ *
+ * Marking an iteration costs a TSC read and a few stores in memory local
+ * to the lcore. The statistics can be read from any thread.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_memory.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of buckets in the histogram of work per iteration. */
+#define RTE_LCORE_POLL_HIST_SIZE 12
+
+/**
+ * Poll loop statistics of an lcore.
+ */
+struct rte_lcore_poll_stats {
+	uint64_t busy_cycles; /**< Cycles of the iterations which did work. */
+	uint64_t idle_cycles; /**< Cycles of the iterations which did none. */
+	/** Number of iterations by amount of work, in power of 2 buckets. */
+	uint64_t hist[RTE_LCORE_POLL_HIST_SIZE];
+};
+
+/**
+ * @internal
+ * Poll loop accounting state of an lcore, written by this lcore only.
+ */
+struct rte_lcore_poll {
+	uint64_t last_tsc; /**< TSC of the last mark, 0 before the first. */
+	struct rte_lcore_poll_stats stats; /**< Accumulated statistics. */
+} __rte_cache_aligned;
+
+/**
+ * @internal
+ * Poll loop accounting state of the lcores.
+ */
+extern struct rte_lcore_poll rte_lcore_poll_data[RTE_MAX_LCORE];
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Mark the end of an iteration of the poll loop of the calling lcore.
+ *
+ * The cycles elapsed since the previous mark are accounted as busy cycles
+ * if work is not 0, as idle cycles otherwise. Nothing is accounted by the
+ * first mark of the lcore, which only starts the measurement.
+ *
+ * This function does nothing when called from a non-EAL thread.
+ *
+ * @param work
+ *   Amount of work done by the iteration, for example the number of
+ *   packets received, 0 if the iteration found nothing to do.
+ */
+static inline void __rte_experimental
+rte_lcore_poll_mark(unsigned int work)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_lcore_poll *poll;
+	uint64_t now;
+	unsigned int bucket;
+
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return;
+
+	poll = &rte_lcore_poll_data[lcore_id];
+	now = rte_rdtsc();
+	if (likely(poll->last_tsc != 0)) {
+		if (work != 0)
+			poll->stats.busy_cycles += now - poll->last_tsc;
+		else
+			poll->stats.idle_cycles += now - poll->last_tsc;
+	}
+	poll->last_tsc = now;
+
+	bucket = rte_fls_u32(work);
+	if (bucket >= RTE_LCORE_POLL_HIST_SIZE)
+		bucket = RTE_LCORE_POLL_HIST_SIZE - 1;
+	poll->stats.hist[bucket]++;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Restart the measurement of the calling lcore, without accounting the
+ * cycles elapsed since the previous mark.
+ *
+ * This is to be called when the poll loop resumes after being suspended,
+ * for example after sleeping, so that the suspended time is not accounted
+ * in the next iteration.
+ */
+static inline void __rte_experimental
+rte_lcore_poll_resume(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return;
+
+	rte_lcore_poll_data[lcore_id].last_tsc = rte_rdtsc();
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the poll loop statistics of an lcore, since its last reset.
+ *
+ * @param lcore_id
+ *   The lcore to get the statistics of.
+ * @param stats
+ *   The structure to fill with the statistics.
+ * @return
+ *   0 on success, -EINVAL if lcore_id or stats is invalid.
+ */
+int __rte_experimental
+rte_lcore_poll_stats_get(unsigned int lcore_id,
+		struct rte_lcore_poll_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset the poll loop statistics of an lcore.
+ *
+ * This is safe to call from any thread, while the lcore marks iterations.
+ *
+ * @param lcore_id
+ *   The lcore to reset the statistics of.
+ * @return
+ *   0 on success, -EINVAL if lcore_id is invalid.
+ */
+int __rte_experimental
+rte_lcore_poll_stats_reset(unsigned int lcore_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the busy ratio of an lcore since its last reset.
+ *
+ * @param lcore_id
+ *   The lcore to get the busy ratio of.
+ * @return
+ *   The percentage of the accounted cycles which were busy, from 0 to 100,
+ *   -EINVAL if lcore_id is invalid, -ENODATA if no cycles were accounted.
+ */
+int __rte_experimental
+rte_lcore_poll_busy_percent(unsigned int lcore_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dump the poll loop statistics of the lcores which marked iterations.
+ *
+ * @param f
+ *   A pointer to a file for output.
+ */
+void __rte_experimental
+rte_lcore_poll_dump(FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_LCORE_POLL_H_ */
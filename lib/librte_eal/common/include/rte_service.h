@@ -365,6 +365,19 @@ int32_t rte_service_dump(FILE *f, uint32_t id);
  */
 #define RTE_SERVICE_ATTR_CALL_COUNT 1
 
+/**
+ * Returns the count of invocations of this service function which reported
+ * that they did no work, by returning -EAGAIN.
+ */
+#define RTE_SERVICE_ATTR_IDLE_CALL_COUNT 2
+
+/**
+ * Returns the average number of cycles consumed per invocation of this
+ * service function which did some work. The cycles of the idle invocations
+ * are not included, see RTE_SERVICE_ATTR_CYCLES for the total.
+ */
+#define RTE_SERVICE_ATTR_CYCLES_PER_BUSY_CALL 3
+
 /**
  * Get an attribute from a service.
  *
@@ -419,6 +432,81 @@ rte_service_lcore_attr_get(uint32_t lcore, uint32_t attr_id,
 int32_t __rte_experimental
 rte_service_lcore_attr_reset_all(uint32_t lcore);
 
+/**
+ * The service core calls each of its mapped services once per loop. This is
+ * the default mode.
+ */
+#define RTE_SERVICE_LCORE_SCHED_ROUND_ROBIN 0
+
+/**
+ * The service core calls a service which reports work up to its weight times
+ * per loop, and skips a service reporting no work for a number of loops,
+ * doubling each time it is found idle again, up to 32 loops.
+ */
+#define RTE_SERVICE_LCORE_SCHED_ADAPTIVE 1
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Set the scheduling mode of a service core, which decides how its mapped
+ * services share its cycles. A service reports that an invocation did no
+ * work by returning -EAGAIN from its callback.
+ *
+ * @param lcore The service core to set the mode of
+ * @param mode RTE_SERVICE_LCORE_SCHED_ROUND_ROBIN or
+ *             RTE_SERVICE_LCORE_SCHED_ADAPTIVE
+ * @retval 0 Success
+ *         -EINVAL Invalid lcore or mode provided
+ *         -ENOTSUP lcore is not a service core.
+ */
+int32_t __rte_experimental
+rte_service_lcore_sched_mode_set(uint32_t lcore, uint32_t mode);
+
+/** Maximum weight of a service. */
+#define RTE_SERVICE_WEIGHT_MAX 64
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Set the weight of a service, which is the maximum number of consecutive
+ * invocations of the service per loop of the service cores in adaptive mode,
+ * as long as it reports work. The default weight is 1.
+ *
+ * @param id The service to set the weight of
+ * @param weight The weight, between 1 and RTE_SERVICE_WEIGHT_MAX
+ * @retval 0 Success
+ *         -EINVAL Invalid service id or weight provided
+ */
+int32_t __rte_experimental
+rte_service_weight_set(uint32_t id, uint32_t weight);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enable or disable the load balancing of the services between the running
+ * service cores.
+ *
+ * Once per period, the service cores measure the cycles they spent in the
+ * service calls doing work. When the difference between the most and the
+ * least loaded service cores is above a quarter of the period, a service
+ * mapped to the most loaded core only is moved to the least loaded one. The
+ * move is done by the most loaded core between two of its loops, when none
+ * of its services is running, so MT unsafe services can be moved too.
+ *
+ * The services mapped to several cores are never moved. The application
+ * should not change the mapping of the other services while the balancing
+ * is enabled.
+ *
+ * @param period_ms The balancing period in milliseconds, 0 to disable the
+ *                  balancing.
+ * @retval 0 Success
+ */
+int32_t __rte_experimental
+rte_service_balance_set(uint32_t period_ms);
+
 #ifdef __cplusplus
 }
 #endif
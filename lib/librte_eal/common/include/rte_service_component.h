@@ -14,6 +14,10 @@
 
 /**
  * Signature of callback function to run a service.
+ *
+ * The callback returns -EAGAIN when the invocation did no work, for example
+ * when no packet or event was available, and 0 otherwise. This is used by the
+ * statistics and the adaptive scheduling of the service cores.
  */
 typedef int32_t (*rte_service_func)(void *args);
 
@@ -0,0 +1,316 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_TRACE_H_
+#define _RTE_TRACE_H_
+
+/**
+ * @file
+ *
+ * RTE Trace
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * The trace framework records fixed-size binary records, emitted by
+ * tracepoints, in per-lcore circular buffers allocated in hugepage memory.
+ * A record holds the TSC value at the time it was written, the ID of the
+ * tracepoint and up to RTE_TRACE_ARGS_MAX 64-bit arguments.
+ *
+ * Tracepoints are disabled by default. When disabled, emitting a record
+ * costs a load and a branch. They are enabled at runtime, by name or
+ * pattern, with rte_trace_pattern() or the --trace EAL option. Building
+ * without CONFIG_RTE_EAL_TRACE removes the tracepoints altogether.
+ *
+ * The tracepoints of the fast path, emitted with rte_trace_point_emit_fp(),
+ * are only compiled in with CONFIG_RTE_ENABLE_TRACE_FP, disabled by default.
+ *
+ * The recorded buffers can be saved in the Common Trace Format (CTF),
+ * to be read offline with the standard trace viewers.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of arguments of a tracepoint. */
+#define RTE_TRACE_ARGS_MAX 4
+
+/** Maximum length of a tracepoint name, including the terminating '\0'. */
+#define RTE_TRACE_NAME_SIZE 64
+
+/**
+ * Handle of a tracepoint.
+ *
+ * It holds the ID of the tracepoint, assigned when it is registered,
+ * and its enabled status.
+ */
+typedef uint32_t rte_trace_point_t;
+
+/** Flag of an enabled tracepoint in its handle. */
+#define RTE_TRACE_POINT_ENABLED (UINT32_C(1) << 31)
+/** Mask of the tracepoint ID in its handle. */
+#define RTE_TRACE_POINT_ID_MASK UINT32_C(0xffff)
+
+/**
+ * A trace record.
+ */
+struct rte_trace_record {
+	uint64_t timestamp; /**< TSC cycles when the record was written. */
+	uint32_t id;        /**< ID of the tracepoint. */
+	uint32_t reserved;  /**< Reserved, always 0. */
+	uint64_t args[RTE_TRACE_ARGS_MAX]; /**< Arguments of the tracepoint. */
+};
+
+/**
+ * The trace buffer of an lcore.
+ *
+ * Records are written in a circular way: once the buffer is full, the
+ * oldest records are overwritten.
+ */
+struct rte_trace_buffer {
+	uint64_t head;     /**< Number of records written since allocation. */
+	uint32_t size;     /**< Number of records, a power of 2. */
+	uint32_t lcore_id; /**< lcore writing in this buffer. */
+	struct rte_trace_record rec[]; /**< Records. */
+};
+
+/**
+ * @internal
+ * Trace buffers of the lcores, NULL until tracing is enabled.
+ */
+extern struct rte_trace_buffer *rte_trace_buffers[RTE_MAX_LCORE];
+
+/**
+ * @internal
+ * Register a tracepoint. Use RTE_TRACE_POINT_DEFINE() instead.
+ *
+ * @param tp
+ *   The handle of the tracepoint.
+ * @param name
+ *   The name of the tracepoint, for example "lib.ethdev.rx_burst".
+ * @param fields
+ *   The names of the RTE_TRACE_ARGS_MAX arguments of the tracepoint,
+ *   NULL for the unused ones. They must be valid C identifiers.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int __rte_experimental
+__rte_trace_point_register(rte_trace_point_t *tp, const char *name,
+		const char * const fields[RTE_TRACE_ARGS_MAX]);
+
+/**
+ * Define and register a tracepoint.
+ *
+ * @param tp
+ *   The handle of the tracepoint, declared as extern rte_trace_point_t
+ *   where the tracepoint is emitted.
+ * @param name
+ *   The name of the tracepoint.
+ * @param ...
+ *   The names of the arguments of the tracepoint, at most
+ *   RTE_TRACE_ARGS_MAX.
+ */
+#define RTE_TRACE_POINT_DEFINE(tp, name, ...)				\
+rte_trace_point_t tp;							\
+RTE_INIT(tp##_register)							\
+{									\
+	static const char * const fields[RTE_TRACE_ARGS_MAX] = {	\
+		__VA_ARGS__ };						\
+	__rte_trace_point_register(&tp, name, fields);			\
+}
+
+/**
+ * Emit a tracepoint.
+ *
+ * If the tracepoint is enabled and the calling thread is an lcore, write
+ * a record in the trace buffer of the lcore. The trace buffer of an lcore
+ * must be written by a single thread.
+ *
+ * @param tp
+ *   A pointer to the handle of the tracepoint.
+ * @param a0
+ *   First argument of the tracepoint.
+ * @param a1
+ *   Second argument of the tracepoint.
+ * @param a2
+ *   Third argument of the tracepoint.
+ * @param a3
+ *   Fourth argument of the tracepoint.
+ */
+static __rte_always_inline void
+rte_trace_point_emit(rte_trace_point_t *tp, uint64_t a0, uint64_t a1,
+		uint64_t a2, uint64_t a3)
+{
+#ifdef RTE_EAL_TRACE
+	rte_trace_point_t val = __atomic_load_n(tp, __ATOMIC_RELAXED);
+	struct rte_trace_buffer *buf;
+	struct rte_trace_record *rec;
+	unsigned int lcore_id;
+
+	if (likely(!(val & RTE_TRACE_POINT_ENABLED)))
+		return;
+
+	lcore_id = rte_lcore_id();
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return;
+	buf = rte_trace_buffers[lcore_id];
+	if (unlikely(buf == NULL))
+		return;
+
+	rec = &buf->rec[buf->head & (buf->size - 1)];
+	rec->timestamp = rte_get_tsc_cycles();
+	rec->id = val & RTE_TRACE_POINT_ID_MASK;
+	rec->args[0] = a0;
+	rec->args[1] = a1;
+	rec->args[2] = a2;
+	rec->args[3] = a3;
+	__atomic_store_n(&buf->head, buf->head + 1, __ATOMIC_RELEASE);
+#else
+	RTE_SET_USED(tp);
+	RTE_SET_USED(a0);
+	RTE_SET_USED(a1);
+	RTE_SET_USED(a2);
+	RTE_SET_USED(a3);
+#endif
+}
+
+/**
+ * Emit a tracepoint of the fast path.
+ *
+ * Same as rte_trace_point_emit(), but compiled to nothing, without
+ * referencing the tracepoint, unless CONFIG_RTE_ENABLE_TRACE_FP is enabled.
+ * It is meant for the functions called for each burst, whose callers must
+ * not pay for a tracepoint they never enable.
+ */
+#ifdef RTE_ENABLE_TRACE_FP
+#define rte_trace_point_emit_fp(tp, a0, a1, a2, a3) \
+	rte_trace_point_emit(tp, a0, a1, a2, a3)
+#else
+#define rte_trace_point_emit_fp(tp, a0, a1, a2, a3) do { } while (0)
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Look up a tracepoint by name.
+ *
+ * @param name
+ *   The name of the tracepoint.
+ * @return
+ *   The handle of the tracepoint, NULL if not found.
+ */
+rte_trace_point_t * __rte_experimental
+rte_trace_point_lookup(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enable a tracepoint.
+ *
+ * The trace buffers are allocated when the first tracepoint is enabled
+ * after the EAL initialization.
+ *
+ * @param tp
+ *   The handle of the tracepoint.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int __rte_experimental
+rte_trace_point_enable(rte_trace_point_t *tp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Disable a tracepoint.
+ *
+ * @param tp
+ *   The handle of the tracepoint.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int __rte_experimental
+rte_trace_point_disable(rte_trace_point_t *tp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Test if a tracepoint is enabled.
+ *
+ * @param tp
+ *   The handle of the tracepoint.
+ * @return
+ *   1 if the tracepoint is enabled, 0 otherwise.
+ */
+int __rte_experimental
+rte_trace_point_is_enabled(rte_trace_point_t *tp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enable or disable the tracepoints whose name matches a globbing pattern.
+ *
+ * @param pattern
+ *   The pattern, for example "lib.ethdev.*".
+ * @param enable
+ *   Non-zero to enable the tracepoints, 0 to disable them.
+ * @return
+ *   The number of matching tracepoints, a negative errno value on error.
+ */
+int __rte_experimental
+rte_trace_pattern(const char *pattern, int enable);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Save the trace buffers in the Common Trace Format.
+ *
+ * The directory is created if needed. It receives a "metadata" file
+ * describing the tracepoints, and one "channel0_<lcore>" stream file per
+ * lcore which recorded something, holding its records from the oldest
+ * to the newest.
+ *
+ * The records written while the buffers are saved may be lost or
+ * corrupted: the tracepoints should be disabled, or the lcores idle.
+ *
+ * @param dir
+ *   The directory in which the trace is saved.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int __rte_experimental
+rte_trace_save(const char *dir);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dump the tracepoints and the trace buffers status.
+ *
+ * @param f
+ *   A pointer to a file for output.
+ */
+void __rte_experimental
+rte_trace_dump(FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_TRACE_H_ */
@@ -125,6 +125,7 @@ malloc_elem_init(struct malloc_elem *elem, struct malloc_heap *heap,
 	elem->state = ELEM_FREE;
 	elem->size = size;
 	elem->pad = 0;
+	elem->slab = 0;
 	elem->orig_elem = orig_elem;
 	elem->orig_size = orig_size;
 	set_header(elem);
@@ -432,6 +433,7 @@ malloc_elem_alloc(struct malloc_elem *elem, size_t size, unsigned align,
 		/* don't split it, pad the element instead */
 		elem->state = ELEM_BUSY;
 		elem->pad = old_elem_size;
+		elem->slab = 0;
 
 		/* put a dummy header in padding, to point to real element header */
 		if (elem->pad > 0) { /* pad will be at least 64-bytes, as everything
@@ -647,6 +649,8 @@ elem_state_to_str(enum elem_state state)
 		return "BUSY";
 	case ELEM_FREE:
 		return "FREE";
+	case ELEM_CACHED:
+		return "CACHED";
 	}
 	return "ERROR";
 }
@@ -17,7 +17,8 @@ struct malloc_heap;
 enum elem_state {
 	ELEM_FREE = 0,
 	ELEM_BUSY,
-	ELEM_PAD  /* element is a padding-only header */
+	ELEM_PAD,  /* element is a padding-only header */
+	ELEM_CACHED /* freed element kept by the slab front-end of an lcore */
 };
 
 struct malloc_elem {
@@ -34,6 +35,8 @@ struct malloc_elem {
 	size_t size;
 	struct malloc_elem *orig_elem;
 	size_t orig_size;
+	uint8_t slab;
+	/**< allocated in a batch by the slab front-end */
 #ifdef RTE_MALLOC_DEBUG
 	uint64_t header_cookie;         /* Cookie marking start of data */
 	                                /* trailer cookie at start + size */
@@ -28,6 +28,7 @@
 #include "malloc_elem.h"
 #include "malloc_heap.h"
 #include "malloc_mp.h"
+#include "malloc_slab.h"
 
 /* start external socket ID's at a very high number */
 #define CONST_MAX(a, b) (a > b ? a : b) /* RTE_MAX is not a constant */
@@ -792,6 +793,46 @@ malloc_heap_alloc_biggest(const char *type, int socket_arg, unsigned int flags,
 	return NULL;
 }
 
+/*
+ * Allocate n elements of the same size next to each other, by splitting
+ * them off a single free element. No memory is added to the heap, the
+ * caller is expected to fall back to malloc_heap_alloc() on failure.
+ */
+int
+malloc_heap_alloc_batch(unsigned int heap_id, size_t size,
+		struct malloc_elem *elems[], unsigned int n)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	struct malloc_heap *heap = &mcfg->malloc_heaps[heap_id];
+	struct malloc_elem *elem;
+	unsigned int i;
+
+	size = RTE_CACHE_LINE_ROUNDUP(size);
+
+	rte_spinlock_lock(&(heap->lock));
+
+	/*
+	 * leave room for a free element below the last one, so that none of
+	 * them is allocated by padding the remaining free element
+	 */
+	elem = find_suitable_element(heap, n * (size + MALLOC_ELEM_OVERHEAD) +
+			MALLOC_ELEM_OVERHEAD + MIN_DATA_SIZE,
+			0, RTE_CACHE_LINE_SIZE, 0, false);
+	if (elem == NULL) {
+		rte_spinlock_unlock(&(heap->lock));
+		return -1;
+	}
+
+	/* each element is split off the end of the remaining free space */
+	for (i = 0; i < n; i++)
+		elems[i] = malloc_elem_alloc(elem, size, RTE_CACHE_LINE_SIZE,
+				0, false);
+	heap->alloc_count += n;
+
+	rte_spinlock_unlock(&(heap->lock));
+	return 0;
+}
+
 /* this function is exposed in malloc_mp.h */
 int
 malloc_heap_free_pages(void *aligned_start, size_t aligned_len)
@@ -1020,7 +1061,8 @@ int
 malloc_heap_get_stats(struct malloc_heap *heap,
 		struct rte_malloc_socket_stats *socket_stats)
 {
-	size_t idx;
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	size_t idx, slab_count, slab_bytes;
 	struct malloc_elem *elem;
 
 	rte_spinlock_lock(&heap->lock);
@@ -1041,11 +1083,16 @@ malloc_heap_get_stats(struct malloc_heap *heap,
 				socket_stats->greatest_free_size = elem->size;
 		}
 	}
+	/* Elements cached by the slab front-end are free for the user */
+	malloc_slab_get_stats(heap - mcfg->malloc_heaps, &slab_count,
+			&slab_bytes);
+	socket_stats->heap_freesz_bytes += slab_bytes;
+
 	/* Get stats on overall heap and allocated memory on this heap */
 	socket_stats->heap_totalsz_bytes = heap->total_size;
 	socket_stats->heap_allocsz_bytes = (socket_stats->heap_totalsz_bytes -
 			socket_stats->heap_freesz_bytes);
-	socket_stats->alloc_count = heap->alloc_count;
+	socket_stats->alloc_count = heap->alloc_count - slab_count;
 
 	rte_spinlock_unlock(&heap->lock);
 	return 0;
@@ -33,6 +33,10 @@ void *
 malloc_heap_alloc_biggest(const char *type, int socket, unsigned int flags,
 		size_t align, bool contig);
 
+int
+malloc_heap_alloc_batch(unsigned int heap_id, size_t size,
+		struct malloc_elem *elems[], unsigned int n);
+
 int
 malloc_heap_create(struct malloc_heap *heap, const char *heap_name);
 
@@ -0,0 +1,329 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include <rte_eal.h>
+#include <rte_eal_memconfig.h>
+#include <rte_atomic.h>
+#include <rte_lcore.h>
+#include <rte_memory.h>
+
+#include "malloc_elem.h"
+#include "malloc_heap.h"
+#include "malloc_slab.h"
+
+#if RTE_MALLOC_SLAB_MAX_SIZE > 0
+
+/* free elements of one size class, used as a stack */
+struct malloc_slab_mag {
+	unsigned int len;
+	struct malloc_elem *elems[MALLOC_SLAB_MAG_SIZE];
+};
+
+/* magazines of one lcore, only accessed by this lcore */
+struct malloc_slab_lcore {
+	/* elements and bytes held per heap, read by the statistics */
+	size_t count[RTE_MAX_NUMA_NODES];
+	size_t bytes[RTE_MAX_NUMA_NODES];
+	unsigned int nb_heaps;
+	/* magazines of the socket heaps, indexed by heap and size class */
+	struct malloc_slab_mag mags[][MALLOC_SLAB_MAX_CLASSES];
+};
+
+/* allocated on the first use of an lcore, private to the process */
+static struct malloc_slab_lcore *slab_lcore[RTE_MAX_LCORE];
+
+static inline unsigned int
+malloc_slab_class(size_t size)
+{
+	return RTE_CACHE_LINE_ROUNDUP(size) / RTE_CACHE_LINE_SIZE - 1;
+}
+
+static inline size_t
+malloc_slab_class_size(unsigned int cls)
+{
+	return (size_t)RTE_CACHE_LINE_SIZE * (cls + 1);
+}
+
+static struct malloc_slab_lcore *
+malloc_slab_get_lcore(unsigned int lcore_id)
+{
+	struct malloc_slab_lcore *sl = slab_lcore[lcore_id];
+	unsigned int nb_heaps;
+
+	if (likely(sl != NULL))
+		return sl;
+
+	nb_heaps = rte_socket_count();
+	sl = calloc(1, sizeof(*sl) + nb_heaps * sizeof(sl->mags[0]));
+	if (sl == NULL)
+		return NULL;
+	sl->nb_heaps = nb_heaps;
+
+	/* the statistics of other lcores may read it from now on */
+	rte_smp_wmb();
+	slab_lcore[lcore_id] = sl;
+	return sl;
+}
+
+static inline struct malloc_elem *
+malloc_slab_pop(struct malloc_slab_lcore *sl, unsigned int heap_id,
+		unsigned int cls)
+{
+	struct malloc_slab_mag *mag = &sl->mags[heap_id][cls];
+	struct malloc_elem *elem;
+
+	if (mag->len == 0)
+		return NULL;
+
+	elem = mag->elems[--mag->len];
+	elem->state = ELEM_BUSY;
+	sl->count[heap_id]--;
+	sl->bytes[heap_id] -= elem->size;
+	return elem;
+}
+
+/* give the n oldest elements of a magazine back to their heap */
+static void
+malloc_slab_flush(struct malloc_slab_lcore *sl, unsigned int heap_id,
+		unsigned int cls, unsigned int n)
+{
+	struct malloc_slab_mag *mag = &sl->mags[heap_id][cls];
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		sl->count[heap_id]--;
+		sl->bytes[heap_id] -= mag->elems[i]->size;
+		mag->elems[i]->state = ELEM_BUSY;
+		mag->elems[i]->slab = 0;
+		malloc_heap_free(mag->elems[i]);
+	}
+	mag->len -= n;
+	memmove(&mag->elems[0], &mag->elems[n],
+		mag->len * sizeof(mag->elems[0]));
+}
+
+/*
+ * Fill an empty magazine with elements split off one free element of the
+ * heap, and return one of them. Keeping the cached elements next to each
+ * other avoids pinning the free space between larger allocations.
+ */
+static struct malloc_elem *
+malloc_slab_refill(struct malloc_slab_lcore *sl, unsigned int heap_id,
+		unsigned int cls)
+{
+	struct malloc_slab_mag *mag = &sl->mags[heap_id][cls];
+	unsigned int i;
+
+	if (malloc_heap_alloc_batch(heap_id, malloc_slab_class_size(cls),
+			mag->elems, MALLOC_SLAB_BATCH_SIZE) < 0)
+		return NULL;
+
+	for (i = 0; i < MALLOC_SLAB_BATCH_SIZE; i++) {
+		mag->elems[i]->state = ELEM_CACHED;
+		mag->elems[i]->slab = 1;
+		sl->count[heap_id]++;
+		sl->bytes[heap_id] += mag->elems[i]->size;
+	}
+	mag->len = MALLOC_SLAB_BATCH_SIZE;
+
+	return malloc_slab_pop(sl, heap_id, cls);
+}
+
+void *
+malloc_slab_alloc(const char *type, size_t size, unsigned int align,
+		int socket_arg)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct malloc_slab_lcore *sl;
+	struct malloc_elem *elem;
+	unsigned int cls, i;
+	int socket, heap_id;
+
+	/* elements are only aligned on a cache line */
+	if (size > RTE_MALLOC_SLAB_MAX_SIZE || align > RTE_CACHE_LINE_SIZE)
+		return NULL;
+
+	/*
+	 * only the slave lcores cache blocks, they give them back when their
+	 * function returns, while the master would pin them until the end
+	 */
+	if (lcore_id >= RTE_MAX_LCORE || lcore_id == rte_get_master_lcore())
+		return NULL;
+
+	/* the magazines are process local, only the primary caches blocks */
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
+		return NULL;
+
+	/* external heaps are not cached, so that they can be removed */
+	if (socket_arg == SOCKET_ID_ANY)
+		socket = malloc_get_numa_socket();
+	else if (socket_arg < 0 || socket_arg >= RTE_MAX_NUMA_NODES)
+		return NULL;
+	else
+		socket = socket_arg;
+
+	heap_id = malloc_socket_to_heap_id(socket);
+	if (heap_id < 0 || heap_id >= (int)rte_socket_count())
+		return NULL;
+
+	sl = malloc_slab_get_lcore(lcore_id);
+	if (sl == NULL)
+		return NULL;
+	cls = malloc_slab_class(size);
+
+	elem = malloc_slab_pop(sl, heap_id, cls);
+	if (likely(elem != NULL))
+		return &elem[1];
+
+	/* any socket will do, try the elements cached for the other ones */
+	if (socket_arg == SOCKET_ID_ANY) {
+		for (i = 0; i < rte_socket_count(); i++) {
+			if ((int)i == heap_id)
+				continue;
+			elem = malloc_slab_pop(sl, i, cls);
+			if (elem != NULL)
+				return &elem[1];
+		}
+	}
+
+	elem = malloc_slab_refill(sl, heap_id, cls);
+	if (elem != NULL)
+		return &elem[1];
+
+	return malloc_heap_alloc(type, malloc_slab_class_size(cls), socket_arg,
+			0, RTE_CACHE_LINE_SIZE, 0, false);
+}
+
+int
+malloc_slab_free(struct malloc_elem *elem)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	unsigned int lcore_id = rte_lcore_id();
+	struct malloc_slab_lcore *sl;
+	struct malloc_slab_mag *mag;
+	unsigned int heap_id, cls;
+	size_t data_len;
+
+	/* let the heap report invalid and double frees */
+	if (!malloc_elem_cookies_ok(elem) || elem->state != ELEM_BUSY ||
+			elem->pad != 0)
+		return -1;
+
+	/*
+	 * only cache the elements of a batch, an element allocated on its
+	 * own would keep the free space around it from being merged
+	 */
+	if (!elem->slab)
+		return -1;
+	elem->slab = 0;
+
+	if (lcore_id >= RTE_MAX_LCORE || lcore_id == rte_get_master_lcore() ||
+			rte_eal_process_type() != RTE_PROC_PRIMARY)
+		return -1;
+
+	heap_id = elem->heap - mcfg->malloc_heaps;
+	if (heap_id >= rte_socket_count())
+		return -1;
+
+	/* a resized element no longer has the size of its class */
+	data_len = elem->size - MALLOC_ELEM_OVERHEAD;
+	if (data_len > RTE_MALLOC_SLAB_MAX_SIZE || data_len == 0 ||
+			data_len % RTE_CACHE_LINE_SIZE != 0)
+		return -1;
+
+	sl = malloc_slab_get_lcore(lcore_id);
+	if (sl == NULL)
+		return -1;
+	cls = malloc_slab_class(data_len);
+	mag = &sl->mags[heap_id][cls];
+	if (unlikely(mag->len == MALLOC_SLAB_MAG_SIZE))
+		malloc_slab_flush(sl, heap_id, cls, MALLOC_SLAB_MAG_SIZE / 2);
+
+	/* rte_zmalloc() relies on free memory being zeroed */
+	memset(&elem[1], 0, data_len);
+
+	elem->state = ELEM_CACHED;
+	elem->slab = 1;
+	mag->elems[mag->len++] = elem;
+	sl->count[heap_id]++;
+	sl->bytes[heap_id] += elem->size;
+	return 0;
+}
+
+void
+malloc_slab_flush_lcore(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct malloc_slab_lcore *sl;
+	unsigned int heap_id, cls;
+
+	if (lcore_id >= RTE_MAX_LCORE || slab_lcore[lcore_id] == NULL)
+		return;
+
+	sl = slab_lcore[lcore_id];
+	for (heap_id = 0; heap_id < sl->nb_heaps; heap_id++) {
+		if (sl->count[heap_id] == 0)
+			continue;
+		for (cls = 0; cls < MALLOC_SLAB_MAX_CLASSES; cls++)
+			malloc_slab_flush(sl, heap_id, cls,
+				sl->mags[heap_id][cls].len);
+	}
+}
+
+void
+malloc_slab_get_stats(unsigned int heap_id, size_t *count, size_t *bytes)
+{
+	struct malloc_slab_lcore *sl;
+	unsigned int lcore_id;
+
+	*count = 0;
+	*bytes = 0;
+	if (heap_id >= RTE_MAX_NUMA_NODES)
+		return;
+
+	/* the counters of other lcores may be updated meanwhile */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		sl = slab_lcore[lcore_id];
+		if (sl == NULL)
+			continue;
+		*count += sl->count[heap_id];
+		*bytes += sl->bytes[heap_id];
+	}
+}
+
+#else /* RTE_MALLOC_SLAB_MAX_SIZE == 0 */
+
+void *
+malloc_slab_alloc(const char *type __rte_unused, size_t size __rte_unused,
+		unsigned int align __rte_unused, int socket_arg __rte_unused)
+{
+	return NULL;
+}
+
+int
+malloc_slab_free(struct malloc_elem *elem __rte_unused)
+{
+	return -1;
+}
+
+void
+malloc_slab_flush_lcore(void)
+{
+}
+
+void
+malloc_slab_get_stats(unsigned int heap_id __rte_unused, size_t *count,
+		size_t *bytes)
+{
+	*count = 0;
+	*bytes = 0;
+}
+
+#endif /* RTE_MALLOC_SLAB_MAX_SIZE */
@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef MALLOC_SLAB_H_
+#define MALLOC_SLAB_H_
+
+#include <stddef.h>
+
+#include "malloc_elem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of free elements cached per lcore, heap and size class */
+#define MALLOC_SLAB_MAG_SIZE 32
+
+/* number of elements allocated at once from the heap on a miss */
+#define MALLOC_SLAB_BATCH_SIZE (MALLOC_SLAB_MAG_SIZE / 4)
+
+/* size classes are multiples of a cache line, like the heap elements */
+#define MALLOC_SLAB_MAX_CLASSES \
+	((RTE_MALLOC_SLAB_MAX_SIZE + RTE_CACHE_LINE_SIZE - 1) / \
+	RTE_CACHE_LINE_SIZE)
+
+/*
+ * Take an element of the size class of *size* from the lcore magazine of
+ * the heap matching *socket_arg*. On a miss, the magazine is refilled with
+ * a batch of adjacent elements of the class size allocated from the heap.
+ * Returns NULL if the request is not handled by the slab front-end, which
+ * is always the case on the master lcore and in secondary processes: the
+ * magazines are private to a process while the heaps are shared.
+ */
+void *
+malloc_slab_alloc(const char *type, size_t size, unsigned int align,
+		int socket_arg);
+
+/*
+ * Cache a freed element allocated by the slab front-end in the magazine of
+ * the calling lcore, where it is marked ELEM_CACHED. Returns 0 if the
+ * element was cached, -1 if it must go back to its heap, which also reports
+ * the invalid or double frees.
+ */
+int
+malloc_slab_free(struct malloc_elem *elem);
+
+/*
+ * Give all the elements cached by the calling lcore back to their heaps.
+ */
+void
+malloc_slab_flush_lcore(void);
+
+/*
+ * Get the number of elements and bytes held in the magazines of all
+ * lcores for a heap.
+ */
+void
+malloc_slab_get_stats(unsigned int heap_id, size_t *count, size_t *bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MALLOC_SLAB_H_ */
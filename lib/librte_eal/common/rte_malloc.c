@@ -24,14 +24,21 @@
 #include <rte_malloc.h>
 #include "malloc_elem.h"
 #include "malloc_heap.h"
+#include "malloc_slab.h"
 #include "eal_memalloc.h"
 
 
 /* Free the memory space back to heap */
 void rte_free(void *addr)
 {
+	struct malloc_elem *elem;
+
 	if (addr == NULL) return;
-	if (malloc_heap_free(malloc_elem_from_data(addr)) < 0)
+	elem = malloc_elem_from_data(addr);
+	/* small elements are kept in the lcore magazines */
+	if (elem != NULL && malloc_slab_free(elem) == 0)
+		return;
+	if (malloc_heap_free(elem) < 0)
 		RTE_LOG(ERR, EAL, "Error: Invalid memory\n");
 }
 
@@ -42,6 +49,8 @@ void *
 rte_malloc_socket(const char *type, size_t size, unsigned int align,
 		int socket_arg)
 {
+	void *ret;
+
 	/* return NULL if size is 0 or alignment is not power-of-2 */
 	if (size == 0 || (align && !rte_is_power_of_2(align)))
 		return NULL;
@@ -55,6 +64,11 @@ rte_malloc_socket(const char *type, size_t size, unsigned int align,
 				!rte_eal_has_hugepages())
 		socket_arg = SOCKET_ID_ANY;
 
+	/* small allocations are first served without taking the heap lock */
+	ret = malloc_slab_alloc(type, size, align, socket_arg);
+	if (ret != NULL)
+		return ret;
+
 	return malloc_heap_alloc(type, size, socket_arg, 0,
 			align == 0 ? 1 : align, 0, false);
 }
@@ -132,7 +146,10 @@ rte_realloc(void *ptr, size_t size, unsigned align)
 		return NULL;
 	const unsigned old_size = elem->size - MALLOC_ELEM_OVERHEAD;
 	rte_memcpy(new_ptr, ptr, old_size < size ? old_size : size);
-	rte_free(ptr);
+	/* the old block goes straight back to the heap, so that it can be
+	 * merged with its neighbours instead of sitting in a magazine */
+	if (malloc_heap_free(elem) < 0)
+		RTE_LOG(ERR, EAL, "Error: Invalid memory\n");
 
 	return new_ptr;
 }
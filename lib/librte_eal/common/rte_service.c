@@ -18,8 +18,10 @@
 #include <rte_debug.h>
 #include <rte_cycles.h>
 #include <rte_atomic.h>
+#include <rte_log.h>
 #include <rte_memory.h>
 #include <rte_malloc.h>
+#include <rte_spinlock.h>
 
 #define RTE_SERVICE_NUM_MAX 64
 
@@ -31,6 +33,16 @@
 #define RUNSTATE_STOPPED 0
 #define RUNSTATE_RUNNING 1
 
+/* maximum number of loops an idle service is skipped for by the adaptive
+ * scheduler, the skip count doubles each time the service is found idle.
+ */
+#define SERVICE_IDLE_BACKOFF_MAX 32
+
+/* minimum load difference between two service cores, in 1/N of the balancing
+ * period, for a service to be migrated from one to the other.
+ */
+#define SERVICE_BALANCE_THRESHOLD 4
+
 /* internal representation of a service */
 struct rte_service_spec_impl {
 	/* public part of the struct */
@@ -46,23 +58,43 @@ struct rte_service_spec_impl {
 	int8_t app_runstate;
 	int8_t comp_runstate;
 	uint8_t internal_flags;
+	uint32_t weight;
 
 	/* per service statistics */
 	rte_atomic32_t num_mapped_cores;
 	uint64_t calls;
+	uint64_t idle_calls;
 	uint64_t cycles_spent;
+	uint64_t busy_cycles; /* cycles_spent in the calls doing work */
 	uint8_t active_on_lcore[RTE_MAX_LCORE];
 } __rte_cache_aligned;
 
+/* adaptive scheduling state of a service on a service core */
+struct service_sched {
+	uint16_t backoff; /* loops to skip the next time the service is idle */
+	uint16_t skip; /* loops left before the service is called again */
+};
+
 /* the internal values of a service core */
 struct core_state {
 	/* map of services IDs are run on this core */
 	uint64_t service_mask;
 	uint8_t runstate; /* running or stopped */
 	uint8_t is_service_core; /* set if core is currently a service core */
+	uint8_t sched_mode; /* RTE_SERVICE_LCORE_SCHED_* */
 
 	uint64_t loops;
 	uint64_t calls_per_service[RTE_SERVICE_NUM_MAX];
+	struct service_sched sched[RTE_SERVICE_NUM_MAX];
+
+	/* cycles spent in the calls doing work, for load balancing */
+	uint64_t busy_cycles_per_service[RTE_SERVICE_NUM_MAX];
+	/* busy cycles at the previous balancing, only used by the balancer */
+	uint64_t balance_cycles_per_service[RTE_SERVICE_NUM_MAX];
+	/* service to hand over to another core at the end of the loop */
+	uint8_t migrate_pending;
+	uint8_t migrate_service;
+	uint32_t migrate_lcore;
 } __rte_cache_aligned;
 
 static uint32_t rte_service_count;
@@ -70,6 +102,11 @@ static struct rte_service_spec_impl *rte_services;
 static struct core_state *lcore_states;
 static uint32_t rte_service_library_initialized;
 
+/* load balancing of the services between the service cores */
+static uint64_t service_balance_period; /* in TSC cycles, 0 if disabled */
+static uint64_t service_balance_next;
+static rte_spinlock_t service_balance_lock = RTE_SPINLOCK_INITIALIZER;
+
 int32_t rte_service_init(void)
 {
 	if (rte_service_library_initialized) {
@@ -252,6 +289,7 @@ rte_service_component_register(const struct rte_service_spec *spec,
 	struct rte_service_spec_impl *s = &rte_services[free_slot];
 	s->spec = *spec;
 	s->internal_flags |= SERVICE_F_REGISTERED | SERVICE_F_START_CHECK;
+	s->weight = 1;
 
 	rte_smp_wmb();
 	rte_service_count++;
@@ -276,7 +314,8 @@ rte_service_component_unregister(uint32_t id)
 
 	/* clear the run-bit in all cores */
 	for (i = 0; i < RTE_MAX_LCORE; i++)
-		lcore_states[i].service_mask &= ~(UINT64_C(1) << id);
+		__atomic_and_fetch(&lcore_states[i].service_mask,
+				~(UINT64_C(1) << id), __ATOMIC_RELAXED);
 
 	memset(&rte_services[id], 0, sizeof(struct rte_service_spec_impl));
 
@@ -328,24 +367,40 @@ rte_service_runstate_get(uint32_t id)
 		(check_disabled | lcore_mapped);
 }
 
-static inline void
+/* returns -EAGAIN if the service reported that it did no work */
+static inline int32_t
 rte_service_runner_do_callback(struct rte_service_spec_impl *s,
 			       struct core_state *cs, uint32_t service_idx)
 {
 	void *userdata = s->spec.callback_userdata;
+	const int stats = service_stats_enabled(s);
+	int32_t ret;
 
-	if (service_stats_enabled(s)) {
+	if (stats || service_balance_period != 0) {
 		uint64_t start = rte_rdtsc();
-		s->spec.callback(userdata);
+		ret = s->spec.callback(userdata);
 		uint64_t end = rte_rdtsc();
-		s->cycles_spent += end - start;
-		cs->calls_per_service[service_idx]++;
-		s->calls++;
+		if (ret != -EAGAIN)
+			cs->busy_cycles_per_service[service_idx] += end - start;
+		if (stats) {
+			s->cycles_spent += end - start;
+			cs->calls_per_service[service_idx]++;
+			s->calls++;
+			if (ret == -EAGAIN)
+				s->idle_calls++;
+			else
+				s->busy_cycles += end - start;
+		}
 	} else
-		s->spec.callback(userdata);
+		ret = s->spec.callback(userdata);
+
+	return ret == -EAGAIN ? -EAGAIN : 0;
 }
 
 
+/* returns 0 if the service was run, -EAGAIN if it was run and did no work,
+ * or another negative value if it could not be run.
+ */
 static inline int32_t
 service_run(uint32_t i, int lcore, struct core_state *cs, uint64_t service_mask)
 {
@@ -366,28 +421,65 @@ service_run(uint32_t i, int lcore, struct core_state *cs, uint64_t service_mask)
 	 */
 	const int use_atomics = (service_mt_safe(s) == 0) &&
 				(rte_atomic32_read(&s->num_mapped_cores) > 1);
+	int32_t ret;
 	if (use_atomics) {
 		if (!rte_atomic32_cmpset((uint32_t *)&s->execute_lock, 0, 1))
 			return -EBUSY;
 
-		rte_service_runner_do_callback(s, cs, i);
+		ret = rte_service_runner_do_callback(s, cs, i);
 		rte_atomic32_clear(&s->execute_lock);
 	} else
-		rte_service_runner_do_callback(s, cs, i);
+		ret = rte_service_runner_do_callback(s, cs, i);
 
-	return 0;
+	return ret;
+}
+
+/* run a service with the adaptive scheduler: a service doing work is called
+ * up to its weight times in a row, an idle service is skipped for a number
+ * of loops doubling each time it is found idle again.
+ */
+static inline void
+service_run_adaptive(uint32_t i, int lcore, struct core_state *cs,
+		uint64_t service_mask)
+{
+	struct service_sched *sched = &cs->sched[i];
+	uint32_t n;
+	int32_t ret;
+
+	if (!(service_mask & (UINT64_C(1) << i))) {
+		/* marks the service as not active on this core */
+		service_run(i, lcore, cs, service_mask);
+		return;
+	}
+
+	if (sched->skip != 0) {
+		sched->skip--;
+		return;
+	}
+
+	ret = service_run(i, lcore, cs, service_mask);
+	for (n = 1; ret == 0 && n < rte_services[i].weight; n++)
+		ret = service_run(i, lcore, cs, service_mask);
+
+	if (ret == -EAGAIN) {
+		sched->skip = sched->backoff;
+		if (sched->backoff == 0)
+			sched->backoff = 1;
+		else if (sched->backoff < SERVICE_IDLE_BACKOFF_MAX)
+			sched->backoff *= 2;
+	} else if (ret == 0)
+		sched->backoff = 0;
 }
 
 int32_t __rte_experimental
 rte_service_may_be_active(uint32_t id)
 {
 	uint32_t ids[RTE_MAX_LCORE] = {0};
-	struct rte_service_spec_impl *s = &rte_services[id];
+	struct rte_service_spec_impl *s;
 	int32_t lcore_count = rte_service_lcore_list(ids, RTE_MAX_LCORE);
 	int i;
 
-	if (!service_valid(id))
-		return -EINVAL;
+	SERVICE_VALID_GET_OR_ERR_RET(id, s, -EINVAL);
 
 	for (i = 0; i < lcore_count; i++) {
 		if (s->active_on_lcore[ids[i]])
@@ -426,7 +518,167 @@ int32_t rte_service_run_iter_on_app_lcore(uint32_t id,
 	if (serialize_mt_unsafe)
 		rte_atomic32_dec(&s->num_mapped_cores);
 
-	return ret;
+	/* an idle iteration is still a successful run */
+	return ret == -EAGAIN ? 0 : ret;
+}
+
+/* move a service mapped to this core only to the core chosen by the
+ * balancer, called by the service core between two loops.
+ */
+static void
+service_migrate(uint32_t lcore, struct core_state *cs)
+{
+	const uint32_t id = cs->migrate_service;
+	const uint32_t dst = cs->migrate_lcore;
+	const uint64_t sid_mask = UINT64_C(1) << id;
+	struct core_state *dst_cs = &lcore_states[dst];
+
+	cs->migrate_pending = 0;
+
+	/* no mapping can change between the check and the move */
+	rte_spinlock_lock(&service_balance_lock);
+
+	/* the mapping may have changed since the balancer chose the service */
+	if (!service_valid(id) || !(cs->service_mask & sid_mask) ||
+			rte_atomic32_read(&rte_services[id].num_mapped_cores)
+			!= 1 || !dst_cs->is_service_core ||
+			dst_cs->runstate != RUNSTATE_RUNNING) {
+		rte_spinlock_unlock(&service_balance_lock);
+		return;
+	}
+
+	__atomic_and_fetch(&cs->service_mask, ~sid_mask, __ATOMIC_RELEASE);
+	rte_services[id].active_on_lcore[lcore] = 0;
+	memset(&cs->sched[id], 0, sizeof(cs->sched[id]));
+	memset(&dst_cs->sched[id], 0, sizeof(dst_cs->sched[id]));
+	__atomic_or_fetch(&dst_cs->service_mask, sid_mask, __ATOMIC_RELEASE);
+
+	rte_spinlock_unlock(&service_balance_lock);
+
+	RTE_LOG(DEBUG, EAL, "Service %s migrated from lcore %u to lcore %u\n",
+		rte_services[id].spec.name, lcore, dst);
+}
+
+/* load of a service core since the previous balancing */
+static uint64_t
+service_lcore_load(struct core_state *cs)
+{
+	uint64_t load = 0;
+	uint32_t i;
+
+	for (i = 0; i < RTE_SERVICE_NUM_MAX; i++)
+		load += cs->busy_cycles_per_service[i] -
+			cs->balance_cycles_per_service[i];
+
+	return load;
+}
+
+static void
+service_balance_snapshot(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		struct core_state *cs = &lcore_states[i];
+
+		if (cs->is_service_core)
+			memcpy(cs->balance_cycles_per_service,
+				cs->busy_cycles_per_service,
+				sizeof(cs->balance_cycles_per_service));
+	}
+}
+
+/* compare the load of the running service cores, and if the difference
+ * between the most and the least loaded ones is large enough, ask the most
+ * loaded one to hand over the service which reduces it the most.
+ */
+static void
+service_balance(uint64_t elapsed)
+{
+	uint64_t load, max_load = 0, min_load = UINT64_MAX;
+	uint32_t src = RTE_MAX_LCORE, dst = RTE_MAX_LCORE;
+	uint64_t diff, best = 0;
+	int32_t best_id = -1;
+	struct core_state *cs;
+	uint32_t i;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		cs = &lcore_states[i];
+		if (!cs->is_service_core || cs->runstate != RUNSTATE_RUNNING)
+			continue;
+
+		load = service_lcore_load(cs);
+		if (src == RTE_MAX_LCORE || load > max_load) {
+			max_load = load;
+			src = i;
+		}
+		if (dst == RTE_MAX_LCORE || load < min_load) {
+			min_load = load;
+			dst = i;
+		}
+	}
+
+	if (src == dst)
+		goto out;
+
+	diff = max_load - min_load;
+	if (diff * SERVICE_BALANCE_THRESHOLD < elapsed)
+		goto out;
+
+	cs = &lcore_states[src];
+	if (cs->migrate_pending)
+		goto out;
+
+	/* moving a service of load d lowers the highest load as long as
+	 * d < diff, the highest such d balances the cores the most.
+	 */
+	for (i = 0; i < RTE_SERVICE_NUM_MAX; i++) {
+		if (!service_valid(i) ||
+				!(cs->service_mask & (UINT64_C(1) << i)) ||
+				rte_atomic32_read(
+					&rte_services[i].num_mapped_cores) != 1)
+			continue;
+
+		load = cs->busy_cycles_per_service[i] -
+			cs->balance_cycles_per_service[i];
+		if (load < diff && load > best) {
+			best = load;
+			best_id = i;
+		}
+	}
+
+	if (best_id >= 0) {
+		cs->migrate_service = best_id;
+		cs->migrate_lcore = dst;
+		__atomic_store_n(&cs->migrate_pending, 1, __ATOMIC_RELEASE);
+	}
+
+out:
+	service_balance_snapshot();
+}
+
+/* called by the service cores between two loops, the first one finding the
+ * balancing period elapsed does the balancing.
+ */
+static void
+service_balance_check(void)
+{
+	uint64_t now = rte_rdtsc();
+	uint64_t period;
+
+	if (now < service_balance_next)
+		return;
+
+	if (!rte_spinlock_trylock(&service_balance_lock))
+		return;
+
+	period = service_balance_period;
+	if (period != 0 && now >= service_balance_next) {
+		service_balance(now - service_balance_next + period);
+		service_balance_next = now + period;
+	}
+
+	rte_spinlock_unlock(&service_balance_lock);
 }
 
 static int32_t
@@ -440,13 +692,29 @@ rte_service_runner_func(void *arg)
 	while (lcore_states[lcore].runstate == RUNSTATE_RUNNING) {
 		const uint64_t service_mask = cs->service_mask;
 
-		for (i = 0; i < RTE_SERVICE_NUM_MAX; i++) {
-			/* return value ignored as no change to code flow */
-			service_run(i, lcore, cs, service_mask);
+		if (cs->sched_mode == RTE_SERVICE_LCORE_SCHED_ADAPTIVE) {
+			for (i = 0; i < RTE_SERVICE_NUM_MAX; i++)
+				service_run_adaptive(i, lcore, cs,
+						service_mask);
+		} else {
+			for (i = 0; i < RTE_SERVICE_NUM_MAX; i++) {
+				/* return value ignored as no change to code
+				 * flow
+				 */
+				service_run(i, lcore, cs, service_mask);
+			}
 		}
 
 		cs->loops++;
 
+		/* none of the services of this core is running between two
+		 * loops, so it can hand one of them over to another core.
+		 */
+		if (unlikely(cs->migrate_pending))
+			service_migrate(lcore, cs);
+		if (unlikely(service_balance_period != 0))
+			service_balance_check();
+
 		rte_smp_rmb();
 	}
 
@@ -569,12 +837,15 @@ service_update(struct rte_service_spec *service, uint32_t lcore,
 		uint64_t lcore_mapped = lcore_states[lcore].service_mask &
 			sid_mask;
 
+		/* atomic as the service cores may migrate services */
 		if (*set && !lcore_mapped) {
-			lcore_states[lcore].service_mask |= sid_mask;
+			__atomic_or_fetch(&lcore_states[lcore].service_mask,
+					sid_mask, __ATOMIC_RELAXED);
 			rte_atomic32_inc(&rte_services[sid].num_mapped_cores);
 		}
 		if (!*set && lcore_mapped) {
-			lcore_states[lcore].service_mask &= ~(sid_mask);
+			__atomic_and_fetch(&lcore_states[lcore].service_mask,
+					~(sid_mask), __ATOMIC_RELAXED);
 			rte_atomic32_dec(&rte_services[sid].num_mapped_cores);
 		}
 	}
@@ -593,7 +864,14 @@ rte_service_map_lcore_set(uint32_t id, uint32_t lcore, uint32_t enabled)
 	struct rte_service_spec_impl *s;
 	SERVICE_VALID_GET_OR_ERR_RET(id, s, -EINVAL);
 	uint32_t on = enabled > 0;
-	return service_update(&s->spec, lcore, &on, 0);
+	int32_t ret;
+
+	/* serialized with the balancing and the migrations it requests */
+	rte_spinlock_lock(&service_balance_lock);
+	ret = service_update(&s->spec, lcore, &on, 0);
+	rte_spinlock_unlock(&service_balance_lock);
+
+	return ret;
 }
 
 int32_t
@@ -655,6 +933,9 @@ rte_service_lcore_add(uint32_t lcore)
 	/* ensure that after adding a core the mask and state are defaults */
 	lcore_states[lcore].service_mask = 0;
 	lcore_states[lcore].runstate = RUNSTATE_STOPPED;
+	lcore_states[lcore].sched_mode = RTE_SERVICE_LCORE_SCHED_ROUND_ROBIN;
+	memset(lcore_states[lcore].sched, 0, sizeof(lcore_states[lcore].sched));
+	lcore_states[lcore].migrate_pending = 0;
 
 	rte_smp_wmb();
 
@@ -733,6 +1014,57 @@ rte_service_lcore_stop(uint32_t lcore)
 	return 0;
 }
 
+int32_t __rte_experimental
+rte_service_lcore_sched_mode_set(uint32_t lcore, uint32_t mode)
+{
+	struct core_state *cs;
+
+	if (lcore >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	cs = &lcore_states[lcore];
+	if (!cs->is_service_core)
+		return -ENOTSUP;
+
+	if (mode != RTE_SERVICE_LCORE_SCHED_ROUND_ROBIN &&
+			mode != RTE_SERVICE_LCORE_SCHED_ADAPTIVE)
+		return -EINVAL;
+
+	cs->sched_mode = mode;
+	rte_smp_wmb();
+
+	return 0;
+}
+
+int32_t __rte_experimental
+rte_service_weight_set(uint32_t id, uint32_t weight)
+{
+	struct rte_service_spec_impl *s;
+	SERVICE_VALID_GET_OR_ERR_RET(id, s, -EINVAL);
+
+	if (weight == 0 || weight > RTE_SERVICE_WEIGHT_MAX)
+		return -EINVAL;
+
+	s->weight = weight;
+	rte_smp_wmb();
+
+	return 0;
+}
+
+int32_t __rte_experimental
+rte_service_balance_set(uint32_t period_ms)
+{
+	uint64_t period = rte_get_tsc_hz() / MS_PER_S * period_ms;
+
+	rte_spinlock_lock(&service_balance_lock);
+	service_balance_snapshot();
+	service_balance_next = rte_rdtsc() + period;
+	service_balance_period = period;
+	rte_spinlock_unlock(&service_balance_lock);
+
+	return 0;
+}
+
 int32_t
 rte_service_attr_get(uint32_t id, uint32_t attr_id, uint32_t *attr_value)
 {
@@ -749,6 +1081,16 @@ rte_service_attr_get(uint32_t id, uint32_t attr_id, uint32_t *attr_value)
 	case RTE_SERVICE_ATTR_CALL_COUNT:
 		*attr_value = s->calls;
 		return 0;
+	case RTE_SERVICE_ATTR_IDLE_CALL_COUNT:
+		*attr_value = s->idle_calls;
+		return 0;
+	case RTE_SERVICE_ATTR_CYCLES_PER_BUSY_CALL:
+		if (s->calls == s->idle_calls)
+			*attr_value = 0;
+		else
+			*attr_value = s->busy_cycles /
+				(s->calls - s->idle_calls);
+		return 0;
 	default:
 		return -EINVAL;
 	}
@@ -790,17 +1132,19 @@ rte_service_dump_one(FILE *f, struct rte_service_spec_impl *s,
 
 	if (reset) {
 		s->cycles_spent = 0;
+		s->busy_cycles = 0;
 		s->calls = 0;
+		s->idle_calls = 0;
 		return;
 	}
 
 	if (f == NULL)
 		return;
 
-	fprintf(f, "  %s: stats %d\tcalls %"PRIu64"\tcycles %"
-			PRIu64"\tavg: %"PRIu64"\n",
+	fprintf(f, "  %s: stats %d\tcalls %"PRIu64"\tidle %"PRIu64
+			"\tcycles %"PRIu64"\tavg: %"PRIu64"\n",
 			s->spec.name, service_stats_enabled(s), s->calls,
-			s->cycles_spent, s->cycles_spent / calls);
+			s->idle_calls, s->cycles_spent, s->cycles_spent / calls);
 }
 
 int32_t
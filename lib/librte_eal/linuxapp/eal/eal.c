@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <string.h>
 #include <stdarg.h>
 #include <unistd.h>
@@ -519,6 +520,10 @@ eal_usage(const char *prgname)
 	       "  --"OPT_LEGACY_MEM"        Legacy memory mode (no dynamic allocation, contiguous segments)\n"
 	       "  --"OPT_SINGLE_FILE_SEGMENTS" Put all hugepage memory in single files\n"
 	       "  --"OPT_MATCH_ALLOCATIONS" Free hugepages exactly as allocated\n"
+	       "  --"OPT_MEM_INIT_THREADS"  Number of threads per socket faulting in\n"
+	       "                      the memory reserved at init (default 1)\n"
+	       "  --"OPT_MEM_INIT_LAZY"     Fault in the memory reserved at init on first use\n"
+	       "  --"OPT_INTR_THREADS"      Number of threads handling the interrupts (default 1)\n"
 	       "\n");
 	/* Allow the application to print its usage message too if hook is set */
 	if ( rte_application_usage_hook ) {
@@ -614,6 +619,46 @@ eal_parse_base_virtaddr(const char *arg)
 	return 0;
 }
 
+static int
+eal_parse_mem_init_threads(const char *arg)
+{
+	char *end;
+	unsigned long num;
+
+	errno = 0;
+	num = strtoul(arg, &end, 10);
+
+	/* check for errors */
+	if ((errno != 0) || (arg[0] == '\0') || end == NULL || (*end != '\0'))
+		return -1;
+	if (num == 0 || num > RTE_MAX_LCORE)
+		return -1;
+
+	internal_config.mem_init_threads = num;
+
+	return 0;
+}
+
+static int
+eal_parse_intr_threads(const char *arg)
+{
+	char *end;
+	unsigned long num;
+
+	errno = 0;
+	num = strtoul(arg, &end, 10);
+
+	/* check for errors */
+	if ((errno != 0) || (arg[0] == '\0') || end == NULL || (*end != '\0'))
+		return -1;
+	if (num == 0 || num > EAL_INTR_THREADS_MAX)
+		return -1;
+
+	internal_config.intr_threads = num;
+
+	return 0;
+}
+
 static int
 eal_parse_vfio_intr(const char *mode)
 {
@@ -816,6 +861,30 @@ eal_parse_args(int argc, char **argv)
 			internal_config.match_allocations = 1;
 			break;
 
+		case OPT_MEM_INIT_THREADS_NUM:
+			if (eal_parse_mem_init_threads(optarg) < 0) {
+				RTE_LOG(ERR, EAL, "invalid parameter for --"
+						OPT_MEM_INIT_THREADS "\n");
+				eal_usage(prgname);
+				ret = -1;
+				goto out;
+			}
+			break;
+
+		case OPT_MEM_INIT_LAZY_NUM:
+			internal_config.mem_init_lazy = 1;
+			break;
+
+		case OPT_INTR_THREADS_NUM:
+			if (eal_parse_intr_threads(optarg) < 0) {
+				RTE_LOG(ERR, EAL, "invalid parameter for --"
+						OPT_INTR_THREADS "\n");
+				eal_usage(prgname);
+				ret = -1;
+				goto out;
+			}
+			break;
+
 		default:
 			if (opt < OPT_LONG_MIN_NUM && isprint(opt)) {
 				RTE_LOG(ERR, EAL, "Option %c is not supported "
@@ -948,6 +1017,11 @@ rte_eal_init(int argc, char **argv)
 	static char logid[PATH_MAX];
 	char cpuset[RTE_CPU_AFFINITY_STR_LEN];
 	char thread_name[RTE_MAX_THREAD_NAME_LEN];
+	/* durations of the slowest init steps, in microseconds */
+	uint64_t ts_start, ts, hugepage_info_us = 0, memory_us, heap_us;
+	uint64_t lcores_us, probe_us;
+
+	ts_start = eal_get_time_us();
 
 	/* checks if the machine is adequate */
 	if (!rte_cpu_is_supported()) {
@@ -1049,6 +1123,7 @@ rte_eal_init(int argc, char **argv)
 	}
 
 	if (internal_config.no_hugetlbfs == 0) {
+		ts = eal_get_time_us();
 		/* rte_config isn't initialized yet */
 		ret = internal_config.process_type == RTE_PROC_PRIMARY ?
 				eal_hugepage_info_init() :
@@ -1059,6 +1134,7 @@ rte_eal_init(int argc, char **argv)
 			rte_atomic32_clear(&run_once);
 			return -1;
 		}
+		hugepage_info_us = eal_get_time_us() - ts;
 	}
 
 	if (internal_config.memory == 0 && internal_config.force_sockets == 0) {
@@ -1094,6 +1170,8 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 #endif
+	ts = eal_get_time_us();
+
 	/* in secondary processes, memory init may allocate additional fbarrays
 	 * not present in primary processes, so to avoid any potential issues,
 	 * initialize memzones first.
@@ -1113,12 +1191,17 @@ rte_eal_init(int argc, char **argv)
 	/* the directories are locked during eal_hugepage_info_init */
 	eal_hugedirs_unlock();
 
+	memory_us = eal_get_time_us() - ts;
+	ts = eal_get_time_us();
+
 	if (rte_eal_malloc_heap_init() < 0) {
 		rte_eal_init_alert("Cannot init malloc heap");
 		rte_errno = ENODEV;
 		return -1;
 	}
 
+	heap_us = eal_get_time_us() - ts;
+
 	if (rte_eal_tailqs_init() < 0) {
 		rte_eal_init_alert("Cannot init tail queues for objects");
 		rte_errno = EFAULT;
@@ -1139,6 +1222,8 @@ rte_eal_init(int argc, char **argv)
 
 	eal_check_mem_on_local_socket();
 
+	ts = eal_get_time_us();
+
 	eal_thread_init_master(rte_config.master_lcore);
 
 	ret = eal_thread_dump_affinity(cpuset, sizeof(cpuset));
@@ -1183,6 +1268,8 @@ rte_eal_init(int argc, char **argv)
 	rte_eal_mp_remote_launch(sync_func, NULL, SKIP_MASTER);
 	rte_eal_mp_wait_lcore();
 
+	lcores_us = eal_get_time_us() - ts;
+
 	/* initialize services so vdevs register service during bus_probe. */
 	ret = rte_service_init();
 	if (ret) {
@@ -1191,6 +1278,14 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	if (eal_trace_init() < 0) {
+		rte_eal_init_alert("Cannot init trace");
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	ts = eal_get_time_us();
+
 	/* Probe all the buses and devices/drivers on them */
 	if (rte_bus_probe()) {
 		rte_eal_init_alert("Cannot probe devices");
@@ -1198,6 +1293,8 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	probe_us = eal_get_time_us() - ts;
+
 #ifdef VFIO_PRESENT
 	/* Register mp action after probe() so that we got enough info */
 	if (rte_vfio_is_enabled("vfio") && vfio_mp_sync_setup() < 0)
@@ -1233,6 +1330,13 @@ rte_eal_init(int argc, char **argv)
 	/* Call each registered callback, if enabled */
 	rte_option_init();
 
+	RTE_LOG(INFO, EAL, "Init done in %" PRIu64 " ms: hugepage info %"
+		PRIu64 " ms, memory %" PRIu64 " ms, malloc heap %" PRIu64
+		" ms, lcores %" PRIu64 " ms, bus probe %" PRIu64 " ms\n",
+		(eal_get_time_us() - ts_start) / 1000,
+		hugepage_info_us / 1000, memory_us / 1000, heap_us / 1000,
+		lcores_us / 1000, probe_us / 1000);
+
 	return fctret;
 }
 
@@ -1261,6 +1365,7 @@ rte_eal_cleanup(void)
 	 */
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY)
 		rte_memseg_walk(mark_freeable, NULL);
+	eal_trace_fini();
 	rte_service_finalize();
 	rte_mp_channel_cleanup();
 	eal_cleanup_config(&internal_config);
@@ -32,31 +32,21 @@
 #include <rte_log.h>
 #include <rte_errno.h>
 #include <rte_spinlock.h>
+#include <rte_string_fns.h>
 #include <rte_pause.h>
 #include <rte_vfio.h>
 
 #include "eal_private.h"
 #include "eal_vfio.h"
 #include "eal_thread.h"
+#include "eal_internal_cfg.h"
 
 #define EAL_INTR_EPOLL_WAIT_FOREVER (-1)
 #define NB_OTHER_INTR               1
+#define EAL_INTR_EVENTS_MAX         64 /* events handled per batch */
 
 static RTE_DEFINE_PER_LCORE(int, _epfd) = -1; /**< epoll fd per thread */
 
-/**
- * union for pipe fds.
- */
-union intr_pipefds{
-	struct {
-		int pipefd[2];
-	};
-	struct {
-		int readfd;
-		int writefd;
-	};
-};
-
 /**
  * union buffer for reading on different devices
  */
@@ -82,20 +72,32 @@ struct rte_intr_source {
 	TAILQ_ENTRY(rte_intr_source) next;
 	struct rte_intr_handle intr_handle; /**< interrupt handle */
 	struct rte_intr_cb_list callbacks;  /**< user callbacks */
+	struct intr_thread *thread;         /**< thread waiting on the fd */
 	uint32_t active;
+	uint32_t removed; /**< removed, freed by its thread */
+};
+
+/**
+ * An interrupt handling thread, waiting on its own epoll instance.
+ */
+struct intr_thread {
+	pthread_t tid;
+	int epfd;                /**< epoll instance of the sources */
+	int wakefd;              /**< eventfd waking up the thread */
+	unsigned int nb_sources; /**< number of sources in the instance */
+	/** removed sources, freed at the end of the current batch */
+	struct rte_intr_source_list removed_sources;
 };
 
 /* global spinlock for interrupt data operation */
 static rte_spinlock_t intr_lock = RTE_SPINLOCK_INITIALIZER;
 
-/* union buffer for pipe read/write */
-static union intr_pipefds intr_pipe;
-
 /* interrupt sources list */
 static struct rte_intr_source_list intr_sources;
 
-/* interrupt handling thread */
-static pthread_t intr_thread;
+/* interrupt handling threads */
+static struct intr_thread intr_threads[EAL_INTR_THREADS_MAX];
+static unsigned int intr_nb_threads;
 
 /* VFIO interrupts */
 #ifdef VFIO_PRESENT
@@ -447,15 +449,58 @@ uio_intr_enable(const struct rte_intr_handle *intr_handle)
 	return 0;
 }
 
+/* pick the thread waiting on the fewest sources */
+static struct intr_thread *
+eal_intr_thread_select(void)
+{
+	struct intr_thread *thread = &intr_threads[0];
+	unsigned int i;
+
+	for (i = 1; i < intr_nb_threads; i++)
+		if (intr_threads[i].nb_sources < thread->nb_sources)
+			thread = &intr_threads[i];
+
+	return thread;
+}
+
+/*
+ * Remove a source from the wait list of its thread, with intr_lock held.
+ * The source is freed by its thread once done with the current batch of
+ * events, which may still refer to it.
+ */
+static void
+eal_intr_source_remove(struct rte_intr_source *src)
+{
+	struct intr_thread *thread = src->thread;
+
+	TAILQ_REMOVE(&intr_sources, src, next);
+	if (epoll_ctl(thread->epfd, EPOLL_CTL_DEL, src->intr_handle.fd,
+			NULL) < 0 && errno != EBADF)
+		RTE_LOG(ERR, EAL, "Error removing fd %d from epoll_ctl, %s\n",
+			src->intr_handle.fd, strerror(errno));
+	thread->nb_sources--;
+	src->removed = 1;
+	TAILQ_INSERT_TAIL(&thread->removed_sources, src, next);
+}
+
+static void
+eal_intr_thread_wake(struct intr_thread *thread)
+{
+	uint64_t value = 1;
+
+	if (write(thread->wakefd, &value, sizeof(value)) < 0)
+		RTE_LOG(ERR, EAL, "Cannot wake up interrupt thread, %s\n",
+			strerror(errno));
+}
+
 int
 rte_intr_callback_register(const struct rte_intr_handle *intr_handle,
 			rte_intr_callback_fn cb, void *cb_arg)
 {
-	int ret, wake_thread;
+	int ret;
 	struct rte_intr_source *src;
 	struct rte_intr_callback *callback;
-
-	wake_thread = 0;
+	struct epoll_event ev;
 
 	/* first do parameter checking */
 	if (intr_handle == NULL || intr_handle->fd < 0 || cb == NULL) {
@@ -464,6 +509,11 @@ rte_intr_callback_register(const struct rte_intr_handle *intr_handle,
 		return -EINVAL;
 	}
 
+	if (intr_nb_threads == 0) {
+		RTE_LOG(ERR, EAL, "Interrupt threads are not running\n");
+		return -EPIPE;
+	}
+
 	/* allocate a new interrupt callback entity */
 	callback = calloc(1, sizeof(*callback));
 	if (callback == NULL) {
@@ -478,10 +528,6 @@ rte_intr_callback_register(const struct rte_intr_handle *intr_handle,
 	/* check if there is at least one callback registered for the fd */
 	TAILQ_FOREACH(src, &intr_sources, next) {
 		if (src->intr_handle.fd == intr_handle->fd) {
-			/* we had no interrupts for this */
-			if (TAILQ_EMPTY(&src->callbacks))
-				wake_thread = 1;
-
 			TAILQ_INSERT_TAIL(&(src->callbacks), callback, next);
 			ret = 0;
 			break;
@@ -495,26 +541,34 @@ rte_intr_callback_register(const struct rte_intr_handle *intr_handle,
 			RTE_LOG(ERR, EAL, "Can not allocate memory\n");
 			free(callback);
 			ret = -ENOMEM;
-		} else {
-			src->intr_handle = *intr_handle;
-			TAILQ_INIT(&src->callbacks);
-			TAILQ_INSERT_TAIL(&(src->callbacks), callback, next);
-			TAILQ_INSERT_TAIL(&intr_sources, src, next);
-			wake_thread = 1;
-			ret = 0;
+			goto out;
+		}
+		src->intr_handle = *intr_handle;
+		src->thread = eal_intr_thread_select();
+		TAILQ_INIT(&src->callbacks);
+
+		/* add the fd to the wait list of the thread, while it waits */
+		ev.events = EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLHUP;
+		ev.data.ptr = src;
+		if (epoll_ctl(src->thread->epfd, EPOLL_CTL_ADD,
+				intr_handle->fd, &ev) < 0) {
+			RTE_LOG(ERR, EAL, "Error adding fd %d epoll_ctl, %s\n",
+				intr_handle->fd, strerror(errno));
+			ret = -errno;
+			free(callback);
+			free(src);
+			goto out;
 		}
+
+		TAILQ_INSERT_TAIL(&(src->callbacks), callback, next);
+		TAILQ_INSERT_TAIL(&intr_sources, src, next);
+		src->thread->nb_sources++;
+		ret = 0;
 	}
 
+out:
 	rte_spinlock_unlock(&intr_lock);
 
-	/**
-	 * check if need to notify the pipe fd waited by epoll_wait to
-	 * rebuild the wait list.
-	 */
-	if (wake_thread)
-		if (write(intr_pipe.writefd, "1", 1) < 0)
-			return -EPIPE;
-
 	return ret;
 }
 
@@ -525,6 +579,7 @@ rte_intr_callback_unregister(const struct rte_intr_handle *intr_handle,
 	int ret;
 	struct rte_intr_source *src;
 	struct rte_intr_callback *cb, *next;
+	struct intr_thread *thread = NULL;
 
 	/* do parameter checking first */
 	if (intr_handle == NULL || intr_handle->fd < 0) {
@@ -567,17 +622,16 @@ rte_intr_callback_unregister(const struct rte_intr_handle *intr_handle,
 
 		/* all callbacks for that source are removed. */
 		if (TAILQ_EMPTY(&src->callbacks)) {
-			TAILQ_REMOVE(&intr_sources, src, next);
-			free(src);
+			thread = src->thread;
+			eal_intr_source_remove(src);
 		}
 	}
 
 	rte_spinlock_unlock(&intr_lock);
 
-	/* notify the pipe fd waited by epoll_wait to rebuild the wait list */
-	if (ret >= 0 && write(intr_pipe.writefd, "1", 1) < 0) {
-		ret = -EPIPE;
-	}
+	/* let the thread free the source */
+	if (thread != NULL)
+		eal_intr_thread_wake(thread);
 
 	return ret;
 }
@@ -694,121 +748,118 @@ rte_intr_disable(const struct rte_intr_handle *intr_handle)
 	return 0;
 }
 
-static int
-eal_intr_process_interrupts(struct epoll_event *events, int nfds)
+/* read the interrupt of a source, return true to call its callbacks */
+static bool
+eal_intr_source_read(struct rte_intr_source *src)
 {
-	bool call = false;
-	int n, bytes_read;
-	struct rte_intr_source *src;
-	struct rte_intr_callback *cb, *next;
 	union rte_intr_read_buffer buf;
+	int bytes_read;
+
+	/* set the length to be read dor different handle type */
+	switch (src->intr_handle.type) {
+	case RTE_INTR_HANDLE_UIO:
+	case RTE_INTR_HANDLE_UIO_INTX:
+		bytes_read = sizeof(buf.uio_intr_count);
+		break;
+	case RTE_INTR_HANDLE_ALARM:
+		bytes_read = sizeof(buf.timerfd_num);
+		break;
+#ifdef VFIO_PRESENT
+	case RTE_INTR_HANDLE_VFIO_MSIX:
+	case RTE_INTR_HANDLE_VFIO_MSI:
+	case RTE_INTR_HANDLE_VFIO_LEGACY:
+		bytes_read = sizeof(buf.vfio_intr_count);
+		break;
+#ifdef HAVE_VFIO_DEV_REQ_INTERFACE
+	case RTE_INTR_HANDLE_VFIO_REQ:
+		return true;
+#endif
+#endif
+	case RTE_INTR_HANDLE_VDEV:
+	case RTE_INTR_HANDLE_EXT:
+		return true;
+	case RTE_INTR_HANDLE_DEV_EVENT:
+		return true;
+	default:
+		bytes_read = 1;
+		break;
+	}
+
+	/**
+	 * read out to clear the ready-to-be-read flag
+	 * for epoll_wait.
+	 */
+	bytes_read = read(src->intr_handle.fd, &buf, bytes_read);
+	if (bytes_read < 0) {
+		if (errno == EINTR || errno == EWOULDBLOCK)
+			return false;
+
+		RTE_LOG(ERR, EAL, "Error reading from file "
+			"descriptor %d: %s\n",
+			src->intr_handle.fd,
+			strerror(errno));
+		/*
+		 * The device is unplugged or buggy, remove
+		 * it as an interrupt source.
+		 */
+		rte_spinlock_lock(&intr_lock);
+		eal_intr_source_remove(src);
+		rte_spinlock_unlock(&intr_lock);
+		return false;
+	} else if (bytes_read == 0) {
+		RTE_LOG(ERR, EAL, "Read nothing from file "
+			"descriptor %d\n", src->intr_handle.fd);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Handle a batch of events. Each source is only marked active around its
+ * read and callbacks, so that a callback can unregister the other sources
+ * of the batch; the lock is kept from a source to the next one.
+ */
+static void
+eal_intr_process_interrupts(struct intr_thread *thread,
+		struct epoll_event *events, int nfds)
+{
+	struct rte_intr_source *src;
+	struct rte_intr_callback *cb;
 	struct rte_intr_callback active_cb;
+	bool call;
+	int n;
 
 	for (n = 0; n < nfds; n++) {
+		uint64_t value;
 
-		/**
-		 * if the pipe fd is ready to read, return out to
-		 * rebuild the wait list.
+		if (events[n].data.ptr != NULL)
+			continue;
+		if (read(thread->wakefd, &value, sizeof(value)) < 0 &&
+				errno != EAGAIN)
+			RTE_LOG(ERR, EAL, "Error reading from wake up fd, %s\n",
+				strerror(errno));
+	}
+
+	rte_spinlock_lock(&intr_lock);
+	for (n = 0; n < nfds; n++) {
+		src = events[n].data.ptr;
+		/*
+		 * removed after epoll_wait() returned, its memory is only
+		 * freed after the batch.
 		 */
-		if (events[n].data.fd == intr_pipe.readfd){
-			int r = read(intr_pipe.readfd, buf.charbuf,
-					sizeof(buf.charbuf));
-			RTE_SET_USED(r);
-			return -1;
-		}
-		rte_spinlock_lock(&intr_lock);
-		TAILQ_FOREACH(src, &intr_sources, next)
-			if (src->intr_handle.fd ==
-					events[n].data.fd)
-				break;
-		if (src == NULL){
-			rte_spinlock_unlock(&intr_lock);
+		if (src == NULL || src->removed)
 			continue;
-		}
 
-		/* mark this interrupt source as active and release the lock. */
+		/* mark this interrupt source as active and release lock */
 		src->active = 1;
 		rte_spinlock_unlock(&intr_lock);
 
-		/* set the length to be read dor different handle type */
-		switch (src->intr_handle.type) {
-		case RTE_INTR_HANDLE_UIO:
-		case RTE_INTR_HANDLE_UIO_INTX:
-			bytes_read = sizeof(buf.uio_intr_count);
-			break;
-		case RTE_INTR_HANDLE_ALARM:
-			bytes_read = sizeof(buf.timerfd_num);
-			break;
-#ifdef VFIO_PRESENT
-		case RTE_INTR_HANDLE_VFIO_MSIX:
-		case RTE_INTR_HANDLE_VFIO_MSI:
-		case RTE_INTR_HANDLE_VFIO_LEGACY:
-			bytes_read = sizeof(buf.vfio_intr_count);
-			break;
-#ifdef HAVE_VFIO_DEV_REQ_INTERFACE
-		case RTE_INTR_HANDLE_VFIO_REQ:
-			bytes_read = 0;
-			call = true;
-			break;
-#endif
-#endif
-		case RTE_INTR_HANDLE_VDEV:
-		case RTE_INTR_HANDLE_EXT:
-			bytes_read = 0;
-			call = true;
-			break;
-		case RTE_INTR_HANDLE_DEV_EVENT:
-			bytes_read = 0;
-			call = true;
-			break;
-		default:
-			bytes_read = 1;
-			break;
-		}
-
-		if (bytes_read > 0) {
-			/**
-			 * read out to clear the ready-to-be-read flag
-			 * for epoll_wait.
-			 */
-			bytes_read = read(events[n].data.fd, &buf, bytes_read);
-			if (bytes_read < 0) {
-				if (errno == EINTR || errno == EWOULDBLOCK)
-					continue;
-
-				RTE_LOG(ERR, EAL, "Error reading from file "
-					"descriptor %d: %s\n",
-					events[n].data.fd,
-					strerror(errno));
-				/*
-				 * The device is unplugged or buggy, remove
-				 * it as an interrupt source and return to
-				 * force the wait list to be rebuilt.
-				 */
-				rte_spinlock_lock(&intr_lock);
-				TAILQ_REMOVE(&intr_sources, src, next);
-				rte_spinlock_unlock(&intr_lock);
-
-				for (cb = TAILQ_FIRST(&src->callbacks); cb;
-							cb = next) {
-					next = TAILQ_NEXT(cb, next);
-					TAILQ_REMOVE(&src->callbacks, cb, next);
-					free(cb);
-				}
-				free(src);
-				return -1;
-			} else if (bytes_read == 0)
-				RTE_LOG(ERR, EAL, "Read nothing from file "
-					"descriptor %d\n", events[n].data.fd);
-			else
-				call = true;
-		}
+		call = eal_intr_source_read(src);
 
 		/* grab a lock, again to call callbacks and update status. */
 		rte_spinlock_lock(&intr_lock);
-
 		if (call) {
-
 			/* Finally, call all callbacks. */
 			TAILQ_FOREACH(cb, &src->callbacks, next) {
 
@@ -826,151 +877,170 @@ eal_intr_process_interrupts(struct epoll_event *events, int nfds)
 
 		/* we done with that interrupt source, release it. */
 		src->active = 0;
-		rte_spinlock_unlock(&intr_lock);
 	}
+	rte_spinlock_unlock(&intr_lock);
+}
 
-	return 0;
+/* free the sources removed from the wait list of the thread */
+static void
+eal_intr_free_removed_sources(struct intr_thread *thread)
+{
+	struct rte_intr_source_list removed;
+	struct rte_intr_source *src;
+	struct rte_intr_callback *cb;
+
+	if (TAILQ_EMPTY(&thread->removed_sources))
+		return;
+
+	TAILQ_INIT(&removed);
+	rte_spinlock_lock(&intr_lock);
+	while ((src = TAILQ_FIRST(&thread->removed_sources)) != NULL) {
+		TAILQ_REMOVE(&thread->removed_sources, src, next);
+		TAILQ_INSERT_TAIL(&removed, src, next);
+	}
+	rte_spinlock_unlock(&intr_lock);
+
+	while ((src = TAILQ_FIRST(&removed)) != NULL) {
+		TAILQ_REMOVE(&removed, src, next);
+		while ((cb = TAILQ_FIRST(&src->callbacks)) != NULL) {
+			TAILQ_REMOVE(&src->callbacks, cb, next);
+			free(cb);
+		}
+		free(src);
+	}
 }
 
 /**
- * It handles all the interrupts.
+ * It handles the interrupts of the sources of a thread.
+ *
+ * The sources are added and removed from the epoll instance of the
+ * thread as they are registered, while the thread is waiting on it.
  *
- * @param pfd
- *  epoll file descriptor.
- * @param totalfds
- *  The number of file descriptors added in epoll.
+ * @param arg
+ *  pointer to the interrupt thread.
  *
  * @return
- *  void
+ *  never return;
  */
-static void
-eal_intr_handle_interrupts(int pfd, unsigned totalfds)
+static __attribute__((noreturn)) void *
+eal_intr_thread_main(void *arg)
 {
-	struct epoll_event events[totalfds];
-	int nfds = 0;
+	struct intr_thread *thread = arg;
+	struct epoll_event events[EAL_INTR_EVENTS_MAX];
+	int nfds;
 
-	for(;;) {
-		nfds = epoll_wait(pfd, events, totalfds,
+	/* host thread, never break out */
+	for (;;) {
+		nfds = epoll_wait(thread->epfd, events, EAL_INTR_EVENTS_MAX,
 			EAL_INTR_EPOLL_WAIT_FOREVER);
 		/* epoll_wait fail */
 		if (nfds < 0) {
 			if (errno == EINTR)
 				continue;
-			RTE_LOG(ERR, EAL,
-				"epoll_wait returns with fail\n");
-			return;
+			rte_panic("epoll_wait returns with fail, %s\n",
+				strerror(errno));
 		}
 		/* epoll_wait timeout, will never happens here */
 		else if (nfds == 0)
 			continue;
+
 		/* epoll_wait has at least one fd ready to read */
-		if (eal_intr_process_interrupts(events, nfds) < 0)
-			return;
+		eal_intr_process_interrupts(thread, events, nfds);
+
+		/* no event of this batch refers to a removed source anymore */
+		eal_intr_free_removed_sources(thread);
 	}
 }
 
-/**
- * It builds/rebuilds up the epoll file descriptor with all the
- * file descriptors being waited on. Then handles the interrupts.
- *
- * @param arg
- *  pointer. (unused)
- *
- * @return
- *  never return;
- */
-static __attribute__((noreturn)) void *
-eal_intr_thread_main(__rte_unused void *arg)
+int
+rte_eal_intr_init(void)
 {
+	char name[RTE_MAX_THREAD_NAME_LEN];
+	struct intr_thread *thread;
 	struct epoll_event ev;
+	unsigned int i;
+	int ret = 0;
 
-	/* host thread, never break out */
-	for (;;) {
-		/* build up the epoll fd with all descriptors we are to
-		 * wait on then pass it to the handle_interrupts function
-		 */
-		static struct epoll_event pipe_event = {
-			.events = EPOLLIN | EPOLLPRI,
-		};
-		struct rte_intr_source *src;
-		unsigned numfds = 0;
-
-		/* create epoll fd */
-		int pfd = epoll_create(1);
-		if (pfd < 0)
-			rte_panic("Cannot create epoll instance\n");
-
-		pipe_event.data.fd = intr_pipe.readfd;
-		/**
-		 * add pipe fd into wait list, this pipe is used to
-		 * rebuild the wait list.
-		 */
-		if (epoll_ctl(pfd, EPOLL_CTL_ADD, intr_pipe.readfd,
-						&pipe_event) < 0) {
-			rte_panic("Error adding fd to %d epoll_ctl, %s\n",
-					intr_pipe.readfd, strerror(errno));
-		}
-		numfds++;
+	/* init the global interrupt source head */
+	TAILQ_INIT(&intr_sources);
 
-		rte_spinlock_lock(&intr_lock);
+	for (i = 0; i < internal_config.intr_threads; i++) {
+		thread = &intr_threads[i];
+		TAILQ_INIT(&thread->removed_sources);
 
-		TAILQ_FOREACH(src, &intr_sources, next) {
-			if (src->callbacks.tqh_first == NULL)
-				continue; /* skip those with no callbacks */
-			ev.events = EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLHUP;
-			ev.data.fd = src->intr_handle.fd;
-
-			/**
-			 * add all the uio device file descriptor
-			 * into wait list.
-			 */
-			if (epoll_ctl(pfd, EPOLL_CTL_ADD,
-					src->intr_handle.fd, &ev) < 0){
-				rte_panic("Error adding fd %d epoll_ctl, %s\n",
-					src->intr_handle.fd, strerror(errno));
-			}
-			else
-				numfds++;
+		thread->epfd = epoll_create1(EPOLL_CLOEXEC);
+		if (thread->epfd < 0) {
+			rte_errno = errno;
+			RTE_LOG(ERR, EAL, "Cannot create epoll instance\n");
+			return -1;
 		}
-		rte_spinlock_unlock(&intr_lock);
-		/* serve the interrupt */
-		eal_intr_handle_interrupts(pfd, numfds);
 
 		/**
-		 * when we return, we need to rebuild the
-		 * list of fds to monitor.
+		 * the eventfd wakes up the thread to free the removed
+		 * sources, it is the only event with a NULL source.
 		 */
-		close(pfd);
+		thread->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (thread->wakefd < 0) {
+			rte_errno = errno;
+			RTE_LOG(ERR, EAL, "Cannot create eventfd\n");
+			close(thread->epfd);
+			return -1;
+		}
+		ev.events = EPOLLIN;
+		ev.data.ptr = NULL;
+		if (epoll_ctl(thread->epfd, EPOLL_CTL_ADD, thread->wakefd,
+				&ev) < 0) {
+			rte_errno = errno;
+			RTE_LOG(ERR, EAL, "Error adding fd %d epoll_ctl, %s\n",
+				thread->wakefd, strerror(errno));
+			close(thread->wakefd);
+			close(thread->epfd);
+			return -1;
+		}
+
+		/* create the host thread to wait/handle the interrupt */
+		if (i == 0)
+			strlcpy(name, "eal-intr-thread", sizeof(name));
+		else
+			snprintf(name, sizeof(name), "eal-intr-thrd-%u", i);
+		ret = rte_ctrl_thread_create(&thread->tid, name, NULL,
+				eal_intr_thread_main, thread);
+		if (ret != 0) {
+			rte_errno = -ret;
+			RTE_LOG(ERR, EAL,
+				"Failed to create thread for interrupt handling\n");
+			close(thread->wakefd);
+			close(thread->epfd);
+			return ret;
+		}
+
+		intr_nb_threads++;
 	}
+
+	return ret;
 }
 
-int
-rte_eal_intr_init(void)
+unsigned int __rte_experimental
+rte_intr_thread_count(void)
 {
-	int ret = 0;
+	return intr_nb_threads;
+}
 
-	/* init the global interrupt source head */
-	TAILQ_INIT(&intr_sources);
+int __rte_experimental
+rte_intr_thread_affinity_set(unsigned int thread_id,
+		const rte_cpuset_t *cpuset)
+{
+	int ret;
 
-	/**
-	 * create a pipe which will be waited by epoll and notified to
-	 * rebuild the wait list of epoll.
-	 */
-	if (pipe(intr_pipe.pipefd) < 0) {
-		rte_errno = errno;
-		return -1;
-	}
+	if (thread_id >= intr_nb_threads || cpuset == NULL)
+		return -EINVAL;
 
-	/* create the host thread to wait/handle the interrupt */
-	ret = rte_ctrl_thread_create(&intr_thread, "eal-intr-thread", NULL,
-			eal_intr_thread_main, NULL);
-	if (ret != 0) {
-		rte_errno = -ret;
-		RTE_LOG(ERR, EAL,
-			"Failed to create thread for interrupt handling\n");
-	}
+	ret = pthread_setaffinity_np(intr_threads[thread_id].tid,
+			sizeof(*cpuset), cpuset);
+	if (ret != 0)
+		return -ret;
 
-	return ret;
+	return 0;
 }
 
 static void
@@ -23,6 +23,7 @@
 #include <sys/time.h>
 #include <signal.h>
 #include <setjmp.h>
+#include <pthread.h>
 #ifdef F_ADD_SEALS /* if file sealing is supported, so is memfd */
 #include <linux/memfd.h>
 #define MEMFD_SUPPORTED
@@ -39,6 +40,7 @@
 #include <rte_eal_memconfig.h>
 #include <rte_eal.h>
 #include <rte_errno.h>
+#include <rte_lcore.h>
 #include <rte_memory.h>
 #include <rte_spinlock.h>
 
@@ -46,6 +48,7 @@
 #include "eal_internal_cfg.h"
 #include "eal_memalloc.h"
 #include "eal_private.h"
+#include "eal_thread.h"
 
 const int anonymous_hugepages_supported =
 #ifdef MAP_HUGE_SHIFT
@@ -111,7 +114,8 @@ static struct {
 /** local copy of a memory map, used to synchronize memory hotplug in MP */
 static struct rte_memseg_list local_memsegs[RTE_MAX_MEMSEG_LISTS];
 
-static sigjmp_buf huge_jmpenv;
+/* pages may be populated by several threads at init */
+static __thread sigjmp_buf huge_jmpenv;
 
 static void __rte_unused huge_sigbus_handler(int signo __rte_unused)
 {
@@ -199,6 +203,25 @@ restore_numa(int *oldpolicy, struct bitmask *oldmask)
 	}
 	numa_free_cpumask(oldmask);
 }
+
+/* make the pages of an area be faulted in on a socket, whichever thread
+ * touches them first
+ */
+static int
+bind_numa(void *addr, size_t len, int socket_id)
+{
+	struct bitmask *mask;
+	int ret;
+
+	mask = numa_allocate_nodemask();
+	numa_bitmask_setbit(mask, socket_id);
+	ret = mbind(addr, len, MPOL_PREFERRED, mask->maskp, mask->size + 1, 0);
+	if (ret < 0)
+		RTE_LOG(DEBUG, EAL, "%s(): mbind() failed: %s\n", __func__,
+			strerror(errno));
+	numa_bitmask_free(mask);
+	return ret;
+}
 #endif
 
 /*
@@ -586,14 +609,65 @@ resize_hugefile(int fd, char *path, int list_idx, int seg_idx,
 	return 0;
 }
 
+/*
+ * fault in a mapped page, and check that it is accessible and located on the
+ * requested socket
+ */
 static int
-alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
-		struct hugepage_info *hi, unsigned int list_idx,
-		unsigned int seg_idx)
+populate_seg(void *addr, size_t alloc_sz, int socket_id, rte_iova_t *iova)
 {
 #ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
 	int cur_socket_id = 0;
 #endif
+
+	/* In linux, hugetlb limitations, like cgroup, are
+	 * enforced at fault time instead of mmap(), even
+	 * with the option of MAP_POPULATE. Kernel will send
+	 * a SIGBUS signal. To avoid to be killed, save stack
+	 * environment here, if SIGBUS happens, we can jump
+	 * back here.
+	 */
+	if (huge_wrap_sigsetjmp()) {
+		RTE_LOG(DEBUG, EAL, "SIGBUS: Cannot mmap more hugepages of size %uMB\n",
+			(unsigned int)(alloc_sz >> 20));
+		return -1;
+	}
+
+	/* we need to trigger a write to the page to enforce page fault and
+	 * ensure that page is accessible to us, but we can't overwrite value
+	 * that is already there, so read the old value, and write itback.
+	 * kernel populates the page with zeroes initially.
+	 */
+	*(volatile int *)addr = *(volatile int *)addr;
+
+	*iova = rte_mem_virt2iova(addr);
+	if (*iova == RTE_BAD_PHYS_ADDR) {
+		RTE_LOG(DEBUG, EAL, "%s(): can't get IOVA addr\n",
+			__func__);
+		return -1;
+	}
+
+#ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
+	move_pages(getpid(), 1, &addr, NULL, &cur_socket_id, 0);
+
+	if (cur_socket_id != socket_id) {
+		RTE_LOG(DEBUG, EAL,
+				"%s(): allocation happened on wrong socket (wanted %d, got %d)\n",
+			__func__, socket_id, cur_socket_id);
+		return -1;
+	}
+#else
+	RTE_SET_USED(socket_id);
+#endif
+
+	return 0;
+}
+
+static int
+alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
+		struct hugepage_info *hi, unsigned int list_idx,
+		unsigned int seg_idx, bool populate)
+{
 	uint64_t map_offset;
 	rte_iova_t iova;
 	void *va;
@@ -665,7 +739,9 @@ alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
 				}
 			}
 		}
-		mmap_flags = MAP_SHARED | MAP_POPULATE | MAP_FIXED;
+		mmap_flags = MAP_SHARED | MAP_FIXED;
+		if (populate)
+			mmap_flags |= MAP_POPULATE;
 	}
 
 	/*
@@ -689,43 +765,21 @@ alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
 		goto resized;
 	}
 
-	/* In linux, hugetlb limitations, like cgroup, are
-	 * enforced at fault time instead of mmap(), even
-	 * with the option of MAP_POPULATE. Kernel will send
-	 * a SIGBUS signal. To avoid to be killed, save stack
-	 * environment here, if SIGBUS happens, we can jump
-	 * back here.
-	 */
-	if (huge_wrap_sigsetjmp()) {
-		RTE_LOG(DEBUG, EAL, "SIGBUS: Cannot mmap more hugepages of size %uMB\n",
-			(unsigned int)(alloc_sz >> 20));
-		goto mapped;
-	}
-
-	/* we need to trigger a write to the page to enforce page fault and
-	 * ensure that page is accessible to us, but we can't overwrite value
-	 * that is already there, so read the old value, and write itback.
-	 * kernel populates the page with zeroes initially.
-	 */
-	*(volatile int *)addr = *(volatile int *)addr;
-
-	iova = rte_mem_virt2iova(addr);
-	if (iova == RTE_BAD_PHYS_ADDR) {
-		RTE_LOG(DEBUG, EAL, "%s(): can't get IOVA addr\n",
-			__func__);
-		goto mapped;
-	}
-
+	if (populate) {
+		if (populate_seg(addr, alloc_sz, socket_id, &iova) < 0)
+			goto mapped;
+	} else {
+		/* the page is faulted in later by eal_memalloc_populate_seg_bulk(),
+		 * or
+		 * on first use, so only its IOVA as VA can be known now.
+		 */
 #ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
-	move_pages(getpid(), 1, &addr, NULL, &cur_socket_id, 0);
-
-	if (cur_socket_id != socket_id) {
-		RTE_LOG(DEBUG, EAL,
-				"%s(): allocation happened on wrong socket (wanted %d, got %d)\n",
-			__func__, socket_id, cur_socket_id);
-		goto mapped;
-	}
+		if (check_numa() && bind_numa(addr, alloc_sz, socket_id) < 0)
+			goto mapped;
 #endif
+		iova = rte_eal_iova_mode() == RTE_IOVA_VA ?
+				(rte_iova_t)(uintptr_t)addr : RTE_BAD_IOVA;
+	}
 
 	ms->addr = addr;
 	ms->hugepage_sz = alloc_sz;
@@ -850,6 +904,7 @@ struct alloc_walk_param {
 	unsigned int n_segs;
 	int socket;
 	bool exact;
+	bool populate;
 };
 static int
 alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
@@ -912,7 +967,7 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 				cur_idx * page_sz);
 
 		if (alloc_seg(cur, map_addr, wa->socket, wa->hi,
-				msl_idx, cur_idx)) {
+				msl_idx, cur_idx, wa->populate)) {
 			RTE_LOG(DEBUG, EAL, "attempted to allocate %i segments, but only %i were allocated\n",
 				need, i);
 
@@ -1022,9 +1077,9 @@ free_seg_walk(const struct rte_memseg_list *msl, void *arg)
 	return 1;
 }
 
-int
-eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
-		int socket, bool exact)
+static int
+alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
+		int socket, bool exact, bool populate)
 {
 	int i, ret = -1;
 #ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
@@ -1063,6 +1118,7 @@ eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
 #endif
 
 	wa.exact = exact;
+	wa.populate = populate;
 	wa.hi = hi;
 	wa.ms = ms;
 	wa.n_segs = n_segs;
@@ -1087,6 +1143,136 @@ eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
 	return ret;
 }
 
+int
+eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
+		int socket, bool exact)
+{
+	return alloc_seg_bulk(ms, n_segs, page_sz, socket, exact, true);
+}
+
+int
+eal_memalloc_map_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
+		int socket)
+{
+	return alloc_seg_bulk(ms, n_segs, page_sz, socket, true, false);
+}
+
+struct populate_param {
+	struct rte_memseg **ms;
+	int n_segs;
+	int socket;
+	/* this thread populates every n_threads segment of its socket,
+	 * starting with the segment number thread_idx
+	 */
+	unsigned int thread_idx;
+	unsigned int n_threads;
+	rte_cpuset_t cpuset;
+	pthread_t tid;
+	bool started;
+	int ret;
+};
+
+static void *
+populate_seg_thread(void *arg)
+{
+	struct populate_param *p = arg;
+	unsigned int idx = 0;
+	int i;
+
+	/* zero the pages from the socket they belong to */
+	if (CPU_COUNT(&p->cpuset) != 0)
+		pthread_setaffinity_np(pthread_self(), sizeof(p->cpuset),
+				&p->cpuset);
+
+	for (i = 0; i < p->n_segs; i++) {
+		struct rte_memseg *ms = p->ms[i];
+		rte_iova_t iova;
+
+		if (ms->socket_id != p->socket)
+			continue;
+		if (idx++ % p->n_threads != p->thread_idx)
+			continue;
+		if (populate_seg(ms->addr, ms->len, ms->socket_id, &iova) < 0) {
+			p->ret = -1;
+			break;
+		}
+		ms->iova = iova;
+	}
+	return NULL;
+}
+
+int
+eal_memalloc_populate_seg_bulk(struct rte_memseg **ms, int n_segs,
+		unsigned int n_threads)
+{
+	struct populate_param *params;
+	unsigned int n_params = 0, i;
+	int socket, seg, ret = 0;
+	unsigned int cpu;
+
+	params = calloc(RTE_MAX_NUMA_NODES * n_threads, sizeof(*params));
+	if (params == NULL)
+		return -1;
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		rte_cpuset_t cpuset;
+
+		for (seg = 0; seg < n_segs; seg++)
+			if (ms[seg]->socket_id == socket)
+				break;
+		if (seg == n_segs)
+			continue;
+
+		CPU_ZERO(&cpuset);
+		for (cpu = 0; cpu < RTE_MAX_LCORE; cpu++)
+			if (eal_cpu_detected(cpu) &&
+					(int)eal_cpu_socket_id(cpu) == socket)
+				CPU_SET(cpu, &cpuset);
+
+		for (i = 0; i < n_threads; i++) {
+			struct populate_param *p = &params[n_params++];
+
+			p->ms = ms;
+			p->n_segs = n_segs;
+			p->socket = socket;
+			p->thread_idx = i;
+			p->n_threads = n_threads;
+			p->cpuset = cpuset;
+		}
+	}
+
+	if (n_params == 1) {
+		/* no need for another thread */
+		populate_seg_thread(&params[0]);
+		ret = params[0].ret;
+		free(params);
+		return ret;
+	}
+
+	for (i = 0; i < n_params; i++) {
+		struct populate_param *p = &params[i];
+
+		if (pthread_create(&p->tid, NULL, populate_seg_thread, p) == 0) {
+			p->started = true;
+			continue;
+		}
+		/* populate the segments of this thread from here */
+		RTE_LOG(DEBUG, EAL, "%s(): cannot create thread\n", __func__);
+		populate_seg_thread(p);
+	}
+
+	for (i = 0; i < n_params; i++) {
+		struct populate_param *p = &params[i];
+
+		if (p->started)
+			pthread_join(p->tid, NULL);
+		if (p->ret < 0)
+			ret = -1;
+	}
+	free(params);
+	return ret;
+}
+
 struct rte_memseg *
 eal_memalloc_alloc_seg(size_t page_sz, int socket)
 {
@@ -1220,7 +1406,7 @@ sync_chunk(struct rte_memseg_list *primary_msl,
 		if (used) {
 			ret = alloc_seg(l_ms, p_ms->addr,
 					p_ms->socket_id, hi,
-					msl_idx, seg_idx);
+					msl_idx, seg_idx, true);
 			if (ret < 0)
 				return -1;
 			rte_fbarray_set_used(l_arr, seg_idx);
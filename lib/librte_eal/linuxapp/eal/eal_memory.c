@@ -6,6 +6,7 @@
 #define _FILE_OFFSET_BITS 64
 #include <errno.h>
 #include <fcntl.h>
+#include <getopt.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -50,6 +51,7 @@
 #include "eal_internal_cfg.h"
 #include "eal_filesystem.h"
 #include "eal_hugepages.h"
+#include "eal_options.h"
 
 #define PFN_MASK_SIZE	8
 
@@ -1732,6 +1734,10 @@ eal_hugepage_init(void)
 {
 	struct hugepage_info used_hp[MAX_HUGEPAGE_SIZES];
 	uint64_t memory[RTE_MAX_NUMA_NODES];
+	struct rte_memseg **pages;
+	unsigned int total_pages = 0, n_pages = 0;
+	uint64_t map_us, populate_us = 0;
+	bool populate;
 	int hp_sz_idx, socket_id;
 
 	test_phys_addrs_available();
@@ -1776,12 +1782,33 @@ eal_hugepage_init(void)
 			internal_config.num_hugepage_sizes) < 0)
 		return -1;
 
+	for (hp_sz_idx = 0;
+			hp_sz_idx < (int)internal_config.num_hugepage_sizes;
+			hp_sz_idx++)
+		for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES;
+				socket_id++)
+			total_pages += used_hp[hp_sz_idx].num_pages[socket_id];
+
+	/* the pages are only mapped first, their population, which zeroes
+	 * them, is then spread over several threads per socket, or left to
+	 * the first access.
+	 */
+	populate = !internal_config.mem_init_lazy;
+	if (!populate && rte_eal_iova_mode() != RTE_IOVA_VA) {
+		RTE_LOG(NOTICE, EAL, "Option --"OPT_MEM_INIT_LAZY" requires IOVA as VA mode, memory will be populated at init\n");
+		populate = true;
+	}
+
+	pages = malloc(sizeof(*pages) * RTE_MAX(total_pages, 1U));
+	if (pages == NULL)
+		return -1;
+
+	map_us = eal_get_time_us();
 	for (hp_sz_idx = 0;
 			hp_sz_idx < (int)internal_config.num_hugepage_sizes;
 			hp_sz_idx++) {
 		for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES;
 				socket_id++) {
-			struct rte_memseg **pages;
 			struct hugepage_info *hpi = &used_hp[hp_sz_idx];
 			unsigned int num_pages = hpi->num_pages[socket_id];
 			int num_pages_alloc, i;
@@ -1789,14 +1816,12 @@ eal_hugepage_init(void)
 			if (num_pages == 0)
 				continue;
 
-			pages = malloc(sizeof(*pages) * num_pages);
-
 			RTE_LOG(DEBUG, EAL, "Allocating %u pages of size %" PRIu64 "M on socket %i\n",
 				num_pages, hpi->hugepage_sz >> 20, socket_id);
 
-			num_pages_alloc = eal_memalloc_alloc_seg_bulk(pages,
-					num_pages, hpi->hugepage_sz,
-					socket_id, true);
+			num_pages_alloc = eal_memalloc_map_seg_bulk(
+					&pages[n_pages], num_pages,
+					hpi->hugepage_sz, socket_id);
 			if (num_pages_alloc < 0) {
 				free(pages);
 				return -1;
@@ -1804,12 +1829,33 @@ eal_hugepage_init(void)
 
 			/* mark preallocated pages as unfreeable */
 			for (i = 0; i < num_pages_alloc; i++) {
-				struct rte_memseg *ms = pages[i];
+				struct rte_memseg *ms = pages[n_pages + i];
 				ms->flags |= RTE_MEMSEG_FLAG_DO_NOT_FREE;
 			}
+			n_pages += num_pages_alloc;
+		}
+	}
+	map_us = eal_get_time_us() - map_us;
+
+	if (populate && n_pages > 0) {
+		populate_us = eal_get_time_us();
+		if (eal_memalloc_populate_seg_bulk(pages, n_pages,
+				internal_config.mem_init_threads) < 0) {
+			RTE_LOG(ERR, EAL, "Cannot populate preallocated hugepages\n");
 			free(pages);
+			return -1;
 		}
+		populate_us = eal_get_time_us() - populate_us;
 	}
+	free(pages);
+
+	if (n_pages > 0 && populate)
+		RTE_LOG(INFO, EAL, "Preallocated %u hugepages: mapped in %" PRIu64 " ms, populated in %" PRIu64 " ms using %u thread(s) per socket\n",
+			n_pages, map_us / 1000, populate_us / 1000,
+			internal_config.mem_init_threads);
+	else if (n_pages > 0)
+		RTE_LOG(INFO, EAL, "Preallocated %u hugepages: mapped in %" PRIu64 " ms, populated on first use\n",
+			n_pages, map_us / 1000);
 	/* if socket limits were specified, set them */
 	if (internal_config.force_socket_limits) {
 		unsigned int i;
@@ -49,6 +49,11 @@ int rte_eth_dev_logtype;
 static const char *MZ_RTE_ETH_DEV_DATA = "rte_eth_dev_data";
 struct rte_eth_dev rte_eth_devices[RTE_MAX_ETHPORTS];
 
+RTE_TRACE_POINT_DEFINE(rte_ethdev_trace_rx_burst, "lib.ethdev.rx_burst",
+		"port_id", "queue_id", "nb_pkts", "nb_rx");
+RTE_TRACE_POINT_DEFINE(rte_ethdev_trace_tx_burst, "lib.ethdev.tx_burst",
+		"port_id", "queue_id", "nb_pkts", "nb_tx");
+
 /* spinlock for eth device callbacks */
 static rte_spinlock_t rte_eth_dev_cb_lock = RTE_SPINLOCK_INITIALIZER;
 
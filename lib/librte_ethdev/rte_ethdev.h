@@ -3892,6 +3892,9 @@ rte_eth_rx_burst(uint16_t port_id, uint16_t queue_id,
 	}
 #endif
 
+	rte_trace_point_emit_fp(&rte_ethdev_trace_rx_burst, port_id, queue_id,
+			nb_pkts, nb_rx);
+
 	return nb_rx;
 }
 
@@ -4132,6 +4135,7 @@ rte_eth_tx_burst(uint16_t port_id, uint16_t queue_id,
 		 struct rte_mbuf **tx_pkts, uint16_t nb_pkts)
 {
 	struct rte_eth_dev *dev = &rte_eth_devices[port_id];
+	uint16_t nb_tx;
 
 #ifdef RTE_LIBRTE_ETHDEV_DEBUG
 	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, 0);
@@ -4155,7 +4159,13 @@ rte_eth_tx_burst(uint16_t port_id, uint16_t queue_id,
 	}
 #endif
 
-	return (*dev->tx_pkt_burst)(dev->data->tx_queues[queue_id], tx_pkts, nb_pkts);
+	nb_tx = (*dev->tx_pkt_burst)(dev->data->tx_queues[queue_id], tx_pkts,
+			nb_pkts);
+
+	rte_trace_point_emit_fp(&rte_ethdev_trace_tx_burst, port_id, queue_id,
+			nb_pkts, nb_tx);
+
+	return nb_tx;
 }
 
 /**
@@ -17,6 +17,8 @@
  *
  */
 
+#include <rte_trace.h>
+
 struct rte_eth_dev_callback;
 /** @internal Structure to keep track of registered callbacks */
 TAILQ_HEAD(rte_eth_dev_cb_list, rte_eth_dev_callback);
@@ -638,4 +640,9 @@ struct rte_eth_dev_data {
  */
 extern struct rte_eth_dev rte_eth_devices[];
 
+/** @internal Tracepoint of rte_eth_rx_burst(). */
+extern rte_trace_point_t rte_ethdev_trace_rx_burst;
+/** @internal Tracepoint of rte_eth_tx_burst(). */
+extern rte_trace_point_t rte_ethdev_trace_tx_burst;
+
 #endif /* _RTE_ETHDEV_CORE_H_ */
@@ -1161,19 +1161,21 @@ rxa_service_func(void *args)
 {
 	struct rte_event_eth_rx_adapter *rx_adapter = args;
 	struct rte_event_eth_rx_adapter_stats *stats;
+	uint32_t nb_rx;
 
 	if (rte_spinlock_trylock(&rx_adapter->rx_lock) == 0)
-		return 0;
+		return -EAGAIN;
 	if (!rx_adapter->rxa_started) {
 		rte_spinlock_unlock(&rx_adapter->rx_lock);
-		return 0;
+		return -EAGAIN;
 	}
 
 	stats = &rx_adapter->stats;
-	stats->rx_packets += rxa_intr_ring_dequeue(rx_adapter);
-	stats->rx_packets += rxa_poll(rx_adapter);
+	nb_rx = rxa_intr_ring_dequeue(rx_adapter);
+	nb_rx += rxa_poll(rx_adapter);
+	stats->rx_packets += nb_rx;
 	rte_spinlock_unlock(&rx_adapter->rx_lock);
-	return 0;
+	return nb_rx ? 0 : -EAGAIN;
 }
 
 static int
@@ -551,16 +551,17 @@ txa_service_func(void *args)
 	uint16_t n;
 	uint32_t nb_tx, max_nb_tx;
 	struct rte_event ev[TXA_BATCH_SIZE];
+	int ret;
 
 	dev_id = txa->eventdev_id;
 	max_nb_tx = txa->max_nb_tx;
 	port = txa->port_id;
 
 	if (txa->nb_queues == 0)
-		return 0;
+		return -EAGAIN;
 
 	if (!rte_spinlock_trylock(&txa->tx_lock))
-		return 0;
+		return -EAGAIN;
 
 	for (nb_tx = 0; nb_tx < max_nb_tx; nb_tx += n) {
 
@@ -569,6 +570,7 @@ txa_service_func(void *args)
 			break;
 		txa_service_tx(txa, ev, n);
 	}
+	ret = nb_tx ? 0 : -EAGAIN;
 
 	if ((txa->loop_cnt++ & (TXA_FLUSH_THRESHOLD - 1)) == 0) {
 
@@ -601,9 +603,11 @@ txa_service_func(void *args)
 		}
 
 		txa->stats.tx_packets += nb_tx;
+		if (nb_tx)
+			ret = 0;
 	}
 	rte_spinlock_unlock(&txa->tx_lock);
-	return 0;
+	return ret;
 }
 
 static int
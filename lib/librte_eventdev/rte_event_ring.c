@@ -56,7 +56,11 @@ rte_event_ring_create(const char *name, unsigned int count, int socket_id,
 		return NULL;
 	}
 
-	ring_size = sizeof(*r) + (count * sizeof(struct rte_event));
+	ring_size = rte_ring_get_memsize_elem(sizeof(struct rte_event), count);
+	if (ring_size < 0) {
+		rte_errno = -ring_size;
+		return NULL;
+	}
 
 	ret = snprintf(mz_name, sizeof(mz_name), "%s%s",
 		RTE_RING_MZ_PREFIX, name);
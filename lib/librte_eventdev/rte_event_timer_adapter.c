@@ -512,6 +512,8 @@ struct rte_event_timer_adapter_sw_data {
 	rte_spinlock_t msgs_tailq_sl;
 	/* Identifier of service executing timer management logic. */
 	uint32_t service_id;
+	/* Identifier of timer data instance holding the adapter timers */
+	uint32_t timer_data_id;
 	/* The cycle count at which the adapter should next tick */
 	uint64_t next_tick_cycles;
 	/* Incremented as the service moves through phases of an iteration */
@@ -565,8 +567,10 @@ sw_event_timer_cb(struct rte_timer *tim, void *arg)
 		 * immediate expiry value, so that we process it again on the
 		 * next iteration.
 		 */
-		rte_timer_reset_sync(tim, 0, SINGLE, rte_lcore_id(),
-				     sw_event_timer_cb, evtim);
+		while (rte_timer_alt_reset(sw_data->timer_data_id, tim, 0,
+					   SINGLE, rte_lcore_id(),
+					   sw_event_timer_cb, evtim) != 0)
+			rte_pause();
 
 		sw_data->stats.evtim_retry_count++;
 		EVTIM_LOG_DBG("event buffer full, resetting rte_timer with "
@@ -704,6 +708,7 @@ sw_event_timer_adapter_service_func(void *arg)
 	struct rte_event_timer *evtim = NULL;
 	struct rte_timer *tim = NULL;
 	struct msg *msg, *msgs[NB_OBJS];
+	int nb_msgs = 0;
 
 	adapter = arg;
 	sw_data = adapter->data->adapter_priv;
@@ -716,6 +721,7 @@ sw_event_timer_adapter_service_func(void *arg)
 
 		num_msgs = rte_ring_dequeue_burst(sw_data->msg_ring,
 						  (void **)msgs, NB_OBJS, NULL);
+		nb_msgs += num_msgs;
 
 		for (i = 0; i < num_msgs; i++) {
 			int ret = 0;
@@ -733,10 +739,11 @@ sw_event_timer_adapter_service_func(void *arg)
 				rte_timer_init(tim);
 				cycles = get_timeout_cycles(evtim,
 							    adapter);
-				ret = rte_timer_reset(tim, cycles, SINGLE,
-						      rte_lcore_id(),
-						      sw_event_timer_cb,
-						      evtim);
+				ret = rte_timer_alt_reset(
+						sw_data->timer_data_id,
+						tim, cycles, SINGLE,
+						rte_lcore_id(),
+						sw_event_timer_cb, evtim);
 				RTE_ASSERT(ret == 0);
 
 				evtim->impl_opaque[0] = (uintptr_t)tim;
@@ -753,7 +760,8 @@ sw_event_timer_adapter_service_func(void *arg)
 				tim = (struct rte_timer *)(uintptr_t)opaque;
 				RTE_ASSERT(tim != NULL);
 
-				ret = rte_timer_stop(tim);
+				ret = rte_timer_alt_stop(
+						sw_data->timer_data_id, tim);
 				RTE_ASSERT(ret == 0);
 
 				/* Free the msg object for the original arm
@@ -780,7 +788,7 @@ sw_event_timer_adapter_service_func(void *arg)
 	rte_smp_wmb();
 
 	if (adapter_did_tick(adapter)) {
-		rte_timer_manage();
+		rte_timer_alt_manage(sw_data->timer_data_id, NULL, 0, NULL);
 
 		event_buffer_flush(&sw_data->buffer,
 				   adapter->data->event_dev_id,
@@ -795,7 +803,7 @@ sw_event_timer_adapter_service_func(void *arg)
 	sw_data->service_phase = 0;
 	rte_smp_wmb();
 
-	return 0;
+	return (nb_msgs || nb_evs_flushed || nb_evs_invalid) ? 0 : -EAGAIN;
 }
 
 /* The adapter initialization function rounds the mempool size up to the next
@@ -938,14 +946,24 @@ sw_event_timer_adapter_init(struct rte_event_timer_adapter *adapter)
 	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
 		      sw_data->service_id);
 
-	adapter->data->service_id = sw_data->service_id;
-	adapter->data->service_inited = 1;
-
 	if (!timer_subsystem_inited) {
 		rte_timer_subsystem_init();
 		timer_subsystem_inited = true;
 	}
 
+	/* Use own timer lists, not to contend with the application timers */
+	ret = rte_timer_data_alloc(&sw_data->timer_data_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to allocate timer data instance");
+		rte_service_component_unregister(sw_data->service_id);
+		rte_errno = ENOSPC;
+		goto free_msg_pool;
+	}
+
+	/* only publish the service once the adapter can run */
+	adapter->data->service_id = sw_data->service_id;
+	adapter->data->service_inited = 1;
+
 	return 0;
 
 free_msg_pool:
@@ -973,7 +991,9 @@ sw_event_timer_adapter_uninit(struct rte_event_timer_adapter *adapter)
 		EVTIM_LOG_DBG("freeing outstanding timer");
 		m2 = TAILQ_NEXT(m1, msgs);
 
-		rte_timer_stop_sync(&m1->tim);
+		while (rte_timer_alt_stop(sw_data->timer_data_id,
+					  &m1->tim) != 0)
+			rte_pause();
 		rte_mempool_put(sw_data->msg_pool, m1);
 
 		m1 = m2;
@@ -987,6 +1007,8 @@ sw_event_timer_adapter_uninit(struct rte_event_timer_adapter *adapter)
 		return ret;
 	}
 
+	rte_timer_data_dealloc(sw_data->timer_data_id);
+
 	rte_ring_free(sw_data->msg_ring);
 	rte_mempool_free(sw_data->msg_pool);
 	rte_free(adapter->data->adapter_priv);
@@ -39,6 +39,13 @@ static struct rte_eventdev rte_event_devices[RTE_EVENT_MAX_DEVS];
 
 struct rte_eventdev *rte_eventdevs = rte_event_devices;
 
+RTE_TRACE_POINT_DEFINE(rte_eventdev_trace_enqueue_burst,
+		"lib.eventdev.enqueue_burst",
+		"dev_id", "port_id", "nb_events", "nb_enq");
+RTE_TRACE_POINT_DEFINE(rte_eventdev_trace_dequeue_burst,
+		"lib.eventdev.dequeue_burst",
+		"dev_id", "port_id", "nb_events", "nb_deq");
+
 static struct rte_eventdev_global eventdev_globals = {
 	.nb_devs		= 0
 };
@@ -215,6 +215,7 @@ extern "C" {
 #include <rte_config.h>
 #include <rte_memory.h>
 #include <rte_errno.h>
+#include <rte_trace.h>
 
 struct rte_mbuf; /* we just use mbuf pointers; no need to include rte_mbuf.h */
 struct rte_event;
@@ -1313,12 +1314,18 @@ struct rte_eventdev {
 extern struct rte_eventdev *rte_eventdevs;
 /** @internal The pool of rte_eventdev structures. */
 
+/** @internal Tracepoint of the rte_event_enqueue_*burst() functions. */
+extern rte_trace_point_t rte_eventdev_trace_enqueue_burst;
+/** @internal Tracepoint of rte_event_dequeue_burst(). */
+extern rte_trace_point_t rte_eventdev_trace_dequeue_burst;
+
 static __rte_always_inline uint16_t
 __rte_event_enqueue_burst(uint8_t dev_id, uint8_t port_id,
 			const struct rte_event ev[], uint16_t nb_events,
 			const event_enqueue_burst_t fn)
 {
 	const struct rte_eventdev *dev = &rte_eventdevs[dev_id];
+	uint16_t nb_enq;
 
 #ifdef RTE_LIBRTE_EVENTDEV_DEBUG
 	if (dev_id >= RTE_EVENT_MAX_DEVS || !rte_eventdevs[dev_id].attached) {
@@ -1336,9 +1343,14 @@ __rte_event_enqueue_burst(uint8_t dev_id, uint8_t port_id,
 	 * requests nb_events as const one
 	 */
 	if (nb_events == 1)
-		return (*dev->enqueue)(dev->data->ports[port_id], ev);
+		nb_enq = (*dev->enqueue)(dev->data->ports[port_id], ev);
 	else
-		return fn(dev->data->ports[port_id], ev, nb_events);
+		nb_enq = fn(dev->data->ports[port_id], ev, nb_events);
+
+	rte_trace_point_emit_fp(&rte_eventdev_trace_enqueue_burst, dev_id,
+			port_id, nb_events, nb_enq);
+
+	return nb_enq;
 }
 
 /**
@@ -1591,6 +1603,7 @@ rte_event_dequeue_burst(uint8_t dev_id, uint8_t port_id, struct rte_event ev[],
 			uint16_t nb_events, uint64_t timeout_ticks)
 {
 	struct rte_eventdev *dev = &rte_eventdevs[dev_id];
+	uint16_t nb_deq;
 
 #ifdef RTE_LIBRTE_EVENTDEV_DEBUG
 	if (dev_id >= RTE_EVENT_MAX_DEVS || !rte_eventdevs[dev_id].attached) {
@@ -1609,12 +1622,17 @@ rte_event_dequeue_burst(uint8_t dev_id, uint8_t port_id, struct rte_event ev[],
 	 * requests nb_events as const one
 	 */
 	if (nb_events == 1)
-		return (*dev->dequeue)(
+		nb_deq = (*dev->dequeue)(
 			dev->data->ports[port_id], ev, timeout_ticks);
 	else
-		return (*dev->dequeue_burst)(
+		nb_deq = (*dev->dequeue_burst)(
 			dev->data->ports[port_id], ev, nb_events,
 				timeout_ticks);
+
+	rte_trace_point_emit_fp(&rte_eventdev_trace_dequeue_burst, dev_id,
+			port_id, nb_events, nb_deq);
+
+	return nb_deq;
 }
 
 /**
@@ -0,0 +1,469 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_atomic.h>
+#include <rte_cpuflags.h>
+#include <rte_debug.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+
+#include <rte_rib.h>
+#include <rte_fib.h>
+#include "dir24_8.h"
+
+#ifdef CC_AVX512F_SUPPORT
+#include "dir24_8_avx512.h"
+#endif
+
+#define DIR24_8_NAMESIZE	64
+
+/* tbl8 group indexes must fit in a signed 32 bits gather index */
+#define DIR24_8_AVX512_4B_MAX_TBL8	(1 << 23)
+
+static rte_fib_lookup_fn_t
+get_scalar_fn(enum rte_fib_dir24_8_nh_sz nh_sz)
+{
+	switch (nh_sz) {
+	case RTE_FIB_DIR24_8_1B:
+		return dir24_8_lookup_bulk_1b;
+	case RTE_FIB_DIR24_8_2B:
+		return dir24_8_lookup_bulk_2b;
+	case RTE_FIB_DIR24_8_4B:
+		return dir24_8_lookup_bulk_4b;
+	case RTE_FIB_DIR24_8_8B:
+		return dir24_8_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+}
+
+static rte_fib_lookup_fn_t
+get_vector_fn(struct dir24_8_tbl *dp)
+{
+#ifdef CC_AVX512F_SUPPORT
+	if (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F))
+		return NULL;
+
+	switch (dp->nh_sz) {
+	case RTE_FIB_DIR24_8_4B:
+		if (dp->number_tbl8s > DIR24_8_AVX512_4B_MAX_TBL8)
+			return NULL;
+		return rte_dir24_8_vec_lookup_bulk_4b;
+	case RTE_FIB_DIR24_8_8B:
+		return rte_dir24_8_vec_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(dp);
+	return NULL;
+#endif
+}
+
+rte_fib_lookup_fn_t
+dir24_8_get_lookup_fn(void *p, enum rte_fib_lookup_type type)
+{
+	struct dir24_8_tbl *dp = p;
+	rte_fib_lookup_fn_t fn;
+
+	switch (type) {
+	case RTE_FIB_LOOKUP_DEFAULT:
+		fn = NULL;
+#ifdef RTE_ENABLE_AVX512
+		/* AVX512 may lower the core frequency, it is opt-in */
+		fn = get_vector_fn(dp);
+#endif
+		return (fn != NULL) ? fn : get_scalar_fn(dp->nh_sz);
+	case RTE_FIB_LOOKUP_DIR24_8_SCALAR:
+		return get_scalar_fn(dp->nh_sz);
+	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512:
+		return get_vector_fn(dp);
+	default:
+		return NULL;
+	}
+}
+
+static void
+write_to_fib(void *ptr, uint64_t val, enum rte_fib_dir24_8_nh_sz size, int n)
+{
+	int i;
+	uint8_t *ptr8 = (uint8_t *)ptr;
+	uint16_t *ptr16 = (uint16_t *)ptr;
+	uint32_t *ptr32 = (uint32_t *)ptr;
+	uint64_t *ptr64 = (uint64_t *)ptr;
+
+	switch (size) {
+	case RTE_FIB_DIR24_8_1B:
+		for (i = 0; i < n; i++)
+			ptr8[i] = (uint8_t)val;
+		break;
+	case RTE_FIB_DIR24_8_2B:
+		for (i = 0; i < n; i++)
+			ptr16[i] = (uint16_t)val;
+		break;
+	case RTE_FIB_DIR24_8_4B:
+		for (i = 0; i < n; i++)
+			ptr32[i] = (uint32_t)val;
+		break;
+	case RTE_FIB_DIR24_8_8B:
+		for (i = 0; i < n; i++)
+			ptr64[i] = (uint64_t)val;
+		break;
+	}
+}
+
+static uint64_t
+read_from_fib(const void *ptr, enum rte_fib_dir24_8_nh_sz size)
+{
+	switch (size) {
+	case RTE_FIB_DIR24_8_1B:
+		return *(const uint8_t *)ptr;
+	case RTE_FIB_DIR24_8_2B:
+		return *(const uint16_t *)ptr;
+	case RTE_FIB_DIR24_8_4B:
+		return *(const uint32_t *)ptr;
+	case RTE_FIB_DIR24_8_8B:
+		return *(const uint64_t *)ptr;
+	}
+	return 0;
+}
+
+static inline uint64_t
+get_tbl24(struct dir24_8_tbl *dp, uint32_t ip)
+{
+	return read_from_fib(get_tbl24_p(dp, ip, dp->nh_sz), dp->nh_sz);
+}
+
+static inline void *
+get_tbl8_p(struct dir24_8_tbl *dp, uint32_t tbl8_idx, uint32_t ip)
+{
+	return (uint8_t *)dp->tbl8 + (((tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT) +
+		(ip & ~DIR24_8_TBL24_MASK)) << dp->nh_sz);
+}
+
+/*
+ * The free tbl8 groups are kept in a stack, so getting or releasing one
+ * does not depend on the number of groups.
+ */
+static int
+tbl8_get_idx(struct dir24_8_tbl *dp)
+{
+	if (dp->cur_tbl8s == dp->number_tbl8s)
+		return -ENOSPC;
+	return dp->tbl8_pool[dp->cur_tbl8s++];
+}
+
+static void
+tbl8_free_idx(struct dir24_8_tbl *dp, uint32_t idx)
+{
+	dp->tbl8_pool[--dp->cur_tbl8s] = idx;
+}
+
+static int
+tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
+{
+	int tbl8_idx;
+
+	tbl8_idx = tbl8_get_idx(dp);
+	if (tbl8_idx < 0)
+		return tbl8_idx;
+	write_to_fib(get_tbl8_p(dp, tbl8_idx, 0), nh, dp->nh_sz,
+		DIR24_8_TBL8_GRP_NUM_ENT);
+	return tbl8_idx;
+}
+
+/* replace a tbl8 group holding a single next hop by a tbl24 entry */
+static void
+tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint32_t tbl8_idx)
+{
+	const void *grp = get_tbl8_p(dp, tbl8_idx, 0);
+	uint64_t nh;
+	uint32_t i;
+
+	nh = read_from_fib(grp, dp->nh_sz);
+	for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
+		if (read_from_fib(get_tbl8_p(dp, tbl8_idx, i), dp->nh_sz) !=
+				nh)
+			return;
+	}
+	write_to_fib(get_tbl24_p(dp, ip, dp->nh_sz), nh, dp->nh_sz, 1);
+	tbl8_free_idx(dp, tbl8_idx);
+}
+
+/*
+ * Write next_hop in the part [ledge, redge[ of a /24 through its tbl8
+ * group, one being taken from the pool if the /24 has none yet.
+ */
+static int
+install_to_tbl8(struct dir24_8_tbl *dp, uint64_t ledge, uint64_t redge,
+	uint64_t next_hop)
+{
+	uint64_t tbl24_tmp;
+	int tbl8_idx;
+
+	tbl24_tmp = get_tbl24(dp, ledge);
+	if (is_entry_extended(tbl24_tmp)) {
+		tbl8_idx = tbl24_tmp >> 1;
+		write_to_fib(get_tbl8_p(dp, tbl8_idx, ledge), next_hop << 1,
+			dp->nh_sz, redge - ledge);
+		tbl8_recycle(dp, ledge, tbl8_idx);
+		return 0;
+	}
+
+	tbl8_idx = tbl8_alloc(dp, tbl24_tmp);
+	if (tbl8_idx < 0)
+		return tbl8_idx;
+	write_to_fib(get_tbl8_p(dp, tbl8_idx, ledge), next_hop << 1,
+		dp->nh_sz, redge - ledge);
+	/* the group must be filled before lookups can reach it */
+	rte_smp_wmb();
+	write_to_fib(get_tbl24_p(dp, ledge, dp->nh_sz),
+		((uint64_t)tbl8_idx << 1) | DIR24_8_EXT_ENT, dp->nh_sz, 1);
+	return 0;
+}
+
+/*
+ * Write next_hop in the range of addresses [ledge, redge[, which does not
+ * hold any more specific route. The edges are 64 bits wide so that the
+ * range can end at the top of the address space.
+ */
+static int
+install_to_fib(struct dir24_8_tbl *dp, uint64_t ledge, uint64_t redge,
+	uint64_t next_hop)
+{
+	uint64_t lfull = RTE_ALIGN_CEIL(ledge, DIR24_8_TBL8_GRP_NUM_ENT);
+	uint64_t rfull = RTE_ALIGN_FLOOR(redge, DIR24_8_TBL8_GRP_NUM_ENT);
+	uint32_t needed = 0;
+	int ret;
+
+	if (ledge >= redge)
+		return 0;
+
+	/* check the space up front not to leave the range half written */
+	if (lfull > rfull) {
+		if (!is_entry_extended(get_tbl24(dp, ledge)))
+			needed++;
+	} else {
+		if ((ledge != lfull) &&
+				!is_entry_extended(get_tbl24(dp, ledge)))
+			needed++;
+		if ((redge != rfull) &&
+				!is_entry_extended(get_tbl24(dp, rfull)))
+			needed++;
+	}
+	if (dp->number_tbl8s - dp->cur_tbl8s < needed)
+		return -ENOSPC;
+
+	/* range inside a single /24 */
+	if (lfull > rfull)
+		return install_to_tbl8(dp, ledge, redge, next_hop);
+
+	if (ledge != lfull) {
+		ret = install_to_tbl8(dp, ledge, lfull, next_hop);
+		if (ret != 0)
+			return ret;
+	}
+	if (rfull != lfull)
+		write_to_fib(get_tbl24_p(dp, lfull, dp->nh_sz), next_hop << 1,
+			dp->nh_sz, (rfull - lfull) >> 8);
+	if (redge != rfull)
+		return install_to_tbl8(dp, rfull, redge, next_hop);
+
+	return 0;
+}
+
+/*
+ * Write next_hop in the addresses of ip/depth which are not covered by a
+ * more specific route, the gaps between them being found in the RIB in
+ * increasing order.
+ */
+static int
+modify_fib(struct dir24_8_tbl *dp, struct rte_rib *rib, uint32_t ip,
+	uint8_t depth, uint64_t next_hop)
+{
+	struct rte_rib_node *tmp = NULL;
+	uint64_t ledge, redge;
+	uint32_t tmp_ip;
+	uint8_t tmp_depth;
+	int ret;
+
+	ledge = ip;
+	redge = (uint64_t)ip + (1ULL << (32 - depth));
+	while ((tmp = rte_rib_get_nxt(rib, ip, depth, tmp,
+			RTE_RIB_GET_NXT_COVER)) != NULL) {
+		rte_rib_get_ip(tmp, &tmp_ip);
+		rte_rib_get_depth(tmp, &tmp_depth);
+		ret = install_to_fib(dp, ledge, tmp_ip, next_hop);
+		if (ret != 0)
+			return ret;
+		ledge = (uint64_t)tmp_ip + (1ULL << (32 - tmp_depth));
+	}
+	return install_to_fib(dp, ledge, redge, next_hop);
+}
+
+int
+dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
+	uint64_t next_hop, int op)
+{
+	struct dir24_8_tbl *dp;
+	struct rte_rib *rib;
+	struct rte_rib_node *tmp = NULL;
+	struct rte_rib_node *node;
+	struct rte_rib_node *parent;
+	uint64_t par_nh, node_nh;
+	int ret = 0;
+
+	if ((fib == NULL) || (depth > RTE_FIB_MAXDEPTH))
+		return -EINVAL;
+
+	dp = rte_fib_get_dp(fib);
+	rib = rte_fib_get_rib(fib);
+	RTE_ASSERT((dp != NULL) && (rib != NULL));
+
+	if (next_hop > get_max_nh(dp->nh_sz))
+		return -EINVAL;
+
+	ip &= rte_rib_depth_to_mask(depth);
+
+	node = rte_rib_lookup_exact(rib, ip, depth);
+	switch (op) {
+	case RTE_FIB_ADD:
+		if (node != NULL) {
+			rte_rib_get_nh(node, &node_nh);
+			if (node_nh == next_hop)
+				return 0;
+			ret = modify_fib(dp, rib, ip, depth, next_hop);
+			if (ret == 0)
+				rte_rib_set_nh(node, next_hop);
+			return ret;
+		}
+		/* each /24 holding longer routes needs a tbl8 group */
+		if (depth > 24) {
+			tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER);
+			if ((tmp == NULL) &&
+					(dp->rsvd_tbl8s >= dp->number_tbl8s))
+				return -ENOSPC;
+		}
+		node = rte_rib_insert(rib, ip, depth);
+		if (node == NULL)
+			return -rte_errno;
+		rte_rib_set_nh(node, next_hop);
+		parent = rte_rib_lookup_parent(node);
+		par_nh = dp->def_nh;
+		if (parent != NULL)
+			rte_rib_get_nh(parent, &par_nh);
+		if (par_nh != next_hop) {
+			ret = modify_fib(dp, rib, ip, depth, next_hop);
+			if (ret != 0) {
+				rte_rib_remove(rib, ip, depth);
+				return ret;
+			}
+		}
+		if ((depth > 24) && (tmp == NULL))
+			dp->rsvd_tbl8s++;
+		return 0;
+	case RTE_FIB_DEL:
+		if (node == NULL)
+			return -ENOENT;
+
+		parent = rte_rib_lookup_parent(node);
+		par_nh = dp->def_nh;
+		if (parent != NULL)
+			rte_rib_get_nh(parent, &par_nh);
+		rte_rib_get_nh(node, &node_nh);
+		if (par_nh != node_nh)
+			ret = modify_fib(dp, rib, ip, depth, par_nh);
+		if (ret != 0)
+			return ret;
+		rte_rib_remove(rib, ip, depth);
+		if (depth > 24) {
+			tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER);
+			if (tmp == NULL)
+				dp->rsvd_tbl8s--;
+		}
+		return 0;
+	default:
+		break;
+	}
+	return -EINVAL;
+}
+
+void *
+dir24_8_create(const char *name, int socket_id, struct rte_fib_conf *fib_conf)
+{
+	char mem_name[DIR24_8_NAMESIZE];
+	struct dir24_8_tbl *dp;
+	uint64_t def_nh;
+	uint32_t num_tbl8;
+	enum rte_fib_dir24_8_nh_sz nh_sz;
+	uint32_t i;
+
+	if ((name == NULL) || (fib_conf == NULL) ||
+			(fib_conf->dir24_8.nh_sz > RTE_FIB_DIR24_8_8B) ||
+			(fib_conf->dir24_8.num_tbl8 == 0) ||
+			(fib_conf->dir24_8.num_tbl8 >
+			get_max_nh(fib_conf->dir24_8.nh_sz)) ||
+			(fib_conf->default_nh >
+			get_max_nh(fib_conf->dir24_8.nh_sz))) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	def_nh = fib_conf->default_nh;
+	nh_sz = fib_conf->dir24_8.nh_sz;
+	num_tbl8 = fib_conf->dir24_8.num_tbl8;
+
+	dp = rte_zmalloc_socket(name, sizeof(struct dir24_8_tbl) +
+		DIR24_8_TBL24_NUM_ENT * (1 << nh_sz), RTE_CACHE_LINE_SIZE,
+		socket_id);
+	if (dp == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	/* Init table with default value */
+	write_to_fib(dp->tbl24, (def_nh << 1), nh_sz, 1 << 24);
+
+	snprintf(mem_name, sizeof(mem_name), "TBL8_%s", name);
+	dp->tbl8 = rte_zmalloc_socket(mem_name, DIR24_8_TBL8_GRP_NUM_ENT *
+		(1ULL << nh_sz) * num_tbl8, RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->tbl8 == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp);
+		return NULL;
+	}
+
+	snprintf(mem_name, sizeof(mem_name), "TBL8_POOL_%s", name);
+	dp->tbl8_pool = rte_malloc_socket(mem_name,
+		sizeof(uint32_t) * num_tbl8, RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->tbl8_pool == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp->tbl8);
+		rte_free(dp);
+		return NULL;
+	}
+	for (i = 0; i < num_tbl8; i++)
+		dp->tbl8_pool[i] = i;
+
+	dp->def_nh = def_nh;
+	dp->nh_sz = nh_sz;
+	dp->number_tbl8s = num_tbl8;
+
+	return dp;
+}
+
+void
+dir24_8_free(void *p)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+
+	rte_free(dp->tbl8_pool);
+	rte_free(dp->tbl8);
+	rte_free(dp);
+}
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <x86intrin.h>
+
+#include <rte_vect.h>
+#include <rte_fib.h>
+
+#include "dir24_8.h"
+#include "dir24_8_avx512.h"
+
+/*
+ * Lookup of 16 addresses with 4 bytes next hops: the tbl24 entries are
+ * gathered at once, then the tbl8 entries of the extended ones.
+ */
+static __rte_always_inline void
+dir24_8_vec_lookup_x16(void *p, const uint32_t *ips, uint64_t *next_hops)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+	const __m512i lsb = _mm512_set1_epi32(1);
+	const __m512i lsbyte_msk = _mm512_set1_epi32(0xff);
+	__m512i ip_vec, idxes, res, bytes;
+	__mmask16 msk_ext;
+
+	ip_vec = _mm512_loadu_si512((const void *)ips);
+	/* 24 most significant bits are the tbl24 indexes */
+	idxes = _mm512_srli_epi32(ip_vec, 8);
+	res = _mm512_i32gather_epi32(idxes, (const void *)dp->tbl24, 4);
+
+	/* get extended entries indexes */
+	msk_ext = _mm512_test_epi32_mask(res, lsb);
+	if (msk_ext != 0) {
+		idxes = _mm512_srli_epi32(res, 1);
+		idxes = _mm512_slli_epi32(idxes, 8);
+		bytes = _mm512_and_epi32(ip_vec, lsbyte_msk);
+		idxes = _mm512_maskz_add_epi32(msk_ext, idxes, bytes);
+		res = _mm512_mask_i32gather_epi32(res, msk_ext, idxes,
+			(const void *)dp->tbl8, 4);
+	}
+
+	res = _mm512_srli_epi32(res, 1);
+	_mm512_storeu_si512((void *)next_hops,
+		_mm512_cvtepu32_epi64(_mm512_castsi512_si256(res)));
+	_mm512_storeu_si512((void *)(next_hops + 8),
+		_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(res, 1)));
+}
+
+/*
+ * Lookup of 8 addresses with 8 bytes next hops, the tbl8 entries being
+ * gathered with 64 bits indexes.
+ */
+static __rte_always_inline void
+dir24_8_vec_lookup_x8_8b(void *p, const uint32_t *ips, uint64_t *next_hops)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+	const __m512i lsb = _mm512_set1_epi64(1);
+	const __m512i lsbyte_msk = _mm512_set1_epi64(0xff);
+	__m512i idxes, res, bytes;
+	__m256i ip_vec, idxes_256;
+	__mmask8 msk_ext;
+
+	ip_vec = _mm256_loadu_si256((const void *)ips);
+	/* 24 most significant bits are the tbl24 indexes */
+	idxes_256 = _mm256_srli_epi32(ip_vec, 8);
+	res = _mm512_i32gather_epi64(idxes_256, (const void *)dp->tbl24, 8);
+
+	/* get extended entries indexes */
+	msk_ext = _mm512_test_epi64_mask(res, lsb);
+	if (msk_ext != 0) {
+		bytes = _mm512_cvtepu32_epi64(ip_vec);
+		bytes = _mm512_and_epi64(bytes, lsbyte_msk);
+		idxes = _mm512_srli_epi64(res, 1);
+		idxes = _mm512_slli_epi64(idxes, 8);
+		idxes = _mm512_maskz_add_epi64(msk_ext, idxes, bytes);
+		res = _mm512_mask_i64gather_epi64(res, msk_ext, idxes,
+			(const void *)dp->tbl8, 8);
+	}
+
+	res = _mm512_srli_epi64(res, 1);
+	_mm512_storeu_si512((void *)next_hops, res);
+}
+
+void
+rte_dir24_8_vec_lookup_bulk_4b(void *p, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 16); i++)
+		dir24_8_vec_lookup_x16(p, ips + i * 16, next_hops + i * 16);
+
+	dir24_8_lookup_bulk_4b(p, ips + i * 16, next_hops + i * 16,
+		n - i * 16);
+}
+
+void
+rte_dir24_8_vec_lookup_bulk_8b(void *p, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 8); i++)
+		dir24_8_vec_lookup_x8_8b(p, ips + i * 8, next_hops + i * 8);
+
+	dir24_8_lookup_bulk_8b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
@@ -0,0 +1,265 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_FIB_H_
+#define _RTE_FIB_H_
+
+/**
+ * @file
+ *
+ * RTE IPv4 Forwarding Information Base
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * The FIB keeps the routes in a RIB for the control plane and builds from
+ * it a lookup table for the data plane. Unlike the LPM library, the
+ * lookup table does not hold the rules: the routes covering or covered by
+ * an updated prefix are found in the RIB, so the cost of an update does not
+ * depend on the number of routes. The DIR24_8 lookup table stores next hops
+ * of 1, 2, 4 or 8 bytes, one bit of which is reserved.
+ *
+ * The updates are not thread safe. They can run concurrently with the
+ * lookups, which see either the old or the new next hop of an address.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rte_fib;
+struct rte_rib;
+
+/** Maximum depth value possible for IPv4 FIB. */
+#define RTE_FIB_MAXDEPTH	32
+
+/** Type of FIB struct */
+enum rte_fib_type {
+	RTE_FIB_DUMMY,		/**< RIB tree based FIB */
+	RTE_FIB_DIR24_8		/**< DIR24_8 based FIB */
+};
+
+/** Modify FIB function */
+typedef int (*rte_fib_modify_fn_t)(struct rte_fib *fib, uint32_t ip,
+	uint8_t depth, uint64_t next_hop, int op);
+/** FIB bulk lookup function */
+typedef void (*rte_fib_lookup_fn_t)(void *fib, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n);
+
+/** FIB modify operations */
+enum rte_fib_op {
+	RTE_FIB_ADD,
+	RTE_FIB_DEL,
+};
+
+/** Size of nexthop (1 << nh_sz) bytes for DIR24_8 based FIB */
+enum rte_fib_dir24_8_nh_sz {
+	RTE_FIB_DIR24_8_1B,
+	RTE_FIB_DIR24_8_2B,
+	RTE_FIB_DIR24_8_4B,
+	RTE_FIB_DIR24_8_8B
+};
+
+/** Type of lookup function implementation */
+enum rte_fib_lookup_type {
+	/**
+	 * Best implementation supported by the CPU, AVX512 only if
+	 * RTE_ENABLE_AVX512 is defined
+	 */
+	RTE_FIB_LOOKUP_DEFAULT,
+	/** Scalar lookup, prefetching the entries of the next addresses */
+	RTE_FIB_LOOKUP_DIR24_8_SCALAR,
+	/** AVX512 lookup, of 4 and 8 bytes next hops only */
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512
+};
+
+/** FIB configuration structure */
+struct rte_fib_conf {
+	enum rte_fib_type type; /**< Type of FIB struct */
+	/** Default value returned on lookup if there is no route */
+	uint64_t default_nh;
+	/** Maximum number of routes */
+	int	max_routes;
+	union {
+		/** DIR24_8 configuration */
+		struct {
+			/** Size of the next hops */
+			enum rte_fib_dir24_8_nh_sz nh_sz;
+			/**
+			 * Number of tbl8 groups, each one holding the routes
+			 * longer than 24 bits of a /24 prefix
+			 */
+			uint32_t	num_tbl8;
+		} dir24_8;
+	};
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a FIB.
+ *
+ * @param name
+ *   FIB name.
+ * @param socket_id
+ *   NUMA socket ID for the FIB table memory allocation.
+ * @param conf
+ *   Structure containing the configuration.
+ * @return
+ *   Handle to the FIB object on success, NULL otherwise with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if a FIB with the same name already exists
+ *   - ENOMEM if the memory cannot be allocated
+ */
+struct rte_fib * __rte_experimental
+rte_fib_create(const char *name, int socket_id, struct rte_fib_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Find an existing FIB object and return a pointer to it.
+ *
+ * @param name
+ *   Name of the FIB object as passed to rte_fib_create().
+ * @return
+ *   Pointer to the FIB object, NULL with rte_errno set to ENOENT if it does
+ *   not exist.
+ */
+struct rte_fib * __rte_experimental
+rte_fib_find_existing(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a FIB object.
+ *
+ * @param fib
+ *   FIB object handle created by rte_fib_create().
+ *   If fib is NULL, no operation is performed.
+ */
+void __rte_experimental
+rte_fib_free(struct rte_fib *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add a route to the FIB, or update its next hop.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ip
+ *   Prefix of the route, in host byte order.
+ * @param depth
+ *   Prefix length of the route, from 0 to 32.
+ * @param next_hop
+ *   Next hop of the route.
+ * @return
+ *   0 on success, a negative value otherwise:
+ *   - -EINVAL for invalid parameters or a next hop too large
+ *   - -ENOSPC if there is no tbl8 group left
+ *   - -ENOMEM if the maximum number of routes is reached
+ */
+int __rte_experimental
+rte_fib_add(struct rte_fib *fib, uint32_t ip, uint8_t depth,
+	uint64_t next_hop);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Delete a route from the FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ip
+ *   Prefix of the route, in host byte order.
+ * @param depth
+ *   Prefix length of the route, from 0 to 32.
+ * @return
+ *   0 on success, -ENOENT if the route does not exist, -EINVAL for invalid
+ *   parameters.
+ */
+int __rte_experimental
+rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup multiple IP addresses in the FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ips
+ *   Array of IPs to be looked up in the FIB, in host byte order.
+ * @param next_hops
+ *   Next hop of the most specific rule found for each IP,
+ *   the default next hop if there is none.
+ * @param n
+ *   Number of elements in the ips and next_hops arrays.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters.
+ */
+int __rte_experimental
+rte_fib_lookup_bulk(struct rte_fib *fib, uint32_t *ips,
+	uint64_t *next_hops, int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the lookup table of a FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @return
+ *   Pointer to the lookup table, to be passed to the lookup functions.
+ */
+void * __rte_experimental
+rte_fib_get_dp(struct rte_fib *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the RIB of a FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @return
+ *   Pointer to the RIB, to be used for read-only queries of the routes.
+ */
+struct rte_rib * __rte_experimental
+rte_fib_get_rib(struct rte_fib *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Select the lookup function implementation of a FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param type
+ *   Type of lookup function.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters, -ENOTSUP if the
+ *   implementation is not supported by the FIB, the build or the CPU.
+ */
+int __rte_experimental
+rte_fib_select_lookup(struct rte_fib *fib, enum rte_fib_lookup_type type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_FIB_H_ */
@@ -0,0 +1,272 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_FIB6_H_
+#define _RTE_FIB6_H_
+
+/**
+ * @file
+ *
+ * RTE IPv6 Forwarding Information Base
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * The IPv6 FIB keeps the routes in a RIB6 for the control plane and builds
+ * from it a lookup table for the data plane. The TRIE lookup table indexes
+ * the first 24 bits of the addresses in a flat table, then each following
+ * byte in groups of 256 entries, a group being allocated only for the
+ * prefixes holding longer routes. An update only rewrites the entries of
+ * the addresses whose next hop changes, the routes covering or covered by
+ * the prefix being found in the RIB6, so its cost does not depend on the
+ * number of routes. The next hops take 2, 4 or 8 bytes, one bit of which is
+ * reserved.
+ *
+ * The updates are not thread safe. They can run concurrently with the
+ * lookups, which see either the old or the new next hop of an address.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_FIB6_IPV6_ADDR_SIZE		16
+/** Maximum depth value possible for IPv6 FIB. */
+#define RTE_FIB6_MAXDEPTH		128
+
+struct rte_fib6;
+struct rte_rib6;
+
+/** Type of FIB struct */
+enum rte_fib6_type {
+	RTE_FIB6_DUMMY,		/**< RIB6 tree based FIB */
+	RTE_FIB6_TRIE		/**< Multibit trie based FIB */
+};
+
+/** Modify FIB function */
+typedef int (*rte_fib6_modify_fn_t)(struct rte_fib6 *fib,
+	const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE], uint8_t depth,
+	uint64_t next_hop, int op);
+/** FIB bulk lookup function */
+typedef void (*rte_fib6_lookup_fn_t)(void *fib,
+	uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n);
+
+/** FIB modify operations */
+enum rte_fib6_op {
+	RTE_FIB6_ADD,
+	RTE_FIB6_DEL,
+};
+
+/** Size of nexthop (1 << nh_sz) bytes for TRIE based FIB */
+enum rte_fib_trie_nh_sz {
+	RTE_FIB6_TRIE_2B = 1,
+	RTE_FIB6_TRIE_4B,
+	RTE_FIB6_TRIE_8B
+};
+
+/** Type of lookup function implementation */
+enum rte_fib6_lookup_type {
+	/**
+	 * Best implementation supported by the CPU, AVX512 only if
+	 * RTE_ENABLE_AVX512 is defined
+	 */
+	RTE_FIB6_LOOKUP_DEFAULT,
+	/** Scalar lookup */
+	RTE_FIB6_LOOKUP_TRIE_SCALAR,
+	/** AVX512 lookup, of 4 and 8 bytes next hops only */
+	RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512
+};
+
+/** FIB configuration structure */
+struct rte_fib6_conf {
+	enum rte_fib6_type type; /**< Type of FIB struct */
+	/** Default value returned on lookup if there is no route */
+	uint64_t default_nh;
+	/** Maximum number of routes */
+	int	max_routes;
+	union {
+		/** TRIE configuration */
+		struct {
+			/** Size of the next hops */
+			enum rte_fib_trie_nh_sz nh_sz;
+			/**
+			 * Number of tbl8 groups, each one holding the routes
+			 * longer than a prefix of 24, 32, ... or 120 bits
+			 */
+			uint32_t	num_tbl8;
+		} trie;
+	};
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create an IPv6 FIB.
+ *
+ * @param name
+ *   FIB name.
+ * @param socket_id
+ *   NUMA socket ID for the FIB table memory allocation.
+ * @param conf
+ *   Structure containing the configuration.
+ * @return
+ *   Handle to the FIB object on success, NULL otherwise with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if a FIB with the same name already exists
+ *   - ENOMEM if the memory cannot be allocated
+ */
+struct rte_fib6 * __rte_experimental
+rte_fib6_create(const char *name, int socket_id, struct rte_fib6_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Find an existing IPv6 FIB object and return a pointer to it.
+ *
+ * @param name
+ *   Name of the FIB object as passed to rte_fib6_create().
+ * @return
+ *   Pointer to the FIB object, NULL with rte_errno set to ENOENT if it does
+ *   not exist.
+ */
+struct rte_fib6 * __rte_experimental
+rte_fib6_find_existing(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free an IPv6 FIB object.
+ *
+ * @param fib
+ *   FIB object handle created by rte_fib6_create().
+ *   If fib is NULL, no operation is performed.
+ */
+void __rte_experimental
+rte_fib6_free(struct rte_fib6 *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add a route to the FIB, or update its next hop.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ip
+ *   Prefix of the route.
+ * @param depth
+ *   Prefix length of the route, from 0 to 128.
+ * @param next_hop
+ *   Next hop of the route.
+ * @return
+ *   0 on success, a negative value otherwise:
+ *   - -EINVAL for invalid parameters or a next hop too large
+ *   - -ENOSPC if there are not enough tbl8 groups left
+ *   - -ENOMEM if the maximum number of routes is reached
+ */
+int __rte_experimental
+rte_fib6_add(struct rte_fib6 *fib, const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE],
+	uint8_t depth, uint64_t next_hop);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Delete a route from the FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ip
+ *   Prefix of the route.
+ * @param depth
+ *   Prefix length of the route, from 0 to 128.
+ * @return
+ *   0 on success, -ENOENT if the route does not exist, -EINVAL for invalid
+ *   parameters.
+ */
+int __rte_experimental
+rte_fib6_delete(struct rte_fib6 *fib,
+	const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE], uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup multiple IPv6 addresses in the FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param ips
+ *   Array of IPv6 addresses to be looked up in the FIB.
+ * @param next_hops
+ *   Next hop of the most specific rule found for each IP,
+ *   the default next hop if there is none.
+ * @param n
+ *   Number of elements in the ips and next_hops arrays.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters.
+ */
+int __rte_experimental
+rte_fib6_lookup_bulk(struct rte_fib6 *fib,
+	uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the lookup table of an IPv6 FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @return
+ *   Pointer to the lookup table, to be passed to the lookup functions.
+ */
+void * __rte_experimental
+rte_fib6_get_dp(struct rte_fib6 *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the RIB6 of an IPv6 FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @return
+ *   Pointer to the RIB6, to be used for read-only queries of the routes.
+ */
+struct rte_rib6 * __rte_experimental
+rte_fib6_get_rib(struct rte_fib6 *fib);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Select the lookup function implementation of an IPv6 FIB.
+ *
+ * @param fib
+ *   FIB object handle.
+ * @param type
+ *   Type of lookup function.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters, -ENOTSUP if the
+ *   implementation is not supported by the FIB, the build or the CPU.
+ */
+int __rte_experimental
+rte_fib6_select_lookup(struct rte_fib6 *fib, enum rte_fib6_lookup_type type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_FIB6_H_ */
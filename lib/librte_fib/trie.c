@@ -0,0 +1,570 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_atomic.h>
+#include <rte_cpuflags.h>
+#include <rte_debug.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+
+#include <rte_rib6.h>
+#include <rte_fib6.h>
+#include "trie.h"
+
+#ifdef CC_AVX512F_SUPPORT
+#include "trie_avx512.h"
+#endif
+
+#define TRIE_NAMESIZE		64
+
+/* tbl8 group indexes must fit in a signed 32 bits gather index */
+#define TRIE_AVX512_4B_MAX_TBL8	(1 << 23)
+
+static rte_fib6_lookup_fn_t
+get_scalar_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return trie_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return trie_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return trie_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+}
+
+static rte_fib6_lookup_fn_t
+get_vector_fn(struct trie_tbl *dp)
+{
+#ifdef CC_AVX512F_SUPPORT
+	if (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F))
+		return NULL;
+
+	switch (dp->nh_sz) {
+	case RTE_FIB6_TRIE_4B:
+		if (dp->number_tbl8s > TRIE_AVX512_4B_MAX_TBL8)
+			return NULL;
+		return rte_trie_vec_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_trie_vec_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(dp);
+	return NULL;
+#endif
+}
+
+rte_fib6_lookup_fn_t
+trie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
+{
+	struct trie_tbl *dp = p;
+	rte_fib6_lookup_fn_t fn;
+
+	switch (type) {
+	case RTE_FIB6_LOOKUP_DEFAULT:
+		fn = NULL;
+#ifdef RTE_ENABLE_AVX512
+		/* AVX512 may lower the core frequency, it is opt-in */
+		fn = get_vector_fn(dp);
+#endif
+		return (fn != NULL) ? fn : get_scalar_fn(dp->nh_sz);
+	case RTE_FIB6_LOOKUP_TRIE_SCALAR:
+		return get_scalar_fn(dp->nh_sz);
+	case RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512:
+		return get_vector_fn(dp);
+	default:
+		return NULL;
+	}
+}
+
+static void
+write_to_dp(void *ptr, uint64_t val, enum rte_fib_trie_nh_sz size, int n)
+{
+	int i;
+	uint16_t *ptr16 = (uint16_t *)ptr;
+	uint32_t *ptr32 = (uint32_t *)ptr;
+	uint64_t *ptr64 = (uint64_t *)ptr;
+
+	switch (size) {
+	case RTE_FIB6_TRIE_2B:
+		for (i = 0; i < n; i++)
+			ptr16[i] = (uint16_t)val;
+		break;
+	case RTE_FIB6_TRIE_4B:
+		for (i = 0; i < n; i++)
+			ptr32[i] = (uint32_t)val;
+		break;
+	case RTE_FIB6_TRIE_8B:
+		for (i = 0; i < n; i++)
+			ptr64[i] = (uint64_t)val;
+		break;
+	}
+}
+
+static uint64_t
+read_from_dp(const void *ptr, enum rte_fib_trie_nh_sz size)
+{
+	switch (size) {
+	case RTE_FIB6_TRIE_2B:
+		return *(const uint16_t *)ptr;
+	case RTE_FIB6_TRIE_4B:
+		return *(const uint32_t *)ptr;
+	case RTE_FIB6_TRIE_8B:
+		return *(const uint64_t *)ptr;
+	}
+	return 0;
+}
+
+static inline void *
+get_tbl_p(struct trie_tbl *dp, void *tbl, uint32_t idx)
+{
+	return (uint8_t *)tbl + ((uint64_t)idx << dp->nh_sz);
+}
+
+static inline void *
+get_tbl8_p(struct trie_tbl *dp, uint64_t tbl8_idx)
+{
+	return get_tbl_p(dp, dp->tbl8, tbl8_idx * TRIE_TBL8_GRP_NUM_ENT);
+}
+
+/* Level 0 is the tbl24, the next ones are tbl8 groups */
+static inline uint32_t
+get_level_idx(const uint8_t *ip, int level)
+{
+	if (level == 0)
+		return get_tbl24_idx(ip);
+	return ip[TRIE_TBL24_BYTES + level - 1];
+}
+
+static inline uint32_t
+get_level_num_ent(int level)
+{
+	return (level == 0) ? TRIE_TBL24_NUM_ENT : TRIE_TBL8_GRP_NUM_ENT;
+}
+
+/* Check if the bytes of ip below an entry of the level are all equal val */
+static inline bool
+is_tail_equal(const uint8_t *ip, int level, uint8_t val)
+{
+	int i;
+
+	for (i = TRIE_TBL24_BYTES + level; i < RTE_FIB6_IPV6_ADDR_SIZE; i++)
+		if (ip[i] != val)
+			return false;
+	return true;
+}
+
+/*
+ * The free tbl8 groups are kept in a stack, so getting or releasing one
+ * does not depend on the number of groups.
+ */
+static int
+tbl8_get_idx(struct trie_tbl *dp)
+{
+	if (dp->cur_tbl8s == dp->number_tbl8s)
+		return -ENOSPC;
+	return dp->tbl8_pool[dp->cur_tbl8s++];
+}
+
+static void
+tbl8_free_idx(struct trie_tbl *dp, uint32_t idx)
+{
+	dp->tbl8_pool[--dp->cur_tbl8s] = idx;
+}
+
+static int
+tbl8_alloc(struct trie_tbl *dp, uint64_t nh)
+{
+	int tbl8_idx;
+
+	tbl8_idx = tbl8_get_idx(dp);
+	if (tbl8_idx < 0)
+		return tbl8_idx;
+	write_to_dp(get_tbl8_p(dp, tbl8_idx), nh, dp->nh_sz,
+		TRIE_TBL8_GRP_NUM_ENT);
+	return tbl8_idx;
+}
+
+/* release a tbl8 group and the groups of the next levels it points to */
+static void
+tbl8_free_tree(struct trie_tbl *dp, uint32_t tbl8_idx)
+{
+	void *grp = get_tbl8_p(dp, tbl8_idx);
+	uint64_t ent;
+	uint32_t i;
+
+	for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++) {
+		ent = read_from_dp(get_tbl_p(dp, grp, i), dp->nh_sz);
+		if (is_entry_extended(ent))
+			tbl8_free_tree(dp, ent >> 1);
+	}
+	tbl8_free_idx(dp, tbl8_idx);
+}
+
+/* replace a tbl8 group holding a single next hop by its parent entry */
+static void
+tbl8_recycle(struct trie_tbl *dp, void *par, uint32_t tbl8_idx)
+{
+	void *grp = get_tbl8_p(dp, tbl8_idx);
+	uint64_t nh;
+	uint32_t i;
+
+	nh = read_from_dp(grp, dp->nh_sz);
+	if (is_entry_extended(nh))
+		return;
+	for (i = 1; i < TRIE_TBL8_GRP_NUM_ENT; i++) {
+		if (read_from_dp(get_tbl_p(dp, grp, i), dp->nh_sz) != nh)
+			return;
+	}
+	write_to_dp(par, nh, dp->nh_sz, 1);
+	tbl8_free_idx(dp, tbl8_idx);
+}
+
+static int
+write_range(struct trie_tbl *dp, void *tbl, int level, const uint8_t *ledge,
+	const uint8_t *redge, bool from_first, bool to_last, uint64_t next_hop);
+
+/*
+ * Write next_hop in the part of the range below an entry which the range
+ * does not cover entirely, through the tbl8 group of the next level.
+ */
+static int
+write_partial(struct trie_tbl *dp, void *ent_p, int level,
+	const uint8_t *ledge, const uint8_t *redge, bool from_first,
+	bool to_last, uint64_t next_hop)
+{
+	uint64_t ent;
+	int tbl8_idx;
+	int ret;
+
+	ent = read_from_dp(ent_p, dp->nh_sz);
+	if (is_entry_extended(ent)) {
+		ret = write_range(dp, get_tbl8_p(dp, ent >> 1), level, ledge,
+			redge, from_first, to_last, next_hop);
+		tbl8_recycle(dp, ent_p, ent >> 1);
+		return ret;
+	}
+	if (ent == (next_hop << 1))
+		return 0;
+
+	tbl8_idx = tbl8_alloc(dp, ent);
+	if (tbl8_idx < 0)
+		return tbl8_idx;
+	ret = write_range(dp, get_tbl8_p(dp, tbl8_idx), level, ledge, redge,
+		from_first, to_last, next_hop);
+	if (ret != 0) {
+		tbl8_free_tree(dp, tbl8_idx);
+		return ret;
+	}
+	/* the group must be filled before lookups can reach it */
+	rte_smp_wmb();
+	write_to_dp(ent_p, ((uint64_t)tbl8_idx << 1) | TRIE_EXT_ENT,
+		dp->nh_sz, 1);
+	return 0;
+}
+
+/*
+ * Write next_hop in the addresses [ledge, redge] below a table of the
+ * given level. The range starts at the first entry of the table when
+ * from_first is set, and ends at its last entry when to_last is set.
+ * Only the entries at the edges of the range may be partially covered,
+ * so the cost is bounded by the number of entries covered plus two paths
+ * down the levels.
+ */
+static int
+write_range(struct trie_tbl *dp, void *tbl, int level, const uint8_t *ledge,
+	const uint8_t *redge, bool from_first, bool to_last, uint64_t next_hop)
+{
+	uint32_t first, last, i;
+	void *ent_p;
+	uint64_t ent;
+	int ret;
+
+	first = from_first ? 0 : get_level_idx(ledge, level);
+	last = to_last ? get_level_num_ent(level) - 1 :
+		get_level_idx(redge, level);
+
+	for (i = first; i <= last; i++) {
+		ent_p = get_tbl_p(dp, tbl, i);
+		if (((i != first) || from_first ||
+				is_tail_equal(ledge, level, 0)) &&
+				((i != last) || to_last ||
+				is_tail_equal(redge, level, UINT8_MAX))) {
+			ent = read_from_dp(ent_p, dp->nh_sz);
+			write_to_dp(ent_p, next_hop << 1, dp->nh_sz, 1);
+			if (is_entry_extended(ent))
+				tbl8_free_tree(dp, ent >> 1);
+			continue;
+		}
+		ret = write_partial(dp, ent_p, level + 1, ledge, redge,
+			from_first || (i != first), to_last || (i != last),
+			next_hop);
+		if (ret != 0)
+			return ret;
+	}
+	return 0;
+}
+
+/* get the last address of a prefix */
+static inline void
+get_last_addr(uint8_t *dst, const uint8_t *ip, uint8_t depth)
+{
+	int i;
+
+	for (i = 0; i < RTE_FIB6_IPV6_ADDR_SIZE; i++)
+		dst[i] = ip[i] | ~rte_rib6_get_msk_part(depth, i);
+}
+
+/* increment an address, return true when it wraps around */
+static inline bool
+addr_inc(uint8_t *ip)
+{
+	int i;
+
+	for (i = RTE_FIB6_IPV6_ADDR_SIZE - 1; i >= 0; i--)
+		if (++ip[i] != 0)
+			return false;
+	return true;
+}
+
+static inline void
+addr_dec(uint8_t *ip)
+{
+	int i;
+
+	for (i = RTE_FIB6_IPV6_ADDR_SIZE - 1; i >= 0; i--)
+		if (ip[i]-- != 0)
+			return;
+}
+
+/*
+ * Write next_hop in the addresses of ip/depth which are not covered by a
+ * more specific route, the gaps between them being found in the RIB6 in
+ * increasing order.
+ */
+static int
+modify_dp(struct trie_tbl *dp, struct rte_rib6 *rib,
+	const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE], uint8_t depth,
+	uint64_t next_hop)
+{
+	struct rte_rib6_node *tmp = NULL;
+	uint8_t ledge[RTE_FIB6_IPV6_ADDR_SIZE];
+	uint8_t redge[RTE_FIB6_IPV6_ADDR_SIZE];
+	uint8_t tmp_ip[RTE_FIB6_IPV6_ADDR_SIZE];
+	uint8_t tmp_depth;
+	int ret;
+
+	rte_rib6_copy_addr(ledge, ip);
+	while ((tmp = rte_rib6_get_nxt(rib, ip, depth, tmp,
+			RTE_RIB6_GET_NXT_COVER)) != NULL) {
+		rte_rib6_get_ip(tmp, tmp_ip);
+		rte_rib6_get_depth(tmp, &tmp_depth);
+		if (!rte_rib6_is_equal(ledge, tmp_ip)) {
+			rte_rib6_copy_addr(redge, tmp_ip);
+			addr_dec(redge);
+			ret = write_range(dp, dp->tbl24, 0, ledge, redge,
+				false, false, next_hop);
+			if (ret != 0)
+				return ret;
+		}
+		get_last_addr(ledge, tmp_ip, tmp_depth);
+		/* the route ends at the top of the address space */
+		if (addr_inc(ledge))
+			return 0;
+	}
+	get_last_addr(redge, ip, depth);
+	if (memcmp(ledge, redge, RTE_FIB6_IPV6_ADDR_SIZE) > 0)
+		return 0;
+	return write_range(dp, dp->tbl24, 0, ledge, redge, false, false,
+		next_hop);
+}
+
+/*
+ * Count the tbl8 groups on the path of ip/depth which hold no other route,
+ * one being needed below each prefix of 24, 32, ... bits shorter than the
+ * route. A prefix holding no route has none in its own prefixes either, so
+ * the count starts from the longest one.
+ */
+static uint32_t
+get_num_new_tbl8(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE], uint8_t depth)
+{
+	uint32_t cnt = 0;
+	int pfx_len;
+
+	for (pfx_len = RTE_ALIGN_FLOOR(depth - 1, 8); pfx_len >= 24;
+			pfx_len -= 8) {
+		if (rte_rib6_get_nxt(rib, ip, pfx_len, NULL,
+				RTE_RIB6_GET_NXT_COVER) != NULL)
+			break;
+		cnt++;
+	}
+	return cnt;
+}
+
+int
+trie_modify(struct rte_fib6 *fib, const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE],
+	uint8_t depth, uint64_t next_hop, int op)
+{
+	struct trie_tbl *dp;
+	struct rte_rib6 *rib;
+	struct rte_rib6_node *node;
+	struct rte_rib6_node *parent;
+	uint8_t ip_masked[RTE_FIB6_IPV6_ADDR_SIZE];
+	uint64_t par_nh, node_nh;
+	uint32_t num_new_tbl8;
+	int ret = 0;
+	int i;
+
+	if ((fib == NULL) || (ip == NULL) || (depth > RTE_FIB6_MAXDEPTH))
+		return -EINVAL;
+
+	dp = rte_fib6_get_dp(fib);
+	rib = rte_fib6_get_rib(fib);
+	RTE_ASSERT((dp != NULL) && (rib != NULL));
+
+	if (next_hop > get_max_nh(dp->nh_sz))
+		return -EINVAL;
+
+	for (i = 0; i < RTE_FIB6_IPV6_ADDR_SIZE; i++)
+		ip_masked[i] = ip[i] & rte_rib6_get_msk_part(depth, i);
+
+	node = rte_rib6_lookup_exact(rib, ip_masked, depth);
+	switch (op) {
+	case RTE_FIB6_ADD:
+		if (node != NULL) {
+			rte_rib6_get_nh(node, &node_nh);
+			if (node_nh == next_hop)
+				return 0;
+			ret = modify_dp(dp, rib, ip_masked, depth, next_hop);
+			if (ret == 0)
+				rte_rib6_set_nh(node, next_hop);
+			return ret;
+		}
+		num_new_tbl8 = get_num_new_tbl8(rib, ip_masked, depth);
+		if (dp->rsvd_tbl8s + num_new_tbl8 > dp->number_tbl8s)
+			return -ENOSPC;
+
+		node = rte_rib6_insert(rib, ip_masked, depth);
+		if (node == NULL)
+			return -rte_errno;
+		rte_rib6_set_nh(node, next_hop);
+		parent = rte_rib6_lookup_parent(node);
+		par_nh = dp->def_nh;
+		if (parent != NULL)
+			rte_rib6_get_nh(parent, &par_nh);
+		if (par_nh != next_hop) {
+			ret = modify_dp(dp, rib, ip_masked, depth, next_hop);
+			if (ret != 0) {
+				rte_rib6_remove(rib, ip_masked, depth);
+				return ret;
+			}
+		}
+		dp->rsvd_tbl8s += num_new_tbl8;
+		return 0;
+	case RTE_FIB6_DEL:
+		if (node == NULL)
+			return -ENOENT;
+
+		parent = rte_rib6_lookup_parent(node);
+		par_nh = dp->def_nh;
+		if (parent != NULL)
+			rte_rib6_get_nh(parent, &par_nh);
+		rte_rib6_get_nh(node, &node_nh);
+		if (par_nh != node_nh)
+			ret = modify_dp(dp, rib, ip_masked, depth, par_nh);
+		if (ret != 0)
+			return ret;
+		rte_rib6_remove(rib, ip_masked, depth);
+		dp->rsvd_tbl8s -= get_num_new_tbl8(rib, ip_masked, depth);
+		return 0;
+	default:
+		break;
+	}
+	return -EINVAL;
+}
+
+void *
+trie_create(const char *name, int socket_id, struct rte_fib6_conf *conf)
+{
+	char mem_name[TRIE_NAMESIZE];
+	struct trie_tbl *dp;
+	uint64_t def_nh;
+	uint32_t num_tbl8;
+	enum rte_fib_trie_nh_sz nh_sz;
+	uint32_t i;
+
+	if ((name == NULL) || (conf == NULL) ||
+			(conf->trie.nh_sz < RTE_FIB6_TRIE_2B) ||
+			(conf->trie.nh_sz > RTE_FIB6_TRIE_8B) ||
+			(conf->trie.num_tbl8 == 0) ||
+			(conf->trie.num_tbl8 >
+			get_max_nh(conf->trie.nh_sz)) ||
+			(conf->default_nh >
+			get_max_nh(conf->trie.nh_sz))) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	def_nh = conf->default_nh;
+	nh_sz = conf->trie.nh_sz;
+	num_tbl8 = conf->trie.num_tbl8;
+
+	dp = rte_zmalloc_socket(name, sizeof(struct trie_tbl) +
+		TRIE_TBL24_NUM_ENT * (1 << nh_sz), RTE_CACHE_LINE_SIZE,
+		socket_id);
+	if (dp == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	/* Init table with default value */
+	write_to_dp(dp->tbl24, (def_nh << 1), nh_sz, TRIE_TBL24_NUM_ENT);
+
+	snprintf(mem_name, sizeof(mem_name), "TBL8_%s", name);
+	dp->tbl8 = rte_zmalloc_socket(mem_name, TRIE_TBL8_GRP_NUM_ENT *
+		(1ULL << nh_sz) * num_tbl8, RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->tbl8 == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp);
+		return NULL;
+	}
+
+	snprintf(mem_name, sizeof(mem_name), "TBL8_POOL_%s", name);
+	dp->tbl8_pool = rte_malloc_socket(mem_name,
+		sizeof(uint32_t) * num_tbl8, RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->tbl8_pool == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp->tbl8);
+		rte_free(dp);
+		return NULL;
+	}
+	for (i = 0; i < num_tbl8; i++)
+		dp->tbl8_pool[i] = i;
+
+	dp->def_nh = def_nh;
+	dp->nh_sz = nh_sz;
+	dp->number_tbl8s = num_tbl8;
+
+	return dp;
+}
+
+void
+trie_free(void *p)
+{
+	struct trie_tbl *dp = (struct trie_tbl *)p;
+
+	rte_free(dp->tbl8_pool);
+	rte_free(dp->tbl8);
+	rte_free(dp);
+}
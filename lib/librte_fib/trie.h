@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _TRIE_H_
+#define _TRIE_H_
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_memory.h>
+
+/**
+ * @file
+ * RTE IPv6 Longest Prefix Match (LPM) multibit trie
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRIE_TBL24_NUM_ENT		(1 << 24)
+#define TRIE_TBL8_GRP_NUM_ENT		256U
+#define TRIE_EXT_ENT			1
+/* Number of address bytes indexing the tbl24 */
+#define TRIE_TBL24_BYTES		3
+
+/*
+ * The tbl24 is indexed by the first 3 bytes of the addresses, each level of
+ * tbl8 groups below it by one more byte. Each entry holds a next hop
+ * shifted left by one bit, or the index of the tbl8 group of the next level
+ * with the lowest bit set.
+ */
+struct trie_tbl {
+	uint32_t	number_tbl8s;	/**< Total number of tbl8s */
+	uint32_t	rsvd_tbl8s;	/**< Number of reserved tbl8s */
+	uint32_t	cur_tbl8s;	/**< Current number of tbl8s */
+	enum rte_fib_trie_nh_sz	nh_sz;	/**< Size of nexthop entry */
+	uint64_t	def_nh;		/**< Default next hop */
+	uint64_t	*tbl8;		/**< tbl8 table. */
+	uint32_t	*tbl8_pool;	/**< Stack of the free tbl8 indexes */
+	__extension__ uint64_t	tbl24[0] __rte_cache_aligned; /**< tbl24 table */
+};
+
+static inline uint32_t
+get_tbl24_idx(const uint8_t *ip)
+{
+	return ip[0] << 16 | ip[1] << 8 | ip[2];
+}
+
+static inline uint8_t
+bits_in_nh(uint8_t nh_sz)
+{
+	return 8 * (1 << nh_sz);
+}
+
+static inline uint64_t
+get_max_nh(uint8_t nh_sz)
+{
+	return ((1ULL << (bits_in_nh(nh_sz) - 1)) - 1);
+}
+
+static inline int
+is_entry_extended(uint64_t ent)
+{
+	return (ent & TRIE_EXT_ENT) == TRIE_EXT_ENT;
+}
+
+#define LOOKUP_FUNC(suffix, type)					\
+static inline void trie_lookup_bulk_##suffix(void *p,			\
+	uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],				\
+	uint64_t *next_hops, const unsigned int n)			\
+{									\
+	struct trie_tbl *dp = (struct trie_tbl *)p;			\
+	uint64_t tmp;							\
+	uint32_t i, j;							\
+									\
+	for (i = 0; i < n; i++) {					\
+		tmp = ((type *)dp->tbl24)[get_tbl24_idx(&ips[i][0])];	\
+		j = TRIE_TBL24_BYTES;					\
+		while (is_entry_extended(tmp)) {			\
+			tmp = ((type *)dp->tbl8)[ips[i][j++] +		\
+				((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT)];	\
+		}							\
+		next_hops[i] = tmp >> 1;				\
+	}								\
+}									\
+
+LOOKUP_FUNC(2b, uint16_t)
+LOOKUP_FUNC(4b, uint32_t)
+LOOKUP_FUNC(8b, uint64_t)
+
+void *
+trie_create(const char *name, int socket_id, struct rte_fib6_conf *conf);
+
+void
+trie_free(void *p);
+
+rte_fib6_lookup_fn_t
+trie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type);
+
+int
+trie_modify(struct rte_fib6 *fib, const uint8_t ip[RTE_FIB6_IPV6_ADDR_SIZE],
+	uint8_t depth, uint64_t next_hop, int op);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TRIE_H_ */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <x86intrin.h>
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "trie.h"
+#include "trie_avx512.h"
+
+/*
+ * The bytes of the addresses are gathered from the array of addresses in 4
+ * bytes words: the word starting at the address gives the tbl24 index, and
+ * the word ending with the byte of a level gives the index of the entry in
+ * the tbl8 group, so that no word crosses the end of the array.
+ */
+
+/*
+ * Lookup of 16 addresses with 4 bytes next hops, one gather of the entries
+ * per level as long as one of the addresses gets an extended entry.
+ */
+static __rte_always_inline void
+trie_vec_lookup_x16(void *p, uint8_t ips[16][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops)
+{
+	struct trie_tbl *dp = (struct trie_tbl *)p;
+	const __m512i lsb = _mm512_set1_epi32(1);
+	const __m512i lsbyte_msk = _mm512_set1_epi32(0xff);
+	const __m512i addr_off = _mm512_set_epi32(15 * 16, 14 * 16, 13 * 16,
+		12 * 16, 11 * 16, 10 * 16, 9 * 16, 8 * 16, 7 * 16, 6 * 16,
+		5 * 16, 4 * 16, 3 * 16, 2 * 16, 1 * 16, 0);
+	__m512i words, idxes, res, bytes;
+	__mmask16 msk_ext;
+	int i;
+
+	/* the first 3 bytes in network order are the tbl24 indexes */
+	words = _mm512_i32gather_epi32(addr_off, (const void *)ips, 1);
+	idxes = _mm512_slli_epi32(_mm512_and_epi32(words, lsbyte_msk), 16);
+	bytes = _mm512_and_epi32(_mm512_srli_epi32(words, 8), lsbyte_msk);
+	idxes = _mm512_or_epi32(idxes, _mm512_slli_epi32(bytes, 8));
+	bytes = _mm512_and_epi32(_mm512_srli_epi32(words, 16), lsbyte_msk);
+	idxes = _mm512_or_epi32(idxes, bytes);
+	res = _mm512_i32gather_epi32(idxes, (const void *)dp->tbl24, 4);
+
+	msk_ext = _mm512_test_epi32_mask(res, lsb);
+	for (i = TRIE_TBL24_BYTES; (msk_ext != 0) &&
+			(i < RTE_FIB6_IPV6_ADDR_SIZE); i++) {
+		words = _mm512_i32gather_epi32(_mm512_add_epi32(addr_off,
+			_mm512_set1_epi32(i - 3)), (const void *)ips, 1);
+		bytes = _mm512_srli_epi32(words, 24);
+		idxes = _mm512_srli_epi32(res, 1);
+		idxes = _mm512_slli_epi32(idxes, 8);
+		idxes = _mm512_add_epi32(idxes, bytes);
+		res = _mm512_mask_i32gather_epi32(res, msk_ext, idxes,
+			(const void *)dp->tbl8, 4);
+		msk_ext = _mm512_test_epi32_mask(res, lsb);
+	}
+
+	res = _mm512_srli_epi32(res, 1);
+	_mm512_storeu_si512((void *)next_hops,
+		_mm512_cvtepu32_epi64(_mm512_castsi512_si256(res)));
+	_mm512_storeu_si512((void *)(next_hops + 8),
+		_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(res, 1)));
+}
+
+/*
+ * Lookup of 8 addresses with 8 bytes next hops, the tbl8 entries being
+ * gathered with 64 bits indexes.
+ */
+static __rte_always_inline void
+trie_vec_lookup_x8_8b(void *p, uint8_t ips[8][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops)
+{
+	struct trie_tbl *dp = (struct trie_tbl *)p;
+	const __m512i lsb = _mm512_set1_epi64(1);
+	const __m256i lsbyte_msk = _mm256_set1_epi32(0xff);
+	const __m256i addr_off = _mm256_set_epi32(7 * 16, 6 * 16, 5 * 16,
+		4 * 16, 3 * 16, 2 * 16, 1 * 16, 0);
+	__m512i idxes, res, bytes;
+	__m256i words, idxes_256, bytes_256;
+	__mmask8 msk_ext;
+	int i;
+
+	/* the first 3 bytes in network order are the tbl24 indexes */
+	words = _mm256_i32gather_epi32((const int *)ips, addr_off, 1);
+	idxes_256 = _mm256_slli_epi32(_mm256_and_si256(words, lsbyte_msk), 16);
+	bytes_256 = _mm256_and_si256(_mm256_srli_epi32(words, 8), lsbyte_msk);
+	bytes_256 = _mm256_slli_epi32(bytes_256, 8);
+	idxes_256 = _mm256_or_si256(idxes_256, bytes_256);
+	bytes_256 = _mm256_and_si256(_mm256_srli_epi32(words, 16), lsbyte_msk);
+	idxes_256 = _mm256_or_si256(idxes_256, bytes_256);
+	res = _mm512_i32gather_epi64(idxes_256, (const void *)dp->tbl24, 8);
+
+	msk_ext = _mm512_test_epi64_mask(res, lsb);
+	for (i = TRIE_TBL24_BYTES; (msk_ext != 0) &&
+			(i < RTE_FIB6_IPV6_ADDR_SIZE); i++) {
+		idxes_256 = _mm256_add_epi32(addr_off,
+			_mm256_set1_epi32(i - 3));
+		words = _mm256_i32gather_epi32((const int *)ips, idxes_256, 1);
+		bytes = _mm512_cvtepu32_epi64(_mm256_srli_epi32(words, 24));
+		idxes = _mm512_srli_epi64(res, 1);
+		idxes = _mm512_slli_epi64(idxes, 8);
+		idxes = _mm512_add_epi64(idxes, bytes);
+		res = _mm512_mask_i64gather_epi64(res, msk_ext, idxes,
+			(const void *)dp->tbl8, 8);
+		msk_ext = _mm512_test_epi64_mask(res, lsb);
+	}
+
+	res = _mm512_srli_epi64(res, 1);
+	_mm512_storeu_si512((void *)next_hops, res);
+}
+
+void
+rte_trie_vec_lookup_bulk_4b(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 16); i++)
+		trie_vec_lookup_x16(p, ips + i * 16, next_hops + i * 16);
+
+	trie_lookup_bulk_4b(p, ips + i * 16, next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_trie_vec_lookup_bulk_8b(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 8); i++)
+		trie_vec_lookup_x8_8b(p, ips + i * 8, next_hops + i * 8);
+
+	trie_lookup_bulk_8b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
@@ -119,6 +119,84 @@ get_alt_bucket_index(const struct rte_hash *h,
 	return (cur_bkt_idx ^ sig) & h->bucket_bitmask;
 }
 
+/*
+ * Get the key table added by a resize storing a key index, which is beyond
+ * the entries of the first key table.
+ */
+static inline const struct rte_hash_key_seg *
+get_key_seg(const struct rte_hash *h, uint32_t key_idx)
+{
+	const struct rte_hash_key_seg *seg;
+
+	seg = &h->key_segs[h->num_key_segs - 1];
+	while (key_idx < seg->first_idx)
+		seg--;
+
+	return seg;
+}
+
+static inline struct rte_hash_key *
+get_key_slot(const struct rte_hash *h, uint32_t key_idx)
+{
+	const struct rte_hash_key_seg *seg;
+
+	if (likely(key_idx < h->key_store_slots))
+		return RTE_PTR_ADD(h->key_store,
+				(uintptr_t)key_idx * h->key_entry_size);
+
+	seg = get_key_seg(h, key_idx);
+	return RTE_PTR_ADD(seg->key_store,
+			(uintptr_t)(key_idx - seg->first_idx) *
+			h->key_entry_size);
+}
+
+/* Get the ring a free key index goes back to */
+static inline struct rte_ring *
+get_free_slots_ring(const struct rte_hash *h, uint32_t key_idx)
+{
+	if (likely(key_idx < h->key_store_slots))
+		return h->free_slots;
+
+	return get_key_seg(h, key_idx)->free_slots;
+}
+
+/* Get the extendable bucket to recycle with a key index */
+static inline uint32_t *
+get_ext_bkt_to_free(const struct rte_hash *h, uint32_t key_idx)
+{
+	const struct rte_hash_key_seg *seg;
+
+	if (likely(key_idx < h->key_store_slots))
+		return &h->ext_bkt_to_free[key_idx];
+
+	seg = get_key_seg(h, key_idx);
+	return &seg->ext_bkt_to_free[key_idx - seg->first_idx];
+}
+
+/*
+ * Get the primary and secondary buckets of a hash among the buckets being
+ * migrated by a resize. Returns NULL if no resize is in progress.
+ */
+static inline struct rte_hash_bucket *
+get_old_bkts(const struct rte_hash *h, const hash_sig_t sig,
+		struct rte_hash_bucket **sec_bkt)
+{
+	const struct rte_hash_resize_state *rs = h->resize;
+	struct rte_hash_bucket *old_buckets;
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+
+	old_buckets = __atomic_load_n(&rs->old_buckets, __ATOMIC_ACQUIRE);
+	if (likely(old_buckets == NULL))
+		return NULL;
+
+	prim_bucket_idx = sig & rs->old_bucket_bitmask;
+	sec_bucket_idx = (prim_bucket_idx ^ get_short_sig(sig)) &
+			rs->old_bucket_bitmask;
+	*sec_bkt = &old_buckets[sec_bucket_idx];
+
+	return &old_buckets[prim_bucket_idx];
+}
+
 struct rte_hash *
 rte_hash_create(const struct rte_hash_parameters *params)
 {
@@ -141,6 +219,8 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	unsigned int writer_takes_lock = 0;
 	unsigned int no_free_on_del = 0;
 	uint32_t *tbl_chng_cnt = NULL;
+	uint32_t *ext_bkt_to_free = NULL;
+	struct rte_hash_resize_state *resize = NULL;
 	unsigned int readwrite_concur_lf_support = 0;
 
 	rte_hash_function default_hash_func = (rte_hash_function)rte_jhash;
@@ -170,15 +250,6 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		return NULL;
 	}
 
-	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF) &&
-	    (params->extra_flag & RTE_HASH_EXTRA_FLAGS_EXT_TABLE)) {
-		rte_errno = EINVAL;
-		RTE_LOG(ERR, HASH, "rte_hash_create: extendable bucket "
-			"feature not supported with rw concurrency "
-			"lock free\n");
-		return NULL;
-	}
-
 	/* Check extra flags field to check extra options. */
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT)
 		hw_trans_mem_support = 1;
@@ -302,6 +373,20 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		 */
 		for (i = 1; i <= num_buckets; i++)
 			rte_ring_sp_enqueue(r_ext, (void *)((uintptr_t) i));
+
+		/* The readers may still walk an extendable bucket emptied
+		 * by a delete, so that it is recycled with the key index
+		 * when the latter is not freed on delete.
+		 */
+		if (no_free_on_del) {
+			ext_bkt_to_free = rte_zmalloc(NULL, sizeof(uint32_t) *
+					num_key_slots, 0);
+			if (ext_bkt_to_free == NULL) {
+				RTE_LOG(ERR, HASH, "ext bkt to free memory "
+						"allocation failed\n");
+				goto err_unlock;
+			}
+		}
 	}
 
 	const uint32_t key_entry_size =
@@ -325,6 +410,14 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		goto err_unlock;
 	}
 
+	resize = rte_zmalloc_socket(NULL, sizeof(struct rte_hash_resize_state),
+			RTE_CACHE_LINE_SIZE, params->socket_id);
+
+	if (resize == NULL) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		goto err_unlock;
+	}
+
 /*
  * If x86 architecture is used, select appropriate compare function,
  * which may use x86 intrinsics, otherwise use memcmp
@@ -389,12 +482,17 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->buckets = buckets;
 	h->buckets_ext = buckets_ext;
 	h->free_ext_bkts = r_ext;
+	h->num_ext_buckets = ext_table_support ? num_buckets : 0;
+	h->ext_bkt_to_free = ext_bkt_to_free;
 	h->hash_func = (params->hash_func == NULL) ?
 		default_hash_func : params->hash_func;
 	h->key_store = k;
+	h->key_store_slots = num_key_slots;
 	h->free_slots = r;
 	h->tbl_chng_cnt = tbl_chng_cnt;
 	*h->tbl_chng_cnt = 0;
+	h->resize = resize;
+	h->socket_id = params->socket_id;
 	h->hw_trans_mem_support = hw_trans_mem_support;
 	h->use_local_cache = use_local_cache;
 	h->readwrite_concur_support = readwrite_concur_support;
@@ -443,6 +541,8 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	rte_free(buckets_ext);
 	rte_free(k);
 	rte_free(tbl_chng_cnt);
+	rte_free(ext_bkt_to_free);
+	rte_free(resize);
 	return NULL;
 }
 
@@ -451,6 +551,7 @@ rte_hash_free(struct rte_hash *h)
 {
 	struct rte_tailq_entry *te;
 	struct rte_hash_list *hash_list;
+	uint32_t i;
 
 	if (h == NULL)
 		return;
@@ -474,6 +575,9 @@ rte_hash_free(struct rte_hash *h)
 
 	rte_rwlock_write_unlock(RTE_EAL_TAILQ_RWLOCK);
 
+	if (h->dq)
+		rte_rcu_qsbr_dq_delete(h->dq);
+	rte_free(h->hash_rcu_cfg);
 	if (h->use_local_cache)
 		rte_free(h->local_free_slots);
 	if (h->writer_takes_lock)
@@ -481,8 +585,17 @@ rte_hash_free(struct rte_hash *h)
 	rte_ring_free(h->free_slots);
 	rte_ring_free(h->free_ext_bkts);
 	rte_free(h->key_store);
+	for (i = 0; i < h->num_key_segs; i++) {
+		rte_ring_free(h->key_segs[i].free_slots);
+		rte_free(h->key_segs[i].key_store);
+		rte_free(h->key_segs[i].ext_bkt_to_free);
+	}
 	rte_free(h->buckets);
 	rte_free(h->buckets_ext);
+	rte_free(h->ext_bkt_to_free);
+	rte_free(h->resize->old_buckets);
+	rte_free(h->resize->retired_buckets);
+	rte_free(h->resize);
 	rte_free(h->tbl_chng_cnt);
 	rte_free(h);
 	rte_free(te);
@@ -498,24 +611,26 @@ rte_hash_hash(const struct rte_hash *h, const void *key)
 int32_t
 rte_hash_count(const struct rte_hash *h)
 {
-	uint32_t tot_ring_cnt, cached_cnt = 0;
+	uint32_t tot_ring_cnt, free_cnt, cached_cnt = 0;
 	uint32_t i, ret;
 
 	if (h == NULL)
 		return -EINVAL;
 
+	/* Entry zero of the first key table is not enqueued */
+	tot_ring_cnt = h->key_store_slots - 1;
+	free_cnt = rte_ring_count(h->free_slots);
+	for (i = 0; i < h->num_key_segs; i++) {
+		tot_ring_cnt += h->key_segs[i].num_slots;
+		free_cnt += rte_ring_count(h->key_segs[i].free_slots);
+	}
+
 	if (h->use_local_cache) {
-		tot_ring_cnt = h->entries + (RTE_MAX_LCORE - 1) *
-					(LCORE_CACHE_SIZE - 1);
 		for (i = 0; i < RTE_MAX_LCORE; i++)
 			cached_cnt += h->local_free_slots[i].len;
-
-		ret = tot_ring_cnt - rte_ring_count(h->free_slots) -
-								cached_cnt;
-	} else {
-		tot_ring_cnt = h->entries;
-		ret = tot_ring_cnt - rte_ring_count(h->free_slots);
 	}
+
+	ret = tot_ring_cnt - free_cnt - cached_cnt;
 	return ret;
 }
 
@@ -559,15 +674,30 @@ __hash_rw_reader_unlock(const struct rte_hash *h)
 void
 rte_hash_reset(struct rte_hash *h)
 {
+	struct rte_hash_key_seg *seg;
 	void *ptr;
-	uint32_t tot_ring_cnt, i;
+	uint32_t i, j;
 
 	if (h == NULL)
 		return;
 
+	/* Wait for the readers of the deleted entries */
+	if (h->hash_rcu_cfg)
+		rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
+					 RTE_QSBR_THRID_INVALID);
+
 	__hash_rw_writer_lock(h);
+	/* Flush the defer queue before the free rings are refilled */
+	if (h->dq)
+		rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, NULL, NULL);
+
+	/* Drop the buckets of a resize, the table keeps its new size */
+	rte_free(h->resize->old_buckets);
+	rte_free(h->resize->retired_buckets);
+	memset(h->resize, 0, sizeof(struct rte_hash_resize_state));
+
 	memset(h->buckets, 0, h->num_buckets * sizeof(struct rte_hash_bucket));
-	memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
+	memset(h->key_store, 0, h->key_entry_size * h->key_store_slots);
 	*h->tbl_chng_cnt = 0;
 
 	/* clear the free ring */
@@ -576,25 +706,36 @@ rte_hash_reset(struct rte_hash *h)
 
 	/* clear free extendable bucket ring and memory */
 	if (h->ext_table_support) {
-		memset(h->buckets_ext, 0, h->num_buckets *
+		memset(h->buckets_ext, 0, h->num_ext_buckets *
 						sizeof(struct rte_hash_bucket));
 		while (rte_ring_dequeue(h->free_ext_bkts, &ptr) == 0)
 			continue;
+		if (h->ext_bkt_to_free)
+			memset(h->ext_bkt_to_free, 0, sizeof(uint32_t) *
+						h->key_store_slots);
 	}
 
 	/* Repopulate the free slots ring. Entry zero is reserved for key misses */
-	if (h->use_local_cache)
-		tot_ring_cnt = h->entries + (RTE_MAX_LCORE - 1) *
-					(LCORE_CACHE_SIZE - 1);
-	else
-		tot_ring_cnt = h->entries;
-
-	for (i = 1; i < tot_ring_cnt + 1; i++)
+	for (i = 1; i < h->key_store_slots; i++)
 		rte_ring_sp_enqueue(h->free_slots, (void *)((uintptr_t) i));
 
+	/* Repopulate the key tables added by the resizes */
+	for (i = 0; i < h->num_key_segs; i++) {
+		seg = &h->key_segs[i];
+		memset(seg->key_store, 0, h->key_entry_size * seg->num_slots);
+		while (rte_ring_dequeue(seg->free_slots, &ptr) == 0)
+			continue;
+		for (j = 0; j < seg->num_slots; j++)
+			rte_ring_sp_enqueue(seg->free_slots,
+				(void *)((uintptr_t)(seg->first_idx + j)));
+		if (seg->ext_bkt_to_free)
+			memset(seg->ext_bkt_to_free, 0, sizeof(uint32_t) *
+						seg->num_slots);
+	}
+
 	/* Repopulate the free ext bkt ring. */
 	if (h->ext_table_support) {
-		for (i = 1; i <= h->num_buckets; i++)
+		for (i = 1; i <= h->num_ext_buckets; i++)
 			rte_ring_sp_enqueue(h->free_ext_bkts,
 						(void *)((uintptr_t) i));
 	}
@@ -607,6 +748,77 @@ rte_hash_reset(struct rte_hash *h)
 	__hash_rw_writer_unlock(h);
 }
 
+/*
+ * Function called to get a free index from the cache/ring.
+ * EMPTY_SLOT is returned if no index is available.
+ */
+static inline void *
+alloc_slot(const struct rte_hash *h, struct lcore_cache *cached_free_slots)
+{
+	unsigned int n_slots;
+	uint32_t i;
+	void *slot_id;
+
+	if (h->use_local_cache) {
+		/* Try to get a free slot from the local cache */
+		if (cached_free_slots->len == 0) {
+			/* Need to get another burst of free slots from global ring */
+			n_slots = rte_ring_mc_dequeue_burst(h->free_slots,
+					cached_free_slots->objs,
+					LCORE_CACHE_SIZE, NULL);
+			/* Then from the key tables added by the resizes */
+			for (i = 0; n_slots == 0 && i < h->num_key_segs; i++)
+				n_slots = rte_ring_mc_dequeue_burst(
+					h->key_segs[i].free_slots,
+					cached_free_slots->objs,
+					LCORE_CACHE_SIZE, NULL);
+			if (n_slots == 0)
+				return (void *)((uintptr_t)EMPTY_SLOT);
+
+			cached_free_slots->len += n_slots;
+		}
+
+		/* Get a free slot from the local cache */
+		cached_free_slots->len--;
+		slot_id = cached_free_slots->objs[cached_free_slots->len];
+	} else {
+		if (rte_ring_sc_dequeue(h->free_slots, &slot_id) == 0)
+			return slot_id;
+		for (i = 0; i < h->num_key_segs; i++)
+			if (rte_ring_sc_dequeue(h->key_segs[i].free_slots,
+					&slot_id) == 0)
+				return slot_id;
+		return (void *)((uintptr_t)EMPTY_SLOT);
+	}
+
+	return slot_id;
+}
+
+/*
+ * Function called to give the free indexes of a full local cache back to
+ * the ring of their key table. Returns the number of indexes given back.
+ */
+static inline unsigned int
+flush_cache_slots(const struct rte_hash *h,
+		struct lcore_cache *cached_free_slots)
+{
+	uint32_t key_idx;
+	unsigned int i;
+
+	if (likely(h->num_key_segs == 0))
+		return rte_ring_mp_enqueue_burst(h->free_slots,
+				cached_free_slots->objs,
+				LCORE_CACHE_SIZE, NULL);
+
+	for (i = 0; i < LCORE_CACHE_SIZE; i++) {
+		key_idx = (uint32_t)((uintptr_t)cached_free_slots->objs[i]);
+		rte_ring_mp_enqueue(get_free_slots_ring(h, key_idx),
+				cached_free_slots->objs[i]);
+	}
+
+	return LCORE_CACHE_SIZE;
+}
+
 /*
  * Function called to enqueue back an index in the cache/ring,
  * as slot has not being used and it can be used in the
@@ -618,10 +830,43 @@ enqueue_slot_back(const struct rte_hash *h,
 		void *slot_id)
 {
 	if (h->use_local_cache) {
+		/* The bulk adds may give back more slots than the cache holds */
+		if (cached_free_slots->len == LCORE_CACHE_SIZE) {
+			rte_ring_mp_enqueue(get_free_slots_ring(h,
+					(uint32_t)((uintptr_t)slot_id)),
+					slot_id);
+			return;
+		}
 		cached_free_slots->objs[cached_free_slots->len] = slot_id;
 		cached_free_slots->len++;
 	} else
-		rte_ring_sp_enqueue(h->free_slots, slot_id);
+		rte_ring_sp_enqueue(get_free_slots_ring(h,
+				(uint32_t)((uintptr_t)slot_id)), slot_id);
+}
+
+/*
+ * Function called to get a free index for a new key. If none is left, the
+ * slots of the deleted keys no longer in use by the readers are reclaimed
+ * first. EMPTY_SLOT is returned if no index is available.
+ */
+static inline void *
+alloc_slot_reclaim(const struct rte_hash *h,
+		struct lcore_cache *cached_free_slots)
+{
+	void *slot_id;
+
+	slot_id = alloc_slot(h, cached_free_slots);
+	if (slot_id == (void *)((uintptr_t)EMPTY_SLOT) && h->dq != NULL) {
+		/* Free the slots of the deleted keys no longer in use */
+		__hash_rw_writer_lock(h);
+		rte_rcu_qsbr_dq_reclaim(h->dq,
+				h->hash_rcu_cfg->max_reclaim_size,
+				NULL, NULL, NULL);
+		__hash_rw_writer_unlock(h);
+		slot_id = alloc_slot(h, cached_free_slots);
+	}
+
+	return slot_id;
 }
 
 /* Search a key from bucket and update its data.
@@ -632,12 +877,11 @@ search_and_update(const struct rte_hash *h, void *data, const void *key,
 	struct rte_hash_bucket *bkt, uint16_t sig)
 {
 	int i;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		if (bkt->sig_current[i] == sig) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					bkt->key_idx[i] * h->key_entry_size);
+			k = get_key_slot(h, bkt->key_idx[i]);
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				/* 'pdata' acts as the synchronization point
 				 * when an existing hash entry is updated.
@@ -724,51 +968,18 @@ rte_hash_cuckoo_insert_mw(const struct rte_hash *h,
 
 /* Shift buckets along provided cuckoo_path (@leaf and @leaf_slot) and fill
  * the path head with new entry (sig, alt_hash, new_idx)
- * return 1 if matched key found, return -1 if cuckoo path invalided and fail,
- * return 0 if succeeds.
+ * return -1 if cuckoo path invalided and fail, return 0 if succeeds.
+ * Writer holds the lock before calling this.
  */
 static inline int
-rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
-			struct rte_hash_bucket *bkt,
-			struct rte_hash_bucket *alt_bkt,
-			const struct rte_hash_key *key, void *data,
+rte_hash_cuckoo_move_path(const struct rte_hash *h,
 			struct queue_node *leaf, uint32_t leaf_slot,
-			uint16_t sig, uint32_t new_idx,
-			int32_t *ret_val)
+			uint16_t sig, uint32_t new_idx)
 {
 	uint32_t prev_alt_bkt_idx;
-	struct rte_hash_bucket *cur_bkt;
 	struct queue_node *prev_node, *curr_node = leaf;
 	struct rte_hash_bucket *prev_bkt, *curr_bkt = leaf->bkt;
 	uint32_t prev_slot, curr_slot = leaf_slot;
-	int32_t ret;
-
-	__hash_rw_writer_lock(h);
-
-	/* In case empty slot was gone before entering protected region */
-	if (curr_bkt->key_idx[curr_slot] != EMPTY_SLOT) {
-		__hash_rw_writer_unlock(h);
-		return -1;
-	}
-
-	/* Check if key was inserted after last check but before this
-	 * protected region.
-	 */
-	ret = search_and_update(h, data, key, bkt, sig);
-	if (ret != -1) {
-		__hash_rw_writer_unlock(h);
-		*ret_val = ret;
-		return 1;
-	}
-
-	FOR_EACH_BUCKET(cur_bkt, alt_bkt) {
-		ret = search_and_update(h, data, key, cur_bkt, sig);
-		if (ret != -1) {
-			__hash_rw_writer_unlock(h);
-			*ret_val = ret;
-			return 1;
-		}
-	}
 
 	while (likely(curr_node->prev != NULL)) {
 		prev_node = curr_node->prev;
@@ -785,7 +996,6 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 			__atomic_store_n(&curr_bkt->key_idx[curr_slot],
 				EMPTY_SLOT,
 				__ATOMIC_RELEASE);
-			__hash_rw_writer_unlock(h);
 			return -1;
 		}
 
@@ -843,15 +1053,70 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 			 new_idx,
 			 __ATOMIC_RELEASE);
 
-	__hash_rw_writer_unlock(h);
-
 	return 0;
+}
+
+/* Shift buckets along provided cuckoo_path (@leaf and @leaf_slot) and fill
+ * the path head with new entry (sig, alt_hash, new_idx)
+ * return 1 if matched key found, return -1 if cuckoo path invalided and fail,
+ * return 0 if succeeds.
+ * The entries migrated by a resize, with a NULL key, are moved with the lock
+ * held, as they cannot be in the new buckets yet.
+ */
+static inline int
+rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
+			struct rte_hash_bucket *bkt,
+			struct rte_hash_bucket *alt_bkt,
+			const struct rte_hash_key *key, void *data,
+			struct queue_node *leaf, uint32_t leaf_slot,
+			uint16_t sig, uint32_t new_idx,
+			int32_t *ret_val)
+{
+	struct rte_hash_bucket *cur_bkt;
+	struct rte_hash_bucket *curr_bkt = leaf->bkt;
+	int32_t ret;
+
+	if (key == NULL)
+		return rte_hash_cuckoo_move_path(h, leaf, leaf_slot, sig,
+						new_idx);
+
+	__hash_rw_writer_lock(h);
+
+	/* In case empty slot was gone before entering protected region */
+	if (curr_bkt->key_idx[leaf_slot] != EMPTY_SLOT) {
+		__hash_rw_writer_unlock(h);
+		return -1;
+	}
+
+	/* Check if key was inserted after last check but before this
+	 * protected region.
+	 */
+	ret = search_and_update(h, data, key, bkt, sig);
+	if (ret != -1) {
+		__hash_rw_writer_unlock(h);
+		*ret_val = ret;
+		return 1;
+	}
+
+	FOR_EACH_BUCKET(cur_bkt, alt_bkt) {
+		ret = search_and_update(h, data, key, cur_bkt, sig);
+		if (ret != -1) {
+			__hash_rw_writer_unlock(h);
+			*ret_val = ret;
+			return 1;
+		}
+	}
+
+	ret = rte_hash_cuckoo_move_path(h, leaf, leaf_slot, sig, new_idx);
+
+	__hash_rw_writer_unlock(h);
 
+	return ret;
 }
 
 /*
  * Make space for new key, using bfs Cuckoo Search and Multi-Writer safe
- * Cuckoo
+ * Cuckoo. A NULL key moves in an entry migrated by a resize.
  */
 static inline int
 rte_hash_cuckoo_make_space_mw(const struct rte_hash *h,
@@ -906,91 +1171,127 @@ rte_hash_cuckoo_make_space_mw(const struct rte_hash *h,
 	return -ENOSPC;
 }
 
+/* Search a key from its primary bucket and its secondary bucket chain and
+ * update its data.
+ * Writer holds the lock before calling this.
+ */
 static inline int32_t
-__rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
-						hash_sig_t sig, void *data)
+search_and_update_bkts(const struct rte_hash *h, void *data, const void *key,
+	struct rte_hash_bucket *prim_bkt, struct rte_hash_bucket *sec_bkt,
+	uint16_t sig)
 {
-	uint16_t short_sig;
-	uint32_t prim_bucket_idx, sec_bucket_idx;
-	struct rte_hash_bucket *prim_bkt, *sec_bkt, *cur_bkt;
-	struct rte_hash_key *new_k, *keys = h->key_store;
-	void *slot_id = NULL;
-	void *ext_bkt_id = NULL;
-	uint32_t new_idx, bkt_id;
-	int ret;
-	unsigned n_slots;
-	unsigned lcore_id;
-	unsigned int i;
-	struct lcore_cache *cached_free_slots = NULL;
-	int32_t ret_val;
-	struct rte_hash_bucket *last;
-
-	short_sig = get_short_sig(sig);
-	prim_bucket_idx = get_prim_bucket_index(h, sig);
-	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
-	prim_bkt = &h->buckets[prim_bucket_idx];
-	sec_bkt = &h->buckets[sec_bucket_idx];
-	rte_prefetch0(prim_bkt);
-	rte_prefetch0(sec_bkt);
+	struct rte_hash_bucket *cur_bkt;
+	int32_t ret;
 
 	/* Check if key is already inserted in primary location */
-	__hash_rw_writer_lock(h);
-	ret = search_and_update(h, data, key, prim_bkt, short_sig);
-	if (ret != -1) {
-		__hash_rw_writer_unlock(h);
+	ret = search_and_update(h, data, key, prim_bkt, sig);
+	if (ret != -1)
 		return ret;
-	}
 
 	/* Check if key is already inserted in secondary location */
 	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
-		ret = search_and_update(h, data, key, cur_bkt, short_sig);
-		if (ret != -1) {
-			__hash_rw_writer_unlock(h);
+		ret = search_and_update(h, data, key, cur_bkt, sig);
+		if (ret != -1)
 			return ret;
-		}
 	}
 
-	__hash_rw_writer_unlock(h);
+	return -1;
+}
 
-	/* Did not find a match, so get a new slot for storing the new key */
-	if (h->use_local_cache) {
-		lcore_id = rte_lcore_id();
-		cached_free_slots = &h->local_free_slots[lcore_id];
-		/* Try to get a free slot from the local cache */
-		if (cached_free_slots->len == 0) {
-			/* Need to get another burst of free slots from global ring */
-			n_slots = rte_ring_mc_dequeue_burst(h->free_slots,
-					cached_free_slots->objs,
-					LCORE_CACHE_SIZE, NULL);
-			if (n_slots == 0) {
-				return -ENOSPC;
-			}
+/* Search a key among the buckets being migrated by a resize and update its
+ * data.
+ * Writer holds the lock before calling this.
+ */
+static inline int32_t
+search_and_update_old(const struct rte_hash *h, void *data, const void *key,
+	hash_sig_t sig)
+{
+	struct rte_hash_bucket *prim_bkt, *sec_bkt;
 
-			cached_free_slots->len += n_slots;
-		}
+	prim_bkt = get_old_bkts(h, sig, &sec_bkt);
+	if (likely(prim_bkt == NULL))
+		return -1;
 
-		/* Get a free slot from the local cache */
-		cached_free_slots->len--;
-		slot_id = cached_free_slots->objs[cached_free_slots->len];
-	} else {
-		if (rte_ring_sc_dequeue(h->free_slots, &slot_id) != 0) {
-			return -ENOSPC;
-		}
+	return search_and_update_bkts(h, data, key, prim_bkt, sec_bkt,
+				get_short_sig(sig));
+}
+
+/*
+ * Insert a key index in the first empty entry of the secondary bucket and
+ * its extendable buckets, linking a new extendable bucket to the chain if
+ * they are all full. Returns -ENOSPC if no extendable bucket is left.
+ * Writer holds the lock before calling this.
+ */
+static inline int
+__rte_hash_insert_ext(const struct rte_hash *h,
+		struct rte_hash_bucket *sec_bkt, uint16_t sig,
+		uint32_t new_idx)
+{
+	struct rte_hash_bucket *cur_bkt, *last;
+	void *ext_bkt_id = NULL;
+	uint32_t bkt_id;
+	unsigned int i;
+
+	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
+		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+			/* Check if slot is available */
+			if (likely(cur_bkt->key_idx[i] == EMPTY_SLOT)) {
+				cur_bkt->sig_current[i] = sig;
+				/* Store to signature should not leak after
+				 * the store to key_idx
+				 */
+				__atomic_store_n(&cur_bkt->key_idx[i],
+						 new_idx,
+						 __ATOMIC_RELEASE);
+				return 0;
+			}
+		}
 	}
 
-	new_k = RTE_PTR_ADD(keys, (uintptr_t)slot_id * h->key_entry_size);
-	new_idx = (uint32_t)((uintptr_t) slot_id);
-	/* Copy key */
-	memcpy(new_k->key, key, h->key_len);
-	/* Key can be of arbitrary length, so it is not possible to store
-	 * it atomically. Hence the new key element's memory stores
-	 * (key as well as data) should be complete before it is referenced.
-	 * 'pdata' acts as the synchronization point when an existing hash
-	 * entry is updated.
+	/* Failed to get an empty entry from extendable buckets. Link a new
+	 * extendable bucket. We first get a free bucket from ring.
 	 */
-	__atomic_store_n(&new_k->pdata,
-		data,
-		__ATOMIC_RELEASE);
+	if (rte_ring_sc_dequeue(h->free_ext_bkts, &ext_bkt_id) != 0)
+		return -ENOSPC;
+
+	bkt_id = (uint32_t)((uintptr_t)ext_bkt_id) - 1;
+	/* Use the first location of the new bucket */
+	(h->buckets_ext[bkt_id]).sig_current[0] = sig;
+	/* Store to signature should not leak after
+	 * the store to key_idx
+	 */
+	__atomic_store_n(&(h->buckets_ext[bkt_id]).key_idx[0],
+			 new_idx,
+			 __ATOMIC_RELEASE);
+	/* Link the new bucket to sec bucket linked list */
+	last = rte_hash_get_last_bkt(sec_bkt);
+	/* The new bucket is complete before the readers can reach it */
+	__atomic_store_n(&last->next, &h->buckets_ext[bkt_id],
+			 __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/*
+ * Insert a new key, whose key and data are already stored in the key slot
+ * 'slot_id', in its primary or secondary bucket. Keys are moved around or an
+ * extendable bucket is linked if both are full. The slot is given back if
+ * the key was inserted meanwhile or if there is no space left.
+ */
+static inline int32_t
+__rte_hash_add_key_slot(const struct rte_hash *h, const void *key,
+		uint16_t short_sig, uint32_t prim_bucket_idx,
+		uint32_t sec_bucket_idx, void *data, void *slot_id,
+		struct lcore_cache *cached_free_slots)
+{
+	struct rte_hash_bucket *prim_bkt, *sec_bkt;
+	uint32_t new_idx;
+	int ret;
+	int32_t ret_val;
+
+	prim_bkt = &h->buckets[prim_bucket_idx];
+	sec_bkt = &h->buckets[sec_bucket_idx];
+	new_idx = (uint32_t)((uintptr_t) slot_id);
 
 	/* Find an empty slot and insert */
 	ret = rte_hash_cuckoo_insert_mw(h, prim_bkt, sec_bkt, key, data,
@@ -1034,55 +1335,274 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	 */
 	__hash_rw_writer_lock(h);
 	/* We check for duplicates again since could be inserted before the lock */
-	ret = search_and_update(h, data, key, prim_bkt, short_sig);
+	ret = search_and_update_bkts(h, data, key, prim_bkt, sec_bkt,
+				short_sig);
 	if (ret != -1) {
 		enqueue_slot_back(h, cached_free_slots, slot_id);
 		goto failure;
 	}
 
-	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
-		ret = search_and_update(h, data, key, cur_bkt, short_sig);
-		if (ret != -1) {
-			enqueue_slot_back(h, cached_free_slots, slot_id);
-			goto failure;
+	/* Search sec and ext buckets to find an empty entry to insert. */
+	ret = __rte_hash_insert_ext(h, sec_bkt, short_sig, new_idx);
+	if (ret != 0) {
+		enqueue_slot_back(h, cached_free_slots, slot_id);
+		goto failure;
+	}
+	__hash_rw_writer_unlock(h);
+	return new_idx - 1;
+
+failure:
+	__hash_rw_writer_unlock(h);
+	return ret;
+
+}
+
+/*
+ * Insert an entry migrated by a resize in the new buckets, moving the entries
+ * around or linking an extendable bucket if both buckets are full.
+ * Writer holds the lock before calling this.
+ */
+static inline int
+__rte_hash_resize_insert(const struct rte_hash *h, hash_sig_t sig,
+		uint32_t key_idx)
+{
+	struct rte_hash_bucket *prim_bkt, *sec_bkt;
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	uint16_t short_sig;
+	int32_t ret_val;
+	unsigned int i;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
+	prim_bkt = &h->buckets[prim_bucket_idx];
+	sec_bkt = &h->buckets[sec_bucket_idx];
+
+	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+		if (prim_bkt->key_idx[i] == EMPTY_SLOT) {
+			prim_bkt->sig_current[i] = short_sig;
+			__atomic_store_n(&prim_bkt->key_idx[i], key_idx,
+					 __ATOMIC_RELEASE);
+			return 0;
 		}
 	}
 
-	/* Search sec and ext buckets to find an empty entry to insert. */
-	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
+	if (rte_hash_cuckoo_make_space_mw(h, prim_bkt, sec_bkt, NULL, NULL,
+			short_sig, prim_bucket_idx, key_idx, &ret_val) == 0)
+		return 0;
+
+	if (rte_hash_cuckoo_make_space_mw(h, sec_bkt, prim_bkt, NULL, NULL,
+			short_sig, sec_bucket_idx, key_idx, &ret_val) == 0)
+		return 0;
+
+	if (!h->ext_table_support)
+		return -ENOSPC;
+
+	return __rte_hash_insert_ext(h, sec_bkt, short_sig, key_idx);
+}
+
+/*
+ * Migrate the entries of an old bucket and of its extendable buckets to the
+ * new buckets, rehashing their keys. An entry is removed from the old bucket
+ * once it is in the new ones.
+ * Writer holds the lock before calling this.
+ */
+static inline int
+__rte_hash_resize_move_bkt(const struct rte_hash *h,
+		struct rte_hash_bucket *old_bkt)
+{
+	struct rte_hash_bucket *cur_bkt;
+	struct rte_hash_key *k;
+	uint32_t key_idx;
+	unsigned int i;
+	int ret;
+
+	FOR_EACH_BUCKET(cur_bkt, old_bkt) {
 		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
-			/* Check if slot is available */
-			if (likely(cur_bkt->key_idx[i] == EMPTY_SLOT)) {
-				cur_bkt->sig_current[i] = short_sig;
-				cur_bkt->key_idx[i] = new_idx;
-				__hash_rw_writer_unlock(h);
-				return new_idx - 1;
+			key_idx = cur_bkt->key_idx[i];
+			if (key_idx == EMPTY_SLOT)
+				continue;
+
+			k = get_key_slot(h, key_idx);
+			ret = __rte_hash_resize_insert(h,
+					rte_hash_hash(h, k->key), key_idx);
+			if (ret != 0)
+				return ret;
+
+			if (h->readwrite_concur_lf_support) {
+				/* Inform the readers that the entry left the
+				 * old bucket. Since there is one writer, load
+				 * acquire on tbl_chng_cnt is not required.
+				 */
+				__atomic_store_n(h->tbl_chng_cnt,
+						 *h->tbl_chng_cnt + 1,
+						 __ATOMIC_RELEASE);
+				/* The store to sig_current should not
+				 * move above the store to tbl_chng_cnt.
+				 */
+				__atomic_thread_fence(__ATOMIC_RELEASE);
 			}
+			cur_bkt->sig_current[i] = NULL_SIGNATURE;
+			__atomic_store_n(&cur_bkt->key_idx[i], EMPTY_SLOT,
+					 __ATOMIC_RELEASE);
 		}
 	}
 
-	/* Failed to get an empty entry from extendable buckets. Link a new
-	 * extendable bucket. We first get a free bucket from ring.
-	 */
-	if (rte_ring_sc_dequeue(h->free_ext_bkts, &ext_bkt_id) != 0) {
-		ret = -ENOSPC;
-		goto failure;
+	return 0;
+}
+
+/*
+ * Free the old buckets of a finished resize once the readers are done with
+ * them, recycling their extendable buckets. Returns 1 if the readers may
+ * still use them.
+ * Writer holds the lock before calling this.
+ */
+static int
+__rte_hash_resize_retire(const struct rte_hash *h, bool wait)
+{
+	struct rte_hash_resize_state *rs = h->resize;
+	struct rte_hash_bucket *bkt, *next_bkt;
+	uint32_t i;
+
+	if (rs->retired_buckets == NULL)
+		return 0;
+
+	if (h->readwrite_concur_lf_support &&
+			rte_rcu_qsbr_check(h->hash_rcu_cfg->v,
+				rs->retired_token, wait) == 0)
+		return 1;
+
+	/* The extendable buckets left are empty */
+	for (i = 0; i < rs->retired_num_buckets; i++) {
+		for (bkt = rs->retired_buckets[i].next; bkt != NULL;
+				bkt = next_bkt) {
+			next_bkt = bkt->next;
+			bkt->next = NULL;
+			rte_ring_sp_enqueue(h->free_ext_bkts,
+				(void *)(uintptr_t)(bkt - h->buckets_ext + 1));
+		}
 	}
 
-	bkt_id = (uint32_t)((uintptr_t)ext_bkt_id) - 1;
-	/* Use the first location of the new bucket */
-	(h->buckets_ext[bkt_id]).sig_current[0] = short_sig;
-	(h->buckets_ext[bkt_id]).key_idx[0] = new_idx;
-	/* Link the new bucket to sec bucket linked list */
-	last = rte_hash_get_last_bkt(sec_bkt);
-	last->next = &h->buckets_ext[bkt_id];
-	__hash_rw_writer_unlock(h);
-	return new_idx - 1;
+	rte_free(rs->retired_buckets);
+	rs->retired_buckets = NULL;
+	rs->retired_num_buckets = 0;
 
-failure:
+	return 0;
+}
+
+/*
+ * Migrate up to max_buckets old buckets of a resize, retiring the old
+ * buckets once they are all migrated. Returns the number of old buckets
+ * left to migrate.
+ * Writer holds the lock before calling this.
+ */
+static int
+__rte_hash_resize_step(const struct rte_hash *h, uint32_t max_buckets)
+{
+	struct rte_hash_resize_state *rs = h->resize;
+	uint32_t n;
+	int ret;
+
+	if (rs->old_buckets == NULL) {
+		__rte_hash_resize_retire(h, false);
+		return 0;
+	}
+
+	for (n = 0; n < max_buckets && rs->next_bucket < rs->old_num_buckets;
+			n++) {
+		ret = __rte_hash_resize_move_bkt(h,
+				&rs->old_buckets[rs->next_bucket]);
+		if (ret != 0)
+			return ret;
+		rs->next_bucket++;
+	}
+
+	if (rs->next_bucket < rs->old_num_buckets)
+		return rs->old_num_buckets - rs->next_bucket;
+
+	/* The readers stop searching the old buckets, which are freed at
+	 * the end of their grace period.
+	 */
+	rs->retired_buckets = rs->old_buckets;
+	rs->retired_num_buckets = rs->old_num_buckets;
+	__atomic_store_n(&rs->old_buckets, NULL, __ATOMIC_RELEASE);
+	if (h->readwrite_concur_lf_support)
+		rs->retired_token = rte_rcu_qsbr_start(h->hash_rcu_cfg->v);
+	__rte_hash_resize_retire(h, false);
+
+	return 0;
+}
+
+/*
+ * Migrate a few old buckets of a resize in progress, bounding the extra
+ * cost of an add or a delete.
+ * Writer holds the lock before calling this.
+ */
+static inline void
+__rte_hash_resize_auto_step(const struct rte_hash *h)
+{
+	if (unlikely(h->resize->old_buckets != NULL ||
+			h->resize->retired_buckets != NULL))
+		__rte_hash_resize_step(h, RTE_HASH_RESIZE_STEP_BUCKETS);
+}
+
+static inline int32_t
+__rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
+						hash_sig_t sig, void *data)
+{
+	uint16_t short_sig;
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	struct rte_hash_bucket *prim_bkt, *sec_bkt;
+	struct rte_hash_key *new_k;
+	void *slot_id = NULL;
+	int ret;
+	unsigned lcore_id;
+	struct lcore_cache *cached_free_slots = NULL;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
+	prim_bkt = &h->buckets[prim_bucket_idx];
+	sec_bkt = &h->buckets[sec_bucket_idx];
+	rte_prefetch0(prim_bkt);
+	rte_prefetch0(sec_bkt);
+
+	/* Check if key is already inserted */
+	__hash_rw_writer_lock(h);
+	__rte_hash_resize_auto_step(h);
+	ret = search_and_update_bkts(h, data, key, prim_bkt, sec_bkt,
+				short_sig);
+	if (ret == -1)
+		ret = search_and_update_old(h, data, key, sig);
 	__hash_rw_writer_unlock(h);
-	return ret;
+	if (ret != -1)
+		return ret;
+
+	/* Did not find a match, so get a new slot for storing the new key */
+	if (h->use_local_cache) {
+		lcore_id = rte_lcore_id();
+		cached_free_slots = &h->local_free_slots[lcore_id];
+	}
+	slot_id = alloc_slot_reclaim(h, cached_free_slots);
+	if (slot_id == (void *)((uintptr_t)EMPTY_SLOT))
+		return -ENOSPC;
+
+	new_k = get_key_slot(h, (uintptr_t)slot_id);
+	/* Copy key */
+	memcpy(new_k->key, key, h->key_len);
+	/* Key can be of arbitrary length, so it is not possible to store
+	 * it atomically. Hence the new key element's memory stores
+	 * (key as well as data) should be complete before it is referenced.
+	 * 'pdata' acts as the synchronization point when an existing hash
+	 * entry is updated.
+	 */
+	__atomic_store_n(&new_k->pdata,
+		data,
+		__ATOMIC_RELEASE);
 
+	return __rte_hash_add_key_slot(h, key, short_sig, prim_bucket_idx,
+				sec_bucket_idx, data, slot_id,
+				cached_free_slots);
 }
 
 int32_t
@@ -1135,13 +1655,12 @@ search_one_bucket_l(const struct rte_hash *h, const void *key,
 		const struct rte_hash_bucket *bkt)
 {
 	int i;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		if (bkt->sig_current[i] == sig &&
 				bkt->key_idx[i] != EMPTY_SLOT) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					bkt->key_idx[i] * h->key_entry_size);
+			k = get_key_slot(h, bkt->key_idx[i]);
 
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				if (data != NULL)
@@ -1165,14 +1684,13 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 	int i;
 	uint32_t key_idx;
 	void *pdata;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		key_idx = __atomic_load_n(&bkt->key_idx[i],
 					  __ATOMIC_ACQUIRE);
 		if (bkt->sig_current[i] == sig && key_idx != EMPTY_SLOT) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					key_idx * h->key_entry_size);
+			k = get_key_slot(h, key_idx);
 			pdata = __atomic_load_n(&k->pdata,
 					__ATOMIC_ACQUIRE);
 
@@ -1190,6 +1708,45 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 	return -1;
 }
 
+/* Search the buckets being migrated by a resize to find the match key */
+static inline int32_t
+search_old_bkts(const struct rte_hash *h, const void *key, hash_sig_t sig,
+		void **data)
+{
+	struct rte_hash_bucket *prim_bkt, *sec_bkt, *cur_bkt;
+	uint16_t short_sig;
+	int32_t ret;
+
+	prim_bkt = get_old_bkts(h, sig, &sec_bkt);
+	if (likely(prim_bkt == NULL))
+		return -1;
+
+	short_sig = get_short_sig(sig);
+	if (h->readwrite_concur_lf_support) {
+		ret = search_one_bucket_lf(h, key, short_sig, data, prim_bkt);
+		if (ret != -1)
+			return ret;
+		FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
+			ret = search_one_bucket_lf(h, key, short_sig, data,
+						cur_bkt);
+			if (ret != -1)
+				return ret;
+		}
+	} else {
+		ret = search_one_bucket_l(h, key, short_sig, data, prim_bkt);
+		if (ret != -1)
+			return ret;
+		FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
+			ret = search_one_bucket_l(h, key, short_sig, data,
+						cur_bkt);
+			if (ret != -1)
+				return ret;
+		}
+	}
+
+	return -1;
+}
+
 static inline int32_t
 __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 				hash_sig_t sig, void **data)
@@ -1200,13 +1757,15 @@ __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 	uint16_t short_sig;
 
 	short_sig = get_short_sig(sig);
+
+	/* The buckets are only switched by a resize under the writer lock */
+	__hash_rw_reader_lock(h);
+
 	prim_bucket_idx = get_prim_bucket_index(h, sig);
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
 
 	bkt = &h->buckets[prim_bucket_idx];
 
-	__hash_rw_reader_lock(h);
-
 	/* Check if key is in primary location */
 	ret = search_one_bucket_l(h, key, short_sig, data, bkt);
 	if (ret != -1) {
@@ -1226,6 +1785,13 @@ __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 		}
 	}
 
+	/* Check if key is in the buckets being migrated by a resize */
+	ret = search_old_bkts(h, key, sig, data);
+	if (ret != -1) {
+		__hash_rw_reader_unlock(h);
+		return ret;
+	}
+
 	__hash_rw_reader_unlock(h);
 
 	return -ENOENT;
@@ -1236,14 +1802,13 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 					hash_sig_t sig, void **data)
 {
 	uint32_t prim_bucket_idx, sec_bucket_idx;
-	struct rte_hash_bucket *bkt, *cur_bkt;
+	struct rte_hash_bucket *buckets, *bkt, *cur_bkt;
+	uint32_t bucket_bitmask;
 	uint32_t cnt_b, cnt_a;
 	int ret;
 	uint16_t short_sig;
 
 	short_sig = get_short_sig(sig);
-	prim_bucket_idx = get_prim_bucket_index(h, sig);
-	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
 
 	do {
 		/* Load the table change counter before the lookup
@@ -1253,15 +1818,25 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 		cnt_b = __atomic_load_n(h->tbl_chng_cnt,
 				__ATOMIC_ACQUIRE);
 
+		/* A resize stores the new buckets before their bitmask,
+		 * the index being in the buckets whichever is loaded.
+		 */
+		bucket_bitmask = __atomic_load_n(&h->bucket_bitmask,
+					__ATOMIC_ACQUIRE);
+		buckets = __atomic_load_n(&h->buckets, __ATOMIC_ACQUIRE);
+		prim_bucket_idx = sig & bucket_bitmask;
+		sec_bucket_idx = (prim_bucket_idx ^ short_sig) &
+					bucket_bitmask;
+
 		/* Check if key is in primary location */
-		bkt = &h->buckets[prim_bucket_idx];
+		bkt = &buckets[prim_bucket_idx];
 		ret = search_one_bucket_lf(h, key, short_sig, data, bkt);
 		if (ret != -1) {
 			__hash_rw_reader_unlock(h);
 			return ret;
 		}
 		/* Calculate secondary hash */
-		bkt = &h->buckets[sec_bucket_idx];
+		bkt = &buckets[sec_bucket_idx];
 
 		/* Check if key is in secondary location */
 		FOR_EACH_BUCKET(cur_bkt, bkt) {
@@ -1273,6 +1848,13 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 			}
 		}
 
+		/* Check if key is in the buckets being migrated by a
+		 * resize.
+		 */
+		ret = search_old_bkts(h, key, sig, data);
+		if (ret != -1)
+			return ret;
+
 		/* The loads of sig_current in search_one_bucket
 		 * should not move below the load from tbl_chng_cnt.
 		 */
@@ -1333,7 +1915,7 @@ rte_hash_lookup_data(const struct rte_hash *h, const void *key, void **data)
 }
 
 static inline void
-remove_entry(const struct rte_hash *h, struct rte_hash_bucket *bkt, unsigned i)
+remove_entry(const struct rte_hash *h, uint32_t key_idx)
 {
 	unsigned lcore_id, n_slots;
 	struct lcore_cache *cached_free_slots;
@@ -1344,9 +1926,7 @@ remove_entry(const struct rte_hash *h, struct rte_hash_bucket *bkt, unsigned i)
 		/* Cache full, need to free it. */
 		if (cached_free_slots->len == LCORE_CACHE_SIZE) {
 			/* Need to enqueue the free slots in global ring. */
-			n_slots = rte_ring_mp_enqueue_burst(h->free_slots,
-						cached_free_slots->objs,
-						LCORE_CACHE_SIZE, NULL);
+			n_slots = flush_cache_slots(h, cached_free_slots);
 			ERR_IF_TRUE((n_slots == 0),
 				"%s: could not enqueue free slots in global ring\n",
 				__func__);
@@ -1354,19 +1934,69 @@ remove_entry(const struct rte_hash *h, struct rte_hash_bucket *bkt, unsigned i)
 		}
 		/* Put index of new free slot in cache. */
 		cached_free_slots->objs[cached_free_slots->len] =
-				(void *)((uintptr_t)bkt->key_idx[i]);
+				(void *)((uintptr_t)key_idx);
 		cached_free_slots->len++;
 	} else {
-		rte_ring_sp_enqueue(h->free_slots,
-				(void *)((uintptr_t)bkt->key_idx[i]));
+		rte_ring_sp_enqueue(get_free_slots_ring(h, key_idx),
+				(void *)((uintptr_t)key_idx));
+	}
+}
+
+/*
+ * Free the resources of deleted entries, once the readers are done with
+ * them. Writer is expected to hold the lock while calling this function.
+ */
+static void
+__hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n)
+{
+	struct rte_hash *h = (struct rte_hash *)p;
+	struct __rte_hash_rcu_dq_entry *rcu_dq_entry = e;
+	struct rte_hash_key *k;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		if (h->hash_rcu_cfg->free_key_data_func) {
+			k = get_key_slot(h, rcu_dq_entry[i].key_idx);
+			h->hash_rcu_cfg->free_key_data_func(
+				h->hash_rcu_cfg->key_data_ptr, k->pdata);
+		}
+
+		remove_entry(h, rcu_dq_entry[i].key_idx);
+
+		if (rcu_dq_entry[i].ext_bkt_idx != 0)
+			rte_ring_sp_enqueue(h->free_ext_bkts,
+				(void *)(uintptr_t)rcu_dq_entry[i].ext_bkt_idx);
 	}
 }
 
+/*
+ * Free the resources of a deleted entry after the grace period, either
+ * through the defer queue or by waiting for the readers.
+ */
+static inline void
+__hash_rcu_qsbr_defer_free(const struct rte_hash *h, uint32_t key_idx,
+			   uint32_t ext_bkt_idx)
+{
+	struct __rte_hash_rcu_dq_entry rcu_dq_entry;
+
+	rcu_dq_entry.key_idx = key_idx;
+	rcu_dq_entry.ext_bkt_idx = ext_bkt_idx;
+
+	if (h->dq != NULL && rte_rcu_qsbr_dq_enqueue(h->dq, &rcu_dq_entry) == 0)
+		return;
+
+	/* Blocking mode, or the defer queue could not take the entry */
+	rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v, RTE_QSBR_THRID_INVALID);
+	__hash_rcu_qsbr_free_resource((void *)((uintptr_t)h),
+				      &rcu_dq_entry, 1);
+}
+
 /* Compact the linked list by moving key from last entry in linked list to the
  * empty slot.
  */
 static inline void
-__rte_hash_compact_ll(struct rte_hash_bucket *cur_bkt, int pos) {
+__rte_hash_compact_ll(const struct rte_hash *h,
+			struct rte_hash_bucket *cur_bkt, int pos) {
 	int i;
 	struct rte_hash_bucket *last_bkt;
 
@@ -1377,10 +2007,28 @@ __rte_hash_compact_ll(struct rte_hash_bucket *cur_bkt, int pos) {
 
 	for (i = RTE_HASH_BUCKET_ENTRIES - 1; i >= 0; i--) {
 		if (last_bkt->key_idx[i] != EMPTY_SLOT) {
-			cur_bkt->key_idx[pos] = last_bkt->key_idx[i];
 			cur_bkt->sig_current[pos] = last_bkt->sig_current[i];
+			__atomic_store_n(&cur_bkt->key_idx[pos],
+					 last_bkt->key_idx[i],
+					 __ATOMIC_RELEASE);
+			if (h->readwrite_concur_lf_support) {
+				/* Inform the readers that the table has
+				 * changed, the key being moved backward in
+				 * the linked list. Since there is one writer,
+				 * load acquire on tbl_chng_cnt is not required.
+				 */
+				__atomic_store_n(h->tbl_chng_cnt,
+						 *h->tbl_chng_cnt + 1,
+						 __ATOMIC_RELEASE);
+				/* The store to sig_current should
+				 * not move above the store to tbl_chng_cnt.
+				 */
+				__atomic_thread_fence(__ATOMIC_RELEASE);
+			}
 			last_bkt->sig_current[i] = NULL_SIGNATURE;
-			last_bkt->key_idx[i] = EMPTY_SLOT;
+			__atomic_store_n(&last_bkt->key_idx[i],
+					 EMPTY_SLOT,
+					 __ATOMIC_RELEASE);
 			return;
 		}
 	}
@@ -1394,7 +2042,7 @@ static inline int32_t
 search_and_remove(const struct rte_hash *h, const void *key,
 			struct rte_hash_bucket *bkt, uint16_t sig, int *pos)
 {
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 	unsigned int i;
 	uint32_t key_idx;
 
@@ -1403,15 +2051,15 @@ search_and_remove(const struct rte_hash *h, const void *key,
 		key_idx = __atomic_load_n(&bkt->key_idx[i],
 					  __ATOMIC_ACQUIRE);
 		if (bkt->sig_current[i] == sig && key_idx != EMPTY_SLOT) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					key_idx * h->key_entry_size);
+			k = get_key_slot(h, key_idx);
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				bkt->sig_current[i] = NULL_SIGNATURE;
 				/* Free the key store index if
-				 * no_free_on_del is disabled.
+				 * no_free_on_del is disabled and it is not
+				 * deferred to the end of the RCU grace period.
 				 */
-				if (!h->no_free_on_del)
-					remove_entry(h, bkt, i);
+				if (!h->no_free_on_del && h->hash_rcu_cfg == NULL)
+					remove_entry(h, key_idx);
 
 				__atomic_store_n(&bkt->key_idx[i],
 						 EMPTY_SLOT,
@@ -1429,54 +2077,47 @@ search_and_remove(const struct rte_hash *h, const void *key,
 	return -1;
 }
 
+/*
+ * Remove a key from its primary bucket or its secondary bucket chain,
+ * recycling the last extendable bucket of the chain if it became empty.
+ * Writer is expected to hold the lock while calling this function.
+ */
 static inline int32_t
-__rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
-						hash_sig_t sig)
+__rte_hash_del_key_bkts(const struct rte_hash *h, const void *key,
+		uint16_t short_sig, struct rte_hash_bucket *prim_bkt,
+		struct rte_hash_bucket *sec_bkt)
 {
-	uint32_t prim_bucket_idx, sec_bucket_idx;
-	struct rte_hash_bucket *prim_bkt, *sec_bkt, *prev_bkt, *last_bkt;
+	struct rte_hash_bucket *prev_bkt, *last_bkt;
 	struct rte_hash_bucket *cur_bkt;
 	int pos;
 	int32_t ret, i;
-	uint16_t short_sig;
+	uint32_t ext_bkt_idx = 0;
 
-	short_sig = get_short_sig(sig);
-	prim_bucket_idx = get_prim_bucket_index(h, sig);
-	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
-	prim_bkt = &h->buckets[prim_bucket_idx];
-
-	__hash_rw_writer_lock(h);
 	/* look for key in primary bucket */
 	ret = search_and_remove(h, key, prim_bkt, short_sig, &pos);
 	if (ret != -1) {
-		__rte_hash_compact_ll(prim_bkt, pos);
+		__rte_hash_compact_ll(h, prim_bkt, pos);
 		last_bkt = prim_bkt->next;
 		prev_bkt = prim_bkt;
 		goto return_bkt;
 	}
 
-	/* Calculate secondary hash */
-	sec_bkt = &h->buckets[sec_bucket_idx];
-
 	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
 		ret = search_and_remove(h, key, cur_bkt, short_sig, &pos);
 		if (ret != -1) {
-			__rte_hash_compact_ll(cur_bkt, pos);
+			__rte_hash_compact_ll(h, cur_bkt, pos);
 			last_bkt = sec_bkt->next;
 			prev_bkt = sec_bkt;
 			goto return_bkt;
 		}
 	}
 
-	__hash_rw_writer_unlock(h);
 	return -ENOENT;
 
 /* Search last bucket to see if empty to be recycled */
 return_bkt:
-	if (!last_bkt) {
-		__hash_rw_writer_unlock(h);
-		return ret;
-	}
+	if (!last_bkt)
+		goto return_key;
 	while (last_bkt->next) {
 		prev_bkt = last_bkt;
 		last_bkt = last_bkt->next;
@@ -1488,12 +2129,65 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	}
 	/* found empty bucket and recycle */
 	if (i == RTE_HASH_BUCKET_ENTRIES) {
-		prev_bkt->next = last_bkt->next = NULL;
-		uint32_t index = last_bkt - h->buckets_ext + 1;
-		rte_ring_sp_enqueue(h->free_ext_bkts, (void *)(uintptr_t)index);
+		prev_bkt->next = NULL;
+		ext_bkt_idx = last_bkt - h->buckets_ext + 1;
+		/* The readers may still walk the bucket if the key index is
+		 * not freed on delete, so that it is recycled along with it.
+		 */
+		if (h->hash_rcu_cfg == NULL && h->no_free_on_del)
+			*get_ext_bkt_to_free(h, ret + 1) = ext_bkt_idx;
+		else if (h->hash_rcu_cfg == NULL)
+			rte_ring_sp_enqueue(h->free_ext_bkts,
+					    (void *)(uintptr_t)ext_bkt_idx);
 	}
 
+return_key:
+	/* Key index where key is stored, adding the first dummy index */
+	if (h->hash_rcu_cfg != NULL)
+		__hash_rcu_qsbr_defer_free(h, ret + 1, ext_bkt_idx);
+
+	return ret;
+}
+
+/*
+ * Remove a key from the buckets being migrated by a resize.
+ * Writer is expected to hold the lock while calling this function.
+ */
+static inline int32_t
+__rte_hash_del_key_old(const struct rte_hash *h, const void *key,
+		hash_sig_t sig)
+{
+	struct rte_hash_bucket *prim_bkt, *sec_bkt;
+
+	prim_bkt = get_old_bkts(h, sig, &sec_bkt);
+	if (likely(prim_bkt == NULL))
+		return -ENOENT;
+
+	return __rte_hash_del_key_bkts(h, key, get_short_sig(sig), prim_bkt,
+				sec_bkt);
+}
+
+static inline int32_t
+__rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
+						hash_sig_t sig)
+{
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	int32_t ret;
+	uint16_t short_sig;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
+
+	__hash_rw_writer_lock(h);
+	__rte_hash_resize_auto_step(h);
+	ret = __rte_hash_del_key_bkts(h, key, short_sig,
+			&h->buckets[prim_bucket_idx],
+			&h->buckets[sec_bucket_idx]);
+	if (ret == -ENOENT)
+		ret = __rte_hash_del_key_old(h, key, sig);
 	__hash_rw_writer_unlock(h);
+
 	return ret;
 }
 
@@ -1518,9 +2212,8 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
-	struct rte_hash_key *k, *keys = h->key_store;
-	k = (struct rte_hash_key *) ((char *) keys + (position + 1) *
-				     h->key_entry_size);
+	struct rte_hash_key *k;
+	k = get_key_slot(h, position + 1);
 	*key = k->key;
 
 	if (position !=
@@ -1538,36 +2231,271 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 {
 	RETURN_IF_TRUE(((h == NULL) || (position == EMPTY_SLOT)), -EINVAL);
 
-	unsigned int lcore_id, n_slots;
-	struct lcore_cache *cached_free_slots;
-	const int32_t total_entries = h->num_buckets * RTE_HASH_BUCKET_ENTRIES;
+	unsigned int lcore_id, n_slots;
+	struct lcore_cache *cached_free_slots;
+	const struct rte_hash_key_seg *seg;
+	uint32_t total_entries = h->key_store_slots;
+	uint32_t *ext_bkt_idx;
+	/* Key index where key is stored, adding the first dummy index */
+	const uint32_t key_idx = position + 1;
+
+	if (h->num_key_segs != 0) {
+		seg = &h->key_segs[h->num_key_segs - 1];
+		total_entries = seg->first_idx + seg->num_slots;
+	}
+
+	/* Out of bounds */
+	if (position < 0 || key_idx >= total_entries)
+		return -EINVAL;
+
+	/* Recycle the extendable bucket emptied by the deletion of the key */
+	if (h->ext_bkt_to_free != NULL) {
+		ext_bkt_idx = get_ext_bkt_to_free(h, key_idx);
+		if (*ext_bkt_idx != 0) {
+			rte_ring_sp_enqueue(h->free_ext_bkts,
+					(void *)(uintptr_t)*ext_bkt_idx);
+			*ext_bkt_idx = 0;
+		}
+	}
+
+	if (h->use_local_cache) {
+		lcore_id = rte_lcore_id();
+		cached_free_slots = &h->local_free_slots[lcore_id];
+		/* Cache full, need to free it. */
+		if (cached_free_slots->len == LCORE_CACHE_SIZE) {
+			/* Need to enqueue the free slots in global ring. */
+			n_slots = flush_cache_slots(h, cached_free_slots);
+			RETURN_IF_TRUE((n_slots == 0), -EFAULT);
+			cached_free_slots->len -= n_slots;
+		}
+		/* Put index of new free slot in cache. */
+		cached_free_slots->objs[cached_free_slots->len] =
+					(void *)((uintptr_t)key_idx);
+		cached_free_slots->len++;
+	} else {
+		rte_ring_sp_enqueue(get_free_slots_ring(h, key_idx),
+				(void *)((uintptr_t)key_idx));
+	}
+
+	return 0;
+}
+
+int __rte_experimental
+rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	struct rte_hash_rcu_config *hash_rcu_cfg;
+	uint32_t total_entries;
+
+	if (h == NULL || cfg == NULL || cfg->v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	if (h->hash_rcu_cfg) {
+		rte_errno = EEXIST;
+		return 1;
+	}
+
+	hash_rcu_cfg = rte_zmalloc(NULL, sizeof(struct rte_hash_rcu_config), 0);
+	if (hash_rcu_cfg == NULL) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		rte_errno = ENOMEM;
+		return 1;
+	}
+
+	if (cfg->mode == RTE_HASH_QSBR_MODE_DQ) {
+		/* Every key slot may be waiting for its grace period */
+		if (h->use_local_cache)
+			total_entries = h->entries + (RTE_MAX_LCORE - 1) *
+						(LCORE_CACHE_SIZE - 1);
+		else
+			total_entries = h->entries;
+
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name), "HASH_RCU_%s",
+			 h->name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = total_entries;
+		params.trigger_reclaim_limit = cfg->trigger_reclaim_limit;
+		params.max_reclaim_size = cfg->max_reclaim_size;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_HASH_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(struct __rte_hash_rcu_dq_entry);
+		params.free_fn = __hash_rcu_qsbr_free_resource;
+		params.p = h;
+		params.v = cfg->v;
+		/* The writers are serialized by the hash lock, if any */
+		if (!h->writer_takes_lock)
+			params.flags |= RTE_RCU_QSBR_DQ_MT_UNSAFE;
+
+		h->dq = rte_rcu_qsbr_dq_create(&params);
+		if (h->dq == NULL) {
+			rte_free(hash_rcu_cfg);
+			RTE_LOG(ERR, HASH, "HASH defer queue creation failed\n");
+			return 1;
+		}
+	}
+
+	*hash_rcu_cfg = *cfg;
+	hash_rcu_cfg->max_reclaim_size = params.max_reclaim_size;
+	h->hash_rcu_cfg = hash_rcu_cfg;
+
+	return 0;
+}
+
+int __rte_experimental
+rte_hash_resize(struct rte_hash *h, uint32_t entries)
+{
+	struct rte_hash_resize_state *rs;
+	struct rte_hash_key_seg *seg;
+	struct rte_hash_bucket *buckets = NULL;
+	struct rte_ring *r = NULL;
+	uint32_t *ext_bkt_to_free = NULL;
+	void *k = NULL;
+	char ring_name[RTE_RING_NAMESIZE];
+	uint32_t num_buckets, num_slots, first_idx, i;
+	int ret = 0;
+
+	if (h == NULL || entries > RTE_HASH_ENTRIES_MAX ||
+			entries <= h->entries)
+		return -EINVAL;
+
+	num_buckets = rte_align32pow2(entries) / RTE_HASH_BUCKET_ENTRIES;
+	if (num_buckets <= h->num_buckets)
+		return -EINVAL;
+
+	/* The old buckets are freed at the end of the readers grace period */
+	if (h->readwrite_concur_lf_support && h->hash_rcu_cfg == NULL)
+		return -ENOTSUP;
+
+	if (h->num_key_segs == RTE_HASH_KEY_SEGS_MAX)
+		return -ENOSPC;
+
+	rs = h->resize;
+
+	__hash_rw_writer_lock(h);
+
+	if (rs->old_buckets != NULL) {
+		ret = -EBUSY;
+		goto out;
+	}
+	/* Wait for the readers of the buckets of the previous resize */
+	__rte_hash_resize_retire(h, true);
+
+	/* Key table of the new entries, keeping the key indexes of the
+	 * entries in the table.
+	 */
+	num_slots = entries - h->entries;
+	if (h->num_key_segs == 0)
+		first_idx = h->key_store_slots;
+	else {
+		seg = &h->key_segs[h->num_key_segs - 1];
+		first_idx = seg->first_idx + seg->num_slots;
+	}
+
+	snprintf(ring_name, sizeof(ring_name), "HTR%u_%s", h->num_key_segs,
+			h->name);
+	r = rte_ring_create(ring_name, rte_align32pow2(num_slots + 1),
+			h->socket_id, 0);
+	k = rte_zmalloc_socket(NULL, (uint64_t)h->key_entry_size * num_slots,
+			RTE_CACHE_LINE_SIZE, h->socket_id);
+	buckets = rte_zmalloc_socket(NULL,
+			num_buckets * sizeof(struct rte_hash_bucket),
+			RTE_CACHE_LINE_SIZE, h->socket_id);
+	if (h->ext_bkt_to_free != NULL)
+		ext_bkt_to_free = rte_zmalloc(NULL,
+				sizeof(uint32_t) * num_slots, 0);
+	if (r == NULL || k == NULL || buckets == NULL ||
+			(h->ext_bkt_to_free != NULL &&
+			 ext_bkt_to_free == NULL)) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		rte_ring_free(r);
+		rte_free(k);
+		rte_free(buckets);
+		rte_free(ext_bkt_to_free);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = first_idx; i < first_idx + num_slots; i++)
+		rte_ring_sp_enqueue(r, (void *)((uintptr_t)i));
+
+	seg = &h->key_segs[h->num_key_segs];
+	seg->key_store = k;
+	seg->free_slots = r;
+	seg->ext_bkt_to_free = ext_bkt_to_free;
+	seg->first_idx = first_idx;
+	seg->num_slots = num_slots;
+	__atomic_store_n(&h->num_key_segs, h->num_key_segs + 1,
+			 __ATOMIC_RELEASE);
+
+	/* The readers search the old buckets after the new ones, which are
+	 * stored before their bitmask.
+	 */
+	rs->old_bucket_bitmask = h->bucket_bitmask;
+	rs->old_num_buckets = h->num_buckets;
+	rs->next_bucket = 0;
+	__atomic_store_n(&rs->old_buckets, h->buckets, __ATOMIC_RELEASE);
+	__atomic_store_n(&h->buckets, buckets, __ATOMIC_RELEASE);
+	__atomic_store_n(&h->bucket_bitmask, num_buckets - 1,
+			 __ATOMIC_RELEASE);
+	__atomic_store_n(&h->num_buckets, num_buckets, __ATOMIC_RELEASE);
+	if (h->readwrite_concur_lf_support)
+		/* Inform the readers that the buckets changed. Since there
+		 * is one writer, load acquire on tbl_chng_cnt is not
+		 * required.
+		 */
+		__atomic_store_n(h->tbl_chng_cnt, *h->tbl_chng_cnt + 1,
+				 __ATOMIC_RELEASE);
+	h->entries = entries;
+
+out:
+	__hash_rw_writer_unlock(h);
+
+	return ret;
+}
+
+int __rte_experimental
+rte_hash_resize_step(const struct rte_hash *h, uint32_t max_buckets)
+{
+	int ret;
+
+	if (h == NULL || max_buckets == 0)
+		return -EINVAL;
+
+	__hash_rw_writer_lock(h);
+	ret = __rte_hash_resize_step(h, max_buckets);
+	__hash_rw_writer_unlock(h);
+
+	return ret;
+}
+
+int __rte_experimental
+rte_hash_resize_progress(const struct rte_hash *h, uint32_t *migrated,
+		uint32_t *total)
+{
+	const struct rte_hash_resize_state *rs;
+	int ret = 0;
 
-	/* Out of bounds */
-	if (position >= total_entries)
+	if (h == NULL || migrated == NULL || total == NULL)
 		return -EINVAL;
 
-	if (h->use_local_cache) {
-		lcore_id = rte_lcore_id();
-		cached_free_slots = &h->local_free_slots[lcore_id];
-		/* Cache full, need to free it. */
-		if (cached_free_slots->len == LCORE_CACHE_SIZE) {
-			/* Need to enqueue the free slots in global ring. */
-			n_slots = rte_ring_mp_enqueue_burst(h->free_slots,
-						cached_free_slots->objs,
-						LCORE_CACHE_SIZE, NULL);
-			RETURN_IF_TRUE((n_slots == 0), -EFAULT);
-			cached_free_slots->len -= n_slots;
-		}
-		/* Put index of new free slot in cache. */
-		cached_free_slots->objs[cached_free_slots->len] =
-					(void *)((uintptr_t)position);
-		cached_free_slots->len++;
+	rs = h->resize;
+	__hash_rw_reader_lock(h);
+	if (rs->old_buckets != NULL) {
+		*migrated = rs->next_bucket;
+		*total = rs->old_num_buckets;
+		ret = 1;
 	} else {
-		rte_ring_sp_enqueue(h->free_slots,
-				(void *)((uintptr_t)position));
+		*migrated = 0;
+		*total = 0;
 	}
+	__hash_rw_reader_unlock(h);
 
-	return 0;
+	return ret;
 }
 
 static inline void
@@ -1623,6 +2551,8 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 	uint32_t prim_hitmask[RTE_HASH_LOOKUP_BULK_MAX] = {0};
 	uint32_t sec_hitmask[RTE_HASH_LOOKUP_BULK_MAX] = {0};
 	struct rte_hash_bucket *cur_bkt, *next_bkt;
+	struct rte_hash_bucket *buckets = h->buckets;
+	uint32_t bucket_bitmask = h->bucket_bitmask;
 
 	/* Prefetch first keys */
 	for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
@@ -1638,11 +2568,11 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -1653,11 +2583,11 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -1665,6 +2595,18 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 
 	__hash_rw_reader_lock(h);
 
+	/* The buckets were switched by a resize meanwhile */
+	if (unlikely(buckets != h->buckets ||
+			bucket_bitmask != h->bucket_bitmask)) {
+		for (i = 0; i < num_keys; i++) {
+			prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
+			sec_index[i] = get_alt_bucket_index(h, prim_index[i],
+							sig[i]);
+			primary_bkt[i] = &h->buckets[prim_index[i]];
+			secondary_bkt[i] = &h->buckets[sec_index[i]];
+		}
+	}
+
 	/* Compare signatures and prefetch key slot of first hit */
 	for (i = 0; i < num_keys; i++) {
 		compare_signatures(&prim_hitmask[i], &sec_hitmask[i],
@@ -1678,9 +2620,7 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 			rte_prefetch0(key_slot);
 			continue;
 		}
@@ -1692,9 +2632,7 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 			rte_prefetch0(key_slot);
 		}
 	}
@@ -1709,9 +2647,7 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
@@ -1737,9 +2673,7 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
@@ -1762,8 +2696,12 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 		continue;
 	}
 
-	/* all found, do not need to go through ext bkt */
-	if ((hits == ((1ULL << num_keys) - 1)) || !h->ext_table_support) {
+	/* all found, do not need to go through ext bkt, a shift by 64 bits
+	 * being undefined for a full burst
+	 */
+	if ((hits == (UINT64_MAX >> (64 - num_keys))) ||
+			(!h->ext_table_support &&
+			 likely(h->resize->old_buckets == NULL))) {
 		if (hit_mask != NULL)
 			*hit_mask = hits;
 		__hash_rw_reader_unlock(h);
@@ -1790,6 +2728,18 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 		}
 	}
 
+	/* and the buckets being migrated by a resize */
+	for (i = 0; i < num_keys; i++) {
+		if ((hits & (1ULL << i)) != 0)
+			continue;
+		ret = search_old_bkts(h, keys[i], prim_hash[i],
+				data != NULL ? &data[i] : NULL);
+		if (ret != -1) {
+			positions[i] = ret;
+			hits |= 1ULL << i;
+		}
+	}
+
 	__hash_rw_reader_unlock(h);
 
 	if (hit_mask != NULL)
@@ -1815,6 +2765,13 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 	struct rte_hash_bucket *cur_bkt, *next_bkt;
 	void *pdata[RTE_HASH_LOOKUP_BULK_MAX];
 	uint32_t cnt_b, cnt_a;
+	/* A resize stores the buckets before their bitmask */
+	uint32_t bucket_bitmask = __atomic_load_n(&h->bucket_bitmask,
+						__ATOMIC_ACQUIRE);
+	struct rte_hash_bucket *buckets = __atomic_load_n(&h->buckets,
+						__ATOMIC_ACQUIRE);
+	uint32_t cur_bitmask;
+	struct rte_hash_bucket *cur_buckets;
 
 	/* Prefetch first keys */
 	for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
@@ -1830,11 +2787,11 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -1845,11 +2802,11 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -1863,8 +2820,29 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 		cnt_b = __atomic_load_n(h->tbl_chng_cnt,
 					__ATOMIC_ACQUIRE);
 
+		/* Recalculate the buckets if they were switched by a resize */
+		cur_bitmask = __atomic_load_n(&h->bucket_bitmask,
+					__ATOMIC_ACQUIRE);
+		cur_buckets = __atomic_load_n(&h->buckets, __ATOMIC_ACQUIRE);
+		if (unlikely(cur_buckets != buckets ||
+				cur_bitmask != bucket_bitmask)) {
+			bucket_bitmask = cur_bitmask;
+			buckets = cur_buckets;
+			for (i = 0; i < num_keys; i++) {
+				prim_index[i] = prim_hash[i] & bucket_bitmask;
+				sec_index[i] = (prim_index[i] ^ sig[i]) &
+						bucket_bitmask;
+				primary_bkt[i] = &buckets[prim_index[i]];
+				secondary_bkt[i] = &buckets[sec_index[i]];
+			}
+		}
+
+		hits = 0;
+
 		/* Compare signatures and prefetch key slot of first hit */
 		for (i = 0; i < num_keys; i++) {
+			prim_hitmask[i] = 0;
+			sec_hitmask[i] = 0;
 			compare_signatures(&prim_hitmask[i], &sec_hitmask[i],
 				primary_bkt[i], secondary_bkt[i],
 				sig[i], h->sig_cmp_fn);
@@ -1876,9 +2854,7 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 				uint32_t key_idx =
 					primary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 				rte_prefetch0(key_slot);
 				continue;
 			}
@@ -1890,9 +2866,7 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 				uint32_t key_idx =
 					secondary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 				rte_prefetch0(key_slot);
 			}
 		}
@@ -1909,9 +2883,7 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 					&primary_bkt[i]->key_idx[hit_index],
 					__ATOMIC_ACQUIRE);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 
 				if (key_idx != EMPTY_SLOT)
 					pdata[i] = __atomic_load_n(
@@ -1943,9 +2915,7 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 					&secondary_bkt[i]->key_idx[hit_index],
 					__ATOMIC_ACQUIRE);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 
 				if (key_idx != EMPTY_SLOT)
 					pdata[i] = __atomic_load_n(
@@ -1972,6 +2942,38 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 			continue;
 		}
 
+		/* need to check ext buckets for match */
+		for (i = 0; h->ext_table_support && i < num_keys; i++) {
+			if ((hits & (1ULL << i)) != 0)
+				continue;
+			next_bkt = secondary_bkt[i]->next;
+			FOR_EACH_BUCKET(cur_bkt, next_bkt) {
+				if (data != NULL)
+					ret = search_one_bucket_lf(h, keys[i],
+						sig[i], &data[i], cur_bkt);
+				else
+					ret = search_one_bucket_lf(h, keys[i],
+						sig[i], NULL, cur_bkt);
+				if (ret != -1) {
+					positions[i] = ret;
+					hits |= 1ULL << i;
+					break;
+				}
+			}
+		}
+
+		/* and the buckets being migrated by a resize */
+		for (i = 0; i < num_keys; i++) {
+			if ((hits & (1ULL << i)) != 0)
+				continue;
+			ret = search_old_bkts(h, keys[i], prim_hash[i],
+					data != NULL ? &data[i] : NULL);
+			if (ret != -1) {
+				positions[i] = ret;
+				hits |= 1ULL << i;
+			}
+		}
+
 		/* The loads of sig_current in compare_signatures
 		 * should not move below the load from tbl_chng_cnt.
 		 */
@@ -1988,34 +2990,6 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 					__ATOMIC_ACQUIRE);
 	} while (cnt_b != cnt_a);
 
-	/* all found, do not need to go through ext bkt */
-	if ((hits == ((1ULL << num_keys) - 1)) || !h->ext_table_support) {
-		if (hit_mask != NULL)
-			*hit_mask = hits;
-		__hash_rw_reader_unlock(h);
-		return;
-	}
-
-	/* need to check ext buckets for match */
-	for (i = 0; i < num_keys; i++) {
-		if ((hits & (1ULL << i)) != 0)
-			continue;
-		next_bkt = secondary_bkt[i]->next;
-		FOR_EACH_BUCKET(cur_bkt, next_bkt) {
-			if (data != NULL)
-				ret = search_one_bucket_lf(h, keys[i],
-						sig[i], &data[i], cur_bkt);
-			else
-				ret = search_one_bucket_lf(h, keys[i],
-						sig[i], NULL, cur_bkt);
-			if (ret != -1) {
-				positions[i] = ret;
-				hits |= 1ULL << i;
-				break;
-			}
-		}
-	}
-
 	if (hit_mask != NULL)
 		*hit_mask = hits;
 }
@@ -2061,28 +3035,349 @@ rte_hash_lookup_bulk_data(const struct rte_hash *h, const void **keys,
 	return __builtin_popcountl(*hit_mask);
 }
 
+/*
+ * Prefetch the keys of a burst, calculate their signatures and buckets
+ * and prefetch the buckets, as the bulk lookups do.
+ */
+static inline void
+__bulk_calc_buckets(const struct rte_hash *h, const void **keys,
+		int32_t num_keys, uint32_t *prim_hash, uint16_t *sig,
+		uint32_t *prim_index, uint32_t *sec_index)
+{
+	int32_t i;
+
+	/* Prefetch first keys */
+	for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
+		rte_prefetch0(keys[i]);
+
+	for (i = 0; i < num_keys; i++) {
+		if (i + PREFETCH_OFFSET < num_keys)
+			rte_prefetch0(keys[i + PREFETCH_OFFSET]);
+
+		prim_hash[i] = rte_hash_hash(h, keys[i]);
+
+		sig[i] = get_short_sig(prim_hash[i]);
+		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
+		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+
+		rte_prefetch0(&h->buckets[prim_index[i]]);
+		rte_prefetch0(&h->buckets[sec_index[i]]);
+	}
+}
+
+/*
+ * Compare the signatures of a burst with its buckets and prefetch the
+ * key slot of the first hit, so that the key comparisons of the update,
+ * delete or lookup stage find the keys in cache.
+ */
+static inline void
+__bulk_prefetch_key_slots(const struct rte_hash *h, int32_t num_keys,
+		const uint16_t *sig, const uint32_t *prim_index,
+		const uint32_t *sec_index)
+{
+	const struct rte_hash_bucket *bkt;
+	uint32_t prim_hitmask, sec_hitmask;
+	uint32_t hit_index, key_idx;
+	int32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		prim_hitmask = 0;
+		sec_hitmask = 0;
+		compare_signatures(&prim_hitmask, &sec_hitmask,
+			&h->buckets[prim_index[i]], &h->buckets[sec_index[i]],
+			sig[i], h->sig_cmp_fn);
+
+		if (prim_hitmask) {
+			bkt = &h->buckets[prim_index[i]];
+			hit_index = __builtin_ctzl(prim_hitmask) >> 1;
+		} else if (sec_hitmask) {
+			bkt = &h->buckets[sec_index[i]];
+			hit_index = __builtin_ctzl(sec_hitmask) >> 1;
+		} else
+			continue;
+
+		key_idx = bkt->key_idx[hit_index];
+		rte_prefetch0(get_key_slot(h, key_idx));
+	}
+}
+
+/*
+ * Get key slots for the keys of the burst set in 'misses' and copy the keys
+ * and their data into them, prefetching all the slots before the first copy.
+ * The keys for which no slot is left get -ENOSPC as position and are removed
+ * from 'misses'.
+ */
+static inline void
+__bulk_alloc_key_slots(const struct rte_hash *h, const void **keys,
+		void *data[], int32_t num_keys, uint64_t *misses,
+		int32_t *positions, void **slot_id,
+		struct lcore_cache *cached_free_slots)
+{
+	struct rte_hash_key *new_k;
+	int32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		if ((*misses & (1ULL << i)) == 0)
+			continue;
+		slot_id[i] = alloc_slot_reclaim(h, cached_free_slots);
+		if (slot_id[i] == (void *)((uintptr_t)EMPTY_SLOT)) {
+			positions[i] = -ENOSPC;
+			*misses &= ~(1ULL << i);
+			continue;
+		}
+		rte_prefetch0(get_key_slot(h, (uintptr_t)slot_id[i]));
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		if ((*misses & (1ULL << i)) == 0)
+			continue;
+		new_k = get_key_slot(h, (uintptr_t)slot_id[i]);
+		memcpy(new_k->key, keys[i], h->key_len);
+		/* The key and data stores must be complete before the
+		 * key index is stored in a bucket, see
+		 * __rte_hash_add_key_with_hash.
+		 */
+		__atomic_store_n(&new_k->pdata,
+			data != NULL ? data[i] : NULL,
+			__ATOMIC_RELEASE);
+	}
+}
+
+static inline struct lcore_cache *
+__bulk_get_cache(const struct rte_hash *h)
+{
+	if (h->use_local_cache)
+		return &h->local_free_slots[rte_lcore_id()];
+	return NULL;
+}
+
+int __rte_experimental
+rte_hash_add_key_bulk_data(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, void *data[], int32_t *positions)
+{
+	uint32_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t prim_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t sec_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
+	void *slot_id[RTE_HASH_LOOKUP_BULK_MAX];
+	struct lcore_cache *cached_free_slots;
+	uint64_t misses = 0;
+	int32_t i, n;
+	int added = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	n = num_keys;
+	__bulk_calc_buckets(h, keys, n, prim_hash, sig, prim_index, sec_index);
+
+	/* Update the data of the keys already in the table */
+	__hash_rw_writer_lock(h);
+	__rte_hash_resize_auto_step(h);
+	__bulk_prefetch_key_slots(h, n, sig, prim_index, sec_index);
+	for (i = 0; i < n; i++) {
+		positions[i] = search_and_update_bkts(h,
+				data != NULL ? data[i] : NULL, keys[i],
+				&h->buckets[prim_index[i]],
+				&h->buckets[sec_index[i]], sig[i]);
+		if (positions[i] == -1)
+			positions[i] = search_and_update_old(h,
+					data != NULL ? data[i] : NULL,
+					keys[i], prim_hash[i]);
+		if (positions[i] == -1)
+			misses |= 1ULL << i;
+	}
+	__hash_rw_writer_unlock(h);
+
+	/* Store the new keys and insert them in their buckets. A key found
+	 * twice in the burst is inserted once, and has the data of its last
+	 * occurrence.
+	 */
+	if (misses != 0) {
+		cached_free_slots = __bulk_get_cache(h);
+		__bulk_alloc_key_slots(h, keys, data, n, &misses, positions,
+				slot_id, cached_free_slots);
+		for (i = 0; i < n; i++) {
+			if ((misses & (1ULL << i)) == 0)
+				continue;
+			positions[i] = __rte_hash_add_key_slot(h, keys[i],
+					sig[i], prim_index[i], sec_index[i],
+					data != NULL ? data[i] : NULL,
+					slot_id[i], cached_free_slots);
+		}
+	}
+
+	for (i = 0; i < n; i++)
+		if (positions[i] >= 0)
+			added++;
+
+	return added;
+}
+
+int __rte_experimental
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions)
+{
+	uint32_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t prim_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t sec_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t i, n;
+	int deleted = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	n = num_keys;
+	__bulk_calc_buckets(h, keys, n, prim_hash, sig, prim_index, sec_index);
+
+	/* The whole burst is removed under a single writer lock */
+	__hash_rw_writer_lock(h);
+	__rte_hash_resize_auto_step(h);
+	__bulk_prefetch_key_slots(h, n, sig, prim_index, sec_index);
+	for (i = 0; i < n; i++) {
+		positions[i] = __rte_hash_del_key_bkts(h, keys[i], sig[i],
+				&h->buckets[prim_index[i]],
+				&h->buckets[sec_index[i]]);
+		if (positions[i] == -ENOENT)
+			positions[i] = __rte_hash_del_key_old(h, keys[i],
+					prim_hash[i]);
+		if (positions[i] >= 0)
+			deleted++;
+	}
+	__hash_rw_writer_unlock(h);
+
+	return deleted;
+}
+
+int __rte_experimental
+rte_hash_lookup_or_add_bulk_data(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, void *data[], int32_t *positions,
+		uint64_t *hit_mask)
+{
+	uint32_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t prim_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t sec_index[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
+	void *slot_id[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t first[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash_bucket *cur_bkt;
+	struct lcore_cache *cached_free_slots;
+	uint64_t hits = 0, misses = 0, dups = 0;
+	int32_t i, j, n;
+	int ret = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(data == NULL) || (positions == NULL) ||
+			(hit_mask == NULL)), -EINVAL);
+
+	n = num_keys;
+	__bulk_calc_buckets(h, keys, n, prim_hash, sig, prim_index, sec_index);
+
+	/* Look for the keys, the writer lock keeping them in the table until
+	 * the new ones are added.
+	 */
+	__hash_rw_writer_lock(h);
+	__rte_hash_resize_auto_step(h);
+	__bulk_prefetch_key_slots(h, n, sig, prim_index, sec_index);
+	for (i = 0; i < n; i++) {
+		positions[i] = search_one_bucket_l(h, keys[i], sig[i],
+				&data[i], &h->buckets[prim_index[i]]);
+		if (positions[i] == -1) {
+			FOR_EACH_BUCKET(cur_bkt, &h->buckets[sec_index[i]]) {
+				positions[i] = search_one_bucket_l(h, keys[i],
+						sig[i], &data[i], cur_bkt);
+				if (positions[i] != -1)
+					break;
+			}
+		}
+		if (positions[i] == -1)
+			positions[i] = search_old_bkts(h, keys[i],
+					prim_hash[i], &data[i]);
+		if (positions[i] != -1)
+			hits |= 1ULL << i;
+	}
+	__hash_rw_writer_unlock(h);
+
+	/* The later occurrences of a missed key in the burst get the entry
+	 * added for the first one.
+	 */
+	for (i = 0; i < n; i++) {
+		if ((hits & (1ULL << i)) != 0)
+			continue;
+		for (j = 0; j < i; j++) {
+			if ((misses & (1ULL << j)) != 0 &&
+					prim_hash[j] == prim_hash[i] &&
+					rte_hash_cmp_eq(keys[j], keys[i],
+						h) == 0)
+				break;
+		}
+		if (j < i) {
+			first[i] = j;
+			dups |= 1ULL << i;
+		} else
+			misses |= 1ULL << i;
+	}
+
+	if (misses != 0) {
+		cached_free_slots = __bulk_get_cache(h);
+		__bulk_alloc_key_slots(h, keys, data, n, &misses, positions,
+				slot_id, cached_free_slots);
+		for (i = 0; i < n; i++) {
+			if ((misses & (1ULL << i)) == 0)
+				continue;
+			positions[i] = __rte_hash_add_key_slot(h, keys[i],
+					sig[i], prim_index[i], sec_index[i],
+					data[i], slot_id[i], cached_free_slots);
+		}
+	}
+
+	for (i = 0; i < n; i++) {
+		if ((dups & (1ULL << i)) != 0) {
+			positions[i] = positions[first[i]];
+			if (positions[i] >= 0) {
+				data[i] = data[first[i]];
+				hits |= 1ULL << i;
+			}
+		}
+		if (positions[i] >= 0)
+			ret++;
+	}
+
+	*hit_mask = hits;
+	return ret;
+}
+
 int32_t
 rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32_t *next)
 {
 	uint32_t bucket_idx, idx, position;
 	struct rte_hash_key *next_key;
+	struct rte_hash_bucket *buckets, *old_buckets;
 
 	RETURN_IF_TRUE(((h == NULL) || (next == NULL)), -EINVAL);
 
-	const uint32_t total_entries_main = h->num_buckets *
-							RTE_HASH_BUCKET_ENTRIES;
-	const uint32_t total_entries = total_entries_main << 1;
+	/* A resize stores the new buckets before their number */
+	const uint32_t total_entries_main = __atomic_load_n(&h->num_buckets,
+				__ATOMIC_ACQUIRE) * RTE_HASH_BUCKET_ENTRIES;
+	const uint32_t total_entries = total_entries_main +
+			h->num_ext_buckets * RTE_HASH_BUCKET_ENTRIES;
 
 	/* Out of bounds of all buckets (both main table and ext table) */
 	if (*next >= total_entries_main)
 		goto extend_table;
 
+	buckets = __atomic_load_n(&h->buckets, __ATOMIC_ACQUIRE);
+
 	/* Calculate bucket and index of current iterator */
 	bucket_idx = *next / RTE_HASH_BUCKET_ENTRIES;
 	idx = *next % RTE_HASH_BUCKET_ENTRIES;
 
 	/* If current position is empty, go to the next one */
-	while ((position = __atomic_load_n(&h->buckets[bucket_idx].key_idx[idx],
+	while ((position = __atomic_load_n(&buckets[bucket_idx].key_idx[idx],
 					__ATOMIC_ACQUIRE)) == EMPTY_SLOT) {
 		(*next)++;
 		/* End of table */
@@ -2093,8 +3388,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 	}
 
 	__hash_rw_reader_lock(h);
-	next_key = (struct rte_hash_key *) ((char *)h->key_store +
-				position * h->key_entry_size);
+	next_key = get_key_slot(h, position);
 	/* Return key and data */
 	*key = next_key->key;
 	*data = next_key->pdata;
@@ -2110,7 +3404,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 extend_table:
 	/* Out of total bound or if ext bucket feature is not enabled */
 	if (*next >= total_entries || !h->ext_table_support)
-		return -ENOENT;
+		goto old_table;
 
 	bucket_idx = (*next - total_entries_main) / RTE_HASH_BUCKET_ENTRIES;
 	idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
@@ -2118,14 +3412,51 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 	while ((position = h->buckets_ext[bucket_idx].key_idx[idx]) == EMPTY_SLOT) {
 		(*next)++;
 		if (*next == total_entries)
-			return -ENOENT;
+			goto old_table;
 		bucket_idx = (*next - total_entries_main) /
 						RTE_HASH_BUCKET_ENTRIES;
 		idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
 	}
 	__hash_rw_reader_lock(h);
-	next_key = (struct rte_hash_key *) ((char *)h->key_store +
-				position * h->key_entry_size);
+	next_key = get_key_slot(h, position);
+	/* Return key and data */
+	*key = next_key->key;
+	*data = next_key->pdata;
+
+	__hash_rw_reader_unlock(h);
+
+	/* Increment iterator */
+	(*next)++;
+	return position - 1;
+
+/* Then the buckets being migrated by a resize */
+old_table:
+	if (*next < total_entries)
+		*next = total_entries;
+
+	__hash_rw_reader_lock(h);
+	old_buckets = __atomic_load_n(&h->resize->old_buckets,
+				__ATOMIC_ACQUIRE);
+	if (old_buckets == NULL || *next >= total_entries +
+			h->resize->old_num_buckets * RTE_HASH_BUCKET_ENTRIES) {
+		__hash_rw_reader_unlock(h);
+		return -ENOENT;
+	}
+
+	bucket_idx = (*next - total_entries) / RTE_HASH_BUCKET_ENTRIES;
+	idx = (*next - total_entries) % RTE_HASH_BUCKET_ENTRIES;
+
+	while ((position = __atomic_load_n(&old_buckets[bucket_idx].key_idx[idx],
+					__ATOMIC_ACQUIRE)) == EMPTY_SLOT) {
+		(*next)++;
+		bucket_idx = (*next - total_entries) / RTE_HASH_BUCKET_ENTRIES;
+		idx = (*next - total_entries) % RTE_HASH_BUCKET_ENTRIES;
+		if (bucket_idx == h->resize->old_num_buckets) {
+			__hash_rw_reader_unlock(h);
+			return -ENOENT;
+		}
+	}
+	next_key = get_key_slot(h, position);
 	/* Return key and data */
 	*key = next_key->key;
 	*data = next_key->pdata;
@@ -122,6 +122,12 @@ const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
 
 #define RTE_HASH_TSX_MAX_RETRY  10
 
+/** Maximum number of key tables added by the resizes of a hash table */
+#define RTE_HASH_KEY_SEGS_MAX		32
+
+/** Number of buckets migrated by each add or delete during a resize */
+#define RTE_HASH_RESIZE_STEP_BUCKETS	2
+
 struct lcore_cache {
 	unsigned len; /**< Cache len */
 	void *objs[LCORE_CACHE_SIZE]; /**< Cache objects */
@@ -155,6 +161,29 @@ struct rte_hash_bucket {
 	void *next;
 } __rte_cache_aligned;
 
+/** Key table added by a resize, storing the keys of the next indexes */
+struct rte_hash_key_seg {
+	void *key_store;		/**< Table storing the keys and data */
+	struct rte_ring *free_slots;	/**< Ring of its free indexes */
+	uint32_t *ext_bkt_to_free;
+	/**< Extendable buckets to recycle with the keys, see rte_hash */
+	uint32_t first_idx;		/**< Key index of its first entry */
+	uint32_t num_slots;		/**< Number of entries */
+};
+
+/** State of the online resize of a hash table, see rte_hash_resize() */
+struct rte_hash_resize_state {
+	struct rte_hash_bucket *old_buckets;
+	/**< Buckets being migrated, searched after the ones of the table */
+	uint32_t old_bucket_bitmask;	/**< Bitmask of the old buckets */
+	uint32_t old_num_buckets;	/**< Number of old buckets */
+	uint32_t next_bucket;		/**< Next old bucket to migrate */
+	uint32_t retired_num_buckets;	/**< Number of retired buckets */
+	struct rte_hash_bucket *retired_buckets;
+	/**< Migrated buckets, freed once the readers are done with them */
+	uint64_t retired_token;	/**< RCU QSBR token of the retired buckets */
+};
+
 /** A hash table structure. */
 struct rte_hash {
 	char name[RTE_HASH_NAMESIZE];   /**< Name of the hash. */
@@ -203,6 +232,11 @@ struct rte_hash {
 	uint32_t key_entry_size;         /**< Size of each key entry. */
 
 	void *key_store;                /**< Table storing all keys and data */
+	uint32_t key_store_slots;
+	/**< Number of entries of key_store, the next key indexes being
+	 * stored in the key tables added by the resizes.
+	 */
+	uint32_t num_key_segs;	/**< Number of key tables added by resizes */
 	struct rte_hash_bucket *buckets;
 	/**< Table with buckets storing all the	hash values and key indexes
 	 * to the key table.
@@ -210,10 +244,29 @@ struct rte_hash {
 	rte_rwlock_t *readwrite_lock; /**< Read-write lock thread-safety. */
 	struct rte_hash_bucket *buckets_ext; /**< Extra buckets array */
 	struct rte_ring *free_ext_bkts; /**< Ring of indexes of free buckets */
+	uint32_t num_ext_buckets;	/**< Number of extendable buckets */
+	uint32_t *ext_bkt_to_free;
+	/**< Extendable buckets emptied by the deletion of a key, indexed by
+	 * key index, recycled when the key index is freed if it is not freed
+	 * on delete.
+	 */
 	uint32_t *tbl_chng_cnt;
 	/**< Indicates if the hash table changed from last read. */
+	struct rte_hash_rcu_config *hash_rcu_cfg;
+	/**< RCU QSBR configuration, if attached. */
+	struct rte_rcu_qsbr_dq *dq;	/**< RCU QSBR defer queue. */
+	struct rte_hash_resize_state *resize;	/**< Online resize state. */
+	int socket_id;			/**< NUMA socket of the table. */
+	struct rte_hash_key_seg key_segs[RTE_HASH_KEY_SEGS_MAX];
+	/**< Key tables added by the resizes. */
 } __rte_cache_aligned;
 
+/* Resources of a deleted entry, freed after the RCU grace period */
+struct __rte_hash_rcu_dq_entry {
+	uint32_t key_idx;	/**< Key index in the key store. */
+	uint32_t ext_bkt_idx;	/**< Extendable bucket to recycle, or 0. */
+};
+
 struct queue_node {
 	struct rte_hash_bucket *bkt; /* Current bucket on the bfs search */
 	uint32_t cur_bkt_idx;
@@ -15,6 +15,7 @@
 #include <stddef.h>
 
 #include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,8 +52,6 @@ extern "C" {
 
 /** Flag to support lock free reader writer concurrency. Both single writer
  * and multi writer use cases are supported.
- * Currently, extendable bucket table feature is not supported with
- * this feature.
  */
 #define RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF 0x20
 
@@ -83,6 +82,45 @@ struct rte_hash_parameters {
 	uint8_t extra_flag;		/**< Indicate if additional parameters are present. */
 };
 
+/** RCU reclamation modes */
+enum rte_hash_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_HASH_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_HASH_QSBR_MODE_SYNC
+};
+
+/** Type of function called to free the data of a reclaimed key. */
+typedef void (*rte_hash_free_key_data)(void *p, void *key_data);
+
+/** HASH RCU QSBR configuration structure. */
+struct rte_hash_rcu_config {
+	struct rte_rcu_qsbr *v;		/**< RCU QSBR variable. */
+	enum rte_hash_qsbr_mode mode;
+	/**< Mode of RCU QSBR. RTE_HASH_QSBR_MODE_xxx
+	 * '0' for default: create defer queue for reclaim.
+	 */
+	uint32_t dq_size;
+	/**< RCU defer queue size.
+	 * default: total hash table entries.
+	 */
+	uint32_t trigger_reclaim_limit;	/**< Threshold to trigger auto reclaim. */
+	uint32_t max_reclaim_size;
+	/**< Max entries to reclaim in one go.
+	 * default: RTE_HASH_RCU_DQ_RECLAIM_MAX.
+	 */
+	void *key_data_ptr;
+	/**< Pointer passed to the free function. Typically, this is the
+	 * pointer to the data structure to which the resource to free
+	 * (key-data) belongs. This can be NULL.
+	 */
+	rte_hash_free_key_data free_key_data_func;
+	/**< Function to call to free the resource (key-data). */
+};
+
+/** Default number of entries reclaimed in one go from the defer queue. */
+#define RTE_HASH_RCU_DQ_RECLAIM_MAX	16
+
 /** @internal A hash table structure. */
 struct rte_hash;
 
@@ -275,6 +313,8 @@ rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t
  * rte_hash_free_key_with_position API should be called after all
  * the readers have stopped referencing the entry corresponding to
  * this key. RCU mechanisms could be used to determine such a state.
+ * If a RCU QSBR variable was attached with rte_hash_rcu_qsbr_add,
+ * the key index is freed automatically once the readers are done.
  *
  * @param h
  *   Hash table to remove the key from.
@@ -523,6 +563,101 @@ int
 rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 		      uint32_t num_keys, int32_t *positions);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add multiple key-value pairs to an existing hash table.
+ * The hashes of the keys are calculated and their buckets prefetched for
+ * the whole burst before the keys are searched and inserted, which is
+ * faster than adding the keys one by one.
+ * This operation has the same thread safety as rte_hash_add_key_data.
+ * If a key exists already in the table, this API updates its value
+ * with the data passed in this API, as rte_hash_add_key_data does.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param data
+ *   A list of data to add with the keys, or NULL to add the keys without data.
+ * @param positions
+ *   Output containing a list of values, corresponding to the list of keys,
+ *   that are the values returned by rte_hash_add_key for each key.
+ *   If a key could not be added, then -ENOSPC will be the value.
+ * @return
+ *   -EINVAL if there's an error, otherwise number of keys added or updated.
+ */
+int __rte_experimental
+rte_hash_add_key_bulk_data(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, void *data[], int32_t *positions);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Remove multiple keys from an existing hash table.
+ * The whole burst is removed under a single writer lock, after the hashes
+ * of the keys are calculated and their buckets prefetched.
+ * This operation has the same thread safety as rte_hash_del_key, and the
+ * key indexes are freed as rte_hash_del_key does.
+ *
+ * @param h
+ *   Hash table to remove the keys from.
+ * @param keys
+ *   A pointer to a list of keys to remove.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a list of values, corresponding to the list of keys,
+ *   that are the values returned by rte_hash_del_key for each key.
+ *   If a key was not found, then -ENOENT will be the value.
+ * @return
+ *   -EINVAL if there's an error, otherwise number of keys removed.
+ */
+int __rte_experimental
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Find multiple keys in the hash table, adding the missing ones.
+ * This is the usual operation of a flow table, where the first packet of
+ * a flow creates its entry. Each key found in the table gets its data
+ * returned, each missing key is added with the data given for it.
+ * A key found several times in the burst is added once, and its later
+ * occurrences get the data of the first one.
+ * This operation has the same thread safety as rte_hash_add_key_data.
+ * If another writer adds a missing key meanwhile, its data is updated
+ * as rte_hash_add_key_data does.
+ *
+ * @param h
+ *   Hash table to look in.
+ * @param keys
+ *   A pointer to a list of keys to look for.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param data
+ *   Input containing the data to add with the missing keys, and output
+ *   containing the data of the keys found in the table.
+ * @param positions
+ *   Output containing a list of values, corresponding to the list of keys,
+ *   that can be used by the caller as an offset into an array of user data.
+ *   If a key could not be added, then -ENOSPC will be the value.
+ * @param hit_mask
+ *   Output containing a bitmask of the keys found in the table.
+ * @return
+ *   -EINVAL if there's an error, otherwise number of keys found or added.
+ */
+int __rte_experimental
+rte_hash_lookup_or_add_bulk_data(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, void *data[], int32_t *positions,
+		uint64_t *hit_mask);
+
 /**
  * Iterate through the hash table, returning key-value pairs.
  *
@@ -544,6 +679,109 @@ rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
  */
 int32_t
 rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32_t *next);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Associate RCU QSBR variable with a Hash object.
+ * Once attached, the key index of a deleted entry, along with its
+ * extendable bucket if it became empty, is freed after the grace period
+ * of the readers is over, whatever the RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL
+ * flag. rte_hash_free_key_with_position must not be called for it.
+ *
+ * @param h
+ *   the hash object to add RCU QSBR
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid pointer
+ *   - EEXIST - already added QSBR
+ *   - ENOMEM - memory allocation failure
+ */
+int __rte_experimental
+rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Start growing a hash table to hold the given number of entries.
+ * The new buckets are used right away, while the entries are migrated from
+ * the old buckets incrementally: a few buckets by each add or delete, or
+ * more by rte_hash_resize_step. The lookups search both until all the
+ * entries are migrated, and the key indexes of the entries are kept.
+ * The keys added after the resize may get positions beyond the entries of
+ * the table before it, up to the new number of entries: an application
+ * indexing its own arrays by key position must grow them before resizing.
+ * The keys are rehashed with the hash function of the table, so a table
+ * whose keys were added with a different precomputed hash must not be
+ * resized.
+ * This API must not be called concurrently with the writers of the table.
+ * When RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF is enabled, a RCU QSBR
+ * variable must have been attached with rte_hash_rcu_qsbr_add: the old
+ * buckets are freed once the readers reported a quiescent state, this API
+ * waiting for them if the buckets of the previous resize are not freed
+ * yet. The extendable buckets are not resized.
+ *
+ * @param h
+ *   Hash table to resize.
+ * @param entries
+ *   New total number of entries, greater than the current one.
+ * @return
+ *   - 0 if the resize started.
+ *   - -EINVAL if the parameters are invalid or do not grow the buckets.
+ *   - -ENOTSUP if no RCU QSBR variable is attached to a lock free table.
+ *   - -EBUSY if a resize is in progress.
+ *   - -ENOSPC if the table was resized too many times.
+ *   - -ENOMEM if the memory allocation failed.
+ */
+int __rte_experimental
+rte_hash_resize(struct rte_hash *h, uint32_t entries);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Migrate the entries of some old buckets of a resize in progress.
+ * Thread safety is the one of the writers of the table.
+ *
+ * @param h
+ *   Hash table being resized.
+ * @param max_buckets
+ *   Maximum number of old buckets to migrate.
+ * @return
+ *   - The number of old buckets left to migrate, 0 if the resize is over.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOSPC if an entry could not be inserted in the new buckets, the
+ *     resize staying in progress.
+ */
+int __rte_experimental
+rte_hash_resize_step(const struct rte_hash *h, uint32_t max_buckets);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the progress of the resize of a hash table.
+ *
+ * @param h
+ *   Hash table to check.
+ * @param migrated
+ *   Output containing the number of old buckets migrated.
+ * @param total
+ *   Output containing the number of old buckets to migrate.
+ * @return
+ *   - 1 if a resize is in progress.
+ *   - 0 if no resize is in progress, both outputs being 0.
+ *   - -EINVAL if the parameters are invalid.
+ */
+int __rte_experimental
+rte_hash_resize_progress(const struct rte_hash *h, uint32_t *migrated,
+		uint32_t *total);
 #ifdef __cplusplus
 }
 #endif
@@ -21,8 +21,15 @@
 #include <rte_errno.h>
 #include <rte_rwlock.h>
 #include <rte_spinlock.h>
+#include <rte_cpuflags.h>
 
 #include "rte_lpm.h"
+#ifdef CC_AVX2_SUPPORT
+#include "rte_lpm_avx2.h"
+#endif
+#ifdef CC_AVX512F_SUPPORT
+#include "rte_lpm_avx512.h"
+#endif
 
 TAILQ_HEAD(rte_lpm_list, rte_tailq_entry);
 
@@ -33,6 +40,9 @@ EAL_REGISTER_TAILQ(rte_lpm_tailq)
 
 #define MAX_DEPTH_TBL24 24
 
+/* Max number of tbl8 groups for 32 bits gather indexes of their entries */
+#define LPM_VEC_MAX_TBL8S (1 << 23)
+
 enum valid_flag {
 	INVALID = 0,
 	VALID
@@ -380,6 +390,8 @@ rte_lpm_free_v1604(struct rte_lpm *lpm)
 
 	rte_rwlock_write_unlock(RTE_EAL_TAILQ_RWLOCK);
 
+	if (lpm->dq)
+		rte_rcu_qsbr_dq_delete(lpm->dq);
 	rte_free(lpm->tbl8);
 	rte_free(lpm->rules_tbl);
 	rte_free(lpm);
@@ -670,7 +682,7 @@ tbl8_alloc_v20(struct rte_lpm_tbl_entry_v20 *tbl8)
 }
 
 static inline int32_t
-tbl8_alloc_v1604(struct rte_lpm_tbl_entry *tbl8, uint32_t number_tbl8s)
+__tbl8_alloc_v1604(struct rte_lpm_tbl_entry *tbl8, uint32_t number_tbl8s)
 {
 	uint32_t group_idx; /* tbl8 group index. */
 	struct rte_lpm_tbl_entry *tbl8_entry;
@@ -702,11 +714,158 @@ tbl8_free_v20(struct rte_lpm_tbl_entry_v20 *tbl8, uint32_t tbl8_group_start)
 	tbl8[tbl8_group_start].valid_group = INVALID;
 }
 
+static inline int32_t
+tbl8_alloc_v1604(struct rte_lpm *lpm)
+{
+	int32_t group_idx; /* tbl8 group index. */
+
+	group_idx = __tbl8_alloc_v1604(lpm->tbl8, lpm->number_tbl8s);
+	if (group_idx == -ENOSPC && lpm->dq != NULL) {
+		/* If there are no tbl8 groups try to reclaim one. */
+		rte_rcu_qsbr_dq_reclaim(lpm->dq, 1, NULL, NULL, NULL);
+		group_idx = __tbl8_alloc_v1604(lpm->tbl8, lpm->number_tbl8s);
+	}
+
+	return group_idx;
+}
+
+/*
+ * Release the tbl8 groups queued by tbl8_free_v1604(), once the readers
+ * cannot reference them anymore.
+ */
+static void
+__lpm_rcu_qsbr_free_resource(void *p, void *data, unsigned int n)
+{
+	struct rte_lpm_tbl_entry *tbl8 = ((struct rte_lpm *)p)->tbl8;
+	uint32_t *tbl8_group_start = data;
+	unsigned int i;
+
+	for (i = 0; i < n; i++)
+		tbl8[tbl8_group_start[i]].valid_group = INVALID;
+}
+
 static inline void
-tbl8_free_v1604(struct rte_lpm_tbl_entry *tbl8, uint32_t tbl8_group_start)
+tbl8_free_v1604(struct rte_lpm *lpm, uint32_t tbl8_group_start)
 {
+	/* Freed by the defer queue once the grace period is over */
+	if (lpm->dq != NULL &&
+			rte_rcu_qsbr_dq_enqueue(lpm->dq,
+				(void *)&tbl8_group_start) == 0)
+		return;
+
+	/* Blocking mode, or the defer queue is full */
+	if (lpm->v != NULL)
+		rte_rcu_qsbr_synchronize(lpm->v, RTE_QSBR_THRID_INVALID);
+
 	/* Set tbl8 group invalid*/
-	tbl8[tbl8_group_start].valid_group = INVALID;
+	lpm->tbl8[tbl8_group_start].valid_group = INVALID;
+}
+
+int __rte_experimental
+rte_lpm_rcu_qsbr_add(struct rte_lpm *lpm, struct rte_lpm_rcu_config *cfg)
+{
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+
+	if (lpm == NULL || cfg == NULL || cfg->v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	if (lpm->v != NULL) {
+		rte_errno = EEXIST;
+		return 1;
+	}
+
+	if (cfg->mode == RTE_LPM_QSBR_MODE_DQ) {
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+				"LPM_RCU_%s", lpm->name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = lpm->number_tbl8s;
+		params.trigger_reclaim_limit = cfg->trigger_reclaim_limit;
+		params.max_reclaim_size = cfg->max_reclaim_size;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_LPM_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(uint32_t);	/* tbl8 group index */
+		params.free_fn = __lpm_rcu_qsbr_free_resource;
+		params.p = lpm;
+		params.v = cfg->v;
+		/* The LPM updates are not multi-thread safe */
+		params.flags = RTE_RCU_QSBR_DQ_MT_UNSAFE;
+		lpm->dq = rte_rcu_qsbr_dq_create(&params);
+		if (lpm->dq == NULL) {
+			RTE_LOG(ERR, LPM, "LPM defer queue creation failed\n");
+			return 1;
+		}
+	}
+
+	lpm->rcu_mode = cfg->mode;
+	lpm->v = cfg->v;
+
+	return 0;
+}
+
+static void
+lookup_bulk_scalar(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops, const unsigned int n)
+{
+	rte_lpm_lookup_bulk_func(lpm, ips, next_hops, n);
+}
+
+static rte_lpm_lookup_bulk_fn_t
+get_vector_fn(const struct rte_lpm *lpm, enum rte_lpm_lookup_type type)
+{
+	if (lpm->number_tbl8s > LPM_VEC_MAX_TBL8S)
+		return NULL;
+
+	switch (type) {
+#ifdef CC_AVX2_SUPPORT
+	case RTE_LPM_LOOKUP_VECTOR_AVX2:
+		if (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+			return NULL;
+		return rte_lpm_lookup_bulk_avx2;
+#endif
+#ifdef CC_AVX512F_SUPPORT
+	case RTE_LPM_LOOKUP_VECTOR_AVX512:
+		if (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F))
+			return NULL;
+		return rte_lpm_lookup_bulk_avx512;
+#endif
+	default:
+		return NULL;
+	}
+}
+
+rte_lpm_lookup_bulk_fn_t __rte_experimental
+rte_lpm_get_lookup_bulk_fn(const struct rte_lpm *lpm,
+	enum rte_lpm_lookup_type type)
+{
+	rte_lpm_lookup_bulk_fn_t fn;
+
+	if (lpm == NULL)
+		return NULL;
+
+	switch (type) {
+	case RTE_LPM_LOOKUP_DEFAULT:
+		fn = NULL;
+#ifdef RTE_ENABLE_AVX512
+		/* AVX512 may lower the core frequency, it is opt-in */
+		fn = get_vector_fn(lpm, RTE_LPM_LOOKUP_VECTOR_AVX512);
+#endif
+		if (fn == NULL)
+			fn = get_vector_fn(lpm, RTE_LPM_LOOKUP_VECTOR_AVX2);
+		return (fn != NULL) ? fn : lookup_bulk_scalar;
+	case RTE_LPM_LOOKUP_SCALAR:
+		return lookup_bulk_scalar;
+	case RTE_LPM_LOOKUP_VECTOR_AVX2:
+	case RTE_LPM_LOOKUP_VECTOR_AVX512:
+		return get_vector_fn(lpm, type);
+	default:
+		return NULL;
+	}
 }
 
 static inline int32_t
@@ -985,7 +1144,7 @@ add_depth_big_v1604(struct rte_lpm *lpm, uint32_t ip_masked, uint8_t depth,
 
 	if (!lpm->tbl24[tbl24_index].valid) {
 		/* Search for a free tbl8 group. */
-		tbl8_group_index = tbl8_alloc_v1604(lpm->tbl8, lpm->number_tbl8s);
+		tbl8_group_index = tbl8_alloc_v1604(lpm);
 
 		/* Check tbl8 allocation was successful. */
 		if (tbl8_group_index < 0) {
@@ -1022,7 +1181,7 @@ add_depth_big_v1604(struct rte_lpm *lpm, uint32_t ip_masked, uint8_t depth,
 	} /* If valid entry but not extended calculate the index into Table8. */
 	else if (lpm->tbl24[tbl24_index].valid_group == 0) {
 		/* Search for free tbl8 group. */
-		tbl8_group_index = tbl8_alloc_v1604(lpm->tbl8, lpm->number_tbl8s);
+		tbl8_group_index = tbl8_alloc_v1604(lpm);
 
 		if (tbl8_group_index < 0) {
 			return tbl8_group_index;
@@ -1715,7 +1874,7 @@ delete_depth_big_v1604(struct rte_lpm *lpm, uint32_t ip_masked,
 	if (tbl8_recycle_index == -EINVAL) {
 		/* Set tbl24 before freeing tbl8 to avoid race condition. */
 		lpm->tbl24[tbl24_index].valid = 0;
-		tbl8_free_v1604(lpm->tbl8, tbl8_group_start);
+		tbl8_free_v1604(lpm, tbl8_group_start);
 	} else if (tbl8_recycle_index > -1) {
 		/* Update tbl24 entry. */
 		struct rte_lpm_tbl_entry new_tbl24_entry = {
@@ -1727,7 +1886,7 @@ delete_depth_big_v1604(struct rte_lpm *lpm, uint32_t ip_masked,
 
 		/* Set tbl24 before freeing tbl8 to avoid race condition. */
 		lpm->tbl24[tbl24_index] = new_tbl24_entry;
-		tbl8_free_v1604(lpm->tbl8, tbl8_group_start);
+		tbl8_free_v1604(lpm, tbl8_group_start);
 	}
 #undef group_idx
 	return 0;
@@ -1869,6 +2028,12 @@ VERSION_SYMBOL(rte_lpm_delete_all, _v20, 2.0);
 void
 rte_lpm_delete_all_v1604(struct rte_lpm *lpm)
 {
+	/* Release the tbl8 groups still waiting for the readers. */
+	if (lpm->dq != NULL) {
+		rte_rcu_qsbr_synchronize(lpm->v, RTE_QSBR_THRID_INVALID);
+		rte_rcu_qsbr_dq_reclaim(lpm->dq, ~0, NULL, NULL, NULL);
+	}
+
 	/* Zero rule information. */
 	memset(lpm->rule_info, 0, sizeof(lpm->rule_info));
 
@@ -21,6 +21,7 @@
 #include <rte_common.h>
 #include <rte_vect.h>
 #include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,14 @@ extern "C" {
 #define RTE_LPM_TBL8_NUM_ENTRIES        (RTE_LPM_TBL8_NUM_GROUPS * \
 					RTE_LPM_TBL8_GROUP_NUM_ENTRIES)
 
+/** RCU reclamation modes */
+enum rte_lpm_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_LPM_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_LPM_QSBR_MODE_SYNC
+};
+
 /** @internal Macro to enable/disable run-time checks. */
 #if defined(RTE_LIBRTE_LPM_DEBUG)
 #define RTE_LPM_RETURN_IF_TRUE(cond, retval) do { \
@@ -186,8 +195,34 @@ struct rte_lpm {
 			__rte_cache_aligned; /**< LPM tbl24 table. */
 	struct rte_lpm_tbl_entry *tbl8; /**< LPM tbl8 table. */
 	struct rte_lpm_rule *rules_tbl; /**< LPM rules. */
+
+	/* RCU config. */
+	struct rte_rcu_qsbr *v;		/**< RCU QSBR variable. */
+	enum rte_lpm_qsbr_mode rcu_mode;/**< Blocking, defer queue. */
+	struct rte_rcu_qsbr_dq *dq;	/**< RCU QSBR defer queue. */
+};
+
+/** LPM RCU QSBR configuration structure. */
+struct rte_lpm_rcu_config {
+	struct rte_rcu_qsbr *v;	/**< RCU QSBR variable. */
+	enum rte_lpm_qsbr_mode mode;
+	/**< Mode of RCU QSBR. RTE_LPM_QSBR_MODE_xxx
+	 * '0' for default: create defer queue for reclaim.
+	 */
+	uint32_t dq_size;
+	/**< RCU defer queue size.
+	 * default: lpm->number_tbl8s.
+	 */
+	uint32_t trigger_reclaim_limit;	/**< Threshold to trigger auto reclaim. */
+	uint32_t max_reclaim_size;
+	/**< Max entries to reclaim in one go.
+	 * default: RTE_LPM_RCU_DQ_RECLAIM_MAX.
+	 */
 };
 
+/** Default number of tbl8 groups reclaimed in one go from the defer queue. */
+#define RTE_LPM_RCU_DQ_RECLAIM_MAX	16
+
 /**
  * Create an LPM object.
  *
@@ -248,6 +283,29 @@ rte_lpm_free_v20(struct rte_lpm_v20 *lpm);
 void
 rte_lpm_free_v1604(struct rte_lpm *lpm);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Associate RCU QSBR variable with an LPM object.
+ * Once attached, the tbl8 groups released by the rule deletions are only
+ * reused after the grace period of the readers is over.
+ *
+ * @param lpm
+ *   the lpm object to add RCU QSBR
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid pointer
+ *   - EEXIST - already added QSBR
+ *   - ENOMEM - memory allocation failure
+ */
+int __rte_experimental
+rte_lpm_rcu_qsbr_add(struct rte_lpm *lpm, struct rte_lpm_rcu_config *cfg);
+
 /**
  * Add a rule to the LPM table.
  *
@@ -429,6 +487,49 @@ rte_lpm_lookup_bulk_func(const struct rte_lpm *lpm, const uint32_t *ips,
 	return 0;
 }
 
+/** Implementations of the LPM bulk lookup. */
+enum rte_lpm_lookup_type {
+	RTE_LPM_LOOKUP_DEFAULT,
+	/**< Widest implementation supported by the CPU and the table, AVX512
+	 * only if RTE_ENABLE_AVX512 is defined
+	 */
+	RTE_LPM_LOOKUP_SCALAR,
+	/**< Scalar lookup, as rte_lpm_lookup_bulk() */
+	RTE_LPM_LOOKUP_VECTOR_AVX2,
+	/**< x86 AVX2 lookup of 8 addresses at a time */
+	RTE_LPM_LOOKUP_VECTOR_AVX512
+	/**< x86 AVX512 lookup of 16 addresses at a time */
+};
+
+/** Bulk lookup function, with the arguments of rte_lpm_lookup_bulk() */
+typedef void (*rte_lpm_lookup_bulk_fn_t)(const struct rte_lpm *lpm,
+	const uint32_t *ips, uint32_t *next_hops, const unsigned int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get a bulk lookup function of an LPM table. The function fills the
+ * next_hops array as rte_lpm_lookup_bulk() does, the vector ones gathering
+ * the tbl24 entries of 8 or 16 addresses at once, then the tbl8 entries of
+ * the addresses which need them.
+ *
+ * The vector implementations need the instruction set at runtime, and a
+ * table of at most 2^23 tbl8 groups for the gather indexes.
+ *
+ * @param lpm
+ *   LPM object handle
+ * @param type
+ *   Lookup implementation, RTE_LPM_LOOKUP_DEFAULT for the widest one
+ *   available
+ * @return
+ *   Pointer to the lookup function, NULL if the implementation is not
+ *   available
+ */
+rte_lpm_lookup_bulk_fn_t __rte_experimental
+rte_lpm_get_lookup_bulk_fn(const struct rte_lpm *lpm,
+	enum rte_lpm_lookup_type type);
+
 /* Mask four results. */
 #define	 RTE_LPM_MASKX4_RES	UINT64_C(0x00ffffff00ffffff)
 
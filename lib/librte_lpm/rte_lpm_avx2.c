@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <x86intrin.h>
+
+#include <rte_vect.h>
+
+#include "rte_lpm.h"
+#include "rte_lpm_avx2.h"
+
+/*
+ * Lookup of 8 addresses: the tbl24 entries are gathered at once, then the
+ * tbl8 entries of the ones pointing to a tbl8 group.
+ */
+static __rte_always_inline void
+lpm_lookup_x8(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops)
+{
+	const __m256i ext_msk =
+		_mm256_set1_epi32(RTE_LPM_VALID_EXT_ENTRY_BITMASK);
+	const __m256i idx_msk = _mm256_set1_epi32(0x00FFFFFF);
+	const __m256i byte_msk = _mm256_set1_epi32(UINT8_MAX);
+	__m256i ip, idxes, res, ext;
+
+	ip = _mm256_loadu_si256((const __m256i *)ips);
+	idxes = _mm256_srli_epi32(ip, 8);
+	res = _mm256_i32gather_epi32((const int *)lpm->tbl24, idxes, 4);
+
+	ext = _mm256_cmpeq_epi32(_mm256_and_si256(res, ext_msk), ext_msk);
+	if (!_mm256_testz_si256(ext, ext)) {
+		idxes = _mm256_slli_epi32(_mm256_and_si256(res, idx_msk), 8);
+		idxes = _mm256_add_epi32(idxes,
+			_mm256_and_si256(ip, byte_msk));
+		res = _mm256_mask_i32gather_epi32(res,
+			(const int *)lpm->tbl8, idxes, ext, 4);
+	}
+
+	_mm256_storeu_si256((__m256i *)next_hops, res);
+}
+
+void
+rte_lpm_lookup_bulk_avx2(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 8); i++)
+		lpm_lookup_x8(lpm, ips + i * 8, next_hops + i * 8);
+
+	if (n % 8 != 0)
+		rte_lpm_lookup_bulk_func(lpm, ips + i * 8, next_hops + i * 8,
+			n - i * 8);
+}
@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <x86intrin.h>
+
+#include <rte_vect.h>
+
+#include "rte_lpm.h"
+#include "rte_lpm_avx512.h"
+
+/*
+ * Lookup of up to 16 addresses, selected by msk: the tbl24 entries are
+ * gathered at once, then the tbl8 entries of the ones pointing to a tbl8
+ * group.
+ */
+static __rte_always_inline void
+lpm_lookup_x16(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops, __mmask16 msk)
+{
+	const __m512i ext_msk =
+		_mm512_set1_epi32(RTE_LPM_VALID_EXT_ENTRY_BITMASK);
+	const __m512i idx_msk = _mm512_set1_epi32(0x00FFFFFF);
+	const __m512i byte_msk = _mm512_set1_epi32(UINT8_MAX);
+	__m512i ip, idxes, res;
+	__mmask16 msk_ext;
+
+	ip = _mm512_maskz_loadu_epi32(msk, (const void *)ips);
+	idxes = _mm512_srli_epi32(ip, 8);
+	res = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), msk, idxes,
+		(const void *)lpm->tbl24, 4);
+
+	msk_ext = _mm512_mask_cmpeq_epi32_mask(msk,
+		_mm512_and_epi32(res, ext_msk), ext_msk);
+	if (msk_ext != 0) {
+		idxes = _mm512_slli_epi32(_mm512_and_epi32(res, idx_msk), 8);
+		idxes = _mm512_add_epi32(idxes,
+			_mm512_and_epi32(ip, byte_msk));
+		res = _mm512_mask_i32gather_epi32(res, msk_ext, idxes,
+			(const void *)lpm->tbl8, 4);
+	}
+
+	_mm512_mask_storeu_epi32((void *)next_hops, msk, res);
+}
+
+void
+rte_lpm_lookup_bulk_avx512(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 16); i++)
+		lpm_lookup_x16(lpm, ips + i * 16, next_hops + i * 16,
+			UINT16_MAX);
+
+	/* the last addresses are looked up with a partial mask */
+	if (n % 16 != 0)
+		lpm_lookup_x16(lpm, ips + i * 16, next_hops + i * 16,
+			(1 << (n % 16)) - 1);
+}
@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_LPM_AVX512_H_
+#define _RTE_LPM_AVX512_H_
+
+void
+rte_lpm_lookup_bulk_avx512(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *next_hops, const unsigned int n);
+
+#endif /* _RTE_LPM_AVX512_H_ */
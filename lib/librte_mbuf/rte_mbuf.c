@@ -62,8 +62,13 @@ rte_pktmbuf_pool_init(struct rte_mempool *mp, void *opaque_arg)
 		user_mbp_priv->mbuf_data_room_size +
 		user_mbp_priv->mbuf_priv_size);
 
+	/* the flags are set by the pool creation helpers only, as older
+	 * callers pass a structure without them
+	 */
 	mbp_priv = rte_mempool_get_priv(mp);
-	memcpy(mbp_priv, user_mbp_priv, sizeof(*mbp_priv));
+	mbp_priv->mbuf_data_room_size = user_mbp_priv->mbuf_data_room_size;
+	mbp_priv->mbuf_priv_size = user_mbp_priv->mbuf_priv_size;
+	mbp_priv->flags = 0;
 }
 
 /*
@@ -106,18 +111,30 @@ rte_pktmbuf_init(struct rte_mempool *mp,
 	m->next = NULL;
 }
 
-/* Helper to create a mbuf pool with given mempool ops name*/
+/* Helper to create a mbuf pool with given mempool ops name and flags */
 struct rte_mempool *
-rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
+rte_pktmbuf_pool_create_with_flags(const char *name, unsigned int n,
 	unsigned int cache_size, uint16_t priv_size, uint16_t data_room_size,
-	int socket_id, const char *ops_name)
+	int socket_id, const char *ops_name, uint32_t flags)
 {
 	struct rte_mempool *mp;
-	struct rte_pktmbuf_pool_private mbp_priv;
+	struct rte_pktmbuf_pool_private *priv, mbp_priv;
 	const char *mp_ops_name = ops_name;
 	unsigned elt_size;
 	int ret;
 
+	if ((flags & ~RTE_PKTMBUF_POOL_F_FAST_FREE) != 0) {
+		RTE_LOG(ERR, MBUF, "invalid mbuf pool flags 0x%x\n", flags);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+#ifndef RTE_MBUF_FAST_FREE_POOL
+	if (flags & RTE_PKTMBUF_POOL_F_FAST_FREE) {
+		RTE_LOG(ERR, MBUF, "fast-free mbuf pools are not built in\n");
+		rte_errno = ENOTSUP;
+		return NULL;
+	}
+#endif
 	if (RTE_ALIGN(priv_size, RTE_MBUF_PRIV_ALIGN) != priv_size) {
 		RTE_LOG(ERR, MBUF, "mbuf priv_size=%u is not aligned\n",
 			priv_size);
@@ -126,6 +143,7 @@ rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
 	}
 	elt_size = sizeof(struct rte_mbuf) + (unsigned)priv_size +
 		(unsigned)data_room_size;
+	memset(&mbp_priv, 0, sizeof(mbp_priv));
 	mbp_priv.mbuf_data_room_size = data_room_size;
 	mbp_priv.mbuf_priv_size = priv_size;
 
@@ -144,6 +162,8 @@ rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
 		return NULL;
 	}
 	rte_pktmbuf_pool_init(mp, &mbp_priv);
+	priv = rte_mempool_get_priv(mp);
+	priv->flags = flags;
 
 	ret = rte_mempool_populate_default(mp);
 	if (ret < 0) {
@@ -157,6 +177,16 @@ rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
 	return mp;
 }
 
+/* Helper to create a mbuf pool with given mempool ops name*/
+struct rte_mempool *
+rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
+	unsigned int cache_size, uint16_t priv_size, uint16_t data_room_size,
+	int socket_id, const char *ops_name)
+{
+	return rte_pktmbuf_pool_create_with_flags(name, n, cache_size,
+			priv_size, data_room_size, socket_id, ops_name, 0);
+}
+
 /* helper to create a mbuf pool */
 struct rte_mempool *
 rte_pktmbuf_pool_create(const char *name, unsigned int n,
@@ -167,6 +197,183 @@ rte_pktmbuf_pool_create(const char *name, unsigned int n,
 			data_room_size, socket_id, NULL);
 }
 
+/* position in the external memory areas while initializing a pool */
+struct rte_pktmbuf_extmem_init_ctx {
+	const struct rte_pktmbuf_extmem *ext_mem; /* memory areas */
+	unsigned int ext_num; /* number of memory areas */
+	unsigned int ext; /* current memory area */
+	size_t off; /* offset of the next buffer in the current area */
+};
+
+/*
+ * Free callback of the pinned external buffers: called when the last
+ * clone of an already freed mbuf releases the buffer.
+ */
+static void
+rte_pktmbuf_free_pinned_extmem(void *addr, void *opaque)
+{
+	struct rte_mbuf *m = opaque;
+
+	RTE_SET_USED(addr);
+	RTE_ASSERT(RTE_MBUF_HAS_EXTBUF(m));
+	RTE_ASSERT(RTE_MBUF_HAS_PINNED_EXTBUF(m));
+	RTE_ASSERT(m->shinfo->fcb_opaque == m);
+
+	rte_mbuf_ext_refcnt_set(m->shinfo, 1);
+	m->ol_flags = EXT_ATTACHED_MBUF;
+	if (m->next != NULL) {
+		m->next = NULL;
+		m->nb_segs = 1;
+	}
+	rte_mbuf_raw_free(m);
+}
+
+/*
+ * pktmbuf constructor for pools with pinned external buffers, given as a
+ * callback function to rte_mempool_obj_iter(). The shared info of the
+ * buffer is stored after the mbuf private area.
+ */
+static void
+rte_pktmbuf_init_extmem(struct rte_mempool *mp, void *opaque_arg,
+			void *_m, __attribute__((unused)) unsigned int i)
+{
+	struct rte_pktmbuf_extmem_init_ctx *ctx = opaque_arg;
+	const struct rte_pktmbuf_extmem *ext_mem;
+	struct rte_mbuf_ext_shared_info *shinfo;
+	struct rte_mbuf *m = _m;
+	uint32_t mbuf_size, buf_len, priv_size;
+
+	priv_size = rte_pktmbuf_priv_size(mp);
+	mbuf_size = sizeof(struct rte_mbuf) + priv_size;
+	buf_len = rte_pktmbuf_data_room_size(mp);
+
+	RTE_ASSERT(RTE_ALIGN(priv_size, RTE_MBUF_PRIV_ALIGN) == priv_size);
+	RTE_ASSERT(mp->elt_size >= mbuf_size + sizeof(*shinfo));
+	RTE_ASSERT(buf_len <= UINT16_MAX);
+	RTE_ASSERT(ctx->ext < ctx->ext_num);
+
+	memset(m, 0, mbuf_size);
+	m->priv_size = priv_size;
+	m->buf_len = (uint16_t)buf_len;
+
+	/* take the next buffer of the external memory */
+	ext_mem = &ctx->ext_mem[ctx->ext];
+	m->buf_addr = RTE_PTR_ADD(ext_mem->buf_ptr, ctx->off);
+	m->buf_iova = ext_mem->buf_iova == RTE_BAD_IOVA ?
+		      RTE_BAD_IOVA : ext_mem->buf_iova + ctx->off;
+
+	ctx->off += ext_mem->elt_size;
+	if (ctx->off + ext_mem->elt_size > ext_mem->buf_len) {
+		ctx->off = 0;
+		ctx->ext++;
+	}
+
+	/* keep some headroom between start of buffer and data */
+	m->data_off = RTE_MIN(RTE_PKTMBUF_HEADROOM, (uint16_t)m->buf_len);
+
+	/* init some constant fields */
+	m->pool = mp;
+	m->nb_segs = 1;
+	m->port = MBUF_INVALID_PORT;
+	m->ol_flags = EXT_ATTACHED_MBUF;
+	rte_mbuf_refcnt_set(m, 1);
+	m->next = NULL;
+
+	shinfo = RTE_PTR_ADD(m, mbuf_size);
+	shinfo->free_cb = rte_pktmbuf_free_pinned_extmem;
+	shinfo->fcb_opaque = m;
+	rte_mbuf_ext_refcnt_set(shinfo, 1);
+	m->shinfo = shinfo;
+}
+
+/* helper to create a mbuf pool with pinned external data buffers */
+struct rte_mempool *
+rte_pktmbuf_pool_create_extbuf(const char *name, unsigned int n,
+	unsigned int cache_size, uint16_t priv_size,
+	uint16_t data_room_size, int socket_id,
+	const struct rte_pktmbuf_extmem *ext_mem, unsigned int ext_num)
+{
+	struct rte_pktmbuf_extmem_init_ctx init_ctx;
+	struct rte_pktmbuf_pool_private *priv, mbp_priv;
+	struct rte_mempool *mp;
+	unsigned int elt_size, i;
+	uint64_t nb_bufs = 0;
+	int ret;
+
+	if (RTE_ALIGN(priv_size, RTE_MBUF_PRIV_ALIGN) != priv_size) {
+		RTE_LOG(ERR, MBUF, "mbuf priv_size=%u is not aligned\n",
+			priv_size);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (ext_mem == NULL || ext_num == 0) {
+		RTE_LOG(ERR, MBUF, "no external memory for mbuf pool\n");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	for (i = 0; i < ext_num; i++) {
+		if (ext_mem[i].buf_ptr == NULL ||
+		    ext_mem[i].elt_size < data_room_size ||
+		    ext_mem[i].elt_size == 0 ||
+		    ext_mem[i].buf_len < ext_mem[i].elt_size) {
+			RTE_LOG(ERR, MBUF, "invalid external memory area %u\n",
+				i);
+			rte_errno = EINVAL;
+			return NULL;
+		}
+		nb_bufs += ext_mem[i].buf_len / ext_mem[i].elt_size;
+	}
+	if (nb_bufs < n) {
+		RTE_LOG(ERR, MBUF,
+			"external memory holds %"PRIu64" buffers for %u mbufs\n",
+			nb_bufs, n);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	elt_size = sizeof(struct rte_mbuf) + (unsigned int)priv_size +
+		sizeof(struct rte_mbuf_ext_shared_info);
+	memset(&mbp_priv, 0, sizeof(mbp_priv));
+	mbp_priv.mbuf_data_room_size = data_room_size;
+	mbp_priv.mbuf_priv_size = priv_size;
+
+	mp = rte_mempool_create_empty(name, n, elt_size, cache_size,
+		 sizeof(struct rte_pktmbuf_pool_private), socket_id, 0);
+	if (mp == NULL)
+		return NULL;
+
+	ret = rte_mempool_set_ops_byname(mp, rte_mbuf_best_mempool_ops(),
+					 NULL);
+	if (ret != 0) {
+		RTE_LOG(ERR, MBUF, "error setting mempool handler\n");
+		rte_mempool_free(mp);
+		rte_errno = -ret;
+		return NULL;
+	}
+	rte_pktmbuf_pool_init(mp, &mbp_priv);
+	priv = rte_mempool_get_priv(mp);
+	priv->flags = RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF;
+
+	ret = rte_mempool_populate_default(mp);
+	if (ret < 0) {
+		rte_mempool_free(mp);
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	init_ctx = (struct rte_pktmbuf_extmem_init_ctx){
+		.ext_mem = ext_mem,
+		.ext_num = ext_num,
+		.ext = 0,
+		.off = 0,
+	};
+	rte_mempool_obj_iter(mp, rte_pktmbuf_init_extmem, &init_ctx);
+
+	return mp;
+}
+
 /* do some sanity checks on a mbuf: panic if it fails */
 void
 rte_mbuf_sanity_check(const struct rte_mbuf *m, int is_header)
@@ -246,6 +453,52 @@ int rte_mbuf_check(const struct rte_mbuf *m, int is_header,
 	return 0;
 }
 
+/* size of the table of segments waiting to be put back in a mempool */
+#define RTE_PKTMBUF_FREE_PENDING_SZ 64
+
+/* free a bulk of packet mbufs, putting back segments per mempool */
+void
+rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count)
+{
+	struct rte_mbuf *pending[RTE_PKTMBUF_FREE_PENDING_SZ];
+	struct rte_mempool *pool = NULL;
+	struct rte_mbuf *m, *m_next;
+	unsigned int idx, nb_pending = 0;
+
+	for (idx = 0; idx < count; idx++) {
+		m = mbufs[idx];
+		if (unlikely(m == NULL))
+			continue;
+
+		__rte_mbuf_sanity_check(m, 1);
+
+		do {
+			m_next = m->next;
+			m = rte_pktmbuf_prefree_seg(m);
+			if (likely(m != NULL)) {
+				if (unlikely(m->pool != pool)) {
+					if (nb_pending != 0)
+						rte_mempool_put_bulk(pool,
+							(void **)pending,
+							nb_pending);
+					nb_pending = 0;
+					pool = m->pool;
+				} else if (nb_pending == RTE_DIM(pending)) {
+					rte_mempool_put_bulk(pool,
+						(void **)pending, nb_pending);
+					nb_pending = 0;
+				}
+
+				pending[nb_pending++] = m;
+			}
+			m = m_next;
+		} while (m != NULL);
+	}
+
+	if (nb_pending != 0)
+		rte_mempool_put_bulk(pool, (void **)pending, nb_pending);
+}
+
 /* dump a mbuf on console */
 void
 rte_pktmbuf_dump(FILE *f, const struct rte_mbuf *m, unsigned dump_len)
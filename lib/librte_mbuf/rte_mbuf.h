@@ -910,8 +910,37 @@ rte_mbuf_to_priv(struct rte_mbuf *m)
 struct rte_pktmbuf_pool_private {
 	uint16_t mbuf_data_room_size; /**< Size of data space in each mbuf. */
 	uint16_t mbuf_priv_size;      /**< Size of private area in each mbuf. */
+	uint32_t flags; /**< RTE_PKTMBUF_POOL_F_* flags of the pool. */
 };
 
+/**
+ * Mbufs of the pool are always given back in the state left by
+ * rte_pktmbuf_reset(), so rte_pktmbuf_alloc_bulk() does not reset them.
+ *
+ * rte_pktmbuf_prefree_seg() resets the mbufs of such a pool, so all the
+ * free functions built on it put them back in reset state. Mbufs must not
+ * be returned to the pool by other means, such as rte_mbuf_raw_free() or
+ * DEV_TX_OFFLOAD_MBUF_FAST_FREE, unless they are already in reset state.
+ * The flag is given at creation with rte_pktmbuf_pool_create_with_flags().
+ *
+ * Checking the flag on each free has a cost for all the pools, so it is
+ * only supported when built with CONFIG_RTE_MBUF_FAST_FREE_POOL.
+ */
+#define RTE_PKTMBUF_POOL_F_FAST_FREE (1 << 0)
+
+/**
+ * Mbufs of the pool are permanently attached to external buffers, see
+ * rte_pktmbuf_pool_create_extbuf(). They are not detached when freed.
+ */
+#define RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF (1 << 1)
+
+/**
+ * Returns TRUE if given mbuf has a pinned external buffer, or FALSE
+ * otherwise. The mbuf must have an external buffer attached.
+ */
+#define RTE_MBUF_HAS_PINNED_EXTBUF(mb) \
+	(rte_pktmbuf_priv_flags((mb)->pool) & RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF)
+
 #ifdef RTE_LIBRTE_MBUF_DEBUG
 
 /**  check mbuf type in debug mode */
@@ -1163,9 +1192,9 @@ static inline struct rte_mbuf *rte_mbuf_raw_alloc(struct rte_mempool *mp)
 /**
  * Put mbuf back into its original mempool.
  *
- * The caller must ensure that the mbuf is direct and properly
- * reinitialized (refcnt=1, next=NULL, nb_segs=1), as done by
- * rte_pktmbuf_prefree_seg().
+ * The caller must ensure that the mbuf is direct, or has a pinned
+ * external buffer, and properly reinitialized (refcnt=1, next=NULL,
+ * nb_segs=1), as done by rte_pktmbuf_prefree_seg().
  *
  * This function should be used with care, when optimization is
  * required. For standard needs, prefer rte_pktmbuf_free() or
@@ -1177,7 +1206,8 @@ static inline struct rte_mbuf *rte_mbuf_raw_alloc(struct rte_mempool *mp)
 static __rte_always_inline void
 rte_mbuf_raw_free(struct rte_mbuf *m)
 {
-	RTE_ASSERT(RTE_MBUF_DIRECT(m));
+	RTE_ASSERT(!RTE_MBUF_CLONED(m) &&
+		  (!RTE_MBUF_HAS_EXTBUF(m) || RTE_MBUF_HAS_PINNED_EXTBUF(m)));
 	RTE_ASSERT(rte_mbuf_refcnt_read(m) == 1);
 	RTE_ASSERT(m->next == NULL);
 	RTE_ASSERT(m->nb_segs == 1);
@@ -1218,6 +1248,9 @@ void rte_pktmbuf_init(struct rte_mempool *mp, void *opaque_arg,
  * pool creation. It can be extended by the user, for example, to
  * provide another packet size.
  *
+ * The flags of the pool are cleared: the *flags* field of the given
+ * structure is ignored.
+ *
  * @param mp
  *   The mempool from which mbufs originate.
  * @param opaque_arg
@@ -1308,6 +1341,120 @@ rte_pktmbuf_pool_create_by_ops(const char *name, unsigned int n,
 	unsigned int cache_size, uint16_t priv_size, uint16_t data_room_size,
 	int socket_id, const char *ops_name);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a mbuf pool with a given mempool ops name and pool flags
+ *
+ * This function does the same as rte_pktmbuf_pool_create_by_ops(), and
+ * sets the given RTE_PKTMBUF_POOL_F_* flags in the pool private data.
+ *
+ * @param name
+ *   The name of the mbuf pool.
+ * @param n
+ *   The number of elements in the mbuf pool. The optimum size (in terms
+ *   of memory usage) for a mempool is when n is a power of two minus one:
+ *   n = (2^q - 1).
+ * @param cache_size
+ *   Size of the per-core object cache. See rte_mempool_create() for
+ *   details.
+ * @param priv_size
+ *   Size of application private are between the rte_mbuf structure
+ *   and the data buffer. This value must be aligned to RTE_MBUF_PRIV_ALIGN.
+ * @param data_room_size
+ *   Size of data buffer in each mbuf, including RTE_PKTMBUF_HEADROOM.
+ * @param socket_id
+ *   The socket identifier where the memory should be allocated. The
+ *   value can be *SOCKET_ID_ANY* if there is no NUMA constraint for the
+ *   reserved zone.
+ * @param ops_name
+ *   The mempool ops name to be used for this mempool instead of
+ *   default mempool. The value can be *NULL* to use default mempool.
+ * @param flags
+ *   The RTE_PKTMBUF_POOL_F_* flags of the pool. Only
+ *   RTE_PKTMBUF_POOL_F_FAST_FREE can be given, when built with
+ *   CONFIG_RTE_MBUF_FAST_FREE_POOL.
+ * @return
+ *   The pointer to the new allocated mempool, on success. NULL on error
+ *   with rte_errno set appropriately. Possible rte_errno values include:
+ *    - E_RTE_NO_CONFIG - function could not get pointer to rte_config structure
+ *    - E_RTE_SECONDARY - function was called from a secondary process instance
+ *    - EINVAL - cache size provided is too large, priv_size is not aligned,
+ *      or invalid flags.
+ *    - ENOTSUP - RTE_PKTMBUF_POOL_F_FAST_FREE given without
+ *      CONFIG_RTE_MBUF_FAST_FREE_POOL.
+ *    - ENOSPC - the maximum number of memzones has already been allocated
+ *    - EEXIST - a memzone with the same name already exists
+ *    - ENOMEM - no appropriate memory area found in which to create memzone
+ */
+struct rte_mempool * __rte_experimental
+rte_pktmbuf_pool_create_with_flags(const char *name, unsigned int n,
+	unsigned int cache_size, uint16_t priv_size, uint16_t data_room_size,
+	int socket_id, const char *ops_name, uint32_t flags);
+
+/** A memory area holding the pinned external buffers of a mbuf pool. */
+struct rte_pktmbuf_extmem {
+	void *buf_ptr;		/**< The virtual address of data buffer. */
+	rte_iova_t buf_iova;	/**< The IO address of the data buffer. */
+	size_t buf_len;		/**< External buffer length in bytes. */
+	uint16_t elt_size;	/**< mbuf element size in bytes. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a mbuf pool with pinned external buffers
+ *
+ * The data buffers of the mbufs are not in the mempool objects but in
+ * the given external memory areas: each area is cut into *elt_size*
+ * buffers, which are attached to the mbufs at creation time and stay
+ * attached for the lifetime of the pool (RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF).
+ * Each mbuf embeds the shared info of its buffer: cloning such a mbuf
+ * takes a reference on the buffer, and the mbuf goes back to the pool only
+ * when the last reference is released. The external memory is owned by
+ * the application and must outlive the pool.
+ *
+ * rte_pktmbuf_attach_extbuf() and rte_pktmbuf_detach() must not be used
+ * on mbufs of such a pool.
+ *
+ * @param name
+ *   The name of the mbuf pool.
+ * @param n
+ *   The number of elements in the mbuf pool.
+ * @param cache_size
+ *   Size of the per-core object cache. See rte_mempool_create() for
+ *   details.
+ * @param priv_size
+ *   Size of application private are between the rte_mbuf structure
+ *   and the data buffer. This value must be aligned to RTE_MBUF_PRIV_ALIGN.
+ * @param data_room_size
+ *   Size of data buffer in each mbuf, including RTE_PKTMBUF_HEADROOM.
+ *   It must not be larger than the *elt_size* of the memory areas.
+ * @param socket_id
+ *   The socket identifier where the memory should be allocated. The
+ *   value can be *SOCKET_ID_ANY* if there is no NUMA constraint for the
+ *   reserved zone.
+ * @param ext_mem
+ *   Pointer to the array of memory areas holding the data buffers.
+ * @param ext_num
+ *   Number of memory areas in the array.
+ * @return
+ *   The pointer to the new allocated mempool, on success. NULL on error
+ *   with rte_errno set appropriately. Possible rte_errno values include:
+ *    - EINVAL - invalid memory areas, or not enough buffers in them for
+ *      *n* mbufs, cache size is too large, or priv_size is not aligned.
+ *    - ENOSPC - the maximum number of memzones has already been allocated
+ *    - EEXIST - a memzone with the same name already exists
+ *    - ENOMEM - no appropriate memory area found in which to create memzone
+ */
+struct rte_mempool * __rte_experimental
+rte_pktmbuf_pool_create_extbuf(const char *name, unsigned int n,
+	unsigned int cache_size, uint16_t priv_size,
+	uint16_t data_room_size, int socket_id,
+	const struct rte_pktmbuf_extmem *ext_mem, unsigned int ext_num);
+
 /**
  * Get the data room size of mbufs stored in a pktmbuf_pool
  *
@@ -1349,6 +1496,23 @@ rte_pktmbuf_priv_size(struct rte_mempool *mp)
 	return mbp_priv->mbuf_priv_size;
 }
 
+/**
+ * Get the flags of a pktmbuf_pool
+ *
+ * @param mp
+ *   The packet mbuf pool.
+ * @return
+ *   The RTE_PKTMBUF_POOL_F_* flags of this mempool.
+ */
+static inline uint32_t
+rte_pktmbuf_priv_flags(struct rte_mempool *mp)
+{
+	struct rte_pktmbuf_pool_private *mbp_priv;
+
+	mbp_priv = (struct rte_pktmbuf_pool_private *)rte_mempool_get_priv(mp);
+	return mbp_priv->flags;
+}
+
 /**
  * Reset the data_off field of a packet mbuf to its default value.
  *
@@ -1366,7 +1530,8 @@ static inline void rte_pktmbuf_reset_headroom(struct rte_mbuf *m)
 /**
  * Reset the fields of a packet mbuf to their default values.
  *
- * The given mbuf must have only one segment.
+ * The given mbuf must have only one segment. The EXT_ATTACHED_MBUF flag is
+ * kept, as the mbuf stays attached to its external buffer, if any.
  *
  * @param m
  *   The packet mbuf to be resetted.
@@ -1383,7 +1548,7 @@ static inline void rte_pktmbuf_reset(struct rte_mbuf *m)
 	m->nb_segs = 1;
 	m->port = MBUF_INVALID_PORT;
 
-	m->ol_flags = 0;
+	m->ol_flags &= EXT_ATTACHED_MBUF;
 	m->packet_type = 0;
 	rte_pktmbuf_reset_headroom(m);
 
@@ -1416,6 +1581,10 @@ static inline struct rte_mbuf *rte_pktmbuf_alloc(struct rte_mempool *mp)
  * Allocate a bulk of mbufs, initialize refcnt and reset the fields to default
  * values.
  *
+ * The fields are not reset if the pool has the RTE_PKTMBUF_POOL_F_FAST_FREE
+ * flag, as its mbufs are already in reset state (only when built with
+ * CONFIG_RTE_MBUF_FAST_FREE_POOL).
+ *
  *  @param pool
  *    The mempool from which mbufs are allocated.
  *  @param mbufs
@@ -1436,6 +1605,16 @@ static inline int rte_pktmbuf_alloc_bulk(struct rte_mempool *pool,
 	if (unlikely(rc))
 		return rc;
 
+#ifdef RTE_MBUF_FAST_FREE_POOL
+	if (rte_pktmbuf_priv_flags(pool) & RTE_PKTMBUF_POOL_F_FAST_FREE) {
+		for (idx = 0; idx < count; idx++) {
+			MBUF_RAW_ALLOC_CHECK(mbufs[idx]);
+			__rte_mbuf_sanity_check(mbufs[idx], 1);
+		}
+		return 0;
+	}
+#endif
+
 	/* To understand duff's device on loop unwinding optimization, see
 	 * https://en.wikipedia.org/wiki/Duff's_device.
 	 * Here while() loop is used rather than do() while{} to avoid extra
@@ -1725,10 +1904,14 @@ static inline void rte_pktmbuf_detach(struct rte_mbuf *m)
 	uint32_t mbuf_size, buf_len;
 	uint16_t priv_size;
 
-	if (RTE_MBUF_HAS_EXTBUF(m))
+	if (RTE_MBUF_HAS_EXTBUF(m)) {
+		/* a pinned external buffer is never detached */
+		if (RTE_MBUF_HAS_PINNED_EXTBUF(m))
+			return;
 		__rte_pktmbuf_free_extbuf(m);
-	else
+	} else {
 		__rte_pktmbuf_free_direct(m);
+	}
 
 	priv_size = rte_pktmbuf_priv_size(mp);
 	mbuf_size = (uint32_t)(sizeof(struct rte_mbuf) + priv_size);
@@ -1743,13 +1926,67 @@ static inline void rte_pktmbuf_detach(struct rte_mbuf *m)
 	m->ol_flags = 0;
 }
 
+/**
+ * @internal Handle the pinned external buffer of a mbuf being freed.
+ *
+ * The pinned buffer shared info is embedded in the mbuf, and holds one
+ * reference for the mbuf itself plus one for each attached clone.
+ *
+ * @param m
+ *   The mbuf with a pinned external buffer.
+ * @return
+ *   - (0) if the mbuf can be returned to its pool.
+ *   - (1) if clones still reference the buffer; the mbuf is returned to
+ *     its pool when the last clone is freed.
+ */
+static inline int
+__rte_pktmbuf_pinned_extbuf_decref(struct rte_mbuf *m)
+{
+	struct rte_mbuf_ext_shared_info *shinfo = m->shinfo;
+
+	/* the mbuf is being freed, only keep the buffer flag */
+	m->ol_flags = EXT_ATTACHED_MBUF;
+
+	if (likely(rte_mbuf_ext_refcnt_read(shinfo) == 1))
+		return 0;
+
+	if (rte_mbuf_ext_refcnt_update(shinfo, -1) != 0)
+		return 1;
+
+	/* the clones went away meanwhile */
+	rte_mbuf_ext_refcnt_set(shinfo, 1);
+	return 0;
+}
+
+/**
+ * @internal Reset a mbuf segment about to be put back in its pool:
+ * completely for RTE_PKTMBUF_POOL_F_FAST_FREE pools, only the chaining
+ * otherwise. The pool is only looked at when built with
+ * CONFIG_RTE_MBUF_FAST_FREE_POOL.
+ */
+static __rte_always_inline void
+__rte_pktmbuf_prefree_reset(struct rte_mbuf *m)
+{
+#ifdef RTE_MBUF_FAST_FREE_POOL
+	if (rte_pktmbuf_priv_flags(m->pool) & RTE_PKTMBUF_POOL_F_FAST_FREE) {
+		rte_pktmbuf_reset(m);
+		return;
+	}
+#endif
+	if (m->next != NULL) {
+		m->next = NULL;
+		m->nb_segs = 1;
+	}
+}
+
 /**
  * Decrease reference counter and unlink a mbuf segment
  *
  * This function does the same than a free, except that it does not
  * return the segment to its pool.
  * It decreases the reference counter, and if it reaches 0, it is
- * detached from its parent for an indirect mbuf.
+ * detached from its parent for an indirect mbuf. The segment of a
+ * RTE_PKTMBUF_POOL_F_FAST_FREE pool is reset.
  *
  * @param m
  *   The mbuf to be unlinked
@@ -1764,26 +2001,34 @@ rte_pktmbuf_prefree_seg(struct rte_mbuf *m)
 
 	if (likely(rte_mbuf_refcnt_read(m) == 1)) {
 
-		if (!RTE_MBUF_DIRECT(m))
+		if (!RTE_MBUF_DIRECT(m)) {
 			rte_pktmbuf_detach(m);
-
-		if (m->next != NULL) {
-			m->next = NULL;
-			m->nb_segs = 1;
+			if (RTE_MBUF_HAS_EXTBUF(m) &&
+			    RTE_MBUF_HAS_PINNED_EXTBUF(m) &&
+			    __rte_pktmbuf_pinned_extbuf_decref(m))
+				return NULL;
 		}
 
+		__rte_pktmbuf_prefree_reset(m);
+
 		return m;
 
 	} else if (__rte_mbuf_refcnt_update(m, -1) == 0) {
 
-		if (!RTE_MBUF_DIRECT(m))
-			rte_pktmbuf_detach(m);
+		/* an mbuf is always put back with a refcnt of 1, also later
+		 * by the free callback of a pinned buffer still in use
+		 */
+		rte_mbuf_refcnt_set(m, 1);
 
-		if (m->next != NULL) {
-			m->next = NULL;
-			m->nb_segs = 1;
+		if (!RTE_MBUF_DIRECT(m)) {
+			rte_pktmbuf_detach(m);
+			if (RTE_MBUF_HAS_EXTBUF(m) &&
+			    RTE_MBUF_HAS_PINNED_EXTBUF(m) &&
+			    __rte_pktmbuf_pinned_extbuf_decref(m))
+				return NULL;
 		}
-		rte_mbuf_refcnt_set(m, 1);
+
+		__rte_pktmbuf_prefree_reset(m);
 
 		return m;
 	}
@@ -1830,6 +2075,25 @@ static inline void rte_pktmbuf_free(struct rte_mbuf *m)
 	}
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a bulk of packet mbufs back into their original mempools.
+ *
+ * Free a bulk of mbufs, and all their segments in case of chained buffers.
+ * Consecutive segments coming from the same mempool are put back together
+ * with rte_mempool_put_bulk(), so the bulk is best sorted by pool.
+ *
+ *  @param mbufs
+ *    Array of pointers to packet mbufs.
+ *    The array may contain NULL pointers.
+ *  @param count
+ *    Array size.
+ */
+void __rte_experimental
+rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count);
+
 /**
  * Creates a "clone" of the given packet mbuf.
  *
@@ -40,6 +40,11 @@ static struct rte_tailq_elem rte_mempool_tailq = {
 };
 EAL_REGISTER_TAILQ(rte_mempool_tailq)
 
+RTE_TRACE_POINT_DEFINE(rte_mempool_trace_put, "lib.mempool.put",
+		"mempool", "cache", "nb_objs");
+RTE_TRACE_POINT_DEFINE(rte_mempool_trace_get, "lib.mempool.get",
+		"mempool", "cache", "nb_objs", "nb_got");
+
 #define CACHE_FLUSHTHRESH_MULTIPLIER 1.5
 #define CALC_CACHE_FLUSHTHRESH(c)	\
 	((typeof(c))((c) * CACHE_FLUSHTHRESH_MULTIPLIER))
@@ -730,13 +735,111 @@ rte_mempool_free(struct rte_mempool *mp)
 }
 
 static void
-mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
+mempool_cache_set_size(struct rte_mempool_cache *cache, uint32_t size)
 {
 	cache->size = size;
 	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+}
+
+static void
+mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
+{
+	mempool_cache_set_size(cache, size);
 	cache->len = 0;
 }
 
+/* adaptive caches start small and grow up to the requested size */
+static void
+mempool_cache_init_adaptive(struct rte_mempool_cache *cache, uint32_t size)
+{
+	cache->max_size = size;
+	cache->min_size = RTE_MAX(size / 8, 1U);
+	cache->win_ops = 0;
+	cache->win_miss = 0;
+	cache->win_low = 0;
+	mempool_cache_init(cache, cache->min_size);
+}
+
+/* resize an adaptive cache at the end of an observation window */
+void
+rte_mempool_cache_adapt(struct rte_mempool *mp,
+			struct rte_mempool_cache *cache)
+{
+	uint32_t size = cache->size;
+
+	if (cache->win_miss * RTE_MEMPOOL_CACHE_ADAPT_MISS_RATIO >
+			cache->win_ops) {
+		/* too many accesses to the common pool */
+		size = RTE_MIN(size * 2, cache->max_size);
+	} else if (cache->win_miss == 0 && cache->win_low >= size / 2) {
+		/* half of the cache was not used during the whole window */
+		size = RTE_MAX(size / 2, cache->min_size);
+	}
+
+	if (size > cache->size) {
+		cache->stats.grow++;
+	} else if (size < cache->size) {
+		cache->stats.shrink++;
+		if (cache->len > size) {
+			rte_mempool_ops_enqueue_bulk(mp, &cache->objs[size],
+					cache->len - size);
+			cache->len = size;
+		}
+	}
+
+	mempool_cache_set_size(cache, size);
+	cache->win_ops = 0;
+	cache->win_miss = 0;
+	cache->win_low = cache->len;
+}
+
+/* get the statistics of one or all default caches */
+int
+rte_mempool_cache_stats_get(const struct rte_mempool *mp, unsigned int lcore_id,
+			    struct rte_mempool_cache_stats *stats)
+{
+	const struct rte_mempool_cache_stats *cs;
+	unsigned int i;
+
+	if (mp->cache_size == 0 || !(mp->flags & MEMPOOL_F_CACHE_ADAPTIVE) ||
+			stats == NULL)
+		return -EINVAL;
+
+	if (lcore_id != LCORE_ID_ANY) {
+		if (lcore_id >= RTE_MAX_LCORE)
+			return -EINVAL;
+		*stats = mp->local_cache[lcore_id].stats;
+		return 0;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		cs = &mp->local_cache[i].stats;
+		stats->get_hit += cs->get_hit;
+		stats->get_miss += cs->get_miss;
+		stats->put_hit += cs->put_hit;
+		stats->put_flush += cs->put_flush;
+		stats->grow += cs->grow;
+		stats->shrink += cs->shrink;
+	}
+
+	return 0;
+}
+
+/* reset the statistics of all default caches */
+void
+rte_mempool_cache_stats_reset(struct rte_mempool *mp)
+{
+	unsigned int i;
+
+	if (mp->cache_size == 0)
+		return;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		memset(&mp->local_cache[i].stats, 0,
+		       sizeof(mp->local_cache[i].stats));
+}
+
 /*
  * Create and initialize a cache for objects that are retrieved from and
  * returned to an underlying mempool. This structure is identical to the
@@ -890,7 +993,11 @@ rte_mempool_create_empty(const char *name, unsigned n, unsigned elt_size,
 		RTE_PTR_ADD(mp, MEMPOOL_HEADER_SIZE(mp, 0));
 
 	/* Init all default caches. */
-	if (cache_size != 0) {
+	if (cache_size != 0 && (flags & MEMPOOL_F_CACHE_ADAPTIVE)) {
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+			mempool_cache_init_adaptive(&mp->local_cache[lcore_id],
+						    cache_size);
+	} else if (cache_size != 0) {
 		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
 			mempool_cache_init(&mp->local_cache[lcore_id],
 					   cache_size);
@@ -997,6 +1104,7 @@ rte_mempool_in_use_count(const struct rte_mempool *mp)
 static unsigned
 rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 {
+	struct rte_mempool_cache_stats stats;
 	unsigned lcore_id;
 	unsigned count = 0;
 	unsigned cache_count;
@@ -1011,9 +1119,23 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 		cache_count = mp->local_cache[lcore_id].len;
 		fprintf(f, "    cache_count[%u]=%"PRIu32"\n",
 			lcore_id, cache_count);
+		if (mp->flags & MEMPOOL_F_CACHE_ADAPTIVE)
+			fprintf(f, "    cache_cur_size[%u]=%"PRIu32"\n",
+				lcore_id, mp->local_cache[lcore_id].size);
 		count += cache_count;
 	}
 	fprintf(f, "    total_cache_count=%u\n", count);
+
+	if (rte_mempool_cache_stats_get(mp, LCORE_ID_ANY, &stats) < 0)
+		return count;
+
+	fprintf(f, "    cache_stats:\n");
+	fprintf(f, "      get_hit=%"PRIu64"\n", stats.get_hit);
+	fprintf(f, "      get_miss=%"PRIu64"\n", stats.get_miss);
+	fprintf(f, "      put_hit=%"PRIu64"\n", stats.put_hit);
+	fprintf(f, "      put_flush=%"PRIu64"\n", stats.put_flush);
+	fprintf(f, "      grow=%"PRIu64"\n", stats.grow);
+	fprintf(f, "      shrink=%"PRIu64"\n", stats.shrink);
 	return count;
 }
 
@@ -1120,6 +1242,45 @@ rte_mempool_contig_blocks_check_cookies(const struct rte_mempool *mp,
 #endif
 }
 
+/* get objects from one contiguous block, or from the bulk path */
+int
+rte_mempool_get_contig_objs(struct rte_mempool *mp, void **obj_table,
+			    unsigned int n)
+{
+	const size_t total_elt_sz =
+		mp->header_size + mp->elt_size + mp->trailer_size;
+	struct rte_mempool_info info;
+	void *tail[RTE_MEMPOOL_CACHE_MAX_SIZE];
+	void *first_obj;
+	unsigned int i, j;
+
+	if (n > 1 && rte_mempool_ops_get_info(mp, &info) == 0 &&
+	    n <= info.contig_block_size &&
+	    rte_mempool_get_contig_blocks(mp, &first_obj, 1) == 0) {
+		for (i = 0; i < n; i++)
+			obj_table[i] = RTE_PTR_ADD(first_obj, i * total_elt_sz);
+
+		/* give back the objects of the block we do not need */
+		for (j = 0; i < info.contig_block_size; i++) {
+			tail[j++] = RTE_PTR_ADD(first_obj, i * total_elt_sz);
+			if (j == RTE_DIM(tail)) {
+				rte_mempool_generic_put(mp, tail, j, NULL);
+				j = 0;
+			}
+		}
+		if (j > 0)
+			rte_mempool_generic_put(mp, tail, j, NULL);
+
+		return 1;
+	}
+
+	if (rte_mempool_get_bulk(mp, obj_table, n) < 0)
+		return -ENOBUFS;
+
+	/* a single object is always contiguous */
+	return n == 1;
+}
+
 #ifdef RTE_LIBRTE_MEMPOOL_DEBUG
 static void
 mempool_obj_audit(struct rte_mempool *mp, __rte_unused void *opaque,
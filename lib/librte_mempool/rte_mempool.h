@@ -50,6 +50,7 @@
 #include <rte_ring.h>
 #include <rte_memcpy.h>
 #include <rte_common.h>
+#include <rte_trace.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,6 +78,32 @@ struct rte_mempool_debug_stats {
 } __rte_cache_aligned;
 #endif
 
+/**
+ * A structure that stores the statistics of a per-core object cache.
+ *
+ * Unlike struct rte_mempool_debug_stats, these counters do not depend on
+ * RTE_LIBRTE_MEMPOOL_DEBUG, but they are only maintained for the mempools
+ * created with MEMPOOL_F_CACHE_ADAPTIVE. They are only updated by the
+ * lcore owning the cache, without atomic operations.
+ */
+struct rte_mempool_cache_stats {
+	uint64_t get_hit;   /**< Gets served from the cache only. */
+	uint64_t get_miss;  /**< Gets that had to access the common pool. */
+	uint64_t put_hit;   /**< Puts stored in the cache only. */
+	uint64_t put_flush; /**< Puts that had to access the common pool. */
+	uint64_t grow;      /**< Number of adaptive cache size increases. */
+	uint64_t shrink;    /**< Number of adaptive cache size decreases. */
+};
+
+/** Number of cache accesses between two adaptive cache size updates. */
+#define RTE_MEMPOOL_CACHE_ADAPT_WINDOW 1024
+
+/**
+ * The adaptive cache grows when more than 1 out of
+ * RTE_MEMPOOL_CACHE_ADAPT_MISS_RATIO accesses reach the common pool.
+ */
+#define RTE_MEMPOOL_CACHE_ADAPT_MISS_RATIO 16
+
 /**
  * A structure that stores a per-core object cache.
  */
@@ -84,6 +111,16 @@ struct rte_mempool_cache {
 	uint32_t size;	      /**< Size of the cache */
 	uint32_t flushthresh; /**< Threshold before we flush excess elements */
 	uint32_t len;	      /**< Current cache count */
+	/*
+	 * Adaptive sizing state, see MEMPOOL_F_CACHE_ADAPTIVE. max_size is
+	 * zero when the cache size is fixed.
+	 */
+	uint32_t min_size;    /**< Lower bound of the adaptive cache size */
+	uint32_t max_size;    /**< Upper bound of the adaptive cache size */
+	uint32_t win_ops;     /**< Accesses in the current window */
+	uint32_t win_miss;    /**< Common pool accesses in the current window */
+	uint32_t win_low;     /**< Lowest cache count in the current window */
+	struct rte_mempool_cache_stats stats; /**< Cache statistics */
 	/*
 	 * Cache is allocated to this size to allow it to overflow in certain
 	 * cases to avoid needless emptying of cache.
@@ -264,6 +301,7 @@ struct rte_mempool {
 #define MEMPOOL_F_POOL_CREATED   0x0010 /**< Internal: pool is created. */
 #define MEMPOOL_F_NO_IOVA_CONTIG 0x0020 /**< Don't need IOVA contiguous objs. */
 #define MEMPOOL_F_NO_PHYS_CONTIG MEMPOOL_F_NO_IOVA_CONTIG /* deprecated */
+#define MEMPOOL_F_CACHE_ADAPTIVE 0x0040 /**< Per-lcore cache size adapts to load. */
 
 /**
  * @internal When debug is enabled, store some statistics.
@@ -668,6 +706,7 @@ rte_mempool_ops_dequeue_bulk(struct rte_mempool *mp,
  *   Number of blocks to get.
  * @return
  *   - 0: Success; got n objects.
+ *   - -EOPNOTSUPP: The mempool driver does not support block dequeue.
  *   - <0: Error; code of dequeue function.
  */
 static inline int
@@ -677,7 +716,8 @@ rte_mempool_ops_dequeue_contig_blocks(struct rte_mempool *mp,
 	struct rte_mempool_ops *ops;
 
 	ops = rte_mempool_get_ops(mp->ops_index);
-	RTE_ASSERT(ops->dequeue_contig_blocks != NULL);
+	if (unlikely(ops->dequeue_contig_blocks == NULL))
+		return -EOPNOTSUPP;
 	return ops->dequeue_contig_blocks(mp, first_obj_table, n);
 }
 
@@ -934,6 +974,11 @@ typedef void (rte_mempool_ctor_t)(struct rte_mempool *, void *);
  *     "single-consumer". Otherwise, it is "multi-consumers".
  *   - MEMPOOL_F_NO_IOVA_CONTIG: If set, allocated objects won't
  *     necessarily be contiguous in IO memory.
+ *   - MEMPOOL_F_CACHE_ADAPTIVE: If set, *cache_size* is the maximum size
+ *     of the per-lcore caches. Each cache starts at 1/8 of it and is
+ *     doubled when too many of its gets and puts reach the common pool,
+ *     or halved, giving the unused objects back, when part of it stayed
+ *     unused. See rte_mempool_cache_stats_get().
  * @return
  *   The pointer to the new allocated mempool, on success. NULL on error
  *   with rte_errno set appropriately. Possible rte_errno values include:
@@ -1164,6 +1209,95 @@ rte_mempool_cache_create(uint32_t size, int socket_id);
 void
 rte_mempool_cache_free(struct rte_mempool_cache *cache);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the statistics of the per-lcore default mempool caches.
+ *
+ * The statistics are maintained whether RTE_LIBRTE_MEMPOOL_DEBUG is
+ * enabled or not, for the mempools created with MEMPOOL_F_CACHE_ADAPTIVE
+ * only. They are updated without atomic operations by the lcore owning the
+ * cache, so the values read from another lcore may be slightly outdated.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param lcore_id
+ *   The logical core id, or LCORE_ID_ANY to get the sum of the statistics
+ *   of all lcores.
+ * @param stats
+ *   A pointer to a structure filled with the statistics.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: The mempool has no adaptive default cache or lcore_id is
+ *     invalid.
+ */
+int __rte_experimental
+rte_mempool_cache_stats_get(const struct rte_mempool *mp, unsigned int lcore_id,
+			    struct rte_mempool_cache_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset the statistics of all the per-lcore default mempool caches.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ */
+void __rte_experimental
+rte_mempool_cache_stats_reset(struct rte_mempool *mp);
+
+/**
+ * @internal Update the size of an adaptive mempool cache at the end of an
+ * observation window, flushing the objects in excess to the mempool when
+ * it shrinks.
+ * It is a stable symbol, as the inline get and put functions call it.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to the adaptive mempool cache.
+ */
+void
+rte_mempool_cache_adapt(struct rte_mempool *mp,
+			struct rte_mempool_cache *cache);
+
+/**
+ * @internal Account an access to the cache of a MEMPOOL_F_CACHE_ADAPTIVE
+ * mempool and resize it at the end of the observation window. Nothing is
+ * done for the other mempools.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param stat
+ *   A pointer to the cache statistics counter of the access.
+ * @param miss
+ *   Non-zero if the access reached the common pool.
+ */
+static __rte_always_inline void
+__mempool_cache_adapt_tick(struct rte_mempool *mp,
+			   struct rte_mempool_cache *cache, uint64_t *stat,
+			   int miss)
+{
+	if (likely(!(mp->flags & MEMPOOL_F_CACHE_ADAPTIVE)))
+		return;
+
+	(*stat)++;
+	if (cache->len < cache->win_low)
+		cache->win_low = cache->len;
+
+	/* the user-owned caches have a fixed size */
+	if (cache->max_size == 0)
+		return;
+
+	cache->win_miss += miss;
+	if (unlikely(++cache->win_ops >= RTE_MEMPOOL_CACHE_ADAPT_WINDOW))
+		rte_mempool_cache_adapt(mp, cache);
+}
+
 /**
  * Get a pointer to the per-lcore default mempool cache.
  *
@@ -1206,6 +1340,11 @@ rte_mempool_cache_flush(struct rte_mempool_cache *cache,
 	cache->len = 0;
 }
 
+/** @internal Tracepoint of rte_mempool_generic_put(). */
+extern rte_trace_point_t rte_mempool_trace_put;
+/** @internal Tracepoint of rte_mempool_generic_get(). */
+extern rte_trace_point_t rte_mempool_trace_get;
+
 /**
  * @internal Put several objects back in the mempool; used internally.
  * @param mp
@@ -1228,9 +1367,15 @@ __mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 	__MEMPOOL_STAT_ADD(mp, put, n);
 
 	/* No cache provided or if put would overflow mem allocated for cache */
-	if (unlikely(cache == NULL || n > RTE_MEMPOOL_CACHE_MAX_SIZE))
+	if (unlikely(cache == NULL))
 		goto ring_enqueue;
 
+	if (unlikely(n > RTE_MEMPOOL_CACHE_MAX_SIZE)) {
+		__mempool_cache_adapt_tick(mp, cache,
+					   &cache->stats.put_flush, 1);
+		goto ring_enqueue;
+	}
+
 	cache_objs = &cache->objs[cache->len];
 
 	/*
@@ -1249,6 +1394,11 @@ __mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[cache->size],
 				cache->len - cache->size);
 		cache->len = cache->size;
+		__mempool_cache_adapt_tick(mp, cache,
+					   &cache->stats.put_flush, 1);
+	} else {
+		__mempool_cache_adapt_tick(mp, cache,
+					   &cache->stats.put_hit, 0);
 	}
 
 	return;
@@ -1283,6 +1433,8 @@ rte_mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 {
 	__mempool_check_cookies(mp, obj_table, n, 0);
 	__mempool_generic_put(mp, obj_table, n, cache);
+	rte_trace_point_emit_fp(&rte_mempool_trace_put, (uintptr_t)mp,
+			(uintptr_t)cache, n, 0);
 }
 
 /**
@@ -1347,11 +1499,19 @@ __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 	int ret;
 	uint32_t index, len;
 	void **cache_objs;
+	int miss = 0;
 
-	/* No cache provided or cannot be satisfied from cache */
-	if (unlikely(cache == NULL || n >= cache->size))
+	/* No cache provided */
+	if (unlikely(cache == NULL))
 		goto ring_dequeue;
 
+	/* Cannot be satisfied from cache */
+	if (unlikely(n >= cache->size)) {
+		__mempool_cache_adapt_tick(mp, cache,
+					   &cache->stats.get_miss, 1);
+		goto ring_dequeue;
+	}
+
 	cache_objs = cache->objs;
 
 	/* Can this be satisfied from the cache? */
@@ -1369,10 +1529,13 @@ __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 			 * the ring directly. If that fails, we are truly out of
 			 * buffers.
 			 */
+			__mempool_cache_adapt_tick(mp, cache,
+						   &cache->stats.get_miss, 1);
 			goto ring_dequeue;
 		}
 
 		cache->len += req;
+		miss = 1;
 	}
 
 	/* Now fill in the response ... */
@@ -1381,6 +1544,9 @@ __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 
 	cache->len -= n;
 
+	__mempool_cache_adapt_tick(mp, cache, miss ? &cache->stats.get_miss :
+				   &cache->stats.get_hit, miss);
+
 	__MEMPOOL_STAT_ADD(mp, get_success, n);
 
 	return 0;
@@ -1426,6 +1592,8 @@ rte_mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 	ret = __mempool_generic_get(mp, obj_table, n, cache);
 	if (ret == 0)
 		__mempool_check_cookies(mp, obj_table, n, 1);
+	rte_trace_point_emit_fp(&rte_mempool_trace_get, (uintptr_t)mp,
+			(uintptr_t)cache, n, ret == 0 ? n : 0);
 	return ret;
 }
 
@@ -1528,6 +1696,42 @@ rte_mempool_get_contig_blocks(struct rte_mempool *mp,
 	return ret;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get several objects laid out contiguously in memory from the mempool.
+ *
+ * When the mempool driver provides blocks of at least *n* contiguous
+ * objects (see `contig_block_size` in rte_mempool_ops_get_info()), the
+ * objects are taken from a single block: they are then virtually
+ * contiguous and obj_table[i] is obj_table[0] plus i times the object
+ * stride (mp->header_size + mp->elt_size + mp->trailer_size). They are
+ * not necessarily IOVA-contiguous, a block being only guaranteed to lie
+ * in one memory chunk of the pool. The unused tail of the block is
+ * returned to the pool.
+ *
+ * Otherwise, or if no block is available, the function falls back to
+ * rte_mempool_get_bulk() and the objects are not necessarily contiguous.
+ * In both cases *obj_table* is filled with the *n* objects, so the caller
+ * only has to check the return value to know whether it can use a base
+ * address and a stride instead of the table.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects) that will be filled.
+ * @param n
+ *   The number of objects to get from the mempool.
+ * @return
+ *   - 1: Success; objects taken and contiguous.
+ *   - 0: Success; objects taken, not necessarily contiguous.
+ *   - -ENOBUFS: Not enough entries in the mempool; no object is retrieved.
+ */
+int __rte_experimental
+rte_mempool_get_contig_objs(struct rte_mempool *mp, void **obj_table,
+			    unsigned int n);
+
 /**
  * Return the number of entries in the mempool.
  *
@@ -0,0 +1,314 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_RIB_H_
+#define _RTE_RIB_H_
+
+/**
+ * @file
+ *
+ * RTE IPv4 Routing Information Base
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * The RIB stores the routes in a path compressed binary trie, each node
+ * holding a prefix, a next hop and an optional user data area. It serves
+ * the control plane: the cost of an insertion, a removal or a lookup is
+ * bounded by the depth of the trie, whatever the number of routes, and the
+ * more specific routes of a prefix are found by walking its subtree. The
+ * FIB library builds its lookup tables from a RIB.
+ *
+ * The RIB is not thread safe, the application is responsible for the
+ * synchronization of the updates and lookups.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum depth value possible for IPv4 RIB. */
+#define RTE_RIB_MAXDEPTH	32
+
+/** Flags of rte_rib_get_nxt() */
+enum {
+	/** Get all the more specific routes */
+	RTE_RIB_GET_NXT_ALL,
+	/** Get only the more specific routes not covered by another one */
+	RTE_RIB_GET_NXT_COVER
+};
+
+struct rte_rib;
+struct rte_rib_node;
+
+/** RIB configuration structure */
+struct rte_rib_conf {
+	/** Size of the user data area in each node, in bytes. */
+	size_t ext_sz;
+	/** Maximum number of nodes, up to twice the number of routes. */
+	int max_nodes;
+};
+
+/**
+ * Get an IPv4 mask from a prefix length.
+ *
+ * @param depth
+ *   Prefix length, from 0 to 32.
+ * @return
+ *   IPv4 mask, in host byte order.
+ */
+static inline uint32_t
+rte_rib_depth_to_mask(uint8_t depth)
+{
+	return (uint32_t)(UINT64_MAX << (32 - depth));
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup the longest prefix match of an IP address.
+ *
+ * @param rib
+ *   RIB object handle.
+ * @param ip
+ *   IP address to lookup, in host byte order.
+ * @return
+ *   Node of the longest matching route, NULL if there is none.
+ */
+struct rte_rib_node * __rte_experimental
+rte_rib_lookup(struct rte_rib *rib, uint32_t ip);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup the route covering a route.
+ *
+ * @param ent
+ *   Node of a route.
+ * @return
+ *   Node of the longest route covering the route, NULL if there is none.
+ */
+struct rte_rib_node * __rte_experimental
+rte_rib_lookup_parent(struct rte_rib_node *ent);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup a route.
+ *
+ * @param rib
+ *   RIB object handle.
+ * @param ip
+ *   Prefix of the route, in host byte order.
+ * @param depth
+ *   Prefix length of the route.
+ * @return
+ *   Node of the route, NULL if it does not exist.
+ */
+struct rte_rib_node * __rte_experimental
+rte_rib_lookup_exact(struct rte_rib *rib, uint32_t ip, uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Iterate on the routes more specific than a prefix, in increasing order
+ * of their addresses.
+ *
+ * @param rib
+ *   RIB object handle.
+ * @param ip
+ *   Prefix to iterate on, in host byte order.
+ * @param depth
+ *   Prefix length, the prefix itself is not part of the iteration.
+ * @param last
+ *   Node returned by the previous call, NULL to get the first route.
+ * @param flag
+ *   RTE_RIB_GET_NXT_ALL to iterate on all the more specific routes,
+ *   RTE_RIB_GET_NXT_COVER to skip the routes covered by another one.
+ * @return
+ *   Node of the next route, NULL at the end of the iteration.
+ */
+struct rte_rib_node * __rte_experimental
+rte_rib_get_nxt(struct rte_rib *rib, uint32_t ip, uint8_t depth,
+	struct rte_rib_node *last, int flag);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Remove a route.
+ *
+ * @param rib
+ *   RIB object handle.
+ * @param ip
+ *   Prefix of the route, in host byte order.
+ * @param depth
+ *   Prefix length of the route.
+ */
+void __rte_experimental
+rte_rib_remove(struct rte_rib *rib, uint32_t ip, uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a route, with a next hop of 0.
+ *
+ * @param rib
+ *   RIB object handle.
+ * @param ip
+ *   Prefix of the route, in host byte order.
+ * @param depth
+ *   Prefix length of the route.
+ * @return
+ *   Node of the new route, NULL on error with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if the route already exists
+ *   - ENOMEM if the maximum number of nodes is reached
+ */
+struct rte_rib_node * __rte_experimental
+rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the prefix of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param ip
+ *   Pointer to the prefix to fill, in host byte order.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib_get_ip(const struct rte_rib_node *node, uint32_t *ip);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the prefix length of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param depth
+ *   Pointer to the prefix length to fill.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib_get_depth(const struct rte_rib_node *node, uint8_t *depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the user data area of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @return
+ *   Pointer to the user data area of the node, of the size given in the
+ *   RIB configuration.
+ */
+void * __rte_experimental
+rte_rib_get_ext(struct rte_rib_node *node);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the next hop of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param nh
+ *   Pointer to the next hop to fill.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib_get_nh(const struct rte_rib_node *node, uint64_t *nh);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Set the next hop of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param nh
+ *   Next hop.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib_set_nh(struct rte_rib_node *node, uint64_t nh);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a RIB.
+ *
+ * @param name
+ *   RIB name.
+ * @param socket_id
+ *   NUMA socket ID for the RIB memory allocation.
+ * @param conf
+ *   Structure containing the configuration.
+ * @return
+ *   Handle to the RIB object on success, NULL otherwise with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if a RIB with the same name already exists
+ *   - ENOMEM if the memory cannot be allocated
+ */
+struct rte_rib * __rte_experimental
+rte_rib_create(const char *name, int socket_id,
+	const struct rte_rib_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Find an existing RIB object and return a pointer to it.
+ *
+ * @param name
+ *   Name of the RIB object as passed to rte_rib_create().
+ * @return
+ *   Pointer to the RIB object, NULL with rte_errno set to ENOENT if it does
+ *   not exist.
+ */
+struct rte_rib * __rte_experimental
+rte_rib_find_existing(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a RIB object.
+ *
+ * @param rib
+ *   RIB object handle created with rte_rib_create().
+ *   If rib is NULL, no operation is performed.
+ */
+void __rte_experimental
+rte_rib_free(struct rte_rib *rib);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RIB_H_ */
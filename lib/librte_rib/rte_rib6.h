@@ -0,0 +1,364 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_RIB6_H_
+#define _RTE_RIB6_H_
+
+/**
+ * @file
+ *
+ * RTE IPv6 Routing Information Base
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * The IPv6 counterpart of the RIB: the routes are stored in a path
+ * compressed binary trie, so that the cost of an update or a lookup is
+ * bounded by the 128 bits of the addresses. The IPv6 FIB builds its lookup
+ * tables from a RIB6.
+ *
+ * The RIB6 is not thread safe, the application is responsible for the
+ * synchronization of the updates and lookups.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_RIB6_IPV6_ADDR_SIZE	16
+
+/** Maximum depth value possible for IPv6 RIB. */
+#define RTE_RIB6_MAXDEPTH	128
+
+/** Flags of rte_rib6_get_nxt() */
+enum {
+	/** Get all the more specific routes */
+	RTE_RIB6_GET_NXT_ALL,
+	/** Get only the more specific routes not covered by another one */
+	RTE_RIB6_GET_NXT_COVER
+};
+
+struct rte_rib6;
+struct rte_rib6_node;
+
+/** RIB6 configuration structure */
+struct rte_rib6_conf {
+	/** Size of the user data area in each node, in bytes. */
+	size_t ext_sz;
+	/** Maximum number of nodes, up to twice the number of routes. */
+	int max_nodes;
+};
+
+/**
+ * Copy an IPv6 address.
+ *
+ * @param dst
+ *   Pointer to the destination address.
+ * @param src
+ *   Pointer to the source address.
+ */
+static inline void
+rte_rib6_copy_addr(uint8_t *dst, const uint8_t *src)
+{
+	if ((dst == NULL) || (src == NULL))
+		return;
+	memcpy(dst, src, RTE_RIB6_IPV6_ADDR_SIZE);
+}
+
+/**
+ * Compare two IPv6 addresses.
+ *
+ * @param ip1
+ *   Pointer to the first address.
+ * @param ip2
+ *   Pointer to the second address.
+ * @return
+ *   true if the addresses are equal, false otherwise.
+ */
+static inline bool
+rte_rib6_is_equal(const uint8_t *ip1, const uint8_t *ip2)
+{
+	if ((ip1 == NULL) || (ip2 == NULL))
+		return false;
+	return memcmp(ip1, ip2, RTE_RIB6_IPV6_ADDR_SIZE) == 0;
+}
+
+/**
+ * Get a byte of an IPv6 mask from a prefix length.
+ *
+ * @param depth
+ *   Prefix length, from 0 to 128.
+ * @param byte
+ *   Index of the byte in the mask, from 0 to 15.
+ * @return
+ *   Byte of the mask.
+ */
+static inline uint8_t
+rte_rib6_get_msk_part(uint8_t depth, int byte)
+{
+	uint8_t part;
+
+	byte *= 8;
+	if (depth <= byte)
+		return 0;
+	part = depth - byte;
+	return (part >= 8) ? UINT8_MAX : (uint8_t)(UINT8_MAX << (8 - part));
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup the longest prefix match of an IPv6 address.
+ *
+ * @param rib
+ *   RIB6 object handle.
+ * @param ip
+ *   IPv6 address to lookup.
+ * @return
+ *   Node of the longest matching route, NULL if there is none.
+ */
+struct rte_rib6_node * __rte_experimental
+rte_rib6_lookup(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE]);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup the route covering a route.
+ *
+ * @param ent
+ *   Node of a route.
+ * @return
+ *   Node of the longest route covering the route, NULL if there is none.
+ */
+struct rte_rib6_node * __rte_experimental
+rte_rib6_lookup_parent(struct rte_rib6_node *ent);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup a route.
+ *
+ * @param rib
+ *   RIB6 object handle.
+ * @param ip
+ *   Prefix of the route.
+ * @param depth
+ *   Prefix length of the route.
+ * @return
+ *   Node of the route, NULL if it does not exist.
+ */
+struct rte_rib6_node * __rte_experimental
+rte_rib6_lookup_exact(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE], uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Iterate on the routes more specific than a prefix, in increasing order
+ * of their addresses.
+ *
+ * @param rib
+ *   RIB6 object handle.
+ * @param ip
+ *   Prefix to iterate on.
+ * @param depth
+ *   Prefix length, the prefix itself is not part of the iteration.
+ * @param last
+ *   Node returned by the previous call, NULL to get the first route.
+ * @param flag
+ *   RTE_RIB6_GET_NXT_ALL to iterate on all the more specific routes,
+ *   RTE_RIB6_GET_NXT_COVER to skip the routes covered by another one.
+ * @return
+ *   Node of the next route, NULL at the end of the iteration.
+ */
+struct rte_rib6_node * __rte_experimental
+rte_rib6_get_nxt(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE],
+	uint8_t depth, struct rte_rib6_node *last, int flag);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Remove a route.
+ *
+ * @param rib
+ *   RIB6 object handle.
+ * @param ip
+ *   Prefix of the route.
+ * @param depth
+ *   Prefix length of the route.
+ */
+void __rte_experimental
+rte_rib6_remove(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE], uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a route, with a next hop of 0.
+ *
+ * @param rib
+ *   RIB6 object handle.
+ * @param ip
+ *   Prefix of the route.
+ * @param depth
+ *   Prefix length of the route.
+ * @return
+ *   Node of the new route, NULL on error with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if the route already exists
+ *   - ENOMEM if the maximum number of nodes is reached
+ */
+struct rte_rib6_node * __rte_experimental
+rte_rib6_insert(struct rte_rib6 *rib,
+	const uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE], uint8_t depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the prefix of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param ip
+ *   Buffer of the prefix to fill.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib6_get_ip(const struct rte_rib6_node *node,
+	uint8_t ip[RTE_RIB6_IPV6_ADDR_SIZE]);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the prefix length of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param depth
+ *   Pointer to the prefix length to fill.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib6_get_depth(const struct rte_rib6_node *node, uint8_t *depth);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the user data area of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @return
+ *   Pointer to the user data area of the node, of the size given in the
+ *   RIB6 configuration.
+ */
+void * __rte_experimental
+rte_rib6_get_ext(struct rte_rib6_node *node);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the next hop of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param nh
+ *   Pointer to the next hop to fill.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib6_get_nh(const struct rte_rib6_node *node, uint64_t *nh);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Set the next hop of a route.
+ *
+ * @param node
+ *   Node of the route.
+ * @param nh
+ *   Next hop.
+ * @return
+ *   0 on success, -1 with rte_errno set to EINVAL on invalid parameters.
+ */
+int __rte_experimental
+rte_rib6_set_nh(struct rte_rib6_node *node, uint64_t nh);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a RIB6.
+ *
+ * @param name
+ *   RIB6 name.
+ * @param socket_id
+ *   NUMA socket ID for the RIB6 memory allocation.
+ * @param conf
+ *   Structure containing the configuration.
+ * @return
+ *   Handle to the RIB6 object on success, NULL otherwise with rte_errno set:
+ *   - EINVAL for invalid parameters
+ *   - EEXIST if a RIB6 with the same name already exists
+ *   - ENOMEM if the memory cannot be allocated
+ */
+struct rte_rib6 * __rte_experimental
+rte_rib6_create(const char *name, int socket_id,
+	const struct rte_rib6_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Find an existing RIB6 object and return a pointer to it.
+ *
+ * @param name
+ *   Name of the RIB6 object as passed to rte_rib6_create().
+ * @return
+ *   Pointer to the RIB6 object, NULL with rte_errno set to ENOENT if it
+ *   does not exist.
+ */
+struct rte_rib6 * __rte_experimental
+rte_rib6_find_existing(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a RIB6 object.
+ *
+ * @param rib
+ *   RIB6 object handle created with rte_rib6_create().
+ *   If rib is NULL, no operation is performed.
+ */
+void __rte_experimental
+rte_rib6_free(struct rte_rib6 *rib);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RIB6_H_ */
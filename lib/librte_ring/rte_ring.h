@@ -26,9 +26,11 @@
  * - Bulk dequeue.
  * - Bulk enqueue.
  *
- * Note: the ring implementation is not preemptible. Refer to Programmer's
- * guide/Environment Abstraction Layer/Multiple pthread/Known Issues/rte_ring
- * for more information.
+ * Note: the default MP/MC ring implementation is not preemptible. Refer to
+ * Programmer's guide/Environment Abstraction Layer/Multiple pthread/Known
+ * Issues/rte_ring for more information. The RTS and HTS sync modes (see
+ * RING_F_MP_RTS_ENQ and RING_F_MP_HTS_ENQ) are better suited for
+ * overcommitted or preemptible producers/consumers.
  *
  */
 
@@ -48,6 +50,7 @@ extern "C" {
 #include <rte_branch_prediction.h>
 #include <rte_memzone.h>
 #include <rte_pause.h>
+#include <rte_debug.h>
 
 #define RTE_TAILQ_RING_NAME "RTE_RING"
 
@@ -63,11 +66,61 @@ enum rte_ring_queue_behavior {
 
 struct rte_memzone; /* forward declaration, so as not to require memzone.h */
 
-/* structure to hold a pair of head/tail values and other metadata */
+/** prod/cons sync types */
+enum rte_ring_sync_type {
+	RTE_RING_SYNC_MT,     /**< multi-thread safe (default mode) */
+	RTE_RING_SYNC_ST,     /**< single thread only */
+	RTE_RING_SYNC_MT_RTS, /**< multi-thread relaxed tail sync */
+	RTE_RING_SYNC_MT_HTS, /**< multi-thread head/tail sync */
+};
+
+/*
+ * structures to hold a pair of head/tail values and other metadata.
+ * Depending on sync_type format of that structure might be different,
+ * but offset for *sync_type* and *tail* values should remain the same.
+ */
 struct rte_ring_headtail {
 	volatile uint32_t head;  /**< Prod/consumer head. */
 	volatile uint32_t tail;  /**< Prod/consumer tail. */
-	uint32_t single;         /**< True if single prod/cons */
+	RTE_STD_C11
+	union {
+		/** sync type of prod/cons */
+		enum rte_ring_sync_type sync_type;
+		/** deprecated -  True if single prod/cons */
+		uint32_t single;
+	};
+};
+
+union __rte_ring_rts_poscnt {
+	/** raw 8B value to read/write *cnt* and *pos* as one atomic op */
+	uint64_t raw __rte_aligned(8);
+	struct {
+		uint32_t cnt; /**< head/tail reference counter */
+		uint32_t pos; /**< head/tail position */
+	} val;
+};
+
+/* head/tail metadata for the relaxed tail sync (RTS) mode */
+struct rte_ring_rts_headtail {
+	volatile union __rte_ring_rts_poscnt tail;
+	enum rte_ring_sync_type sync_type;  /**< sync type of prod/cons */
+	uint32_t htd_max;   /**< max allowed distance between head/tail */
+	volatile union __rte_ring_rts_poscnt head;
+};
+
+union __rte_ring_hts_pos {
+	/** raw 8B value to read/write *head* and *tail* as one atomic op */
+	uint64_t raw __rte_aligned(8);
+	struct {
+		uint32_t head; /**< head position */
+		uint32_t tail; /**< tail position */
+	} pos;
+};
+
+/* head/tail metadata for the head/tail sync (HTS) mode */
+struct rte_ring_hts_headtail {
+	volatile union __rte_ring_hts_pos ht;
+	enum rte_ring_sync_type sync_type;  /**< sync type of prod/cons */
 };
 
 /**
@@ -97,11 +150,23 @@ struct rte_ring {
 	char pad0 __rte_cache_aligned; /**< empty cache line */
 
 	/** Ring producer status. */
-	struct rte_ring_headtail prod __rte_cache_aligned;
+	RTE_STD_C11
+	union {
+		struct rte_ring_headtail prod;
+		struct rte_ring_hts_headtail hts_prod;
+		struct rte_ring_rts_headtail rts_prod;
+	}  __rte_cache_aligned;
+
 	char pad1 __rte_cache_aligned; /**< empty cache line */
 
 	/** Ring consumer status. */
-	struct rte_ring_headtail cons __rte_cache_aligned;
+	RTE_STD_C11
+	union {
+		struct rte_ring_headtail cons;
+		struct rte_ring_hts_headtail hts_cons;
+		struct rte_ring_rts_headtail rts_cons;
+	}  __rte_cache_aligned;
+
 	char pad2 __rte_cache_aligned; /**< empty cache line */
 };
 
@@ -118,6 +183,12 @@ struct rte_ring {
 #define RING_F_EXACT_SZ 0x0004
 #define RTE_RING_SZ_MASK  (0x7fffffffU) /**< Ring size mask */
 
+#define RING_F_MP_RTS_ENQ 0x0008 /**< The default enqueue is "MP RTS". */
+#define RING_F_MC_RTS_DEQ 0x0010 /**< The default dequeue is "MC RTS". */
+
+#define RING_F_MP_HTS_ENQ 0x0020 /**< The default enqueue is "MP HTS". */
+#define RING_F_MC_HTS_DEQ 0x0040 /**< The default dequeue is "MC HTS". */
+
 /* @internal defines for passing to the enqueue dequeue worker functions */
 #define __IS_SP 1
 #define __IS_MP 0
@@ -165,12 +236,30 @@ ssize_t rte_ring_get_memsize(unsigned count);
  *   The number of elements in the ring (must be a power of 2).
  * @param flags
  *   An OR of the following:
- *    - RING_F_SP_ENQ: If this flag is set, the default behavior when
- *      using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
- *      is "single-producer". Otherwise, it is "multi-producers".
- *    - RING_F_SC_DEQ: If this flag is set, the default behavior when
- *      using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
- *      is "single-consumer". Otherwise, it is "multi-consumers".
+ *    - One of mutually exclusive flags that define producer behavior:
+ *       - RING_F_SP_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "single-producer".
+ *       - RING_F_MP_RTS_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "multi-producer RTS mode".
+ *       - RING_F_MP_HTS_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "multi-producer HTS mode".
+ *     If none of these flags is set, then default "multi-producer"
+ *     behavior is selected.
+ *    - One of mutually exclusive flags that define consumer behavior:
+ *       - RING_F_SC_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "single-consumer". Otherwise, it is "multi-consumers".
+ *       - RING_F_MC_RTS_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "multi-consumer RTS mode".
+ *       - RING_F_MC_HTS_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "multi-consumer HTS mode".
+ *     If none of these flags is set, then default "multi-consumer"
+ *     behavior is selected.
  * @return
  *   0 on success, or a negative value on error.
  */
@@ -200,18 +289,37 @@ int rte_ring_init(struct rte_ring *r, const char *name, unsigned count,
  *   constraint for the reserved zone.
  * @param flags
  *   An OR of the following:
- *    - RING_F_SP_ENQ: If this flag is set, the default behavior when
- *      using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
- *      is "single-producer". Otherwise, it is "multi-producers".
- *    - RING_F_SC_DEQ: If this flag is set, the default behavior when
- *      using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
- *      is "single-consumer". Otherwise, it is "multi-consumers".
+ *    - One of mutually exclusive flags that define producer behavior:
+ *       - RING_F_SP_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "single-producer".
+ *       - RING_F_MP_RTS_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "multi-producer RTS mode".
+ *       - RING_F_MP_HTS_ENQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_enqueue()`` or ``rte_ring_enqueue_bulk()``
+ *         is "multi-producer HTS mode".
+ *     If none of these flags is set, then default "multi-producer"
+ *     behavior is selected.
+ *    - One of mutually exclusive flags that define consumer behavior:
+ *       - RING_F_SC_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "single-consumer". Otherwise, it is "multi-consumers".
+ *       - RING_F_MC_RTS_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "multi-consumer RTS mode".
+ *       - RING_F_MC_HTS_DEQ: If this flag is set, the default behavior when
+ *         using ``rte_ring_dequeue()`` or ``rte_ring_dequeue_bulk()``
+ *         is "multi-consumer HTS mode".
+ *     If none of these flags is set, then default "multi-consumer"
+ *     behavior is selected.
  * @return
  *   On success, the pointer to the new allocated ring. NULL on error with
  *    rte_errno set appropriately. Possible errno values include:
  *    - E_RTE_NO_CONFIG - function could not get pointer to rte_config structure
  *    - E_RTE_SECONDARY - function was called from a secondary process instance
- *    - EINVAL - count provided is not a power of 2
+ *    - EINVAL - count provided is not a power of 2, or flags contain
+ *      conflicting sync modes
  *    - ENOSPC - the maximum number of memzones has already been allocated
  *    - EEXIST - a memzone with the same name already exists
  *    - ENOMEM - no appropriate memory area found in which to create memzone
@@ -313,6 +421,9 @@ void rte_ring_dump(FILE *f, const struct rte_ring *r);
 #include "rte_ring_generic.h"
 #endif
 
+#include "rte_ring_hts.h"
+#include "rte_ring_rts.h"
+
 /**
  * @internal Enqueue several objects on the ring
  *
@@ -470,8 +581,22 @@ static __rte_always_inline unsigned int
 rte_ring_enqueue_bulk(struct rte_ring *r, void * const *obj_table,
 		      unsigned int n, unsigned int *free_space)
 {
-	return __rte_ring_do_enqueue(r, obj_table, n, RTE_RING_QUEUE_FIXED,
-			r->prod.single, free_space);
+	switch (r->prod.sync_type) {
+	case RTE_RING_SYNC_MT:
+		return rte_ring_mp_enqueue_bulk(r, obj_table, n, free_space);
+	case RTE_RING_SYNC_ST:
+		return rte_ring_sp_enqueue_bulk(r, obj_table, n, free_space);
+	case RTE_RING_SYNC_MT_RTS:
+		return __rte_ring_do_rts_enqueue(r, obj_table, n,
+			RTE_RING_QUEUE_FIXED, free_space);
+	case RTE_RING_SYNC_MT_HTS:
+		return __rte_ring_do_hts_enqueue(r, obj_table, n,
+			RTE_RING_QUEUE_FIXED, free_space);
+	}
+
+	/* valid ring should never reach this point */
+	RTE_ASSERT(0);
+	return 0;
 }
 
 /**
@@ -605,8 +730,22 @@ static __rte_always_inline unsigned int
 rte_ring_dequeue_bulk(struct rte_ring *r, void **obj_table, unsigned int n,
 		unsigned int *available)
 {
-	return __rte_ring_do_dequeue(r, obj_table, n, RTE_RING_QUEUE_FIXED,
-				r->cons.single, available);
+	switch (r->cons.sync_type) {
+	case RTE_RING_SYNC_MT:
+		return rte_ring_mc_dequeue_bulk(r, obj_table, n, available);
+	case RTE_RING_SYNC_ST:
+		return rte_ring_sc_dequeue_bulk(r, obj_table, n, available);
+	case RTE_RING_SYNC_MT_RTS:
+		return __rte_ring_do_rts_dequeue(r, obj_table, n,
+			RTE_RING_QUEUE_FIXED, available);
+	case RTE_RING_SYNC_MT_HTS:
+		return __rte_ring_do_hts_dequeue(r, obj_table, n,
+			RTE_RING_QUEUE_FIXED, available);
+	}
+
+	/* valid ring should never reach this point */
+	RTE_ASSERT(0);
+	return 0;
 }
 
 /**
@@ -761,6 +900,62 @@ rte_ring_get_capacity(const struct rte_ring *r)
 	return r->capacity;
 }
 
+/**
+ * Return sync type used by producer in the ring.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   Producer sync type value.
+ */
+static inline enum rte_ring_sync_type
+rte_ring_get_prod_sync_type(const struct rte_ring *r)
+{
+	return r->prod.sync_type;
+}
+
+/**
+ * Check is the ring for single producer.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   true if ring is SP, zero otherwise.
+ */
+static inline int
+rte_ring_is_prod_single(const struct rte_ring *r)
+{
+	return (rte_ring_get_prod_sync_type(r) == RTE_RING_SYNC_ST);
+}
+
+/**
+ * Return sync type used by consumer in the ring.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   Consumer sync type value.
+ */
+static inline enum rte_ring_sync_type
+rte_ring_get_cons_sync_type(const struct rte_ring *r)
+{
+	return r->cons.sync_type;
+}
+
+/**
+ * Check is the ring for single consumer.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   true if ring is SC, zero otherwise.
+ */
+static inline int
+rte_ring_is_cons_single(const struct rte_ring *r)
+{
+	return (rte_ring_get_cons_sync_type(r) == RTE_RING_SYNC_ST);
+}
+
 /**
  * Dump the status of all rings on the console
  *
@@ -853,8 +1048,22 @@ static __rte_always_inline unsigned
 rte_ring_enqueue_burst(struct rte_ring *r, void * const *obj_table,
 		      unsigned int n, unsigned int *free_space)
 {
-	return __rte_ring_do_enqueue(r, obj_table, n, RTE_RING_QUEUE_VARIABLE,
-			r->prod.single, free_space);
+	switch (r->prod.sync_type) {
+	case RTE_RING_SYNC_MT:
+		return rte_ring_mp_enqueue_burst(r, obj_table, n, free_space);
+	case RTE_RING_SYNC_ST:
+		return rte_ring_sp_enqueue_burst(r, obj_table, n, free_space);
+	case RTE_RING_SYNC_MT_RTS:
+		return __rte_ring_do_rts_enqueue(r, obj_table, n,
+			RTE_RING_QUEUE_VARIABLE, free_space);
+	case RTE_RING_SYNC_MT_HTS:
+		return __rte_ring_do_hts_enqueue(r, obj_table, n,
+			RTE_RING_QUEUE_VARIABLE, free_space);
+	}
+
+	/* valid ring should never reach this point */
+	RTE_ASSERT(0);
+	return 0;
 }
 
 /**
@@ -933,9 +1142,22 @@ static __rte_always_inline unsigned
 rte_ring_dequeue_burst(struct rte_ring *r, void **obj_table,
 		unsigned int n, unsigned int *available)
 {
-	return __rte_ring_do_dequeue(r, obj_table, n,
-				RTE_RING_QUEUE_VARIABLE,
-				r->cons.single, available);
+	switch (r->cons.sync_type) {
+	case RTE_RING_SYNC_MT:
+		return rte_ring_mc_dequeue_burst(r, obj_table, n, available);
+	case RTE_RING_SYNC_ST:
+		return rte_ring_sc_dequeue_burst(r, obj_table, n, available);
+	case RTE_RING_SYNC_MT_RTS:
+		return __rte_ring_do_rts_dequeue(r, obj_table, n,
+			RTE_RING_QUEUE_VARIABLE, available);
+	case RTE_RING_SYNC_MT_HTS:
+		return __rte_ring_do_hts_dequeue(r, obj_table, n,
+			RTE_RING_QUEUE_VARIABLE, available);
+	}
+
+	/* valid ring should never reach this point */
+	RTE_ASSERT(0);
+	return 0;
 }
 
 #ifdef __cplusplus
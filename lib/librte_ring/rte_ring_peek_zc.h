@@ -0,0 +1,302 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _RTE_RING_PEEK_ZC_H_
+#define _RTE_RING_PEEK_ZC_H_
+
+/**
+ * @file
+ * @b EXPERIMENTAL: this API may change without prior notice
+ * This file is not included by <rte_ring.h>, applications using the
+ * API below have to include it explicitly.
+ *
+ * Ring Peek Zero Copy APIs
+ * These APIs make it possible to split public enqueue/dequeue API
+ * into 3 parts:
+ * - enqueue/dequeue start
+ * - copy data to/from the ring
+ * - enqueue/dequeue finish
+ * Along with the advantages of the peek APIs (see <rte_ring_peek.h>),
+ * these APIs provide the ability to avoid copying of the data to a
+ * temporary area: the application reads or writes the objects directly
+ * in the ring slots.
+ *
+ * Note that currently these APIs are available only for two sync modes:
+ * 1) Single Producer/Single Consumer (RTE_RING_SYNC_ST)
+ * 2) Serialized Producer/Serialized Consumer (RTE_RING_SYNC_MT_HTS).
+ * It is user's responsibility to create/init ring with appropriate sync
+ * modes selected.
+ *
+ * Following are some examples showing the API usage.
+ * 1)
+ * // Create ring with sync type RTE_RING_SYNC_ST or RTE_RING_SYNC_MT_HTS
+ * // Look at the object at the head of the ring without dequeuing it
+ * n = rte_ring_dequeue_zc_bulk_start(r, 1, &zcd, NULL);
+ * if (n != 0) {
+ *	if (object_examine(zcd.ptr1[0]) == KEEP)
+ *		// leave it in the ring
+ *		rte_ring_dequeue_zc_finish(r, 0);
+ *	else
+ *		// remove it from the ring
+ *		rte_ring_dequeue_zc_finish(r, n);
+ * }
+ *
+ * 2)
+ * // Create ring with sync type RTE_RING_SYNC_ST or RTE_RING_SYNC_MT_HTS
+ * // Reserve space on the ring
+ * n = rte_ring_enqueue_zc_burst_start(r, 32, &zcd, NULL);
+ *
+ * // Pkt I/O core polls packets from the NIC
+ * if (n != 0) {
+ *	nb_rx = rte_eth_rx_burst(portid, queueid, zcd.ptr1, zcd.n1);
+ *	if (nb_rx == zcd.n1 && n != zcd.n1)
+ *		nb_rx += rte_eth_rx_burst(portid, queueid,
+ *						zcd.ptr2, n - zcd.n1);
+ *
+ *	// Provide packets to the packet processing cores
+ *	rte_ring_enqueue_zc_finish(r, nb_rx);
+ * }
+ *
+ * Note that between _start_ and _finish_ no other thread can proceed
+ * with enqueue/dequeue operation till _finish_ completes.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rte_ring.h>
+#include "rte_ring_peek_c11_mem.h"
+
+/**
+ * Ring zero-copy information structure.
+ *
+ * This structure contains the pointers and length of the space
+ * reserved on the ring storage.
+ */
+struct rte_ring_zc_data {
+	/* Pointer to the first space in the ring */
+	void **ptr1;
+	/* Pointer to the second space in the ring if there is wrap-around.
+	 * It contains valid value only if wrap-around happens.
+	 */
+	void **ptr2;
+	/* Number of elements in the first pointer. If this is equal to
+	 * the number of elements requested, then ptr2 is NULL.
+	 * Otherwise, subtracting n1 from number of elements requested
+	 * will give the number of elements available at ptr2.
+	 */
+	unsigned int n1;
+} __rte_cache_aligned;
+
+/**
+ * @internal Fill *zcd* with the ring slots for *num* objects from *head*.
+ */
+static __rte_always_inline void
+__rte_ring_get_slot_addr(struct rte_ring *r, uint32_t head, uint32_t num,
+	struct rte_ring_zc_data *zcd)
+{
+	void **ring = (void **)&r[1];
+	uint32_t idx;
+
+	idx = head & r->mask;
+
+	zcd->ptr1 = ring + idx;
+	zcd->n1 = num;
+
+	if (idx + num > r->size) {
+		zcd->n1 = r->size - idx;
+		zcd->ptr2 = ring;
+	} else {
+		zcd->ptr2 = NULL;
+	}
+}
+
+/**
+ * @internal This function moves prod head value.
+ */
+static __rte_always_inline unsigned int
+__rte_ring_do_enqueue_zc_start(struct rte_ring *r, uint32_t n,
+		enum rte_ring_queue_behavior behavior,
+		struct rte_ring_zc_data *zcd, unsigned int *free_space)
+{
+	uint32_t head;
+
+	n = __rte_ring_do_enqueue_start(r, n, behavior, &head, free_space);
+	if (n != 0)
+		__rte_ring_get_slot_addr(r, head, n, zcd);
+	return n;
+}
+
+/**
+ * Start to enqueue several pointers to objects on the ring.
+ * Note that no actual pointers are put in the queue by this function,
+ * it just reserves space for the user on the ring.
+ * User has to copy pointers to objects directly to the space returned
+ * and then call rte_ring_enqueue_zc_finish to complete the
+ * enqueue operation.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of objects to add in the ring.
+ * @param zcd
+ *   Structure containing the pointers and length of the space
+ *   reserved on the ring storage.
+ * @param free_space
+ *   If non-NULL, returns the amount of space in the ring after the
+ *   reservation operation has finished.
+ * @return
+ *   The number of objects that can be enqueued, either 0 or n
+ */
+static __rte_always_inline unsigned int __rte_experimental
+rte_ring_enqueue_zc_bulk_start(struct rte_ring *r, unsigned int n,
+	struct rte_ring_zc_data *zcd, unsigned int *free_space)
+{
+	return __rte_ring_do_enqueue_zc_start(r, n, RTE_RING_QUEUE_FIXED,
+			zcd, free_space);
+}
+
+/**
+ * Start to enqueue several pointers to objects on the ring.
+ * Note that no actual pointers are put in the queue by this function,
+ * it just reserves space for the user on the ring.
+ * User has to copy pointers to objects directly to the space returned
+ * and then call rte_ring_enqueue_zc_finish to complete the
+ * enqueue operation.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of objects to add in the ring.
+ * @param zcd
+ *   Structure containing the pointers and length of the space
+ *   reserved on the ring storage.
+ * @param free_space
+ *   If non-NULL, returns the amount of space in the ring after the
+ *   reservation operation has finished.
+ * @return
+ *   The actual number of objects that can be enqueued.
+ */
+static __rte_always_inline unsigned int __rte_experimental
+rte_ring_enqueue_zc_burst_start(struct rte_ring *r, unsigned int n,
+	struct rte_ring_zc_data *zcd, unsigned int *free_space)
+{
+	return __rte_ring_do_enqueue_zc_start(r, n, RTE_RING_QUEUE_VARIABLE,
+			zcd, free_space);
+}
+
+/**
+ * Complete enqueuing several pointers to objects on the ring.
+ * Note that number of objects to enqueue should not exceed previous
+ * enqueue_start return value.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of pointers to objects to add to the ring.
+ */
+static __rte_always_inline void __rte_experimental
+rte_ring_enqueue_zc_finish(struct rte_ring *r, unsigned int n)
+{
+	uint32_t tail;
+
+	n = __rte_ring_do_enqueue_get_tail(r, &tail, n);
+	__rte_ring_do_enqueue_set_tail(r, tail, n);
+}
+
+/**
+ * @internal This function moves cons head value.
+ */
+static __rte_always_inline unsigned int
+__rte_ring_do_dequeue_zc_start(struct rte_ring *r, uint32_t n,
+	enum rte_ring_queue_behavior behavior,
+	struct rte_ring_zc_data *zcd, unsigned int *available)
+{
+	uint32_t head;
+
+	n = __rte_ring_do_dequeue_start(r, n, behavior, &head, available);
+	if (n != 0)
+		__rte_ring_get_slot_addr(r, head, n, zcd);
+	return n;
+}
+
+/**
+ * Start to dequeue several pointers to objects from the ring.
+ * Note that no actual pointers are removed from the queue by this function.
+ * User has to copy pointers to objects from the space returned
+ * and then call rte_ring_dequeue_zc_finish to complete the
+ * dequeue operation.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of objects to remove from the ring.
+ * @param zcd
+ *   Structure containing the pointers and length of the space
+ *   reserved on the ring storage.
+ * @param available
+ *   If non-NULL, returns the number of remaining ring entries after the
+ *   dequeue has finished.
+ * @return
+ *   The number of objects that can be dequeued, either 0 or n
+ */
+static __rte_always_inline unsigned int __rte_experimental
+rte_ring_dequeue_zc_bulk_start(struct rte_ring *r, unsigned int n,
+	struct rte_ring_zc_data *zcd, unsigned int *available)
+{
+	return __rte_ring_do_dequeue_zc_start(r, n, RTE_RING_QUEUE_FIXED,
+			zcd, available);
+}
+
+/**
+ * Start to dequeue several pointers to objects from the ring.
+ * Note that no actual pointers are removed from the queue by this function.
+ * User has to copy pointers to objects from the space returned
+ * and then call rte_ring_dequeue_zc_finish to complete the
+ * dequeue operation.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of objects to remove from the ring.
+ * @param zcd
+ *   Structure containing the pointers and length of the space
+ *   reserved on the ring storage.
+ * @param available
+ *   If non-NULL, returns the number of remaining ring entries after the
+ *   dequeue has finished.
+ * @return
+ *   The actual number of objects that can be dequeued.
+ */
+static __rte_always_inline unsigned int __rte_experimental
+rte_ring_dequeue_zc_burst_start(struct rte_ring *r, unsigned int n,
+	struct rte_ring_zc_data *zcd, unsigned int *available)
+{
+	return __rte_ring_do_dequeue_zc_start(r, n, RTE_RING_QUEUE_VARIABLE,
+			zcd, available);
+}
+
+/**
+ * Complete dequeuing several pointers to objects from the ring.
+ * Note that number of objects to dequeued should not exceed previous
+ * dequeue_start return value. Passing zero leaves all the objects
+ * in the ring.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of pointers to objects to remove from the ring.
+ */
+static __rte_always_inline void __rte_experimental
+rte_ring_dequeue_zc_finish(struct rte_ring *r, unsigned int n)
+{
+	__rte_ring_do_dequeue_finish(r, n);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RING_PEEK_ZC_H_ */
@@ -11,6 +11,8 @@
 
 #include <rte_eal.h>
 #include <rte_ethdev.h>
+#include <rte_lcore.h>
+#include <rte_lcore_poll.h>
 #include <rte_metrics.h>
 #include <rte_option.h>
 #include <rte_string_fns.h>
@@ -588,6 +590,155 @@ rte_telemetry_send_ports_stats_values(uint32_t *metric_ids, int num_metric_ids,
 }
 
 
+static int32_t
+rte_telemetry_json_format_lcore(struct telemetry_impl *telemetry,
+	uint32_t lcore_id, json_t *lcores)
+{
+	struct rte_lcore_poll_stats poll_stats;
+	char name[RTE_METRICS_MAX_NAME_LEN];
+	json_t *lcore, *stats;
+	uint32_t i;
+	int ret;
+
+	ret = rte_lcore_poll_stats_get(lcore_id, &poll_stats);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Could not get poll stats of lcore %u",
+				lcore_id);
+		goto eperm_fail;
+	}
+
+	lcore = json_object();
+	stats = json_array();
+	if (lcore == NULL || stats == NULL) {
+		TELEMETRY_LOG_ERR("Could not create lcore/stats JSON objects");
+		goto eperm_fail;
+	}
+
+	ret = json_object_set_new(lcore, "lcore", json_integer(lcore_id));
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Lcore field cannot be set");
+		goto eperm_fail;
+	}
+
+	ret = rte_telemetry_json_format_stat(telemetry, stats, "busy_cycles",
+		poll_stats.busy_cycles);
+	if (ret < 0)
+		return -1;
+
+	ret = rte_telemetry_json_format_stat(telemetry, stats, "idle_cycles",
+		poll_stats.idle_cycles);
+	if (ret < 0)
+		return -1;
+
+	/* name the histogram buckets by their range of work per iteration */
+	for (i = 0; i < RTE_LCORE_POLL_HIST_SIZE; i++) {
+		if (i == 0)
+			strlcpy(name, "iterations_idle", sizeof(name));
+		else if (i == RTE_LCORE_POLL_HIST_SIZE - 1)
+			snprintf(name, sizeof(name), "iterations_work_%u_plus",
+				1U << (i - 1));
+		else
+			snprintf(name, sizeof(name), "iterations_work_%u_%u",
+				1U << (i - 1), (1U << i) - 1);
+
+		ret = rte_telemetry_json_format_stat(telemetry, stats, name,
+			poll_stats.hist[i]);
+		if (ret < 0)
+			return -1;
+	}
+
+	ret = json_object_set_new(lcore, "stats", stats);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Stats object cannot be set");
+		goto eperm_fail;
+	}
+
+	ret = json_array_append_new(lcores, lcore);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Lcore object cannot be added to lcores array");
+		goto eperm_fail;
+	}
+
+	return 0;
+
+eperm_fail:
+	ret = rte_telemetry_send_error_response(telemetry, -EPERM);
+	if (ret < 0)
+		TELEMETRY_LOG_ERR("Could not send error");
+	return -1;
+}
+
+int32_t
+rte_telemetry_send_lcores_stats_values(struct telemetry_impl *telemetry)
+{
+	json_t *root, *lcores;
+	char *json_buffer;
+	uint32_t lcore_id;
+	int ret;
+
+	if (telemetry == NULL) {
+		TELEMETRY_LOG_ERR("Invalid telemetry argument");
+		return -1;
+	}
+
+	lcores = json_array();
+	if (lcores == NULL) {
+		TELEMETRY_LOG_ERR("Could not create lcores JSON array");
+		goto eperm_fail;
+	}
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		ret = rte_telemetry_json_format_lcore(telemetry, lcore_id,
+			lcores);
+		if (ret < 0) {
+			TELEMETRY_LOG_ERR("Format lcore in JSON failed");
+			json_decref(lcores);
+			return -1;
+		}
+	}
+
+	root = json_object();
+	if (root == NULL) {
+		TELEMETRY_LOG_ERR("Could not create root JSON object");
+		json_decref(lcores);
+		goto eperm_fail;
+	}
+
+	ret = json_object_set_new(root, "status_code",
+		json_string("Status OK: 200"));
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Status code field cannot be set");
+		json_decref(lcores);
+		json_decref(root);
+		goto eperm_fail;
+	}
+
+	ret = json_object_set_new(root, "data", lcores);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Data field cannot be set");
+		json_decref(root);
+		goto eperm_fail;
+	}
+
+	json_buffer = json_dumps(root, JSON_INDENT(2));
+	json_decref(root);
+
+	ret = rte_telemetry_write_to_socket(telemetry, json_buffer);
+	free(json_buffer);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Could not write to socket");
+		return -1;
+	}
+
+	return 0;
+
+eperm_fail:
+	ret = rte_telemetry_send_error_response(telemetry, -EPERM);
+	if (ret < 0)
+		TELEMETRY_LOG_ERR("Could not send error");
+	return -1;
+}
+
 static int32_t
 rte_telemetry_reg_ethdev_to_metrics(uint16_t port_id)
 {
@@ -448,6 +448,42 @@ rte_telemetry_command_ports_stats_values_by_name(struct telemetry_impl
 	return 0;
 }
 
+static int32_t
+rte_telemetry_command_lcores_stats_values(struct telemetry_impl *telemetry,
+	int action, json_t *data)
+{
+	int ret;
+
+	if (telemetry == NULL) {
+		TELEMETRY_LOG_ERR("Invalid telemetry argument");
+		return -1;
+	}
+
+	if (action != ACTION_GET) {
+		TELEMETRY_LOG_WARN("Invalid action for this command");
+		goto einval_fail;
+	}
+
+	if (!json_is_null(data)) {
+		TELEMETRY_LOG_WARN("Data should be NULL JSON object for 'lcores_stats_values' command");
+		goto einval_fail;
+	}
+
+	ret = rte_telemetry_send_lcores_stats_values(telemetry);
+	if (ret < 0) {
+		TELEMETRY_LOG_ERR("Sending lcores stats values failed");
+		return -1;
+	}
+
+	return 0;
+
+einval_fail:
+	ret = rte_telemetry_send_error_response(telemetry, -EINVAL);
+	if (ret < 0)
+		TELEMETRY_LOG_ERR("Could not send error");
+	return -1;
+}
+
 static int32_t
 rte_telemetry_parse_command(struct telemetry_impl *telemetry, int action,
 	const char *command, json_t *data)
@@ -484,6 +520,10 @@ rte_telemetry_parse_command(struct telemetry_impl *telemetry, int action,
 		{
 			.text = "ports_all_stat_values",
 			.fn = &rte_telemetry_command_ports_all_stat_values
+		},
+		{
+			.text = "lcores_stats_values",
+			.fn = &rte_telemetry_command_lcores_stats_values
 		}
 	};
 
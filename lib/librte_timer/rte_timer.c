@@ -4,9 +4,11 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <assert.h>
+#include <limits.h>
 #include <sys/queue.h>
 
 #include <rte_atomic.h>
@@ -23,6 +25,7 @@
 #include <rte_pause.h>
 
 #include "rte_timer.h"
+#include "timer_wheel.h"
 
 LIST_HEAD(rte_timer_list, rte_timer);
 
@@ -42,34 +45,66 @@ struct priv_timer {
 	/** running timer on this lcore now */
 	struct rte_timer *running_tim;
 
+	/** timing wheel replacing the skiplist, if any */
+	struct timer_wheel *wheel;
+
 #ifdef RTE_LIBRTE_TIMER_DEBUG
 	/** per-lcore statistics */
 	struct rte_timer_debug_stats stats;
 #endif
 } __rte_cache_aligned;
 
-/** per-lcore private info for timers */
-static struct priv_timer priv_timer[RTE_MAX_LCORE];
+#define FL_ALLOCATED	(1 << 0)
+struct rte_timer_data {
+	/** per-lcore private info for timers */
+	struct priv_timer priv_timer[RTE_MAX_LCORE];
+	uint8_t internal_flags;
+};
+
+#define RTE_MAX_DATA_ELS 64
+static struct rte_timer_data rte_timer_data_arr[RTE_MAX_DATA_ELS];
+static rte_spinlock_t rte_timer_data_lock = RTE_SPINLOCK_INITIALIZER;
+
+/* timer data instance used by the API without a timer_data_id, reserved
+ * even before rte_timer_subsystem_init() is called
+ */
+static uint32_t default_data_id;
+
+#define TIMER_DATA_VALID_GET_OR_ERR_RET(id, timer_data, retval) do {	\
+	if ((id) >= RTE_MAX_DATA_ELS ||					\
+	    !(rte_timer_data_arr[id].internal_flags & FL_ALLOCATED))	\
+		return retval;						\
+	timer_data = &rte_timer_data_arr[id];				\
+} while (0)
 
 /* when debug is enabled, store some statistics */
 #ifdef RTE_LIBRTE_TIMER_DEBUG
-#define __TIMER_STAT_ADD(name, n) do {					\
+#define __TIMER_STAT_ADD(priv_timer, name, n) do {			\
 		unsigned __lcore_id = rte_lcore_id();			\
 		if (__lcore_id < RTE_MAX_LCORE)				\
 			priv_timer[__lcore_id].stats.name += (n);	\
 	} while(0)
 #else
-#define __TIMER_STAT_ADD(name, n) do {} while(0)
+#define __TIMER_STAT_ADD(priv_timer, name, n) do {} while(0)
 #endif
 
-/* Init the timer library. */
-void
-rte_timer_subsystem_init(void)
+/* Check if no timer is pending in the list of an lcore */
+static inline int
+timer_list_empty(struct priv_timer *pt)
+{
+	if (pt->wheel != NULL)
+		return pt->wheel->count == 0;
+	return pt->pending_head.sl_next[0] == NULL;
+}
+
+static void
+timer_data_init(struct rte_timer_data *timer_data)
 {
+	struct priv_timer *priv_timer = timer_data->priv_timer;
 	unsigned lcore_id;
 
-	/* since priv_timer is static, it's zeroed by default, so only init some
-	 * fields.
+	/* since the timer data is static, it's zeroed by default, so only
+	 * init some fields.
 	 */
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id ++) {
 		rte_spinlock_init(&priv_timer[lcore_id].list_lock);
@@ -77,6 +112,122 @@ rte_timer_subsystem_init(void)
 	}
 }
 
+/* Init the timer library. */
+void
+rte_timer_subsystem_init(void)
+{
+	timer_data_init(&rte_timer_data_arr[default_data_id]);
+	rte_timer_data_arr[default_data_id].internal_flags |= FL_ALLOCATED;
+}
+
+/* Allocate a timer data instance */
+int __rte_experimental
+rte_timer_data_alloc(uint32_t *id_ptr)
+{
+	struct rte_timer_data *data;
+	uint32_t i;
+
+	if (id_ptr == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&rte_timer_data_lock);
+	for (i = 0; i < RTE_MAX_DATA_ELS; i++) {
+		if (i == default_data_id)
+			continue;
+		data = &rte_timer_data_arr[i];
+		if (!(data->internal_flags & FL_ALLOCATED)) {
+			timer_data_init(data);
+			data->internal_flags |= FL_ALLOCATED;
+			*id_ptr = i;
+			break;
+		}
+	}
+	rte_spinlock_unlock(&rte_timer_data_lock);
+
+	return i == RTE_MAX_DATA_ELS ? -ENOSPC : 0;
+}
+
+/* Free a timer data instance */
+int __rte_experimental
+rte_timer_data_dealloc(uint32_t id)
+{
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	unsigned int lcore_id;
+
+	if (id == default_data_id)
+		return -EINVAL;
+	TIMER_DATA_VALID_GET_OR_ERR_RET(id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		if (!timer_list_empty(&priv_timer[lcore_id]))
+			return -EBUSY;
+
+	rte_spinlock_lock(&rte_timer_data_lock);
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		timer_wheel_free(priv_timer[lcore_id].wheel);
+	memset(timer_data, 0, sizeof(*timer_data));
+	rte_spinlock_unlock(&rte_timer_data_lock);
+
+	return 0;
+}
+
+static int
+timer_list_set_type(struct rte_timer_data *timer_data, unsigned int lcore_id,
+		    enum rte_timer_list_type type)
+{
+	struct priv_timer *pt;
+	struct timer_wheel *wheel = NULL;
+	int ret = 0;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	if (type == RTE_TIMER_LIST_WHEEL) {
+		wheel = timer_wheel_create(rte_lcore_to_socket_id(lcore_id));
+		if (wheel == NULL)
+			return -ENOMEM;
+	} else if (type != RTE_TIMER_LIST_SKIPLIST)
+		return -EINVAL;
+
+	pt = &timer_data->priv_timer[lcore_id];
+	rte_spinlock_lock(&pt->list_lock);
+	if (!timer_list_empty(pt)) {
+		ret = -EBUSY;
+	} else {
+		/* swap the wheels, the old one is freed below */
+		struct timer_wheel *old_wheel = pt->wheel;
+
+		pt->wheel = wheel;
+		pt->pending_head.expire = 0;
+		wheel = old_wheel;
+	}
+	rte_spinlock_unlock(&pt->list_lock);
+
+	timer_wheel_free(wheel);
+	return ret;
+}
+
+/* Select the data structure keeping the pending timers of an lcore */
+int __rte_experimental
+rte_timer_list_set_type(unsigned int lcore_id, enum rte_timer_list_type type)
+{
+	return timer_list_set_type(&rte_timer_data_arr[default_data_id],
+				   lcore_id, type);
+}
+
+int __rte_experimental
+rte_timer_alt_list_set_type(uint32_t timer_data_id, unsigned int lcore_id,
+			    enum rte_timer_list_type type)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return timer_list_set_type(timer_data, lcore_id, type);
+}
+
 /* Initialize the timer handle tim for use */
 void
 rte_timer_init(struct rte_timer *tim)
@@ -95,7 +246,8 @@ rte_timer_init(struct rte_timer *tim)
  */
 static int
 timer_set_config_state(struct rte_timer *tim,
-		       union rte_timer_status *ret_prev_status)
+		       union rte_timer_status *ret_prev_status,
+		       struct priv_timer *priv_timer)
 {
 	union rte_timer_status prev_status, status;
 	int success = 0;
@@ -207,7 +359,7 @@ timer_get_skiplist_level(unsigned curr_depth)
  */
 static void
 timer_get_prev_entries(uint64_t time_val, unsigned tim_lcore,
-		struct rte_timer **prev)
+		struct rte_timer **prev, struct priv_timer *priv_timer)
 {
 	unsigned lvl = priv_timer[tim_lcore].curr_skiplist_depth;
 	prev[lvl] = &priv_timer[tim_lcore].pending_head;
@@ -226,13 +378,13 @@ timer_get_prev_entries(uint64_t time_val, unsigned tim_lcore,
  */
 static void
 timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
-		struct rte_timer **prev)
+		struct rte_timer **prev, struct priv_timer *priv_timer)
 {
 	int i;
 	/* to get a specific entry in the list, look for just lower than the time
 	 * values, and then increment on each level individually if necessary
 	 */
-	timer_get_prev_entries(tim->expire - 1, tim_lcore, prev);
+	timer_get_prev_entries(tim->expire - 1, tim_lcore, prev, priv_timer);
 	for (i = priv_timer[tim_lcore].curr_skiplist_depth - 1; i >= 0; i--) {
 		while (prev[i]->sl_next[i] != NULL &&
 				prev[i]->sl_next[i] != tim &&
@@ -247,14 +399,23 @@ timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
  * timer must not be in a list
  */
 static void
-timer_add(struct rte_timer *tim, unsigned int tim_lcore)
+timer_add(struct rte_timer *tim, unsigned int tim_lcore,
+	  struct priv_timer *priv_timer)
 {
 	unsigned lvl;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
 
+	if (priv_timer[tim_lcore].wheel != NULL) {
+		timer_wheel_add(priv_timer[tim_lcore].wheel, tim);
+		/* NOTE: this is not atomic on 32-bit */
+		priv_timer[tim_lcore].pending_head.expire =
+			timer_wheel_next_expire(priv_timer[tim_lcore].wheel);
+		return;
+	}
+
 	/* find where exactly this element goes in the list of elements
 	 * for each depth. */
-	timer_get_prev_entries(tim->expire, tim_lcore, prev);
+	timer_get_prev_entries(tim->expire, tim_lcore, prev, priv_timer);
 
 	/* now assign it a new level and add at that level */
 	const unsigned tim_level = timer_get_skiplist_level(
@@ -284,7 +445,7 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore)
  */
 static void
 timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
-		int local_is_locked)
+		int local_is_locked, struct priv_timer *priv_timer)
 {
 	unsigned lcore_id = rte_lcore_id();
 	unsigned prev_owner = prev_status.owner;
@@ -297,6 +458,12 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 	if (prev_owner != lcore_id || !local_is_locked)
 		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
 
+	/* the next expiry time of a wheel is kept as a lower bound */
+	if (priv_timer[prev_owner].wheel != NULL) {
+		timer_wheel_del(priv_timer[prev_owner].wheel, tim);
+		goto unlock;
+	}
+
 	/* save the lowest list entry into the expire field of the dummy hdr.
 	 * NOTE: this is not atomic on 32-bit */
 	if (tim == priv_timer[prev_owner].pending_head.sl_next[0])
@@ -304,7 +471,7 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 				((tim->sl_next[0] == NULL) ? 0 : tim->sl_next[0]->expire);
 
 	/* adjust pointers from previous entries to point past this */
-	timer_get_prev_entries_for_node(tim, prev_owner, prev);
+	timer_get_prev_entries_for_node(tim, prev_owner, prev, priv_timer);
 	for (i = priv_timer[prev_owner].curr_skiplist_depth - 1; i >= 0; i--) {
 		if (prev[i]->sl_next[i] == tim)
 			prev[i]->sl_next[i] = tim->sl_next[i];
@@ -317,6 +484,7 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 		else
 			break;
 
+unlock:
 	if (prev_owner != lcore_id || !local_is_locked)
 		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
@@ -326,11 +494,13 @@ static int
 __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 		  uint64_t period, unsigned tim_lcore,
 		  rte_timer_cb_t fct, void *arg,
-		  int local_is_locked)
+		  int local_is_locked,
+		  struct rte_timer_data *timer_data)
 {
 	union rte_timer_status prev_status, status;
 	int ret;
 	unsigned lcore_id = rte_lcore_id();
+	struct priv_timer *priv_timer = timer_data->priv_timer;
 
 	/* round robin for tim_lcore */
 	if (tim_lcore == (unsigned)LCORE_ID_ANY) {
@@ -348,11 +518,11 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
-	ret = timer_set_config_state(tim, &prev_status);
+	ret = timer_set_config_state(tim, &prev_status, priv_timer);
 	if (ret < 0)
 		return -1;
 
-	__TIMER_STAT_ADD(reset, 1);
+	__TIMER_STAT_ADD(priv_timer, reset, 1);
 	if (prev_status.state == RTE_TIMER_RUNNING &&
 	    lcore_id < RTE_MAX_LCORE) {
 		priv_timer[lcore_id].updated = 1;
@@ -360,8 +530,8 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, local_is_locked);
-		__TIMER_STAT_ADD(pending, -1);
+		timer_del(tim, prev_status, local_is_locked, priv_timer);
+		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
 	tim->period = period;
@@ -376,8 +546,8 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 	if (tim_lcore != lcore_id || !local_is_locked)
 		rte_spinlock_lock(&priv_timer[tim_lcore].list_lock);
 
-	__TIMER_STAT_ADD(pending, 1);
-	timer_add(tim, tim_lcore);
+	__TIMER_STAT_ADD(priv_timer, pending, 1);
+	timer_add(tim, tim_lcore, priv_timer);
 
 	/* update state: as we are in CONFIG state, only us can modify
 	 * the state so we don't need to use cmpset() here */
@@ -392,11 +562,11 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 	return 0;
 }
 
-/* Reset and start the timer associated with the timer handle tim */
-int
-rte_timer_reset(struct rte_timer *tim, uint64_t ticks,
-		enum rte_timer_type type, unsigned tim_lcore,
-		rte_timer_cb_t fct, void *arg)
+static int
+timer_reset(struct rte_timer *tim, uint64_t ticks,
+	    enum rte_timer_type type, unsigned int tim_lcore,
+	    rte_timer_cb_t fct, void *arg,
+	    struct rte_timer_data *timer_data)
 {
 	uint64_t cur_time = rte_get_timer_cycles();
 	uint64_t period;
@@ -412,7 +582,29 @@ rte_timer_reset(struct rte_timer *tim, uint64_t ticks,
 		period = 0;
 
 	return __rte_timer_reset(tim,  cur_time + ticks, period, tim_lcore,
-			  fct, arg, 0);
+			  fct, arg, 0, timer_data);
+}
+
+/* Reset and start the timer associated with the timer handle tim */
+int
+rte_timer_reset(struct rte_timer *tim, uint64_t ticks,
+		enum rte_timer_type type, unsigned tim_lcore,
+		rte_timer_cb_t fct, void *arg)
+{
+	return timer_reset(tim, ticks, type, tim_lcore, fct, arg,
+			   &rte_timer_data_arr[default_data_id]);
+}
+
+int __rte_experimental
+rte_timer_alt_reset(uint32_t timer_data_id, struct rte_timer *tim,
+		    uint64_t ticks, enum rte_timer_type type,
+		    unsigned int tim_lcore, rte_timer_cb_t fct, void *arg)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return timer_reset(tim, ticks, type, tim_lcore, fct, arg, timer_data);
 }
 
 /* loop until rte_timer_reset() succeed */
@@ -426,21 +618,21 @@ rte_timer_reset_sync(struct rte_timer *tim, uint64_t ticks,
 		rte_pause();
 }
 
-/* Stop the timer associated with the timer handle tim */
-int
-rte_timer_stop(struct rte_timer *tim)
+static int
+__rte_timer_stop(struct rte_timer *tim, struct rte_timer_data *timer_data)
 {
 	union rte_timer_status prev_status, status;
 	unsigned lcore_id = rte_lcore_id();
+	struct priv_timer *priv_timer = timer_data->priv_timer;
 	int ret;
 
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
-	ret = timer_set_config_state(tim, &prev_status);
+	ret = timer_set_config_state(tim, &prev_status, priv_timer);
 	if (ret < 0)
 		return -1;
 
-	__TIMER_STAT_ADD(stop, 1);
+	__TIMER_STAT_ADD(priv_timer, stop, 1);
 	if (prev_status.state == RTE_TIMER_RUNNING &&
 	    lcore_id < RTE_MAX_LCORE) {
 		priv_timer[lcore_id].updated = 1;
@@ -448,8 +640,8 @@ rte_timer_stop(struct rte_timer *tim)
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, 0);
-		__TIMER_STAT_ADD(pending, -1);
+		timer_del(tim, prev_status, 0, priv_timer);
+		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
 	/* mark timer as stopped */
@@ -461,6 +653,23 @@ rte_timer_stop(struct rte_timer *tim)
 	return 0;
 }
 
+/* Stop the timer associated with the timer handle tim */
+int
+rte_timer_stop(struct rte_timer *tim)
+{
+	return __rte_timer_stop(tim, &rte_timer_data_arr[default_data_id]);
+}
+
+int __rte_experimental
+rte_timer_alt_stop(uint32_t timer_data_id, struct rte_timer *tim)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return __rte_timer_stop(tim, timer_data);
+}
+
 /* loop until rte_timer_stop() succeed */
 void
 rte_timer_stop_sync(struct rte_timer *tim)
@@ -476,59 +685,67 @@ rte_timer_pending(struct rte_timer *tim)
 	return tim->status.state == RTE_TIMER_PENDING;
 }
 
-/* must be called periodically, run all timer that expired */
-void rte_timer_manage(void)
+/*
+ * Remove at most max_expired timers expired at cur_time from the list of
+ * list_lcore and mark them as running on the calling lcore. They are
+ * returned linked with their sl_next[0] field.
+ */
+static struct rte_timer *
+timer_list_expire(struct priv_timer *priv_timer, unsigned int list_lcore,
+		  uint64_t cur_time, unsigned int max_expired)
 {
-	union rte_timer_status status;
 	struct rte_timer *tim, *next_tim;
 	struct rte_timer *run_first_tim, **pprev;
-	unsigned lcore_id = rte_lcore_id();
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
-	uint64_t cur_time;
+	unsigned int nb_expired = 0;
 	int i, ret;
 
-	/* timer manager only runs on EAL thread with valid lcore_id */
-	assert(lcore_id < RTE_MAX_LCORE);
-
-	__TIMER_STAT_ADD(manage, 1);
-	/* optimize for the case where per-cpu list is empty */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL)
-		return;
-	cur_time = rte_get_timer_cycles();
-
 #ifdef RTE_ARCH_64
 	/* on 64-bit the value cached in the pending_head.expired will be
 	 * updated atomically, so we can consult that for a quick check here
 	 * outside the lock */
-	if (likely(priv_timer[lcore_id].pending_head.expire > cur_time))
-		return;
+	if (likely(priv_timer[list_lcore].pending_head.expire > cur_time))
+		return NULL;
 #endif
 
 	/* browse ordered list, add expired timers in 'expired' list */
-	rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
+	rte_spinlock_lock(&priv_timer[list_lcore].list_lock);
+
+	if (priv_timer[list_lcore].wheel != NULL) {
+		tim = timer_wheel_expire(priv_timer[list_lcore].wheel,
+					 cur_time);
+		priv_timer[list_lcore].pending_head.expire =
+			timer_wheel_next_expire(priv_timer[list_lcore].wheel);
+		if (tim == NULL) {
+			rte_spinlock_unlock(&priv_timer[list_lcore].list_lock);
+			return NULL;
+		}
+		goto set_running;
+	}
 
 	/* if nothing to do just unlock and return */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL ||
-	    priv_timer[lcore_id].pending_head.sl_next[0]->expire > cur_time) {
-		rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
-		return;
+	if (priv_timer[list_lcore].pending_head.sl_next[0] == NULL ||
+	    priv_timer[list_lcore].pending_head.sl_next[0]->expire > cur_time) {
+		rte_spinlock_unlock(&priv_timer[list_lcore].list_lock);
+		return NULL;
 	}
 
 	/* save start of list of expired timers */
-	tim = priv_timer[lcore_id].pending_head.sl_next[0];
+	tim = priv_timer[list_lcore].pending_head.sl_next[0];
 
 	/* break the existing list at current time point */
-	timer_get_prev_entries(cur_time, lcore_id, prev);
-	for (i = priv_timer[lcore_id].curr_skiplist_depth -1; i >= 0; i--) {
-		if (prev[i] == &priv_timer[lcore_id].pending_head)
+	timer_get_prev_entries(cur_time, list_lcore, prev, priv_timer);
+	for (i = priv_timer[list_lcore].curr_skiplist_depth -1; i >= 0; i--) {
+		if (prev[i] == &priv_timer[list_lcore].pending_head)
 			continue;
-		priv_timer[lcore_id].pending_head.sl_next[i] =
+		priv_timer[list_lcore].pending_head.sl_next[i] =
 		    prev[i]->sl_next[i];
 		if (prev[i]->sl_next[i] == NULL)
-			priv_timer[lcore_id].curr_skiplist_depth--;
+			priv_timer[list_lcore].curr_skiplist_depth--;
 		prev[i] ->sl_next[i] = NULL;
 	}
 
+set_running:
 	/* transition run-list from PENDING to RUNNING */
 	run_first_tim = tim;
 	pprev = &run_first_tim;
@@ -536,9 +753,16 @@ void rte_timer_manage(void)
 	for ( ; tim != NULL; tim = next_tim) {
 		next_tim = tim->sl_next[0];
 
+		/* put the timers over the limit back in the list */
+		if (unlikely(nb_expired == max_expired)) {
+			timer_add(tim, list_lcore, priv_timer);
+			continue;
+		}
+
 		ret = timer_set_running_state(tim);
 		if (likely(ret == 0)) {
 			pprev = &tim->sl_next[0];
+			nb_expired++;
 		} else {
 			/* another core is trying to re-config this one,
 			 * remove it from local expired list
@@ -546,16 +770,41 @@ void rte_timer_manage(void)
 			*pprev = next_tim;
 		}
 	}
+	*pprev = NULL;
 
 	/* update the next to expire timer value */
-	priv_timer[lcore_id].pending_head.expire =
-	    (priv_timer[lcore_id].pending_head.sl_next[0] == NULL) ? 0 :
-		priv_timer[lcore_id].pending_head.sl_next[0]->expire;
+	if (priv_timer[list_lcore].wheel == NULL)
+		priv_timer[list_lcore].pending_head.expire =
+		    (priv_timer[list_lcore].pending_head.sl_next[0] == NULL) ?
+			0 : priv_timer[list_lcore].pending_head.sl_next[0]->expire;
+
+	rte_spinlock_unlock(&priv_timer[list_lcore].list_lock);
+
+	return run_first_tim;
+}
+
+/* must be called periodically, run all timer that expired */
+void rte_timer_manage(void)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer_data *timer_data = &rte_timer_data_arr[default_data_id];
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned lcore_id = rte_lcore_id();
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	assert(lcore_id < RTE_MAX_LCORE);
+
+	__TIMER_STAT_ADD(priv_timer, manage, 1);
+	/* optimize for the case where per-cpu list is empty */
+	if (timer_list_empty(&priv_timer[lcore_id]))
+		return;
 
-	rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
+	tim = timer_list_expire(priv_timer, lcore_id, rte_get_timer_cycles(),
+				UINT_MAX);
 
 	/* now scan expired list and call callbacks */
-	for (tim = run_first_tim; tim != NULL; tim = next_tim) {
+	for ( ; tim != NULL; tim = next_tim) {
 		next_tim = tim->sl_next[0];
 		priv_timer[lcore_id].updated = 0;
 		priv_timer[lcore_id].running_tim = tim;
@@ -563,7 +812,7 @@ void rte_timer_manage(void)
 		/* execute callback function with list unlocked */
 		tim->f(tim, tim->arg);
 
-		__TIMER_STAT_ADD(pending, -1);
+		__TIMER_STAT_ADD(priv_timer, pending, -1);
 		/* the timer was stopped or reloaded by the callback
 		 * function, we have nothing to do here */
 		if (priv_timer[lcore_id].updated == 1)
@@ -580,24 +829,237 @@ void rte_timer_manage(void)
 			/* keep it in list and mark timer as pending */
 			rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
 			status.state = RTE_TIMER_PENDING;
-			__TIMER_STAT_ADD(pending, 1);
+			__TIMER_STAT_ADD(priv_timer, pending, 1);
 			status.owner = (int16_t)lcore_id;
 			rte_wmb();
 			tim->status.u32 = status.u32;
 			__rte_timer_reset(tim, tim->expire + tim->period,
-				tim->period, lcore_id, tim->f, tim->arg, 1);
+				tim->period, lcore_id, tim->f, tim->arg, 1,
+				timer_data);
 			rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
 		}
 	}
 	priv_timer[lcore_id].running_tim = NULL;
 }
 
-/* dump statistics about timers */
-void rte_timer_dump_stats(FILE *f)
+int __rte_experimental
+rte_timer_alt_manage(uint32_t timer_data_id, unsigned int *poll_lcores,
+		     int nb_poll_lcores, rte_timer_alt_manage_cb_t f)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int poll_lcore;
+	uint64_t cur_time;
+	int i;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	if (poll_lcores == NULL) {
+		poll_lcores = &lcore_id;
+		nb_poll_lcores = 1;
+	}
+
+	__TIMER_STAT_ADD(priv_timer, manage, 1);
+	cur_time = rte_get_timer_cycles();
+
+	for (i = 0; i < nb_poll_lcores; i++) {
+		poll_lcore = poll_lcores[i];
+		if (poll_lcore >= RTE_MAX_LCORE)
+			return -EINVAL;
+		if (timer_list_empty(&priv_timer[poll_lcore]))
+			continue;
+
+		tim = timer_list_expire(priv_timer, poll_lcore, cur_time,
+					UINT_MAX);
+
+		for ( ; tim != NULL; tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			priv_timer[lcore_id].updated = 0;
+			priv_timer[lcore_id].running_tim = tim;
+
+			/* execute callback function with list unlocked */
+			if (f != NULL)
+				f(tim);
+			else
+				tim->f(tim, tim->arg);
+
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+			/* the timer was stopped or reloaded by the callback
+			 * function, we have nothing to do here */
+			if (priv_timer[lcore_id].updated == 1)
+				continue;
+
+			if (tim->period == 0) {
+				/* mark timer as stopped */
+				status.state = RTE_TIMER_STOP;
+				status.owner = RTE_TIMER_NO_OWNER;
+				rte_wmb();
+				tim->status.u32 = status.u32;
+			} else {
+				/* reload it in the list it expired from */
+				__rte_timer_reset(tim,
+					tim->expire + tim->period,
+					tim->period, poll_lcore, tim->f,
+					tim->arg, 0, timer_data);
+			}
+		}
+		priv_timer[lcore_id].running_tim = NULL;
+	}
+
+	return 0;
+}
+
+int __rte_experimental
+rte_timer_alt_manage_burst(uint32_t timer_data_id, unsigned int *poll_lcores,
+			   int nb_poll_lcores, struct rte_timer **expired,
+			   unsigned int nb_expired)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int poll_lcore, n = 0;
+	uint64_t cur_time;
+	int i;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	if (lcore_id >= RTE_MAX_LCORE || expired == NULL)
+		return -EINVAL;
+
+	if (poll_lcores == NULL) {
+		poll_lcores = &lcore_id;
+		nb_poll_lcores = 1;
+	}
+
+	__TIMER_STAT_ADD(priv_timer, manage, 1);
+	cur_time = rte_get_timer_cycles();
+
+	for (i = 0; i < nb_poll_lcores && n < nb_expired; i++) {
+		poll_lcore = poll_lcores[i];
+		if (poll_lcore >= RTE_MAX_LCORE)
+			return -EINVAL;
+		if (timer_list_empty(&priv_timer[poll_lcore]))
+			continue;
+
+		tim = timer_list_expire(priv_timer, poll_lcore, cur_time,
+					nb_expired - n);
+
+		/* the callback functions are left to the caller */
+		for ( ; tim != NULL; tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			expired[n++] = tim;
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+
+			if (tim->period == 0) {
+				/* mark timer as stopped */
+				status.state = RTE_TIMER_STOP;
+				status.owner = RTE_TIMER_NO_OWNER;
+				rte_wmb();
+				tim->status.u32 = status.u32;
+			} else {
+				/* reload it in the list it expired from */
+				priv_timer[lcore_id].running_tim = tim;
+				__rte_timer_reset(tim,
+					tim->expire + tim->period,
+					tim->period, poll_lcore, tim->f,
+					tim->arg, 0, timer_data);
+				priv_timer[lcore_id].running_tim = NULL;
+			}
+		}
+	}
+
+	return n;
+}
+
+/* Stop all the pending timers of a set of lcores */
+int __rte_experimental
+rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
+		   int nb_walk_lcores, rte_timer_stop_all_cb_t f,
+		   void *f_arg)
+{
+	union rte_timer_status prev_status, status;
+	struct rte_timer *tim, *next_tim, *stopped, **pprev;
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	unsigned int walk_lcore;
+	int i, lvl;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	if (walk_lcores == NULL && nb_walk_lcores != 0)
+		return -EINVAL;
+
+	for (i = 0; i < nb_walk_lcores; i++) {
+		walk_lcore = walk_lcores[i];
+		if (walk_lcore >= RTE_MAX_LCORE)
+			return -EINVAL;
+
+		/* take the whole list */
+		rte_spinlock_lock(&priv_timer[walk_lcore].list_lock);
+		if (priv_timer[walk_lcore].wheel != NULL) {
+			tim = timer_wheel_flush(priv_timer[walk_lcore].wheel);
+		} else {
+			tim = priv_timer[walk_lcore].pending_head.sl_next[0];
+			for (lvl = 0; lvl < MAX_SKIPLIST_DEPTH; lvl++)
+				priv_timer[walk_lcore].pending_head.sl_next[lvl] =
+					NULL;
+			priv_timer[walk_lcore].curr_skiplist_depth = 0;
+		}
+		priv_timer[walk_lcore].pending_head.expire = 0;
+
+		/* the timers being configured by other cores were already
+		 * removed from the list by them, skip them
+		 */
+		stopped = NULL;
+		pprev = &stopped;
+		for ( ; tim != NULL; tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			if (timer_set_config_state(tim, &prev_status,
+						   priv_timer) < 0)
+				continue;
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+			*pprev = tim;
+			pprev = &tim->sl_next[0];
+		}
+		*pprev = NULL;
+		rte_spinlock_unlock(&priv_timer[walk_lcore].list_lock);
+
+		/* callbacks are called with the list unlocked */
+		for (tim = stopped; tim != NULL; tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			__TIMER_STAT_ADD(priv_timer, stop, 1);
+			status.state = RTE_TIMER_STOP;
+			status.owner = RTE_TIMER_NO_OWNER;
+			rte_wmb();
+			tim->status.u32 = status.u32;
+			if (f != NULL)
+				f(tim, f_arg);
+		}
+	}
+
+	return 0;
+}
+
+static void
+timer_dump_stats(struct rte_timer_data *timer_data, FILE *f)
 {
 #ifdef RTE_LIBRTE_TIMER_DEBUG
 	struct rte_timer_debug_stats sum;
 	unsigned lcore_id;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
 
 	memset(&sum, 0, sizeof(sum));
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
@@ -612,6 +1074,24 @@ void rte_timer_dump_stats(FILE *f)
 	fprintf(f, "  manage = %"PRIu64"\n", sum.manage);
 	fprintf(f, "  pending = %"PRIu64"\n", sum.pending);
 #else
+	RTE_SET_USED(timer_data);
 	fprintf(f, "No timer statistics, RTE_LIBRTE_TIMER_DEBUG is disabled\n");
 #endif
 }
+
+/* dump statistics about timers */
+void rte_timer_dump_stats(FILE *f)
+{
+	timer_dump_stats(&rte_timer_data_arr[default_data_id], f);
+}
+
+int __rte_experimental
+rte_timer_alt_dump_stats(uint32_t timer_data_id, FILE *f)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	timer_dump_stats(timer_data, f);
+	return 0;
+}
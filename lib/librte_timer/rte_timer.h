@@ -38,6 +38,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_config.h>
 
 #ifdef __cplusplus
@@ -99,7 +100,17 @@ typedef void (*rte_timer_cb_t)(struct rte_timer *, void *);
 struct rte_timer
 {
 	uint64_t expire;       /**< Time when timer expire. */
-	struct rte_timer *sl_next[MAX_SKIPLIST_DEPTH];
+	RTE_STD_C11
+	union {
+		struct rte_timer *sl_next[MAX_SKIPLIST_DEPTH];
+		/** Links used when the list is a timing wheel. */
+		RTE_STD_C11
+		struct {
+			struct rte_timer *wh_next;   /**< Next timer in slot. */
+			struct rte_timer **wh_pprev; /**< Link to this timer. */
+			uint32_t wh_slot;            /**< Level and slot index. */
+		};
+	};
 	volatile union rte_timer_status status; /**< Status of timer. */
 	uint64_t period;       /**< Period of timer (0 if not periodic). */
 	rte_timer_cb_t f;      /**< Callback function. */
@@ -131,6 +142,16 @@ struct rte_timer
 	}
 #endif
 
+/**
+ * Data structure keeping the pending timers of an lcore.
+ */
+enum rte_timer_list_type {
+	/** Skiplist ordered by expiry time, O(log n) add and remove. */
+	RTE_TIMER_LIST_SKIPLIST,
+	/** Hierarchical timing wheel, O(1) add and remove. */
+	RTE_TIMER_LIST_WHEEL,
+};
+
 /**
  * Initialize the timer library.
  *
@@ -139,6 +160,95 @@ struct rte_timer
  */
 void rte_timer_subsystem_init(void);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Allocate a timer data instance.
+ *
+ * A timer data instance holds its own pending timer list for each lcore,
+ * so that the timers of a subsystem are neither contending with nor run by
+ * rte_timer_manage() calls for other timers. The timers of an instance are
+ * handled with the rte_timer_alt_*() functions, and a timer must always be
+ * used with the same instance. The API without a timer data identifier
+ * uses a default instance, initialized by rte_timer_subsystem_init(), which
+ * is never returned by this function, even before this initialization.
+ *
+ * @param id_ptr
+ *   Pointer to variable to store the allocated timer data identifier.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid parameter.
+ *   - (-ENOSPC): Maximum number of instances already allocated.
+ */
+int __rte_experimental rte_timer_data_alloc(uint32_t *id_ptr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a timer data instance.
+ *
+ * @param id
+ *   Identifier of the timer data instance.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid timer data identifier, or default instance.
+ *   - (-EBUSY): Timers are pending in the instance.
+ */
+int __rte_experimental rte_timer_data_dealloc(uint32_t id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Select the data structure keeping the pending timers of an lcore.
+ *
+ * The skiplist is used by default. The timing wheel adds and removes
+ * timers in constant time, which is faster when an lcore has a lot of
+ * pending timers, for instance one per flow. Its resolution is a wheel tick
+ * of about one microsecond: the callbacks of the timers expiring in the same
+ * tick may not be called in expiry order.
+ *
+ * The list must be empty, and rte_timer_manage() must not be running on
+ * the lcore.
+ *
+ * @param lcore_id
+ *   The ID of the lcore owning the list.
+ * @param type
+ *   The data structure to use.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid lcore or type.
+ *   - (-EBUSY): Timers are pending on the lcore.
+ *   - (-ENOMEM): Not enough memory for the timing wheel.
+ */
+int __rte_experimental
+rte_timer_list_set_type(unsigned int lcore_id, enum rte_timer_list_type type);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Select the data structure keeping the pending timers of an lcore in a
+ * timer data instance. See rte_timer_list_set_type() for details.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param lcore_id
+ *   The ID of the lcore owning the list.
+ * @param type
+ *   The data structure to use.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid timer data, lcore or type.
+ *   - (-EBUSY): Timers are pending on the lcore.
+ *   - (-ENOMEM): Not enough memory for the timing wheel.
+ */
+int __rte_experimental
+rte_timer_alt_list_set_type(uint32_t timer_data_id, unsigned int lcore_id,
+			    enum rte_timer_list_type type);
+
 /**
  * Initialize a timer handle.
  *
@@ -229,6 +339,40 @@ rte_timer_reset_sync(struct rte_timer *tim, uint64_t ticks,
 		     enum rte_timer_type type, unsigned tim_lcore,
 		     rte_timer_cb_t fct, void *arg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset and start a timer of a timer data instance.
+ *
+ * See rte_timer_reset() for details.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param tim
+ *   The timer handle.
+ * @param ticks
+ *   The number of cycles (see rte_get_hpet_hz()) before the callback
+ *   function is called.
+ * @param type
+ *   The type can be either SINGLE or PERIODICAL.
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback function has to be
+ *   executed, or LCORE_ID_ANY for round-robin.
+ * @param fct
+ *   The callback function of the timer.
+ * @param arg
+ *   The user argument of the callback function.
+ * @return
+ *   - 0: Success; the timer is scheduled.
+ *   - (-1): Timer is in the RUNNING or CONFIG state.
+ *   - (-EINVAL): Invalid timer data identifier.
+ */
+int __rte_experimental
+rte_timer_alt_reset(uint32_t timer_data_id, struct rte_timer *tim,
+		    uint64_t ticks, enum rte_timer_type type,
+		    unsigned int tim_lcore, rte_timer_cb_t fct, void *arg);
+
 /**
  * Stop a timer.
  *
@@ -266,6 +410,26 @@ int rte_timer_stop(struct rte_timer *tim);
  */
 void rte_timer_stop_sync(struct rte_timer *tim);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Stop a timer of a timer data instance.
+ *
+ * See rte_timer_stop() for details.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param tim
+ *   The timer handle.
+ * @return
+ *   - 0: Success; the timer is stopped.
+ *   - (-1): The timer is in the RUNNING or CONFIG state.
+ *   - (-EINVAL): Invalid timer data identifier.
+ */
+int __rte_experimental
+rte_timer_alt_stop(uint32_t timer_data_id, struct rte_timer *tim);
+
 /**
  * Test if a timer is pending.
  *
@@ -294,6 +458,105 @@ int rte_timer_pending(struct rte_timer *tim);
  */
 void rte_timer_manage(void);
 
+/**
+ * Callback function type for rte_timer_alt_manage().
+ */
+typedef void (*rte_timer_alt_manage_cb_t)(struct rte_timer *tim);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Manage the timer lists of a set of lcores in a timer data instance.
+ *
+ * The expired timers are removed from the list of each lcore in
+ * *poll_lcores* at once, and are then run on the calling lcore, with the
+ * lists unlocked. This allows a service core to drain the timers of
+ * several lcores. A periodic timer is reloaded in the list it expired from.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param poll_lcores
+ *   Array of the lcores whose list is managed, NULL for the calling lcore.
+ * @param nb_poll_lcores
+ *   Number of lcores in *poll_lcores*.
+ * @param f
+ *   Function called for each expired timer, instead of its own callback
+ *   function if not NULL.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid timer data identifier or lcore, or not called from
+ *     an EAL thread.
+ */
+int __rte_experimental
+rte_timer_alt_manage(uint32_t timer_data_id, unsigned int *poll_lcores,
+		     int nb_poll_lcores, rte_timer_alt_manage_cb_t f);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Manage the timer lists of a set of lcores in a timer data instance, and
+ * return the expired timers instead of running their callback function.
+ *
+ * At most *nb_expired* timers are removed, the other expired timers are
+ * kept for the next call. A periodic timer is reloaded in the list it
+ * expired from, the other returned timers are stopped, so that they can be
+ * reset by the caller while processing them.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param poll_lcores
+ *   Array of the lcores whose list is managed, NULL for the calling lcore.
+ * @param nb_poll_lcores
+ *   Number of lcores in *poll_lcores*.
+ * @param expired
+ *   Array filled with the expired timers.
+ * @param nb_expired
+ *   Size of the *expired* array.
+ * @return
+ *   - The number of timers stored in *expired*.
+ *   - (-EINVAL): Invalid timer data identifier or lcore, or not called from
+ *     an EAL thread.
+ */
+int __rte_experimental
+rte_timer_alt_manage_burst(uint32_t timer_data_id, unsigned int *poll_lcores,
+			   int nb_poll_lcores, struct rte_timer **expired,
+			   unsigned int nb_expired);
+
+/**
+ * Callback function type for rte_timer_stop_all().
+ */
+typedef void (*rte_timer_stop_all_cb_t)(struct rte_timer *tim, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Stop all the pending timers of a set of lcores in a timer data instance.
+ *
+ * The timers being run or configured at the same time are not stopped.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param walk_lcores
+ *   Array of the lcores whose list is emptied.
+ * @param nb_walk_lcores
+ *   Number of lcores in *walk_lcores*.
+ * @param f
+ *   Function called for each stopped timer, with the list unlocked, so
+ *   that it can for instance be freed. Can be NULL.
+ * @param f_arg
+ *   Argument of *f*.
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid timer data identifier or lcore.
+ */
+int __rte_experimental
+rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
+		   int nb_walk_lcores, rte_timer_stop_all_cb_t f,
+		   void *f_arg);
+
 /**
  * Dump statistics about timers.
  *
@@ -302,6 +565,23 @@ void rte_timer_manage(void);
  */
 void rte_timer_dump_stats(FILE *f);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dump statistics about the timers of a timer data instance.
+ *
+ * @param timer_data_id
+ *   Identifier of the timer data instance.
+ * @param f
+ *   A pointer to a file for output
+ * @return
+ *   - 0: Success.
+ *   - (-EINVAL): Invalid timer data identifier.
+ */
+int __rte_experimental
+rte_timer_alt_dump_stats(uint32_t timer_data_id, FILE *f);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,256 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+
+#include "timer_wheel.h"
+
+/* timers further away are put in the last slot reached by the top level */
+#define TIMER_WHEEL_MAX_DELTA \
+	((UINT64_C(1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)
+
+struct timer_wheel *
+timer_wheel_create(int socket_id)
+{
+	uint64_t hz = rte_get_timer_hz();
+	struct timer_wheel *w;
+
+	/* expired timers are chained like in the skiplist */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_timer, wh_next) !=
+			offsetof(struct rte_timer, sl_next[0]));
+
+	w = rte_zmalloc_socket("TIMER_WHEEL", sizeof(*w), RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (w == NULL)
+		return NULL;
+
+	/* ticks of at most one microsecond */
+	while ((hz >> (w->shift + 1)) >= US_PER_S)
+		w->shift++;
+
+	w->now = rte_get_timer_cycles() >> w->shift;
+	w->cascade_tick = w->now;
+	w->next_tick = UINT64_MAX;
+	return w;
+}
+
+void
+timer_wheel_free(struct timer_wheel *w)
+{
+	rte_free(w);
+}
+
+/* link a timer in the slot matching its expiry time */
+static void
+wheel_link(struct timer_wheel *w, struct rte_timer *tim)
+{
+	uint64_t tick = tim->expire >> w->shift;
+	struct rte_timer **slot;
+	unsigned int lvl, idx;
+	uint64_t delta, visit;
+
+	/* expired timers are run by the next rte_timer_manage() */
+	if (tick < w->now)
+		tick = w->now;
+
+	delta = tick - w->now;
+	if (delta > TIMER_WHEEL_MAX_DELTA) {
+		delta = TIMER_WHEEL_MAX_DELTA;
+		tick = w->now + delta;
+	}
+
+	/* the lowest level where the slot is reached in less than a turn */
+	lvl = delta == 0 ? 0 : (63 - __builtin_clzll(delta)) / TIMER_WHEEL_BITS;
+	idx = (tick >> (lvl * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
+
+	slot = &w->slots[lvl][idx];
+	tim->wh_next = *slot;
+	if (*slot != NULL)
+		(*slot)->wh_pprev = &tim->wh_next;
+	tim->wh_pprev = slot;
+	tim->wh_slot = lvl * TIMER_WHEEL_SLOTS + idx;
+	*slot = tim;
+	w->bitmap[lvl] |= UINT64_C(1) << idx;
+
+	/* upper levels are handled when their slot is cascaded */
+	visit = tick & ~((UINT64_C(1) << (lvl * TIMER_WHEEL_BITS)) - 1);
+	if (visit < w->next_tick)
+		w->next_tick = visit;
+}
+
+static void
+wheel_unlink(struct timer_wheel *w, struct rte_timer *tim)
+{
+	unsigned int lvl = tim->wh_slot / TIMER_WHEEL_SLOTS;
+	unsigned int idx = tim->wh_slot % TIMER_WHEEL_SLOTS;
+
+	*tim->wh_pprev = tim->wh_next;
+	if (tim->wh_next != NULL)
+		tim->wh_next->wh_pprev = tim->wh_pprev;
+	tim->wh_pprev = NULL;
+
+	if (w->slots[lvl][idx] == NULL)
+		w->bitmap[lvl] &= ~(UINT64_C(1) << idx);
+}
+
+/* get the first tick from *from* where a non-empty slot is reached */
+static uint64_t
+wheel_next_tick(const struct timer_wheel *w, uint64_t from)
+{
+	uint64_t next = UINT64_MAX;
+	unsigned int lvl;
+
+	for (lvl = 0; lvl < TIMER_WHEEL_LEVELS; lvl++) {
+		unsigned int shift = lvl * TIMER_WHEEL_BITS;
+		uint64_t bitmap = w->bitmap[lvl];
+		uint64_t visit;
+		unsigned int idx;
+
+		if (bitmap == 0)
+			continue;
+
+		/* rotate the bitmap so that bit 0 is the next slot reached */
+		visit = RTE_ALIGN_CEIL(from, UINT64_C(1) << shift);
+		idx = (visit >> shift) & TIMER_WHEEL_MASK;
+		if (idx != 0)
+			bitmap = (bitmap >> idx) |
+				(bitmap << (TIMER_WHEEL_SLOTS - idx));
+
+		visit += (uint64_t)__builtin_ctzll(bitmap) << shift;
+		if (visit < next)
+			next = visit;
+	}
+
+	return next;
+}
+
+/* move the timers of the upper level slots reached now to lower levels */
+static void
+wheel_cascade(struct timer_wheel *w)
+{
+	struct rte_timer *tim, *next;
+	unsigned int lvl, idx;
+
+	for (lvl = 1; lvl < TIMER_WHEEL_LEVELS; lvl++) {
+		unsigned int shift = lvl * TIMER_WHEEL_BITS;
+
+		if ((w->now & ((UINT64_C(1) << shift) - 1)) != 0)
+			break;
+
+		idx = (w->now >> shift) & TIMER_WHEEL_MASK;
+		tim = w->slots[lvl][idx];
+		w->slots[lvl][idx] = NULL;
+		w->bitmap[lvl] &= ~(UINT64_C(1) << idx);
+
+		for (; tim != NULL; tim = next) {
+			next = tim->wh_next;
+			wheel_link(w, tim);
+		}
+	}
+	w->cascade_tick = w->now;
+}
+
+void
+timer_wheel_add(struct timer_wheel *w, struct rte_timer *tim)
+{
+	/* an empty wheel is not advanced, catch up with the current time */
+	if (w->count == 0) {
+		uint64_t now = rte_get_timer_cycles() >> w->shift;
+
+		if (now > w->now) {
+			w->now = now;
+			w->cascade_tick = now;
+		}
+	}
+
+	wheel_link(w, tim);
+	w->count++;
+}
+
+void
+timer_wheel_del(struct timer_wheel *w, struct rte_timer *tim)
+{
+	/* already removed by timer_wheel_expire() */
+	if (tim->wh_pprev == NULL)
+		return;
+
+	wheel_unlink(w, tim);
+	w->count--;
+}
+
+struct rte_timer *
+timer_wheel_expire(struct timer_wheel *w, uint64_t cur_time)
+{
+	uint64_t cur = cur_time >> w->shift;
+	struct rte_timer *run_first = NULL;
+	struct rte_timer **run_last = &run_first;
+	struct rte_timer *tim, *next;
+
+	if (cur < w->now)
+		return NULL;
+
+	for (;;) {
+		if ((w->now & TIMER_WHEEL_MASK) == 0 &&
+				w->now != w->cascade_tick)
+			wheel_cascade(w);
+
+		/* the timers of the current tick may not be expired yet */
+		tim = w->slots[0][w->now & TIMER_WHEEL_MASK];
+		for (; tim != NULL; tim = next) {
+			next = tim->wh_next;
+			if (w->now == cur && tim->expire > cur_time)
+				continue;
+			wheel_unlink(w, tim);
+			w->count--;
+			*run_last = tim;
+			run_last = &tim->wh_next;
+		}
+
+		if (w->now == cur)
+			break;
+		w->now = RTE_MIN(wheel_next_tick(w, w->now + 1), cur);
+	}
+	*run_last = NULL;
+
+	if (w->bitmap[0] & (UINT64_C(1) << (w->now & TIMER_WHEEL_MASK)))
+		w->next_tick = w->now;
+	else
+		w->next_tick = wheel_next_tick(w, w->now + 1);
+
+	return run_first;
+}
+
+struct rte_timer *
+timer_wheel_flush(struct timer_wheel *w)
+{
+	struct rte_timer *first = NULL;
+	struct rte_timer **last = &first;
+	struct rte_timer *tim;
+	unsigned int lvl, idx;
+
+	for (lvl = 0; lvl < TIMER_WHEEL_LEVELS; lvl++) {
+		for (idx = 0; idx < TIMER_WHEEL_SLOTS; idx++) {
+			tim = w->slots[lvl][idx];
+			if (tim == NULL)
+				continue;
+			w->slots[lvl][idx] = NULL;
+
+			*last = tim;
+			for (; tim != NULL; tim = tim->wh_next) {
+				tim->wh_pprev = NULL;
+				last = &tim->wh_next;
+			}
+		}
+		w->bitmap[lvl] = 0;
+	}
+
+	w->count = 0;
+	w->next_tick = UINT64_MAX;
+	return first;
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2019 Intel Corporation
+ */
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include "rte_timer.h"
+
+/*
+ * Hierarchical timing wheel, used as an alternative to the skiplist to keep
+ * the pending timers of an lcore.
+ *
+ * The time is split in wheel ticks of 2^shift timer cycles (about one
+ * microsecond). Each level has 64 slots, a slot of level n covering 64^n
+ * ticks. A timer is linked in the slot of the lowest level covering its
+ * expiry time, so that adding and removing it is done in constant time.
+ * When the wheel reaches a slot of an upper level, its timers are moved to
+ * the lower levels (cascading). A bitmap of the non-empty slots is kept for
+ * each level, to skip the empty ones.
+ *
+ * The wheel is not thread-safe, the caller must hold the lock of the list.
+ */
+
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS 6
+
+struct timer_wheel {
+	uint64_t now;          /**< Tick being processed. */
+	uint64_t cascade_tick; /**< Last tick the upper levels were cascaded. */
+	uint64_t next_tick;    /**< No timer to process before this tick. */
+	unsigned int shift;    /**< Log2 of the number of cycles per tick. */
+	unsigned int count;    /**< Number of timers in the wheel. */
+	uint64_t bitmap[TIMER_WHEEL_LEVELS]; /**< Non-empty slots. */
+	struct rte_timer *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+};
+
+/* Allocate a wheel starting at the current time. */
+struct timer_wheel *
+timer_wheel_create(int socket_id);
+
+/* Free a wheel. */
+void
+timer_wheel_free(struct timer_wheel *w);
+
+/* Add a timer, its expire field must be set. */
+void
+timer_wheel_add(struct timer_wheel *w, struct rte_timer *tim);
+
+/* Remove a timer, if it is still linked in the wheel. */
+void
+timer_wheel_del(struct timer_wheel *w, struct rte_timer *tim);
+
+/*
+ * Remove all the timers expired at cur_time from the wheel. They are
+ * returned in expiry order, linked with their sl_next[0] field.
+ */
+struct rte_timer *
+timer_wheel_expire(struct timer_wheel *w, uint64_t cur_time);
+
+/* Remove all the timers of the wheel, linked with their sl_next[0] field. */
+struct rte_timer *
+timer_wheel_flush(struct timer_wheel *w);
+
+/* Get a time before which no timer of the wheel expires. */
+static inline uint64_t
+timer_wheel_next_expire(const struct timer_wheel *w)
+{
+	if (w->next_tick > (UINT64_MAX >> w->shift))
+		return UINT64_MAX;
+	return w->next_tick << w->shift;
+}
+
+#endif /* _TIMER_WHEEL_H_ */